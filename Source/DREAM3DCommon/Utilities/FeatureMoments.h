@@ -0,0 +1,419 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The FeatureMoments class accumulates per Feature statistics of the cells of an image in a single parallel
+ * pass over the Feature Ids: the number of cells and, optionally, the first and second moments of the cell indices.
+ *
+ * The volume is split into chunks of rows and every chunk sums into its own per Feature buffer, so no locking is
+ * needed. The buffers are merged when the pass is done. All sums are kept as unsigned integers of the cell indices,
+ * which makes them exact and independent of the number of chunks. Callers map indices to physical coordinates with
+ * getProductSum().
+ *
+ * Cells whose Feature Id is negative or not smaller than the number of Features are ignored.
+ */
+class FeatureMoments
+{
+public:
+  /**
+   * @brief The Order enum selects the highest moment that is accumulated
+   */
+  enum class Order : int32_t
+  {
+    Counts = 0, //!< Number of cells only
+    First = 1,  //!< Counts and the sums of the cell indices
+    Second = 2  //!< Counts, first moments and the sums of the products of the cell indices
+  };
+
+  /**
+   * @brief FeatureMoments
+   * @param featureIds Feature Id of every cell, x fastest
+   * @param dims Dimensions of the image
+   * @param numFeatures Number of Features, including Feature 0
+   * @param order Highest moment to accumulate
+   */
+  FeatureMoments(const int32_t* featureIds, const SizeVec3Type& dims, size_t numFeatures, Order order)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_NumFeatures(numFeatures)
+  , m_Order(order)
+  {
+    m_Stride = (order == Order::Counts) ? 1 : (order == Order::First ? 4 : 10);
+  }
+
+  ~FeatureMoments() = default;
+
+  /**
+   * @brief compute Runs the pass over the Feature Ids. Must be called before any of the getters.
+   */
+  void compute()
+  {
+    const size_t numRows = m_Dims[1] * m_Dims[2];
+    const size_t numChunks = ChunkCount(numRows, m_NumFeatures * m_Stride);
+
+    std::vector<std::vector<uint64_t>> chunkSums(numChunks);
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numChunks);
+      dataAlg.setGrain(1);
+      dataAlg.execute(AccumulateImpl(this, numChunks, chunkSums));
+    }
+
+    if(numChunks == 1)
+    {
+      m_Sums = std::move(chunkSums[0]);
+      return;
+    }
+    m_Sums.assign(m_NumFeatures * m_Stride, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, m_NumFeatures);
+    dataAlg.execute(MergeImpl(chunkSums, m_Sums, m_Stride, false));
+  }
+
+  /**
+   * @brief getCount Returns the number of cells of the Feature
+   */
+  uint64_t getCount(size_t feature) const
+  {
+    return m_Sums[feature * m_Stride];
+  }
+
+  /**
+   * @brief getMeanIndex Returns the mean cell index of the Feature along the axis (0 = x, 1 = y, 2 = z). Requires
+   * Order::First or higher and a Feature with at least one cell.
+   */
+  double getMeanIndex(size_t feature, size_t axis) const
+  {
+    const uint64_t* sums = m_Sums.data() + feature * m_Stride;
+    return static_cast<double>(sums[1 + axis]) / static_cast<double>(sums[0]);
+  }
+
+  /**
+   * @brief getProductSum Returns the sum over the cells of the Feature of (scaleA * a + offsetA) * (scaleB * b + offsetB),
+   * where a and b are the cell indices along axisA and axisB. Passing the spacing as scale and origin - center as offset
+   * gives the second moment about the center. Requires Order::Second.
+   */
+  double getProductSum(size_t feature, size_t axisA, double scaleA, double offsetA, size_t axisB, double scaleB, double offsetB) const
+  {
+    const uint64_t* sums = m_Sums.data() + feature * m_Stride;
+    const double count = static_cast<double>(sums[0]);
+    const double sumA = static_cast<double>(sums[1 + axisA]);
+    const double sumB = static_cast<double>(sums[1 + axisB]);
+    const double sumAB = static_cast<double>(sums[SecondMomentIndex(axisA, axisB)]);
+    return scaleA * scaleB * sumAB + scaleA * offsetB * sumA + scaleB * offsetA * sumB + count * offsetA * offsetB;
+  }
+
+  /**
+   * @brief LargestSliceCounts Returns, for every Feature, the largest number of cells it has in any one slice
+   * perpendicular to the axis (0 = x, 1 = y, 2 = z). Slices are split between threads, each thread keeping its own
+   * maxima, which are merged at the end.
+   * @param featureIds Feature Id of every cell, x fastest
+   * @param dims Dimensions of the image
+   * @param numFeatures Number of Features, including Feature 0
+   * @param axis Axis normal to the slices
+   */
+  static std::vector<uint64_t> LargestSliceCounts(const int32_t* featureIds, const SizeVec3Type& dims, size_t numFeatures, size_t axis)
+  {
+    // Each chunk holds the running counts of its current slice and its maxima
+    const size_t numChunks = ChunkCount(dims[axis], 2 * numFeatures);
+
+    std::vector<std::vector<uint64_t>> chunkMaxima(numChunks);
+    {
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numChunks);
+      dataAlg.setGrain(1);
+      dataAlg.execute(SliceImpl(featureIds, dims, numFeatures, axis, numChunks, chunkMaxima));
+    }
+
+    if(numChunks == 1)
+    {
+      return std::move(chunkMaxima[0]);
+    }
+    std::vector<uint64_t> largest(numFeatures, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numFeatures);
+    dataAlg.execute(MergeImpl(chunkMaxima, largest, 1, true));
+    return largest;
+  }
+
+private:
+  // Upper bound on the memory used by the per chunk buffers
+  static constexpr size_t k_ChunkBufferBudget = 256ULL * 1024ULL * 1024ULL;
+
+  static size_t ChunkCount(size_t workItems, size_t valuesPerChunk)
+  {
+    size_t numChunks = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    numChunks = std::min(numChunks, std::max<size_t>(workItems, 1));
+    numChunks = std::min(numChunks, std::max<size_t>(k_ChunkBufferBudget / (std::max<size_t>(valuesPerChunk, 1) * sizeof(uint64_t)), 1));
+    return numChunks;
+  }
+
+  // Layout of the 10 sums of a Feature: count, x, y, z, xx, yy, zz, xy, yz, xz
+  static size_t SecondMomentIndex(size_t axisA, size_t axisB)
+  {
+    if(axisA == axisB)
+    {
+      return 4 + axisA;
+    }
+    if(axisA + axisB == 1)
+    {
+      return 7;
+    }
+    return (axisA + axisB == 3) ? 8 : 9;
+  }
+
+  void accumulateRows(size_t rowStart, size_t rowEnd, std::vector<uint64_t>& sums) const
+  {
+    const size_t xPoints = m_Dims[0];
+    const size_t yPoints = m_Dims[1];
+    const size_t stride = m_Stride;
+    const int64_t numFeatures = static_cast<int64_t>(m_NumFeatures);
+    uint64_t* out = sums.data();
+
+    for(size_t row = rowStart; row < rowEnd; row++)
+    {
+      const uint64_t y = row % yPoints;
+      const uint64_t z = row / yPoints;
+      const int32_t* ids = m_FeatureIds + row * xPoints;
+      for(uint64_t x = 0; x < xPoints; x++)
+      {
+        const int64_t gnum = ids[x];
+        if(gnum < 0 || gnum >= numFeatures)
+        {
+          continue;
+        }
+        uint64_t* s = out + static_cast<size_t>(gnum) * stride;
+        s[0]++;
+        if(m_Order == Order::Counts)
+        {
+          continue;
+        }
+        s[1] += x;
+        s[2] += y;
+        s[3] += z;
+        if(m_Order == Order::Second)
+        {
+          s[4] += x * x;
+          s[5] += y * y;
+          s[6] += z * z;
+          s[7] += x * y;
+          s[8] += y * z;
+          s[9] += x * z;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief The AccumulateImpl class sums one chunk of rows into the buffer of that chunk
+   */
+  class AccumulateImpl
+  {
+  public:
+    AccumulateImpl(const FeatureMoments* engine, size_t numChunks, std::vector<std::vector<uint64_t>>& chunkSums)
+    : m_Engine(engine)
+    , m_NumChunks(numChunks)
+    , m_ChunkSums(chunkSums)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      const size_t numRows = m_Engine->m_Dims[1] * m_Engine->m_Dims[2];
+      for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+      {
+        std::vector<uint64_t>& sums = m_ChunkSums[chunk];
+        sums.assign(m_Engine->m_NumFeatures * m_Engine->m_Stride, 0);
+        m_Engine->accumulateRows(chunk * numRows / m_NumChunks, (chunk + 1) * numRows / m_NumChunks, sums);
+      }
+    }
+
+  private:
+    const FeatureMoments* m_Engine = nullptr;
+    size_t m_NumChunks = 1;
+    std::vector<std::vector<uint64_t>>& m_ChunkSums;
+  };
+
+  /**
+   * @brief The SliceImpl class counts the cells of every Feature in one chunk of slices and keeps the largest count
+   */
+  class SliceImpl
+  {
+  public:
+    SliceImpl(const int32_t* featureIds, const SizeVec3Type& dims, size_t numFeatures, size_t axis, size_t numChunks, std::vector<std::vector<uint64_t>>& chunkMaxima)
+    : m_FeatureIds(featureIds)
+    , m_Dims(dims)
+    , m_NumFeatures(numFeatures)
+    , m_Axis(axis)
+    , m_NumChunks(numChunks)
+    , m_ChunkMaxima(chunkMaxima)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      const size_t numSlices = m_Dims[m_Axis];
+      for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+      {
+        std::vector<uint64_t>& maxima = m_ChunkMaxima[chunk];
+        maxima.assign(m_NumFeatures, 0);
+        std::vector<uint64_t> counts(m_NumFeatures, 0);
+        std::vector<int32_t> touched;
+        for(size_t slice = chunk * numSlices / m_NumChunks; slice < (chunk + 1) * numSlices / m_NumChunks; slice++)
+        {
+          countSlice(slice, counts, touched);
+          for(int32_t gnum : touched)
+          {
+            maxima[gnum] = std::max(maxima[gnum], counts[gnum]);
+            counts[gnum] = 0;
+          }
+          touched.clear();
+        }
+      }
+    }
+
+  private:
+    void count(int32_t gnum, std::vector<uint64_t>& counts, std::vector<int32_t>& touched) const
+    {
+      if(gnum < 0 || static_cast<size_t>(gnum) >= m_NumFeatures)
+      {
+        return;
+      }
+      if(counts[gnum]++ == 0)
+      {
+        touched.push_back(gnum);
+      }
+    }
+
+    void countSlice(size_t slice, std::vector<uint64_t>& counts, std::vector<int32_t>& touched) const
+    {
+      const size_t xPoints = m_Dims[0];
+      const size_t yPoints = m_Dims[1];
+      const size_t zPoints = m_Dims[2];
+      if(m_Axis == 2)
+      {
+        const int32_t* ids = m_FeatureIds + slice * xPoints * yPoints;
+        for(size_t i = 0; i < xPoints * yPoints; i++)
+        {
+          count(ids[i], counts, touched);
+        }
+      }
+      else if(m_Axis == 1)
+      {
+        for(size_t z = 0; z < zPoints; z++)
+        {
+          const int32_t* ids = m_FeatureIds + (z * yPoints + slice) * xPoints;
+          for(size_t x = 0; x < xPoints; x++)
+          {
+            count(ids[x], counts, touched);
+          }
+        }
+      }
+      else
+      {
+        for(size_t row = 0; row < yPoints * zPoints; row++)
+        {
+          count(m_FeatureIds[row * xPoints + slice], counts, touched);
+        }
+      }
+    }
+
+    const int32_t* m_FeatureIds = nullptr;
+    SizeVec3Type m_Dims;
+    size_t m_NumFeatures = 0;
+    size_t m_Axis = 2;
+    size_t m_NumChunks = 1;
+    std::vector<std::vector<uint64_t>>& m_ChunkMaxima;
+  };
+
+  /**
+   * @brief The MergeImpl class combines the chunk buffers of a range of Features, either by summing or by taking the maximum
+   */
+  class MergeImpl
+  {
+  public:
+    MergeImpl(const std::vector<std::vector<uint64_t>>& chunkValues, std::vector<uint64_t>& merged, size_t stride, bool useMaximum)
+    : m_ChunkValues(chunkValues)
+    , m_Merged(merged)
+    , m_Stride(stride)
+    , m_UseMaximum(useMaximum)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      const size_t start = range.min() * m_Stride;
+      const size_t end = range.max() * m_Stride;
+      for(const auto& values : m_ChunkValues)
+      {
+        for(size_t i = start; i < end; i++)
+        {
+          m_Merged[i] = m_UseMaximum ? std::max(m_Merged[i], values[i]) : m_Merged[i] + values[i];
+        }
+      }
+    }
+
+  private:
+    const std::vector<std::vector<uint64_t>>& m_ChunkValues;
+    std::vector<uint64_t>& m_Merged;
+    size_t m_Stride = 1;
+    bool m_UseMaximum = false;
+  };
+
+  const int32_t* m_FeatureIds = nullptr;
+  SizeVec3Type m_Dims;
+  size_t m_NumFeatures = 0;
+  Order m_Order = Order::Counts;
+  size_t m_Stride = 1;
+  std::vector<uint64_t> m_Sums;
+
+public:
+  FeatureMoments(const FeatureMoments&) = delete;            // Copy Constructor Not Implemented
+  FeatureMoments(FeatureMoments&&) = delete;                 // Move Constructor Not Implemented
+  FeatureMoments& operator=(const FeatureMoments&) = delete; // Copy Assignment Not Implemented
+  FeatureMoments& operator=(FeatureMoments&&) = delete;      // Move Assignment Not Implemented
+};
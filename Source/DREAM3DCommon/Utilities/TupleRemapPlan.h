@@ -0,0 +1,229 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The TupleRemapPlan class collects a list of tuple copies (source -> destination) that should be applied
+ * to every array of an AttributeMatrix. The arrays are looked up once when the plan is created and each copy is a
+ * plain memcpy of the tuple's bytes, instead of a name lookup and a virtual copyTuple() per array per tuple.
+ *
+ * The copies of each array are applied in the order they were added, so a plan reproduces a sequence of in place
+ * copyTuple() calls exactly, including chains where a destination is later used as a source. Different arrays are
+ * independent and are remapped in parallel.
+ *
+ * The arrays must not be resized between creating and applying the plan.
+ */
+class TupleRemapPlan
+{
+public:
+  /**
+   * @brief TupleRemapPlan
+   * @param attrMat AttributeMatrix holding the arrays
+   * @param arrayNames Names of the arrays the plan is applied to
+   */
+  TupleRemapPlan(const AttributeMatrix::Pointer& attrMat, const QList<QString>& arrayNames)
+  {
+    for(const auto& arrayName : arrayNames)
+    {
+      IDataArray::Pointer array = attrMat->getAttributeArray(arrayName);
+      if(nullptr == array.get())
+      {
+        continue;
+      }
+      Target target;
+      target.array = array;
+      if(!(resolve<int8_t>(target) || resolve<uint8_t>(target) || resolve<int16_t>(target) || resolve<uint16_t>(target) || resolve<int32_t>(target) || resolve<uint32_t>(target) ||
+           resolve<int64_t>(target) || resolve<uint64_t>(target) || resolve<float>(target) || resolve<double>(target) || resolve<bool>(target)))
+      {
+        // Not a plain DataArray (e.g. a StringDataArray), so fall back to the array's own virtual copy
+        target.data = nullptr;
+      }
+      m_Targets.push_back(target);
+    }
+  }
+
+  ~TupleRemapPlan() = default;
+
+  /**
+   * @brief addCopy Copies the tuple at source over the tuple at destination
+   */
+  void addCopy(size_t source, size_t destination)
+  {
+    m_Sources.push_back(source);
+    m_Destinations.push_back(destination);
+  }
+
+  /**
+   * @brief addInitialize Sets every component of the tuple at destination to zero
+   */
+  void addInitialize(size_t destination)
+  {
+    m_Sources.push_back(k_Initialize);
+    m_Destinations.push_back(destination);
+  }
+
+  /**
+   * @brief size Returns the number of entries in the plan
+   */
+  size_t size() const
+  {
+    return m_Destinations.size();
+  }
+
+  /**
+   * @brief clear Removes all entries from the plan while keeping the resolved arrays
+   */
+  void clear()
+  {
+    m_Sources.clear();
+    m_Destinations.clear();
+  }
+
+  /**
+   * @brief apply Applies the plan to every array
+   */
+  void apply() const
+  {
+    if(m_Destinations.empty() || m_Targets.empty())
+    {
+      return;
+    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, m_Targets.size());
+    dataAlg.setGrain(1);
+    dataAlg.execute(ApplyImpl(this));
+  }
+
+private:
+  static constexpr size_t k_Initialize = std::numeric_limits<size_t>::max();
+
+  struct Target
+  {
+    IDataArray::Pointer array;
+    uint8_t* data = nullptr;
+    size_t tupleBytes = 0;
+  };
+
+  template <typename T>
+  static bool resolve(Target& target)
+  {
+    typename DataArray<T>::Pointer typedArray = std::dynamic_pointer_cast<DataArray<T>>(target.array);
+    if(nullptr == typedArray.get() || typedArray->getNumberOfTuples() == 0)
+    {
+      return false;
+    }
+    target.data = reinterpret_cast<uint8_t*>(typedArray->getPointer(0));
+    target.tupleBytes = sizeof(T) * typedArray->getNumberOfComponents();
+    return true;
+  }
+
+  void applyTo(const Target& target) const
+  {
+    const size_t count = m_Destinations.size();
+    if(nullptr == target.data)
+    {
+      for(size_t i = 0; i < count; i++)
+      {
+        if(m_Sources[i] != k_Initialize)
+        {
+          target.array->copyTuple(m_Sources[i], m_Destinations[i]);
+        }
+      }
+      return;
+    }
+
+    const size_t tupleBytes = target.tupleBytes;
+    for(size_t i = 0; i < count; i++)
+    {
+      uint8_t* destination = target.data + m_Destinations[i] * tupleBytes;
+      if(m_Sources[i] == k_Initialize)
+      {
+        std::memset(destination, 0, tupleBytes);
+      }
+      else if(m_Sources[i] != m_Destinations[i])
+      {
+        std::memcpy(destination, target.data + m_Sources[i] * tupleBytes, tupleBytes);
+      }
+    }
+  }
+
+  /**
+   * @brief The ApplyImpl class applies the plan to a range of arrays
+   */
+  class ApplyImpl
+  {
+  public:
+    ApplyImpl(const TupleRemapPlan* plan)
+    : m_Plan(plan)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        m_Plan->applyTo(m_Plan->m_Targets[i]);
+      }
+    }
+
+  private:
+    const TupleRemapPlan* m_Plan = nullptr;
+  };
+
+  std::vector<Target> m_Targets;
+  std::vector<size_t> m_Sources;
+  std::vector<size_t> m_Destinations;
+
+public:
+  TupleRemapPlan(const TupleRemapPlan&) = delete;            // Copy Constructor Not Implemented
+  TupleRemapPlan(TupleRemapPlan&&) = delete;                 // Move Constructor Not Implemented
+  TupleRemapPlan& operator=(const TupleRemapPlan&) = delete; // Copy Assignment Not Implemented
+  TupleRemapPlan& operator=(TupleRemapPlan&&) = delete;      // Move Assignment Not Implemented
+};
@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "EMMPMFilter.h"
 
+#include <algorithm>
+#include <thread>
+
 #include <QtGui/QColor>
 #include <QtCore/QTextStream>
 
@@ -58,6 +61,7 @@
 #include "SIMPLib/FilterParameters/ConstrainedIntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Messages/AbstractMessageHandler.h"
 #include "SIMPLib/Messages/GenericProgressMessage.h"
@@ -66,6 +70,7 @@
 #include "SIMPLib/Messages/GenericWarningMessage.h"
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 /**
  * @brief This message handler is used by EMMPMFilter instances to re-emit incoming generic messages from the
@@ -118,9 +123,288 @@ private:
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
+  AttributeMatrixID21 = 21,
+
   DataArrayID30 = 30,
   DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+};
+
+namespace
+{
+/**
+ * @brief The EM/MPM settings shared by every image that one execution of the filter segments
+ */
+struct SegmentationSettings
+{
+  int32_t classes = 0;
+  float exchangeEnergy = 0.0f;
+  int32_t histogramLoops = 0;
+  int32_t segmentationLoops = 0;
+  std::vector<std::vector<double>> tableData;
+  bool useSimulatedAnnealing = false;
+  bool useGradientPenalty = false;
+  double gradientBetaE = 0.0;
+  bool useCurvaturePenalty = false;
+  double curvatureBetaC = 0.0;
+  double curvatureRMax = 0.0;
+  int32_t curvatureEMLoopDelay = 0;
+  size_t columns = 0;
+  size_t rows = 0;
+  uint8_t channels = 1;
+};
+
+/**
+ * @brief CreateSegmentationSettings Collects the filter parameters needed to set up an EMMPM_Data object
+ */
+SegmentationSettings CreateSegmentationSettings(const EMMPMFilter& filter, size_t columns, size_t rows, size_t channels)
+{
+  SegmentationSettings settings;
+  settings.classes = filter.getNumClasses();
+  settings.exchangeEnergy = filter.getExchangeEnergy();
+  settings.histogramLoops = filter.getHistogramLoops();
+  settings.segmentationLoops = filter.getSegmentationLoops();
+  settings.tableData = filter.getEMMPMTableData().getTableData();
+  settings.useSimulatedAnnealing = filter.getUseSimulatedAnnealing();
+  settings.useGradientPenalty = filter.getUseGradientPenalty();
+  settings.gradientBetaE = filter.getGradientBetaE();
+  settings.useCurvaturePenalty = filter.getUseCurvaturePenalty();
+  settings.curvatureBetaC = filter.getCurvatureBetaC();
+  settings.curvatureRMax = filter.getCurvatureRMax();
+  settings.curvatureEMLoopDelay = filter.getCurvatureEMLoopDelay();
+  settings.columns = columns;
+  settings.rows = rows;
+  settings.channels = static_cast<uint8_t>(channels);
+  return settings;
+}
+
+/**
+ * @brief CreateInitializationFunction Returns the initialization function matching the initialization type
+ */
+InitializationFunction::Pointer CreateInitializationFunction(EMMPM_InitializationType initType)
+{
+  switch(initType)
+  {
+  case EMMPM_ManualInit:
+    return InitializationFunction::New();
+  case EMMPM_UserInitArea:
+    return UserDefinedAreasInitialization::New();
+  default:
+    return BasicInitialization::New();
+  }
+}
+
+/**
+ * @brief ConfigureData Copies all the variables from the filter settings into the EMMPM_Data structure,
+ * points it at the given input/output images and allocates the working memory. If the initialization type
+ * is EMMPM_ManualInit the mean/variance are seeded from the supplied values.
+ */
+void ConfigureData(const SegmentationSettings& settings, EMMPM_Data* data, EMMPM_InitializationType initType, uint8_t* inputImage, uint8_t* outputImage, const std::vector<float>& mu,
+                   const std::vector<float>& sigma)
+{
+  data->initType = initType;
+  data->classes = settings.classes;
+  data->in_beta = settings.exchangeEnergy;
+  data->emIterations = settings.histogramLoops;
+  data->mpmIterations = settings.segmentationLoops;
+
+  for(int32_t i = 0; i < data->classes; i++)
+  {
+    int32_t gray = 255 / (data->classes - 1);
+    // Generate a Gray Scale Color Table
+    data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
+    // Hard code the minimum variance to 4.5; This could be a user option.
+    data->min_variance[i] = settings.tableData[i][1];
+    // Do we know what w_gamma is?
+    data->w_gamma[i] = settings.tableData[i][0];
+  }
+
+  data->columns = settings.columns;
+  data->rows = settings.rows;
+  data->inputImageChannels = settings.channels;
+
+  data->simulatedAnnealing = static_cast<char>(settings.useSimulatedAnnealing);
+  data->useGradientPenalty = static_cast<char>(settings.useGradientPenalty);
+  data->beta_e = settings.gradientBetaE;
+  data->useCurvaturePenalty = static_cast<char>(settings.useCurvaturePenalty);
+  data->beta_c = settings.curvatureBetaC;
+  data->r_max = settings.curvatureRMax;
+  data->ccostLoopDelay = settings.curvatureEMLoopDelay;
+
+  // Assign our Data array allocated input and output images into the EMMPData class
+  data->inputImage = inputImage;
+  data->xt = outputImage;
+
+  // Allocate all the memory here
+  data->allocateDataStructureMemory();
+
+  // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
+  // variables
+  if(data->initType == EMMPM_ManualInit)
+  {
+    for(int32_t i = 0; i < data->classes; i++)
+    {
+      for(uint32_t d = 0; d < data->dims; d++)
+      {
+        data->mean[i * data->dims + d] = mu[i * data->dims + d];
+        data->variance[i * data->dims + d] = sigma[i * data->dims + d];
+      }
+    }
+  }
+}
+
+/**
+ * @brief CopyStatistics Copies the final mean/variance of a segmented image out of the EMMPM_Data structure
+ */
+void CopyStatistics(const EMMPM_Data* data, std::vector<float>& mu, std::vector<float>& sigma)
+{
+  size_t count = static_cast<size_t>(data->classes) * data->dims;
+  mu.resize(count);
+  sigma.resize(count);
+  for(size_t i = 0; i < count; i++)
+  {
+    mu[i] = data->mean[i];
+    sigma[i] = data->variance[i];
+  }
+}
+
+/**
+ * @brief The SegmentSlicesImpl class segments contiguous chains of Z slices. The slices of a chain are
+ * segmented in order so that each one can be initialized from the Mu/Sigma of the slice before it,
+ * while the chains themselves run concurrently. Without warm starting every chain is a single slice.
+ * The chain that ends with the last slice hands its final Mu/Sigma back through lastMu/lastSigma.
+ */
+class SegmentSlicesImpl
+{
+public:
+  SegmentSlicesImpl(EMMPMFilter* filter, const SegmentationSettings& settings, EMMPM_InitializationType initType, const std::vector<float>& initialMu, const std::vector<float>& initialSigma,
+                    uint8_t* inputImage, uint8_t* outputImage, size_t numSlices, size_t numChains, bool warmStart, float* sliceMeans, float* sliceVariances, std::vector<int32_t>& sliceErrors,
+                    std::vector<float>& lastMu, std::vector<float>& lastSigma)
+  : m_Filter(filter)
+  , m_Settings(settings)
+  , m_InitType(initType)
+  , m_InitialMu(initialMu)
+  , m_InitialSigma(initialSigma)
+  , m_InputImage(inputImage)
+  , m_OutputImage(outputImage)
+  , m_NumSlices(numSlices)
+  , m_NumChains(numChains)
+  , m_WarmStart(warmStart)
+  , m_SliceMeans(sliceMeans)
+  , m_SliceVariances(sliceVariances)
+  , m_SliceErrors(sliceErrors)
+  , m_LastMu(lastMu)
+  , m_LastSigma(lastSigma)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chain = range.min(); chain < range.max(); chain++)
+    {
+      size_t start = chain * m_NumSlices / m_NumChains;
+      size_t end = (chain + 1) * m_NumSlices / m_NumChains;
+
+      std::vector<float> mu = m_InitialMu;
+      std::vector<float> sigma = m_InitialSigma;
+      EMMPM_InitializationType initType = m_InitType;
+      bool failed = false;
+      for(size_t slice = start; slice < end; slice++)
+      {
+        if(m_Filter->getCancel())
+        {
+          return;
+        }
+        m_SliceErrors[slice] = segmentSlice(slice, initType, mu, sigma);
+        if(m_SliceErrors[slice] < 0)
+        {
+          failed = true;
+          break;
+        }
+        if(m_WarmStart)
+        {
+          initType = EMMPM_ManualInit;
+        }
+      }
+      // Only one chain ends with the last slice, so only one task writes these
+      if(end == m_NumSlices && !failed)
+      {
+        m_LastMu = mu;
+        m_LastSigma = sigma;
+      }
+    }
+  }
+
+private:
+  EMMPMFilter* m_Filter = nullptr;
+  const SegmentationSettings& m_Settings;
+  EMMPM_InitializationType m_InitType;
+  const std::vector<float>& m_InitialMu;
+  const std::vector<float>& m_InitialSigma;
+  uint8_t* m_InputImage = nullptr;
+  uint8_t* m_OutputImage = nullptr;
+  size_t m_NumSlices = 0;
+  size_t m_NumChains = 0;
+  bool m_WarmStart = false;
+  float* m_SliceMeans = nullptr;
+  float* m_SliceVariances = nullptr;
+  std::vector<int32_t>& m_SliceErrors;
+  std::vector<float>& m_LastMu;
+  std::vector<float>& m_LastSigma;
+
+  /**
+   * @brief segmentSlice Runs the EM/MPM algorithm on a single slice with its own EMMPM_Data object. On return
+   * mu/sigma hold the statistics of the segmented slice.
+   * @return The error code generated by the EM/MPM algorithm, zero on success
+   */
+  int32_t segmentSlice(size_t slice, EMMPM_InitializationType initType, std::vector<float>& mu, std::vector<float>& sigma) const
+  {
+    size_t offset = slice * m_Settings.rows * m_Settings.columns;
+
+    EMMPM_Data::Pointer data = EMMPM_Data::New();
+    data->dims = 1; // We operate on a single channel | single component "image".
+    ConfigureData(m_Settings, data.get(), initType, m_InputImage + offset, m_OutputImage + offset, mu, sigma);
+
+    StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
+    EMMPM::Pointer emmpm = EMMPM::New();
+    emmpm->setData(data);
+    emmpm->setStatsDelegate(statsDelegate.get());
+    emmpm->setInitializationFunction(CreateInitializationFunction(initType));
+
+    // The slices run on worker threads, so only errors are collected here and reported by the filter afterwards
+    int32_t errorCode = 0;
+    QObject::connect(emmpm.get(), &EMMPM::messageGenerated, [&errorCode](const AbstractMessage::Pointer& msg) {
+      const GenericErrorMessage* errorMsg = dynamic_cast<const GenericErrorMessage*>(msg.get());
+      if(nullptr != errorMsg)
+      {
+        errorCode = errorMsg->getCode();
+      }
+    });
+
+    emmpm->execute();
+
+    // We manually set the pointers to nullptr so that the EMMPData class does not try to free the memory
+    data->inputImage = nullptr;
+    data->xt = nullptr;
+
+    CopyStatistics(data.get(), mu, sigma);
+    size_t classes = static_cast<size_t>(m_Settings.classes);
+    for(size_t c = 0; c < classes; c++)
+    {
+      if(nullptr != m_SliceMeans)
+      {
+        m_SliceMeans[slice * classes + c] = mu[c];
+      }
+      if(nullptr != m_SliceVariances)
+      {
+        m_SliceVariances[slice * classes + c] = sigma[c];
+      }
+    }
+    return errorCode;
+  }
 };
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -139,6 +423,12 @@ EMMPMFilter::EMMPMFilter()
 , m_CurvatureEMLoopDelay(1)
 , m_OutputDataArrayPath("", "", "")
 , m_EmmpmInitType(EMMPM_Basic)
+, m_SegmentAllSlices(false)
+, m_UseNeighborSliceInitialization(true)
+, m_WriteSliceStatistics(false)
+, m_SliceStatisticsAttributeMatrixName("SliceStatistics")
+, m_SliceMeansArrayName("Means")
+, m_SliceVariancesArrayName("Variances")
 , m_Data(EMMPM_Data::New())
 {
   std::vector<std::vector<double>> tableData(2, std::vector<double>(4));
@@ -204,6 +494,19 @@ void EMMPMFilter::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_CONSTRAINED_DOUBLE_FP("Beta C", CurvatureBetaC, FilterParameter::Parameter, EMMPMFilter));
   parameters.push_back(SIMPL_NEW_CONSTRAINED_DOUBLE_FP("R Max", CurvatureRMax, FilterParameter::Parameter, EMMPMFilter));
   parameters.push_back(SIMPL_NEW_CONSTRAINED_INT_FP("EM Loop Delay", CurvatureEMLoopDelay, FilterParameter::Parameter, EMMPMFilter));
+  {
+    QStringList linkedProps;
+    linkedProps << "UseNeighborSliceInitialization";
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Segment All Slices", SegmentAllSlices, FilterParameter::Parameter, EMMPMFilter, linkedProps));
+  }
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Initialize from Neighboring Slice", UseNeighborSliceInitialization, FilterParameter::Parameter, EMMPMFilter));
+  {
+    QStringList linkedProps;
+    linkedProps << "SliceStatisticsAttributeMatrixName"
+                << "SliceMeansArrayName"
+                << "SliceVariancesArrayName";
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Write Slice Statistics", WriteSliceStatistics, FilterParameter::Parameter, EMMPMFilter, linkedProps));
+  }
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -215,6 +518,10 @@ void EMMPMFilter::setupFilterParameters()
     DataArrayCreationFilterParameter::RequirementType req = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::Cell, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Output Attribute Array", OutputDataArrayPath, FilterParameter::CreatedArray, EMMPMFilter, req));
   }
+  parameters.push_back(SeparatorFilterParameter::New("Slice Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Slice Statistics Attribute Matrix", SliceStatisticsAttributeMatrixName, FilterParameter::CreatedArray, EMMPMFilter));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Means", SliceMeansArrayName, FilterParameter::CreatedArray, EMMPMFilter));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Variances", SliceVariancesArrayName, FilterParameter::CreatedArray, EMMPMFilter));
   setFilterParameters(parameters);
 }
 
@@ -237,6 +544,12 @@ void EMMPMFilter::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCurvatureRMax(reader->readValue("RMax", getCurvatureRMax()));
   setCurvatureEMLoopDelay(reader->readValue("EMLoopDelay", getCurvatureEMLoopDelay()));
   setOutputDataArrayPath(reader->readDataArrayPath("OutputDataArrayPath", getOutputDataArrayPath()));
+  setSegmentAllSlices(reader->readValue("SegmentAllSlices", getSegmentAllSlices()));
+  setUseNeighborSliceInitialization(reader->readValue("UseNeighborSliceInitialization", getUseNeighborSliceInitialization()));
+  setWriteSliceStatistics(reader->readValue("WriteSliceStatistics", getWriteSliceStatistics()));
+  setSliceStatisticsAttributeMatrixName(reader->readString("SliceStatisticsAttributeMatrixName", getSliceStatisticsAttributeMatrixName()));
+  setSliceMeansArrayName(reader->readString("SliceMeansArrayName", getSliceMeansArrayName()));
+  setSliceVariancesArrayName(reader->readString("SliceVariancesArrayName", getSliceVariancesArrayName()));
   reader->closeFilterGroup();
 }
 
@@ -247,7 +560,13 @@ void EMMPMFilter::initialize()
 {
   m_Data->initVariables();
   m_Data->dims = 1; // We operate on a single channel | single component "image".
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::initializePreviousStatistics()
+{
   m_PreviousMu.resize(getNumClasses() * m_Data->dims);
   m_PreviousSigma.resize(getNumClasses() * m_Data->dims);
 
@@ -272,7 +591,7 @@ void EMMPMFilter::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputDataArrayPath().getDataContainerName());
+  ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputDataArrayPath().getDataContainerName());
 
   std::vector<size_t> cDims(1, 1); // We need a single component, gray scale image
   m_InputImagePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>>(this, getInputDataArrayPath(), cDims);
@@ -297,6 +616,33 @@ void EMMPMFilter::dataCheck()
     QString ss = QObject::tr("The minimum number of classes is 2");
     setErrorCondition(-89101, ss);
   }
+
+  if(getWriteSliceStatistics() && getErrorCode() >= 0 && nullptr != image)
+  {
+    // One tuple per segmented slice holding the final Mu/Sigma of every class
+    std::vector<size_t> tDims(1, getSegmentAllSlices() ? image->getZPoints() : 1);
+    DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getInputDataArrayPath().getDataContainerName());
+    m->createNonPrereqAttributeMatrix(this, getSliceStatisticsAttributeMatrixName(), tDims, AttributeMatrix::Type::Generic, AttributeMatrixID21);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+
+    std::vector<size_t> classDims(1, static_cast<size_t>(getNumClasses()));
+    DataArrayPath path(getInputDataArrayPath().getDataContainerName(), getSliceStatisticsAttributeMatrixName(), getSliceMeansArrayName());
+    m_SliceMeansPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, path, 0, classDims, "", DataArrayID32);
+    if(nullptr != m_SliceMeansPtr.lock())
+    {
+      m_SliceMeans = m_SliceMeansPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to Data from the DataArray<T> object */
+
+    path.setDataArrayName(getSliceVariancesArrayName());
+    m_SliceVariancesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, path, 0, classDims, "", DataArrayID33);
+    if(nullptr != m_SliceVariancesPtr.lock())
+    {
+      m_SliceVariances = m_SliceVariancesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to Data from the DataArray<T> object */
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -311,10 +657,51 @@ void EMMPMFilter::execute()
   {
     return;
   }
+  initializePreviousStatistics();
+
+  segmentInputArray();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentInputArray()
+{
   initialize();
 
+  // Subclasses point the filter at different arrays between runs, so fetch the current ones by path
+  std::vector<size_t> cDims(1, 1);
+  m_InputImagePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>>(this, getInputDataArrayPath(), cDims);
+  m_OutputImagePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint8_t>>(this, getOutputDataArrayPath(), cDims);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  m_InputImage = m_InputImagePtr.lock()->getPointer(0);
+  m_OutputImage = m_OutputImagePtr.lock()->getPointer(0);
+
   // This is the routine that sets up the EM/MPM to segment the image
-  segment(getEmmpmInitType());
+  if(getSegmentAllSlices())
+  {
+    segmentVolume(getEmmpmInitType());
+  }
+  else
+  {
+    segment(getEmmpmInitType());
+
+    if(getWriteSliceStatistics() && nullptr != m_SliceMeansPtr.lock() && nullptr != m_SliceVariancesPtr.lock())
+    {
+      for(int32_t c = 0; c < getNumClasses(); c++)
+      {
+        m_SliceMeans[c] = m_PreviousMu[c];
+        m_SliceVariances[c] = m_PreviousSigma[c];
+      }
+    }
+  }
+  if(getErrorCode() < 0 || getCancel())
+  {
+    return;
+  }
 
   if(m_UseOneBasedValues && m_OutputImagePtr.lock() != nullptr)
   {
@@ -333,81 +720,15 @@ void EMMPMFilter::execute()
 // -----------------------------------------------------------------------------
 void EMMPMFilter::segment(EMMPM_InitializationType initType)
 {
-  // Copy all the variables from the filter into the EMmpm Data structure.
-  m_Data->initType = initType;
-
-  InitializationFunction::Pointer initFunction = BasicInitialization::New();
-
-  // Set the initialization function based on the parameters
-  switch(m_Data->initType)
-  {
-  case EMMPM_ManualInit:
-    initFunction = InitializationFunction::New();
-    break;
-  case EMMPM_UserInitArea:
-    initFunction = UserDefinedAreasInitialization::New();
-    break;
-  default:
-    initFunction = BasicInitialization::New();
-    break;
-  }
-
-  m_Data->classes = getNumClasses();
-  m_Data->in_beta = getExchangeEnergy();
-  m_Data->emIterations = getHistogramLoops();
-  m_Data->mpmIterations = getSegmentationLoops();
-
-  DynamicTableData tableDataObj = getEMMPMTableData();
-  std::vector<std::vector<double>> tableData = tableDataObj.getTableData();
-  for(int32_t i = 0; i < m_Data->classes; i++)
-  {
-    int32_t gray = 255 / (m_Data->classes - 1);
-    // Generate a Gray Scale Color Table
-    m_Data->colorTable[i] = qRgb(i * gray, i * gray, i * gray);
-    // Hard code the minimum variance to 4.5; This could be a user option.
-    m_Data->min_variance[i] = tableData[i][1];
-    // Do we know what w_gamma is?
-    m_Data->w_gamma[i] = tableData[i][0];
-  }
-
   DataArrayPath dap = getInputDataArrayPath();
   AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
   std::vector<size_t> tDims = am->getTupleDimensions();
   IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
   std::vector<size_t> cDims = iDataArray->getComponentDimensions();
 
-  m_Data->columns = tDims[0];
-  m_Data->rows = tDims[1];
-  m_Data->inputImageChannels = cDims[0];
-
-  m_Data->simulatedAnnealing = (char)(getUseSimulatedAnnealing());
-  m_Data->useGradientPenalty = static_cast<char>(getUseGradientPenalty());
-  m_Data->beta_e = getGradientBetaE();
-  m_Data->useCurvaturePenalty = static_cast<char>(getUseCurvaturePenalty());
-  m_Data->beta_c = getCurvatureBetaC();
-  m_Data->r_max = getCurvatureRMax();
-  m_Data->ccostLoopDelay = getCurvatureEMLoopDelay();
-
-  // Assign our Data array allocated input and output images into the EMMPData class
-  m_Data->inputImage = m_InputImage;
-  m_Data->xt = m_OutputImage;
-
-  // Allocate all the memory here
-  m_Data->allocateDataStructureMemory();
-
-  // If we are using the "Feedback" loop then we copy the previous Mu/Sigma values into the Mean/Variance
-  // variables
-  if(m_Data->initType == EMMPM_ManualInit)
-  {
-    for(int32_t i = 0; i < m_Data->classes; i++)
-    {
-      for(uint32_t d = 0; d < m_Data->dims; d++)
-      {
-        m_Data->mean[i * m_Data->dims + d] = m_PreviousMu[i * m_Data->dims + d];
-        m_Data->variance[i * m_Data->dims + d] = m_PreviousSigma[i * m_Data->dims + d];
-      }
-    }
-  }
+  // Copy all the variables from the filter into the EMmpm Data structure.
+  SegmentationSettings settings = CreateSegmentationSettings(*this, tDims[0], tDims[1], cDims[0]);
+  ConfigureData(settings, m_Data.get(), initType, m_InputImage, m_OutputImage, m_PreviousMu, m_PreviousSigma);
 
   // Create a new StatsDelegate so the EMMPM algorith has somewhere to write its statistics
   StatsDelegate::Pointer statsDelegate = StatsDelegate::New();
@@ -417,7 +738,7 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
 
   emmpm->setData(m_Data);
   emmpm->setStatsDelegate(statsDelegate.get());
-  emmpm->setInitializationFunction(initFunction);
+  emmpm->setInitializationFunction(CreateInitializationFunction(initType));
 
   // Connect up the Error/Warning/Progress object so the filter can report those things
   connect(emmpm.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SLOT(handleEmmpmMessage(const AbstractMessage::Pointer&)));
@@ -430,8 +751,75 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
 
   // Grab the Mu/Sigma values from the current finished segmented image and use those as inputs
   // into the initialization of the next Image to be Segmented
-  m_PreviousMu.resize(getNumClasses() * m_Data->dims);
-  m_PreviousSigma.resize(getNumClasses() * m_Data->dims);
+  CopyStatistics(m_Data.get(), m_PreviousMu, m_PreviousSigma);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EMMPMFilter::segmentVolume(EMMPM_InitializationType initType)
+{
+  DataArrayPath dap = getInputDataArrayPath();
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(dap);
+  std::vector<size_t> tDims = am->getTupleDimensions();
+  IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
+  std::vector<size_t> cDims = iDataArray->getComponentDimensions();
+
+  size_t numSlices = tDims.size() > 2 ? tDims[2] : 1;
+
+  float* sliceMeans = nullptr;
+  float* sliceVariances = nullptr;
+  if(getWriteSliceStatistics() && nullptr != m_SliceMeansPtr.lock() && nullptr != m_SliceVariancesPtr.lock())
+  {
+    sliceMeans = m_SliceMeans;
+    sliceVariances = m_SliceVariances;
+  }
+
+  QString ss = QObject::tr("Segmenting %1 slices").arg(numSlices);
+  notifyStatusMessage(ss);
+
+  // The final Mu/Sigma of the last slice become the previous values for the next image to be segmented
+  std::vector<int32_t> sliceErrors = segmentSlices(m_InputImage, m_OutputImage, tDims[0], tDims[1], cDims[0], numSlices, initType, m_PreviousMu, m_PreviousSigma, sliceMeans, sliceVariances);
+  for(size_t slice = 0; slice < numSlices; slice++)
+  {
+    if(sliceErrors[slice] < 0)
+    {
+      ss = QObject::tr("The EM/MPM algorithm failed on slice %1").arg(slice);
+      setErrorCondition(sliceErrors[slice], ss);
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<int32_t> EMMPMFilter::segmentSlices(uint8_t* inputImage, uint8_t* outputImage, size_t columns, size_t rows, size_t channels, size_t numSlices, EMMPM_InitializationType initType,
+                                                std::vector<float>& mu, std::vector<float>& sigma, float* sliceMeans, float* sliceVariances)
+{
+  SegmentationSettings settings = CreateSegmentationSettings(*this, columns, rows, channels);
+
+  // Warm starting chains the slices together, so split the stack into one contiguous chain per thread;
+  // otherwise every slice is independent and is its own chain
+  bool warmStart = getUseNeighborSliceInitialization();
+  size_t numChains = numSlices;
+  if(warmStart)
+  {
+    size_t numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    numChains = std::min(numSlices, numThreads);
+  }
+
+  std::vector<int32_t> sliceErrors(numSlices, 0);
+  std::vector<float> lastMu = mu;
+  std::vector<float> lastSigma = sigma;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChains);
+  dataAlg.setGrain(1);
+  dataAlg.execute(SegmentSlicesImpl(this, settings, initType, mu, sigma, inputImage, outputImage, numSlices, numChains, warmStart, sliceMeans, sliceVariances, sliceErrors, lastMu, lastSigma));
+
+  mu = lastMu;
+  sigma = lastSigma;
+  return sliceErrors;
 }
 
 // -----------------------------------------------------------------------------
@@ -766,3 +1154,75 @@ EMMPM_InitializationType EMMPMFilter::getEmmpmInitType() const
 {
   return m_EmmpmInitType;
 }
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setSegmentAllSlices(bool value)
+{
+  m_SegmentAllSlices = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EMMPMFilter::getSegmentAllSlices() const
+{
+  return m_SegmentAllSlices;
+}
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setUseNeighborSliceInitialization(bool value)
+{
+  m_UseNeighborSliceInitialization = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EMMPMFilter::getUseNeighborSliceInitialization() const
+{
+  return m_UseNeighborSliceInitialization;
+}
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setWriteSliceStatistics(bool value)
+{
+  m_WriteSliceStatistics = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EMMPMFilter::getWriteSliceStatistics() const
+{
+  return m_WriteSliceStatistics;
+}
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setSliceStatisticsAttributeMatrixName(const QString& value)
+{
+  m_SliceStatisticsAttributeMatrixName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString EMMPMFilter::getSliceStatisticsAttributeMatrixName() const
+{
+  return m_SliceStatisticsAttributeMatrixName;
+}
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setSliceMeansArrayName(const QString& value)
+{
+  m_SliceMeansArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString EMMPMFilter::getSliceMeansArrayName() const
+{
+  return m_SliceMeansArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void EMMPMFilter::setSliceVariancesArrayName(const QString& value)
+{
+  m_SliceVariancesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString EMMPMFilter::getSliceVariancesArrayName() const
+{
+  return m_SliceVariancesArrayName;
+}
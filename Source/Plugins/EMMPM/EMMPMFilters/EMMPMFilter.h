@@ -76,6 +76,12 @@ class EMMPM_EXPORT EMMPMFilter : public AbstractFilter
   PYB11_PROPERTY(double CurvatureRMax READ getCurvatureRMax WRITE setCurvatureRMax)
   PYB11_PROPERTY(int CurvatureEMLoopDelay READ getCurvatureEMLoopDelay WRITE setCurvatureEMLoopDelay)
   PYB11_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
+  PYB11_PROPERTY(bool SegmentAllSlices READ getSegmentAllSlices WRITE setSegmentAllSlices)
+  PYB11_PROPERTY(bool UseNeighborSliceInitialization READ getUseNeighborSliceInitialization WRITE setUseNeighborSliceInitialization)
+  PYB11_PROPERTY(bool WriteSliceStatistics READ getWriteSliceStatistics WRITE setWriteSliceStatistics)
+  PYB11_PROPERTY(QString SliceStatisticsAttributeMatrixName READ getSliceStatisticsAttributeMatrixName WRITE setSliceStatisticsAttributeMatrixName)
+  PYB11_PROPERTY(QString SliceMeansArrayName READ getSliceMeansArrayName WRITE setSliceMeansArrayName)
+  PYB11_PROPERTY(QString SliceVariancesArrayName READ getSliceVariancesArrayName WRITE setSliceVariancesArrayName)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -276,6 +282,72 @@ public:
   DataArrayPath getOutputDataArrayPath() const;
   Q_PROPERTY(DataArrayPath OutputDataArrayPath READ getOutputDataArrayPath WRITE setOutputDataArrayPath)
 
+  /**
+   * @brief Setter property for SegmentAllSlices
+   */
+  void setSegmentAllSlices(bool value);
+  /**
+   * @brief Getter property for SegmentAllSlices
+   * @return Value of SegmentAllSlices
+   */
+  bool getSegmentAllSlices() const;
+  Q_PROPERTY(bool SegmentAllSlices READ getSegmentAllSlices WRITE setSegmentAllSlices)
+
+  /**
+   * @brief Setter property for UseNeighborSliceInitialization
+   */
+  void setUseNeighborSliceInitialization(bool value);
+  /**
+   * @brief Getter property for UseNeighborSliceInitialization
+   * @return Value of UseNeighborSliceInitialization
+   */
+  bool getUseNeighborSliceInitialization() const;
+  Q_PROPERTY(bool UseNeighborSliceInitialization READ getUseNeighborSliceInitialization WRITE setUseNeighborSliceInitialization)
+
+  /**
+   * @brief Setter property for WriteSliceStatistics
+   */
+  void setWriteSliceStatistics(bool value);
+  /**
+   * @brief Getter property for WriteSliceStatistics
+   * @return Value of WriteSliceStatistics
+   */
+  bool getWriteSliceStatistics() const;
+  Q_PROPERTY(bool WriteSliceStatistics READ getWriteSliceStatistics WRITE setWriteSliceStatistics)
+
+  /**
+   * @brief Setter property for SliceStatisticsAttributeMatrixName
+   */
+  void setSliceStatisticsAttributeMatrixName(const QString& value);
+  /**
+   * @brief Getter property for SliceStatisticsAttributeMatrixName
+   * @return Value of SliceStatisticsAttributeMatrixName
+   */
+  QString getSliceStatisticsAttributeMatrixName() const;
+  Q_PROPERTY(QString SliceStatisticsAttributeMatrixName READ getSliceStatisticsAttributeMatrixName WRITE setSliceStatisticsAttributeMatrixName)
+
+  /**
+   * @brief Setter property for SliceMeansArrayName
+   */
+  void setSliceMeansArrayName(const QString& value);
+  /**
+   * @brief Getter property for SliceMeansArrayName
+   * @return Value of SliceMeansArrayName
+   */
+  QString getSliceMeansArrayName() const;
+  Q_PROPERTY(QString SliceMeansArrayName READ getSliceMeansArrayName WRITE setSliceMeansArrayName)
+
+  /**
+   * @brief Setter property for SliceVariancesArrayName
+   */
+  void setSliceVariancesArrayName(const QString& value);
+  /**
+   * @brief Getter property for SliceVariancesArrayName
+   * @return Value of SliceVariancesArrayName
+   */
+  QString getSliceVariancesArrayName() const;
+  Q_PROPERTY(QString SliceVariancesArrayName READ getSliceVariancesArrayName WRITE setSliceVariancesArrayName)
+
   /**
    * @brief Setter property for EmmpmInitType
    */
@@ -358,12 +430,42 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief initializePreviousStatistics Seeds the previous Mu/Sigma from the EM/MPM table. This is done
+   * once per execution so the statistics of one segmented image can initialize the next one.
+   */
+  void initializePreviousStatistics();
+
+  /**
+   * @brief segmentInputArray Segments the current input array into the current output array
+   */
+  void segmentInputArray();
+
   /**
    * @brief segment Performs the EMMPM segmentation routine
    * @param initType Enumeration of EMMPM initialization types
    */
   virtual void segment(EMMPM_InitializationType initType);
 
+  /**
+   * @brief segmentVolume Segments every Z slice of the input image stack concurrently. Each slice
+   * gets its own EM/MPM data structure so the slices only share the thread pool.
+   * @param initType Enumeration of EMMPM initialization types used for the first slice of each chain
+   */
+  virtual void segmentVolume(EMMPM_InitializationType initType);
+
+  /**
+   * @brief segmentSlices Segments the first numSlices Z slices of an image stack. Every slice gets its own
+   * EM/MPM data structure and only the filter parameters are read, so several stacks can be segmented at once.
+   * @param mu The means used by EMMPM_ManualInit; on return the final means of the last slice
+   * @param sigma The variances used by EMMPM_ManualInit; on return the final variances of the last slice
+   * @param sliceMeans Optional per-slice output of the final means
+   * @param sliceVariances Optional per-slice output of the final variances
+   * @return The error code of every slice, zero on success
+   */
+  std::vector<int32_t> segmentSlices(uint8_t* inputImage, uint8_t* outputImage, size_t columns, size_t rows, size_t channels, size_t numSlices, EMMPM_InitializationType initType,
+                                     std::vector<float>& mu, std::vector<float>& sigma, float* sliceMeans, float* sliceVariances);
+
   /**
    * @brief getPreviousMu
    * @return
@@ -399,6 +501,10 @@ private:
   uint8_t* m_InputImage = nullptr;
   std::weak_ptr<DataArray<uint8_t>> m_OutputImagePtr;
   uint8_t* m_OutputImage = nullptr;
+  std::weak_ptr<DataArray<float>> m_SliceMeansPtr;
+  float* m_SliceMeans = nullptr;
+  std::weak_ptr<DataArray<float>> m_SliceVariancesPtr;
+  float* m_SliceVariances = nullptr;
 
   DataArrayPath m_InputDataArrayPath = {};
   bool m_UseOneBasedValues = {};
@@ -416,6 +522,12 @@ private:
   int m_CurvatureEMLoopDelay = {};
   DataArrayPath m_OutputDataArrayPath = {};
   EMMPM_InitializationType m_EmmpmInitType = {};
+  bool m_SegmentAllSlices = {};
+  bool m_UseNeighborSliceInitialization = {};
+  bool m_WriteSliceStatistics = {};
+  QString m_SliceStatisticsAttributeMatrixName = {};
+  QString m_SliceMeansArrayName = {};
+  QString m_SliceVariancesArrayName = {};
 
   std::vector<float> m_PreviousMu;
   std::vector<float> m_PreviousSigma;
@@ -33,6 +33,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "MultiEmmpmFilter.h"
@@ -58,6 +60,7 @@
 #include "SIMPLib/Messages/GenericErrorMessage.h"
 #include "SIMPLib/Messages/GenericWarningMessage.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EMMPM/EMMPMVersion.h"
 
@@ -112,6 +115,71 @@ private:
   MultiEmmpmFilter* m_Filter = nullptr;
 };
 
+/**
+ * @brief The MultiEmmpmFilterSegmentArraysImpl class segments several input arrays at the same time. It is
+ * only used when the arrays do not initialize each other, so every array starts from the same Mu/Sigma.
+ */
+class MultiEmmpmFilterSegmentArraysImpl
+{
+public:
+  MultiEmmpmFilterSegmentArraysImpl(MultiEmmpmFilter* filter, const std::vector<UInt8ArrayType::Pointer>& inputArrays, const std::vector<UInt8ArrayType::Pointer>& outputArrays, size_t columns,
+                                    size_t rows, size_t numSlices, const std::vector<float>& initialMu, const std::vector<float>& initialSigma, std::vector<int32_t>& arrayErrors)
+  : m_Filter(filter)
+  , m_InputArrays(inputArrays)
+  , m_OutputArrays(outputArrays)
+  , m_Columns(columns)
+  , m_Rows(rows)
+  , m_NumSlices(numSlices)
+  , m_InitialMu(initialMu)
+  , m_InitialSigma(initialSigma)
+  , m_ArrayErrors(arrayErrors)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
+      std::vector<float> mu = m_InitialMu;
+      std::vector<float> sigma = m_InitialSigma;
+      std::vector<int32_t> sliceErrors =
+          m_Filter->segmentSlices(m_InputArrays[i]->getPointer(0), m_OutputArrays[i]->getPointer(0), m_Columns, m_Rows, 1, m_NumSlices, EMMPM_Basic, mu, sigma, nullptr, nullptr);
+      auto failedSlice = std::find_if(sliceErrors.begin(), sliceErrors.end(), [](int32_t err) { return err < 0; });
+      if(failedSlice != sliceErrors.end())
+      {
+        m_ArrayErrors[i] = *failedSlice;
+        continue;
+      }
+
+      if(m_Filter->getUseOneBasedValues())
+      {
+        uint8_t* output = m_OutputArrays[i]->getPointer(0);
+        size_t numTuples = m_OutputArrays[i]->getNumberOfTuples();
+        for(size_t t = 0; t < numTuples; t++)
+        {
+          output[t] = output[t] + 1;
+        }
+      }
+    }
+  }
+
+private:
+  MultiEmmpmFilter* m_Filter = nullptr;
+  const std::vector<UInt8ArrayType::Pointer>& m_InputArrays;
+  const std::vector<UInt8ArrayType::Pointer>& m_OutputArrays;
+  size_t m_Columns = 0;
+  size_t m_Rows = 0;
+  size_t m_NumSlices = 0;
+  const std::vector<float>& m_InitialMu;
+  const std::vector<float>& m_InitialSigma;
+  std::vector<int32_t>& m_ArrayErrors;
+};
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -171,6 +239,17 @@ void MultiEmmpmFilter::setupFilterParameters()
     }
   }
 
+  // The per-slice statistics are only written for a single input array, so drop those parameters
+  QStringList sliceStatisticsProps;
+  sliceStatisticsProps << "WriteSliceStatistics"
+                       << "SliceStatisticsAttributeMatrixName"
+                       << "SliceMeansArrayName"
+                       << "SliceVariancesArrayName";
+  auto isSliceStatisticsParameter = [&sliceStatisticsProps](const FilterParameter::Pointer& p) {
+    return sliceStatisticsProps.contains(p->getPropertyName()) || p->getHumanLabel() == "Slice Data";
+  };
+  parameters.erase(std::remove_if(parameters.begin(), parameters.end(), isSliceStatisticsParameter), parameters.end());
+
   // Set the new parameters back into the class
   setFilterParameters(parameters);
 }
@@ -196,6 +275,8 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
   setOutputAttributeMatrixName(reader->readString("OutputAttributeMatrixName", getOutputAttributeMatrixName()));
   setUsePreviousMuSigma(reader->readValue("UsePreviousMuSigma", getUsePreviousMuSigma()));
   setOutputArrayPrefix(reader->readString("OutputArrayPrefix", getOutputArrayPrefix()));
+  setSegmentAllSlices(reader->readValue("SegmentAllSlices", getSegmentAllSlices()));
+  setUseNeighborSliceInitialization(reader->readValue("UseNeighborSliceInitialization", getUseNeighborSliceInitialization()));
   reader->closeFilterGroup();
 }
 
@@ -205,6 +286,7 @@ void MultiEmmpmFilter::readFilterParameters(AbstractFilterParametersReader* read
 void MultiEmmpmFilter::initialize()
 {
   EMMPMFilter::initialize();
+  initializePreviousStatistics();
 
   m_ArrayCount = 0;
   m_CurrentArrayIndex = 0;
@@ -329,42 +411,82 @@ void MultiEmmpmFilter::execute()
 
   m_ArrayCount = arrayNames.size();
 
-  // This is the routine that sets up the EM/MPM to segment the image
-  while(iter.hasNext())
+  // Without the Mu/Sigma feedback the arrays do not depend on each other, so segment them all at the same time
+  if(!getUsePreviousMuSigma())
   {
-    DataArrayPath arrayPath = inputAMPath;
-    QString name = iter.next();
+    DataArrayPath outputAMPath(inputAMPath.getDataContainerName(), getOutputAttributeMatrixName(), "");
+    AttributeMatrix::Pointer inAM = getDataContainerArray()->getAttributeMatrix(inputAMPath);
+    AttributeMatrix::Pointer outAM = getDataContainerArray()->getAttributeMatrix(outputAMPath);
 
-    arrayPath.setDataArrayName(name);
-    setInputDataArrayPath(arrayPath);
+    std::vector<UInt8ArrayType::Pointer> inputArrays;
+    std::vector<UInt8ArrayType::Pointer> outputArrays;
+    for(const QString& name : arrayNames)
+    {
+      inputArrays.push_back(inAM->getAttributeArrayAs<UInt8ArrayType>(name));
+      outputArrays.push_back(outAM->getAttributeArrayAs<UInt8ArrayType>(getOutputArrayPrefix() + name));
+    }
 
-    // Change the output AttributeMatrix
-    arrayPath.setAttributeMatrixName(getOutputAttributeMatrixName());
-    QString outName = getOutputArrayPrefix() + arrayPath.getDataArrayName();
-    arrayPath.setDataArrayName(outName);
-    // Remove the array if it already exists ; this would be very strange but check for it anyway
-    getDataContainerArray()->getAttributeMatrix(arrayPath)->removeAttributeArray(outName);
-    setOutputDataArrayPath(arrayPath);
+    std::vector<size_t> tDims = inAM->getTupleDimensions();
+    size_t numSlices = getSegmentAllSlices() && tDims.size() > 2 ? tDims[2] : 1;
 
-    if(m_CurrentArrayIndex == 2 && getUsePreviousMuSigma())
+    QString ss = QObject::tr("Segmenting %1 arrays").arg(m_ArrayCount);
+    notifyStatusMessage(ss);
+
+    std::vector<float> initialMu = getPreviousMu();
+    std::vector<float> initialSigma = getPreviousSigma();
+    std::vector<int32_t> arrayErrors(inputArrays.size(), 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, inputArrays.size());
+    dataAlg.setGrain(1);
+    dataAlg.execute(MultiEmmpmFilterSegmentArraysImpl(this, inputArrays, outputArrays, tDims[0], tDims[1], numSlices, initialMu, initialSigma, arrayErrors));
+
+    for(size_t i = 0; i < arrayErrors.size(); i++)
     {
-      setEmmpmInitType(EMMPM_ManualInit);
+      if(arrayErrors[i] < 0)
+      {
+        ss = QObject::tr("The EM/MPM algorithm failed on array %1").arg(arrayNames.at(static_cast<int>(i)));
+        setErrorCondition(arrayErrors[i], ss);
+        break;
+      }
     }
-    else
+  }
+  else
+  {
+    // This is the routine that sets up the EM/MPM to segment the image
+    while(iter.hasNext())
     {
-      setEmmpmInitType(EMMPM_Basic);
-    }
+      DataArrayPath arrayPath = inputAMPath;
+      QString name = iter.next();
 
-    EMMPMFilter::execute();
-    if(getErrorCode() < 0)
-    {
-      break;
-    }
-    m_CurrentArrayIndex++;
+      arrayPath.setDataArrayName(name);
+      setInputDataArrayPath(arrayPath);
 
-    if(getCancel())
-    {
-      break;
+      // Change the output AttributeMatrix
+      arrayPath.setAttributeMatrixName(getOutputAttributeMatrixName());
+      QString outName = getOutputArrayPrefix() + arrayPath.getDataArrayName();
+      arrayPath.setDataArrayName(outName);
+      setOutputDataArrayPath(arrayPath);
+
+      if(m_CurrentArrayIndex == 2 && getUsePreviousMuSigma())
+      {
+        setEmmpmInitType(EMMPM_ManualInit);
+      }
+      else
+      {
+        setEmmpmInitType(EMMPM_Basic);
+      }
+
+      segmentInputArray();
+      if(getErrorCode() < 0)
+      {
+        break;
+      }
+      m_CurrentArrayIndex++;
+
+      if(getCancel())
+      {
+        break;
+      }
     }
   }
 
@@ -406,6 +528,8 @@ AbstractFilter::Pointer MultiEmmpmFilter::newFilterInstance(bool copyFilterParam
     filter->setCurvatureRMax(getCurvatureRMax());
     filter->setCurvatureEMLoopDelay(getCurvatureEMLoopDelay());
     filter->setOutputAttributeMatrixName(getOutputAttributeMatrixName());
+    filter->setSegmentAllSlices(getSegmentAllSlices());
+    filter->setUseNeighborSliceInitialization(getUseNeighborSliceInitialization());
   }
   return filter;
 }
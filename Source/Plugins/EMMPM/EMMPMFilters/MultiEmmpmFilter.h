@@ -46,6 +46,7 @@
 #include "EMMPM/EMMPMDLLExport.h"
 
 class MultiEmmpmFilterMessageHandler;
+class MultiEmmpmFilterSegmentArraysImpl;
 
 /**
  * @brief The MultiEmmpmFilter class. See [Filter documentation](@ref multiemmpmfilter) for details.
@@ -97,6 +98,7 @@ public:
   virtual ~MultiEmmpmFilter();
 
   friend MultiEmmpmFilterMessageHandler;
+  friend MultiEmmpmFilterSegmentArraysImpl;
 
   /**
    * @brief Setter property for InputDataArrayVector
@@ -239,6 +239,7 @@ void EMMPM_Data::initVariables()
   this->y = nullptr;
   this->xt = nullptr;
   this->workingKappa = 0.0;
+  this->useScalarMPMKernel = 0;
 
   this->currentEMLoop = 0;
   this->currentMPMLoop = 0;
@@ -119,6 +119,7 @@ public:
   unsigned int colorTable[EMMPM_MAX_CLASSES];
   real_t min_variance[EMMPM_MAX_CLASSES]; /**< The minimum value that the variance can be for each class */
   char simulatedAnnealing;                /**<  */
+  char useScalarMPMKernel;                /**< Use the reference (unoptimized) MPM kernel, e.g. to validate the optimized one */
   char verbose;                           /**<  */
 
   // -----------------------------------------------------------------------------
@@ -47,19 +47,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //-- C Includes
 #include <cstddef>
 #include <cstdio>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 
 //-- C++ includes
+#include <algorithm>
+#include <cstdint>
 #include <random>
 #include <chrono>
 #include <sstream>
+#include <limits>
 #include <thread>
+#include <vector>
 
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Core/EMMPM.h"
 #include "EMMPMLib/Core/EMMPMUtilities.h"
+#include "EMMPMLib/Core/MPMKernel.h"
 
 #define USE_TBB_TASK_GROUP 0
 #ifdef EMMPM_USE_PARALLEL_ALGORITHMS
@@ -70,255 +76,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #endif
 
-#define COMPUTE_C_CLIQUE(C, x, y, ci, cj)                                                                                                                                                              \
-  if((x) < 0 || (x) >= colEnd || (y) < 0 || (y) >= rowEnd)                                                                                                                                             \
-  {                                                                                                                                                                                                    \
-    C[ci][cj] = classes;                                                                                                                                                                               \
-  }                                                                                                                                                                                                    \
-  else                                                                                                                                                                                                 \
-  {                                                                                                                                                                                                    \
-    ij = (cols * (y)) + (x);                                                                                                                                                                           \
-    C[ci][cj] = xt[ij];                                                                                                                                                                                \
-  }
-
-/**
- * @class ParallelCalcLoop ParallelCalcLoop.h EMMPM/Curvature/ParallelCalcLoop.h
- * @brief This class can calculate the parts of the MPM loop in parallel
- *
- * @date March 11, 2012
- * @version 1.0
- */
-class ParallelMPMLoop
-{
-public:
-#if USE_TBB_TASK_GROUP
-  ParallelCalcLoop(EMMPM_Data* dPtr, real_t* ykPtr, real_t* rnd, int rowStart, int rowEnd, int colStart, int colEnd)
-  : m_RowStart(rowStart)
-  , m_RowEnd(rowEnd)
-  , m_ColStart(colStart)
-  , m_ColEnd(colEnd)
-  ,
-#else
-  ParallelMPMLoop(EMMPM_Data* dPtr, real_t* ykPtr, real_t* rnd)
-  :
-#endif
-
-  data(dPtr)
-  , yk(ykPtr)
-  , rnd(rnd)
-  {
-  }
-  virtual ~ParallelMPMLoop() = default;
-
-  void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
-  {
-    // uint64_t millis = EMMPM_getMilliSeconds();
-    //  int l;
-    real_t prior;
-    int32_t ij, lij;
-    int rows = data->rows;
-    int cols = data->columns;
-    int classes = data->classes;
-
-    real_t xrnd, current;
-    real_t post[EMMPM_MAX_CLASSES], sum, edge;
-
-    size_t nsCols = data->columns - 1;
-    size_t ewCols = data->columns;
-    size_t swCols = data->columns - 1;
-    size_t nwCols = data->columns - 1;
-
-    unsigned char* xt = data->xt;
-    real_t* probs = data->probs;
-    real_t* ccost = data->ccost;
-    real_t* ns = data->ns;
-    real_t* ew = data->ew;
-    real_t* sw = data->sw;
-    real_t* nw = data->nw;
-    real_t curvature_value = (real_t)0.0;
-
-    int C[3][3]; // This is the Clique for the current Pixel
-                 //      --------- X -----
-                 //      |   | 0 | 1 | 2 |
-                 //      -----------------
-                 //   Y  | 0 |   |   |   |
-                 //      -----------------
-                 //      | 1 |   | P |   |
-                 //      -----------------
-                 //      | 2 |   |   |   |
-                 //
-                 // When we calculate the "C" matrix if the pixel value for the specific index of
-                 // the clique would be off the image then a value = number of classes is
-                 // used for the C[i][j]. That way we can figure out if we are off the image
-
-    std::stringstream ss;
-    unsigned int cSize = classes + 1;
-    real_t* coupling = data->couplingBeta;
-
-    for(int32_t y = rowStart; y < rowEnd; y++)
-    {
-      for(int32_t x = colStart; x < colEnd; x++)
-      {
-
-        /* -------------  */
-        COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
-        COMPUTE_C_CLIQUE(C, x, y - 1, 1, 0);
-        COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2, 0);
-        COMPUTE_C_CLIQUE(C, x - 1, y, 0, 1);
-        COMPUTE_C_CLIQUE(C, x + 1, y, 2, 1);
-        COMPUTE_C_CLIQUE(C, x - 1, y + 1, 0, 2);
-        COMPUTE_C_CLIQUE(C, x, y + 1, 1, 2);
-        COMPUTE_C_CLIQUE(C, x + 1, y + 1, 2, 2);
-
-#if 0
-          if (y == rowStart + 1 && x == colStart + 1)
-          {
-            ss << "------------------------------" << std::endl;
-            ss << "|" << C[0][0] << "\t" << C[1][0] << "\t" << C[2][0] << std::endl;
-            ss << "|" << C[0][1] << "\t" << C[1][1] << "\t" << C[2][1] << std::endl;
-            ss << "|" << C[0][2] << "\t" << C[1][2] << "\t" << C[2][2] << std::endl;
-            ss << "------------------------------" << std::endl;
-            std::cout << ss.str() << std::endl;
-          }
-#endif
-
-        ij = (cols * y) + x;
-        sum = 0;
-        for(int l = 0; l < classes; ++l)
-        {
-          prior = 0;
-          edge = 0;
-
-          prior += coupling[(cSize * l) + C[0][0]];
-          prior += coupling[(cSize * l) + C[1][0]];
-          prior += coupling[(cSize * l) + C[2][0]];
-          prior += coupling[(cSize * l) + C[0][1]];
-          prior += coupling[(cSize * l) + C[2][1]];
-          prior += coupling[(cSize * l) + C[0][2]];
-          prior += coupling[(cSize * l) + C[1][2]];
-          prior += coupling[(cSize * l) + C[2][2]];
-
-#if 0
-            if (y == rowStart + 1 && x == colStart + 1)
-            {
-              std::cout << "Class: " << l << "\t prior: " << prior << std::endl;
-            }
-#endif
-
-          // now check for the gradient penalty. If our current class is NOT equal
-          // to the class at index[i][j] AND the value of C[i][j] does NOT equal
-          // to the Number of Classes then add in the gradient penalty.
-          if(data->useGradientPenalty != 0)
-          {
-            if(C[0][0] != l && C[0][0] != classes)
-            {
-              edge += sw[(swCols * (y - 1)) + x - 1];
-            }
-            if(C[1][0] != l && C[1][0] != classes)
-            {
-              edge += ew[(ewCols * (y - 1)) + x];
-            }
-            if(C[2][0] != l && C[2][0] != classes)
-            {
-              edge += nw[(nwCols * (y - 1)) + x];
-            }
-            if(C[0][1] != l && C[0][1] != classes)
-            {
-              edge += ns[(nsCols * y) + x - 1];
-            }
-            if(C[2][1] != l && C[2][1] != classes)
-            {
-              edge += ns[(nsCols * y) + x];
-            }
-            if(C[0][2] != l && C[0][2] != classes)
-            {
-              edge += nw[(nwCols * y) + x - 1];
-            }
-            if(C[1][2] != l && C[1][2] != classes)
-            {
-              edge += ew[(ewCols * y) + x];
-            }
-            if(C[2][2] != l && C[2][2] != classes)
-            {
-              edge += sw[(swCols * y) + x];
-            }
-          }
-
-          lij = (cols * rows * l) + (cols * y) + x;
-          curvature_value = 0.0;
-          if(data->useCurvaturePenalty != 0)
-          {
-            curvature_value = data->beta_c * ccost[lij];
-          }
-          real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value)-data->w_gamma[l]);
-          post[l] = expf(arg);
-          sum += post[l];
-        }
-
-        xrnd = rnd[ij];
-        current = 0.0;
-
-        for(int l = 0; l < classes; l++)
-        {
-          lij = (cols * rows * l) + ij;
-          real_t arg = post[l] / sum;
-          if((xrnd >= current) && (xrnd <= (current + arg)))
-          {
-            xt[ij] = l;
-            probs[lij] += 1.0;
-          }
-          current += arg;
-        }
-#if 0
-          Dont even THINK about using this code...
-          This classifys the pixel based on the largest
-          in magnitude  probability
-          real_t max = 0.0;
-          int maxClass = 0;
-          for (int l = 0; l < classes; l++)
-          {
-            lij = (cols * rows * l) + ij;
-            //real_t arg = post[l] / sum;
-            if (probs[lij] > max)
-            {
-              max = probs[lij];
-              maxClass = l;
-            }
-          }
-          //Assign class based on Maximum probability
-          xt[ij] = maxClass;
-#endif
-      }
-    }
-    //  std::cout << "     --" << EMMPM_getMilliSeconds() - millis << "--" << std::endl;
-  }
-
-#if EMMPM_USE_PARALLEL_ALGORITHMS
-#if USE_TBB_TASK_GROUP
-  void operator()() const
-  {
-    calc(m_RowStart, m_RowEnd, m_ColStart, m_ColEnd);
-  }
-#else
-  void operator()(const tbb::blocked_range2d<int>& r) const
-  {
-    calc(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-  }
-#endif
-#endif
-
-private:
-#if USE_TBB_TASK_GROUP
-  int m_RowStart;
-  int m_RowEnd;
-  int m_ColStart;
-  int m_ColEnd;
-#endif
-  const EMMPM_Data* data;
-  const real_t* yk;
-  const real_t* rnd;
-};
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -404,6 +161,11 @@ void MPMCalculation::execute()
     }
   }
 
+  // Precompute the class-major clique priors of every 3 pixel row and every 2 pixel pair of the 8-neighborhood
+  std::vector<real_t> pairPriors;
+  std::vector<real_t> triplePriors;
+  MPMKernel::BuildCliquePriors(data->couplingBeta, classes, pairPriors, triplePriors);
+
   const double rangeMin = 0.0;
   const double rangeMax = 1.0;
 
@@ -445,7 +207,7 @@ void MPMCalculation::execute()
     unsigned int rowStart = 0;
     for(int t = 0; t < threads; ++t)
     {
-      g->run(ParallelCalcLoop(data, yk, &(rndNumbers.front()), rowStart, rowStop, 0, cols));
+      g->run(ParallelCalcLoop(data, yk, &(rndNumbers.front()), triplePriors.data(), pairPriors.data(), rowStart, rowStop, 0, cols));
       rowStart = rowStop;
       rowStop = rowStop + rowIncrement;
       if(rowStop >= rows)
@@ -456,12 +218,14 @@ void MPMCalculation::execute()
     g->wait();
 
 #else
-    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rows / threads, 0, cols, cols), ParallelMPMLoop(data, yk, &(rndNumbers.front())), tbb::simple_partitioner());
+    int rowGrain = std::max(static_cast<int>(rows) / threads, 1);
+    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rowGrain, 0, cols, cols), ParallelMPMLoop(data, yk, &(rndNumbers.front()), triplePriors.data(), pairPriors.data()),
+                      tbb::simple_partitioner());
 #endif
 
 #else
-    ParallelMPMLoop pcl(data, yk, &(rndNumbers.front()));
-    pcl.calc(0, rows, 0, cols);
+    ParallelMPMLoop pcl(data, yk, &(rndNumbers.front()), triplePriors.data(), pairPriors.data());
+    pcl.run(0, rows, 0, cols);
 #endif
 
     // std::cout << "Counter: " << counter << std::endl;
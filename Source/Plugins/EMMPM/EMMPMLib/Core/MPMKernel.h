@@ -0,0 +1,490 @@
+/*
+The Original EM/MPM algorithm was developed by Mary L. Comer and is distributed
+under the BSD License.
+Copyright (c) <2010>, <Mary L. Comer>
+All rights reserved.
+
+[1] Comer, Mary L., and Delp, Edward J.,  ÒThe EM/MPM Algorithm for Segmentation
+of Textured Images: Analysis and Further Experimental Results,Ó IEEE Transactions
+on Image Processing, Vol. 9, No. 10, October 2000, pp. 1731-1744.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+
+Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+Neither the name of <Mary L. Comer> nor the names of its contributors may be
+used to endorse or promote products derived from this software without specific
+prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Heavily modified from the original by Michael A. Jackson for BlueQuartz Software
+ * and funded by the Air Force Research Laboratory, Wright-Patterson AFB.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "EMMPMLib/EMMPMLib.h"
+#include "EMMPMLib/Core/EMMPM_Constants.h"
+#include "EMMPMLib/Core/EMMPM_Data.h"
+
+#ifdef EMMPM_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range2d.h>
+#endif
+
+#define COMPUTE_C_CLIQUE(C, x, y, ci, cj)                                                                                                                                                              \
+  if((x) < 0 || (x) >= cols || (y) < 0 || (y) >= rows)                                                                                                                                                 \
+  {                                                                                                                                                                                                    \
+    C[ci][cj] = classes;                                                                                                                                                                               \
+  }                                                                                                                                                                                                    \
+  else                                                                                                                                                                                                 \
+  {                                                                                                                                                                                                    \
+    ij = (cols * (y)) + (x);                                                                                                                                                                           \
+    C[ci][cj] = xt[ij];                                                                                                                                                                                \
+  }
+
+namespace MPMKernel
+{
+/**
+ * @brief FastExp Branch free single precision exp() (Cephes expf polynomial) that the compiler can
+ * vectorize. Arguments below -87 are clamped, so the result never underflows to zero.
+ */
+inline float FastExp(float x)
+{
+  x = std::min(std::max(x, -87.0f), 88.0f);
+  float fx = std::floor(x * 1.44269504088896341f + 0.5f);
+  x = x - fx * 0.693359375f + fx * 2.12194440e-4f;
+  float z = x * x;
+  float y = 1.9875691500E-4f;
+  y = y * x + 1.3981999507E-3f;
+  y = y * x + 8.3334519073E-3f;
+  y = y * x + 4.1665795894E-2f;
+  y = y * x + 1.6666665459E-1f;
+  y = y * x + 5.0000001201E-1f;
+  y = y * z + x + 1.0f;
+
+  // Scale by 2^fx by building the exponent bits directly
+  int32_t bits = (static_cast<int32_t>(fx) + 127) << 23;
+  float pow2n = 0.0f;
+  std::memcpy(&pow2n, &bits, sizeof(float));
+  return y * pow2n;
+}
+
+/**
+ * @brief BuildCliquePriors Precomputes the class-major clique priors of every 3 pixel row and every 2 pixel
+ * pair of the 8-neighborhood. Neighbor values are packed base (classes + 1), the last value marking "off the image".
+ * @param coupling The (classes + 1) * classes coupling matrix from EMMPM_Data::couplingBeta
+ * @param classes The number of classes
+ * @param pairPriors Resized to (classes + 1)^2 * classes and filled
+ * @param triplePriors Resized to (classes + 1)^3 * classes and filled
+ */
+inline void BuildCliquePriors(const real_t* coupling, size_t classes, std::vector<real_t>& pairPriors, std::vector<real_t>& triplePriors)
+{
+  size_t cSize = classes + 1;
+  pairPriors.resize(cSize * cSize * classes);
+  triplePriors.resize(cSize * cSize * cSize * classes);
+  for(size_t code = 0; code < cSize * cSize; code++)
+  {
+    for(size_t l = 0; l < classes; l++)
+    {
+      pairPriors[code * classes + l] = coupling[(cSize * l) + (code % cSize)] + coupling[(cSize * l) + (code / cSize)];
+    }
+  }
+  for(size_t code = 0; code < cSize * cSize * cSize; code++)
+  {
+    for(size_t l = 0; l < classes; l++)
+    {
+      triplePriors[code * classes + l] = coupling[(cSize * l) + (code % cSize)] + coupling[(cSize * l) + ((code / cSize) % cSize)] + coupling[(cSize * l) + (code / (cSize * cSize))];
+    }
+  }
+}
+} // namespace MPMKernel
+
+/**
+ * @class ParallelMPMLoop MPMKernel.h EMMPMLib/Core/MPMKernel.h
+ * @brief This class can calculate the parts of the MPM loop in parallel
+ *
+ * @date March 11, 2012
+ * @version 1.0
+ */
+class ParallelMPMLoop
+{
+public:
+  ParallelMPMLoop(EMMPM_Data* dPtr, const real_t* ykPtr, const real_t* rnd, const real_t* triplePriors, const real_t* pairPriors)
+  : data(dPtr)
+  , yk(ykPtr)
+  , rnd(rnd)
+  , triplePriors(triplePriors)
+  , pairPriors(pairPriors)
+  {
+  }
+  virtual ~ParallelMPMLoop() = default;
+
+  void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
+  {
+    // uint64_t millis = EMMPM_getMilliSeconds();
+    //  int l;
+    real_t prior;
+    int32_t ij, lij;
+    int rows = data->rows;
+    int cols = data->columns;
+    int classes = data->classes;
+
+    real_t xrnd, current;
+    real_t post[EMMPM_MAX_CLASSES], sum, edge;
+
+    size_t nsCols = data->columns - 1;
+    size_t ewCols = data->columns;
+    size_t swCols = data->columns - 1;
+    size_t nwCols = data->columns - 1;
+
+    unsigned char* xt = data->xt;
+    real_t* probs = data->probs;
+    real_t* ccost = data->ccost;
+    real_t* ns = data->ns;
+    real_t* ew = data->ew;
+    real_t* sw = data->sw;
+    real_t* nw = data->nw;
+    real_t curvature_value = (real_t)0.0;
+
+    int C[3][3]; // This is the Clique for the current Pixel
+                 //      --------- X -----
+                 //      |   | 0 | 1 | 2 |
+                 //      -----------------
+                 //   Y  | 0 |   |   |   |
+                 //      -----------------
+                 //      | 1 |   | P |   |
+                 //      -----------------
+                 //      | 2 |   |   |   |
+                 //
+                 // When we calculate the "C" matrix if the pixel value for the specific index of
+                 // the clique would be off the image then a value = number of classes is
+                 // used for the C[i][j]. That way we can figure out if we are off the image
+
+    std::stringstream ss;
+    unsigned int cSize = classes + 1;
+    real_t* coupling = data->couplingBeta;
+
+    for(int32_t y = rowStart; y < rowEnd; y++)
+    {
+      for(int32_t x = colStart; x < colEnd; x++)
+      {
+
+        /* -------------  */
+        COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
+        COMPUTE_C_CLIQUE(C, x, y - 1, 1, 0);
+        COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2, 0);
+        COMPUTE_C_CLIQUE(C, x - 1, y, 0, 1);
+        COMPUTE_C_CLIQUE(C, x + 1, y, 2, 1);
+        COMPUTE_C_CLIQUE(C, x - 1, y + 1, 0, 2);
+        COMPUTE_C_CLIQUE(C, x, y + 1, 1, 2);
+        COMPUTE_C_CLIQUE(C, x + 1, y + 1, 2, 2);
+
+#if 0
+          if (y == rowStart + 1 && x == colStart + 1)
+          {
+            ss << "------------------------------" << std::endl;
+            ss << "|" << C[0][0] << "\t" << C[1][0] << "\t" << C[2][0] << std::endl;
+            ss << "|" << C[0][1] << "\t" << C[1][1] << "\t" << C[2][1] << std::endl;
+            ss << "|" << C[0][2] << "\t" << C[1][2] << "\t" << C[2][2] << std::endl;
+            ss << "------------------------------" << std::endl;
+            std::cout << ss.str() << std::endl;
+          }
+#endif
+
+        ij = (cols * y) + x;
+        sum = 0;
+        for(int l = 0; l < classes; ++l)
+        {
+          prior = 0;
+          edge = 0;
+
+          prior += coupling[(cSize * l) + C[0][0]];
+          prior += coupling[(cSize * l) + C[1][0]];
+          prior += coupling[(cSize * l) + C[2][0]];
+          prior += coupling[(cSize * l) + C[0][1]];
+          prior += coupling[(cSize * l) + C[2][1]];
+          prior += coupling[(cSize * l) + C[0][2]];
+          prior += coupling[(cSize * l) + C[1][2]];
+          prior += coupling[(cSize * l) + C[2][2]];
+
+#if 0
+            if (y == rowStart + 1 && x == colStart + 1)
+            {
+              std::cout << "Class: " << l << "\t prior: " << prior << std::endl;
+            }
+#endif
+
+          // now check for the gradient penalty. If our current class is NOT equal
+          // to the class at index[i][j] AND the value of C[i][j] does NOT equal
+          // to the Number of Classes then add in the gradient penalty.
+          if(data->useGradientPenalty != 0)
+          {
+            if(C[0][0] != l && C[0][0] != classes)
+            {
+              edge += sw[(swCols * (y - 1)) + x - 1];
+            }
+            if(C[1][0] != l && C[1][0] != classes)
+            {
+              edge += ew[(ewCols * (y - 1)) + x];
+            }
+            if(C[2][0] != l && C[2][0] != classes)
+            {
+              edge += nw[(nwCols * (y - 1)) + x];
+            }
+            if(C[0][1] != l && C[0][1] != classes)
+            {
+              edge += ns[(nsCols * y) + x - 1];
+            }
+            if(C[2][1] != l && C[2][1] != classes)
+            {
+              edge += ns[(nsCols * y) + x];
+            }
+            if(C[0][2] != l && C[0][2] != classes)
+            {
+              edge += nw[(nwCols * y) + x - 1];
+            }
+            if(C[1][2] != l && C[1][2] != classes)
+            {
+              edge += ew[(ewCols * y) + x];
+            }
+            if(C[2][2] != l && C[2][2] != classes)
+            {
+              edge += sw[(swCols * y) + x];
+            }
+          }
+
+          lij = (cols * rows * l) + (cols * y) + x;
+          curvature_value = 0.0;
+          if(data->useCurvaturePenalty != 0)
+          {
+            curvature_value = data->beta_c * ccost[lij];
+          }
+          real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value)-data->w_gamma[l]);
+          post[l] = expf(arg);
+          sum += post[l];
+        }
+
+        xrnd = rnd[ij];
+        current = 0.0;
+
+        for(int l = 0; l < classes; l++)
+        {
+          lij = (cols * rows * l) + ij;
+          real_t arg = post[l] / sum;
+          if((xrnd >= current) && (xrnd <= (current + arg)))
+          {
+            xt[ij] = l;
+            probs[lij] += 1.0;
+          }
+          current += arg;
+        }
+#if 0
+          Dont even THINK about using this code...
+          This classifys the pixel based on the largest
+          in magnitude  probability
+          real_t max = 0.0;
+          int maxClass = 0;
+          for (int l = 0; l < classes; l++)
+          {
+            lij = (cols * rows * l) + ij;
+            //real_t arg = post[l] / sum;
+            if (probs[lij] > max)
+            {
+              max = probs[lij];
+              maxClass = l;
+            }
+          }
+          //Assign class based on Maximum probability
+          xt[ij] = maxClass;
+#endif
+      }
+    }
+    //  std::cout << "     --" << EMMPM_getMilliSeconds() - millis << "--" << std::endl;
+  }
+
+  /**
+   * @brief calcOptimized Performs the same update as calc() for the interior pixels but builds the clique
+   * prior of every class from three rows of the precomputed neighborhood tables, evaluates all classes
+   * in straight line loops the compiler can vectorize and uses FastExp(). Pixels on the image border
+   * are handed to calc().
+   */
+  void calcOptimized(int rowStart, int rowEnd, int colStart, int colEnd) const
+  {
+    const int rows = data->rows;
+    const int cols = data->columns;
+    const int classes = data->classes;
+    const size_t cSize = classes + 1;
+    const size_t planeSize = static_cast<size_t>(rows) * cols;
+
+    const size_t nsCols = data->columns - 1;
+    const size_t ewCols = data->columns;
+    const size_t swCols = data->columns - 1;
+    const size_t nwCols = data->columns - 1;
+
+    unsigned char* xt = data->xt;
+    real_t* probs = data->probs;
+    const real_t* ccost = data->ccost;
+    const real_t* ns = data->ns;
+    const real_t* ew = data->ew;
+    const real_t* sw = data->sw;
+    const real_t* nw = data->nw;
+    const real_t* wGamma = data->w_gamma;
+    const real_t kappa = data->workingKappa;
+    const real_t betaC = data->beta_c;
+    const bool useGradientPenalty = data->useGradientPenalty != 0;
+    const bool useCurvaturePenalty = data->useCurvaturePenalty != 0;
+
+    const int interiorRowStart = std::max(rowStart, 1);
+    const int interiorRowEnd = std::min(rowEnd, rows - 1);
+    const int interiorColStart = std::max(colStart, 1);
+    const int interiorColEnd = std::min(colEnd, cols - 1);
+
+    real_t edge[EMMPM_MAX_CLASSES] = {0};
+    real_t arg[EMMPM_MAX_CLASSES];
+    real_t post[EMMPM_MAX_CLASSES];
+
+    for(int32_t y = rowStart; y < rowEnd; y++)
+    {
+      if(y < interiorRowStart || y >= interiorRowEnd || interiorColStart >= interiorColEnd)
+      {
+        calc(y, y + 1, colStart, colEnd);
+        continue;
+      }
+      if(colStart < interiorColStart)
+      {
+        calc(y, y + 1, colStart, interiorColStart);
+      }
+
+      for(int32_t x = interiorColStart; x < interiorColEnd; x++)
+      {
+        const size_t ij = static_cast<size_t>(cols) * y + x;
+        const unsigned char* above = xt + ij - cols;
+        const unsigned char* below = xt + ij + cols;
+
+        const real_t* upperPrior = triplePriors + (above[-1] + cSize * (above[0] + cSize * above[1])) * classes;
+        const real_t* middlePrior = pairPriors + (xt[ij - 1] + cSize * xt[ij + 1]) * classes;
+        const real_t* lowerPrior = triplePriors + (below[-1] + cSize * (below[0] + cSize * below[1])) * classes;
+
+        if(useGradientPenalty)
+        {
+          // Every neighbor of an interior pixel is on the image, so the penalty of class l is the
+          // total edge weight minus the weight of the neighbors that are already in class l
+          real_t sameClass[EMMPM_MAX_CLASSES + 1] = {0};
+          const real_t w0 = sw[(swCols * (y - 1)) + x - 1];
+          const real_t w1 = ew[(ewCols * (y - 1)) + x];
+          const real_t w2 = nw[(nwCols * (y - 1)) + x];
+          const real_t w3 = ns[(nsCols * y) + x - 1];
+          const real_t w4 = ns[(nsCols * y) + x];
+          const real_t w5 = nw[(nwCols * y) + x - 1];
+          const real_t w6 = ew[(ewCols * y) + x];
+          const real_t w7 = sw[(swCols * y) + x];
+          sameClass[above[-1]] += w0;
+          sameClass[above[0]] += w1;
+          sameClass[above[1]] += w2;
+          sameClass[xt[ij - 1]] += w3;
+          sameClass[xt[ij + 1]] += w4;
+          sameClass[below[-1]] += w5;
+          sameClass[below[0]] += w6;
+          sameClass[below[1]] += w7;
+          const real_t total = w0 + w1 + w2 + w3 + w4 + w5 + w6 + w7;
+          for(int l = 0; l < classes; ++l)
+          {
+            edge[l] = total - sameClass[l];
+          }
+        }
+
+        real_t maxArg = -std::numeric_limits<real_t>::max();
+        for(int l = 0; l < classes; ++l)
+        {
+          const size_t lij = planeSize * l + ij;
+          const real_t prior = upperPrior[l] + middlePrior[l] + lowerPrior[l];
+          const real_t curvatureValue = useCurvaturePenalty ? betaC * ccost[lij] : 0.0f;
+          arg[l] = kappa * (yk[lij] - prior - edge[l] - curvatureValue - wGamma[l]);
+          maxArg = std::max(maxArg, arg[l]);
+        }
+
+        // Shifting by the largest argument leaves post[l] / sum unchanged but keeps the sum finite
+        real_t sum = 0.0f;
+        for(int l = 0; l < classes; ++l)
+        {
+          post[l] = MPMKernel::FastExp(arg[l] - maxArg);
+          sum += post[l];
+        }
+
+        const real_t xrnd = rnd[ij];
+        real_t current = 0.0f;
+        for(int l = 0; l < classes; l++)
+        {
+          const real_t prob = post[l] / sum;
+          if((xrnd >= current) && (xrnd <= (current + prob)))
+          {
+            xt[ij] = l;
+            probs[planeSize * l + ij] += 1.0;
+          }
+          current += prob;
+        }
+      }
+
+      if(interiorColEnd < colEnd)
+      {
+        calc(y, y + 1, interiorColEnd, colEnd);
+      }
+    }
+  }
+
+  /**
+   * @brief run Updates the given block of pixels with the kernel selected in the EMMPM_Data
+   */
+  void run(int rowStart, int rowEnd, int colStart, int colEnd) const
+  {
+    if(data->useScalarMPMKernel != 0)
+    {
+      calc(rowStart, rowEnd, colStart, colEnd);
+    }
+    else
+    {
+      calcOptimized(rowStart, rowEnd, colStart, colEnd);
+    }
+  }
+
+#if EMMPM_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range2d<int>& r) const
+  {
+    run(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+  }
+#endif
+
+private:
+  const EMMPM_Data* data;
+  const real_t* yk;
+  const real_t* rnd;
+  const real_t* triplePriors;
+  const real_t* pairPriors;
+};
+
+#undef COMPUTE_C_CLIQUE
@@ -19,6 +19,7 @@ set (EMMPMLib_Core_HDRS
     ${EMMPMLib_SOURCE_DIR}/Core/EMMPM_Data.h
     ${EMMPMLib_SOURCE_DIR}/Core/EMMPMUtilities.h
     ${EMMPMLib_SOURCE_DIR}/Core/InitializationFunctions.h
+    ${EMMPMLib_SOURCE_DIR}/Core/MPMKernel.h
 )
 
 set(EMMPMLib_Core_Moc_HDRS
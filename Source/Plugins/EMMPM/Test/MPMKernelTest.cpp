@@ -0,0 +1,259 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EMMPMLib/Core/EMMPM_Data.h"
+#include "EMMPMLib/Core/MPMKernel.h"
+
+#include "EMMPMTestFileLocations.h"
+
+class MPMKernelTest
+{
+
+public:
+  MPMKernelTest() = default;
+  virtual ~MPMKernelTest() = default;
+
+  enum KernelMode
+  {
+    Scalar = 0,
+    Optimized = 1,
+    ScalarRowBlocks = 2
+  };
+
+  // -----------------------------------------------------------------------------
+  // Builds a random multi class image with the edge and curvature tables filled in
+  // -----------------------------------------------------------------------------
+  EMMPM_Data::Pointer CreateData(int rows, int cols, int classes, bool useGradientPenalty, bool useCurvaturePenalty, std::mt19937& generator)
+  {
+    std::uniform_real_distribution<real_t> unit(0.0f, 1.0f);
+
+    EMMPM_Data::Pointer data = EMMPM_Data::New();
+    data->rows = rows;
+    data->columns = cols;
+    data->classes = classes;
+    data->dims = 1;
+    data->allocateDataStructureMemory();
+    data->calculateBetaMatrix(0.7);
+    data->workingKappa = 1.0f;
+    data->useGradientPenalty = useGradientPenalty ? 1 : 0;
+    data->useCurvaturePenalty = useCurvaturePenalty ? 1 : 0;
+    data->beta_e = 1.0f;
+    data->beta_c = 0.5f;
+    for(int l = 0; l < classes; l++)
+    {
+      data->w_gamma[l] = 0.25f * l;
+    }
+
+    size_t totalPoints = static_cast<size_t>(rows) * cols;
+    data->ns = new real_t[rows * (cols - 1)]();
+    data->ew = new real_t[(rows - 1) * cols]();
+    data->sw = new real_t[(rows - 1) * (cols - 1)]();
+    data->nw = new real_t[(rows - 1) * (cols - 1)]();
+    data->ccost = new real_t[classes * totalPoints]();
+    for(int i = 0; i < rows * (cols - 1); i++)
+    {
+      data->ns[i] = unit(generator);
+    }
+    for(int i = 0; i < (rows - 1) * cols; i++)
+    {
+      data->ew[i] = unit(generator);
+    }
+    for(int i = 0; i < (rows - 1) * (cols - 1); i++)
+    {
+      data->sw[i] = unit(generator);
+      data->nw[i] = unit(generator);
+    }
+    for(size_t i = 0; i < classes * totalPoints; i++)
+    {
+      data->ccost[i] = unit(generator);
+    }
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      data->xt[i] = static_cast<unsigned char>(generator() % classes);
+    }
+    return data;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs a few MPM sweeps over a copy of the labels and returns the labels and probabilities
+  // -----------------------------------------------------------------------------
+  void RunSweeps(const EMMPM_Data::Pointer& data, const std::vector<unsigned char>& initialLabels, const std::vector<real_t>& yk, const std::vector<std::vector<real_t>>& rnd, KernelMode mode,
+                 std::vector<unsigned char>& labels, std::vector<real_t>& probs)
+  {
+    size_t totalPoints = static_cast<size_t>(data->rows) * data->columns;
+    std::copy(initialLabels.begin(), initialLabels.end(), data->xt);
+    std::fill(data->probs, data->probs + data->classes * totalPoints, 0.0f);
+
+    std::vector<real_t> pairPriors;
+    std::vector<real_t> triplePriors;
+    MPMKernel::BuildCliquePriors(data->couplingBeta, data->classes, pairPriors, triplePriors);
+
+    for(const std::vector<real_t>& sweepRnd : rnd)
+    {
+      ParallelMPMLoop loop(data.get(), yk.data(), sweepRnd.data(), triplePriors.data(), pairPriors.data());
+      if(mode == Scalar)
+      {
+        loop.calc(0, data->rows, 0, data->columns);
+      }
+      else if(mode == Optimized)
+      {
+        loop.calcOptimized(0, data->rows, 0, data->columns);
+      }
+      else
+      {
+        int split = data->rows / 2;
+        loop.calc(0, split, 0, data->columns);
+        loop.calc(split, data->rows, 0, data->columns);
+      }
+    }
+    labels.assign(data->xt, data->xt + totalPoints);
+    probs.assign(data->probs, data->probs + data->classes * totalPoints);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFastExp()
+  {
+    DREAM3D_REQUIRE_EQUAL(MPMKernel::FastExp(0.0f), 1.0f)
+
+    // Relative error against std::exp over the whole unclamped range
+    for(float x = -87.0f; x <= 88.0f; x += 0.01f)
+    {
+      double expected = std::exp(static_cast<double>(x));
+      double relError = std::abs(MPMKernel::FastExp(x) - expected) / expected;
+      DREAM3D_REQUIRED(relError, <, 2.0e-6)
+    }
+
+    // Arguments outside the range are clamped so the result stays finite and non zero
+    DREAM3D_REQUIRE_EQUAL(MPMKernel::FastExp(-1000.0f), MPMKernel::FastExp(-87.0f))
+    DREAM3D_REQUIRED(MPMKernel::FastExp(-1000.0f), >, 0.0f)
+    DREAM3D_REQUIRE_EQUAL(MPMKernel::FastExp(1000.0f), MPMKernel::FastExp(88.0f))
+    DREAM3D_REQUIRE(MPMKernel::FastExp(1000.0f) < std::numeric_limits<float>::infinity())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCliquePriors()
+  {
+    std::mt19937 generator(5489u);
+    EMMPM_Data::Pointer data = CreateData(4, 4, 4, false, false, generator);
+    size_t classes = data->classes;
+    size_t cSize = classes + 1;
+    const real_t* coupling = data->couplingBeta;
+
+    std::vector<real_t> pairPriors;
+    std::vector<real_t> triplePriors;
+    MPMKernel::BuildCliquePriors(coupling, classes, pairPriors, triplePriors);
+    DREAM3D_REQUIRE_EQUAL(pairPriors.size(), cSize * cSize * classes)
+    DREAM3D_REQUIRE_EQUAL(triplePriors.size(), cSize * cSize * cSize * classes)
+
+    for(size_t a = 0; a < cSize; a++)
+    {
+      for(size_t b = 0; b < cSize; b++)
+      {
+        for(size_t l = 0; l < classes; l++)
+        {
+          real_t expected = coupling[cSize * l + a] + coupling[cSize * l + b];
+          DREAM3D_REQUIRE_EQUAL(pairPriors[(a + cSize * b) * classes + l], expected)
+          for(size_t c = 0; c < cSize; c++)
+          {
+            expected = coupling[cSize * l + a] + coupling[cSize * l + b] + coupling[cSize * l + c];
+            DREAM3D_REQUIRE_EQUAL(triplePriors[(a + cSize * (b + cSize * c)) * classes + l], expected)
+          }
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The optimized kernel must sample the same labels as the scalar one and updating the image
+  // in two row blocks must match a single pass, i.e. block edges are not treated as image edges.
+  // -----------------------------------------------------------------------------
+  int TestKernelsMatch()
+  {
+    const int rows = 23;
+    const int cols = 19;
+    const int sweeps = 5;
+    std::mt19937 generator(5489u);
+
+    for(int classes = 2; classes <= 5; classes++)
+    {
+      for(int penalties = 0; penalties < 4; penalties++)
+      {
+        EMMPM_Data::Pointer data = CreateData(rows, cols, classes, (penalties & 1) != 0, (penalties & 2) != 0, generator);
+        size_t totalPoints = static_cast<size_t>(rows) * cols;
+
+        std::uniform_real_distribution<real_t> unit(0.0f, 1.0f);
+        std::vector<real_t> yk(classes * totalPoints);
+        for(real_t& value : yk)
+        {
+          value = -4.0f * unit(generator);
+        }
+        std::vector<std::vector<real_t>> rnd(sweeps, std::vector<real_t>(totalPoints));
+        for(std::vector<real_t>& sweepRnd : rnd)
+        {
+          for(real_t& value : sweepRnd)
+          {
+            value = unit(generator);
+          }
+        }
+        std::vector<unsigned char> initialLabels(data->xt, data->xt + totalPoints);
+
+        std::vector<unsigned char> scalarLabels;
+        std::vector<real_t> scalarProbs;
+        RunSweeps(data, initialLabels, yk, rnd, Scalar, scalarLabels, scalarProbs);
+
+        std::vector<unsigned char> optimizedLabels;
+        std::vector<real_t> optimizedProbs;
+        RunSweeps(data, initialLabels, yk, rnd, Optimized, optimizedLabels, optimizedProbs);
+
+        std::vector<unsigned char> blockLabels;
+        std::vector<real_t> blockProbs;
+        RunSweeps(data, initialLabels, yk, rnd, ScalarRowBlocks, blockLabels, blockProbs);
+
+        for(size_t i = 0; i < totalPoints; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(optimizedLabels[i], scalarLabels[i])
+          DREAM3D_REQUIRE_EQUAL(blockLabels[i], scalarLabels[i])
+        }
+        // The probabilities are sample counts, so they match exactly when the labels do
+        for(size_t i = 0; i < scalarProbs.size(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(optimizedProbs[i], scalarProbs[i])
+          DREAM3D_REQUIRE_EQUAL(blockProbs[i], scalarProbs[i])
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFastExp())
+    DREAM3D_REGISTER_TEST(TestCliquePriors())
+    DREAM3D_REGISTER_TEST(TestKernelsMatch())
+  }
+
+private:
+  MPMKernelTest(const MPMKernelTest&);   // Copy Constructor Not Implemented
+  void operator=(const MPMKernelTest&); // Move assignment Not Implemented
+};
@@ -47,6 +47,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/FeatureMoments.h"
+
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
 
@@ -142,50 +144,24 @@ void FindFeatureCentroids::find_centroids()
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  std::vector<size_t> dims(1, 4);
-  FloatArrayType::Pointer m_FeatureCentersPtr = FloatArrayType::CreateArray(totalFeatures, dims, "_INTERNAL_USE_ONLY_Centroids", true);
-  m_FeatureCentersPtr->initializeWithZeros();
-  float* featurecenters = m_FeatureCentersPtr->getPointer(0);
-
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
+  FeatureMoments moments(m_FeatureIds, imageGeom->getDimensions(), totalFeatures, FeatureMoments::Order::First);
+  moments.compute();
 
-  // FloatVec3Type spacing = imageGeom->getSpacing();
-  // FloatVec3Type origin = imageGeom->getOrigin();
+  // The centroid is the mean of the cell centers, so it is the center of the first cell moved by the mean index
+  FloatVec3Type spacing = imageGeom->getSpacing();
+  std::array<float, 3> firstCenter = {{0.0f, 0.0f, 0.0f}};
+  imageGeom->getCoords(0, 0, 0, firstCenter.data());
 
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  for(size_t i = 0; i < totalFeatures; i++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    if(moments.getCount(i) > 0)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
+      for(size_t d = 0; d < 3; d++)
       {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        featurecenters[gnum * 4 + 0]++;
-        std::array<float, 3> coords = {{0.0f, 0.0f, 0.0f}};
-        imageGeom->getCoords(k, j, i, coords.data());
-        featurecenters[gnum * 4 + 1] = featurecenters[gnum * 4 + 1] + coords[0];
-        featurecenters[gnum * 4 + 2] = featurecenters[gnum * 4 + 2] + coords[1];
-        featurecenters[gnum * 4 + 3] = featurecenters[gnum * 4 + 3] + coords[2];
+        m_Centroids[3 * i + d] = static_cast<float>(firstCenter[d] + moments.getMeanIndex(i, d) * spacing[d]);
       }
     }
   }
-  for(size_t i = 0; i < totalFeatures; i++)
-  {
-    if(featurecenters[i * 4 + 0] > 0.0f)
-    {
-      featurecenters[i * 4 + 1] = featurecenters[i * 4 + 1] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 2] = featurecenters[i * 4 + 2] / featurecenters[i * 4 + 0];
-      featurecenters[i * 4 + 3] = featurecenters[i * 4 + 3] / featurecenters[i * 4 + 0];
-      m_Centroids[3 * i] = featurecenters[i * 4 + 1];
-      m_Centroids[3 * i + 1] = featurecenters[i * 4 + 2];
-      m_Centroids[3 * i + 2] = featurecenters[i * 4 + 3];
-    }
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -34,7 +34,6 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AbaqusHexahedronWriter.h"
 
-#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
@@ -48,10 +47,16 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
-#include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_LinesPerBlock = 65536;
+constexpr size_t k_GrainsPerBlock = 64;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -266,24 +271,9 @@ void AbaqusHexahedronWriter::execute()
 // -----------------------------------------------------------------------------
 int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size_t* cDims, float* origin, float* spacing)
 {
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-  uint64_t startMillis = millis;
-  uint64_t estimatedTime = 0;
-  float timeDiff = 0.0f;
-  QString buf;
-  QTextStream ss(&buf);
-
   size_t pDims[3] = {cDims[0] + 1, cDims[1] + 1, cDims[2] + 1};
-  size_t nodeIndex = 1;
   size_t totalPoints = pDims[0] * pDims[1] * pDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
-  int32_t err = 0;
   FILE* f = nullptr;
   f = fopen(fileNames.at(0).toLatin1().data(), "wb");
   if(nullptr == f)
@@ -294,38 +284,30 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Node\n");
 
-  for(size_t z = 0; z < pDims[2]; z++)
-  {
-    for(size_t y = 0; y < pDims[1]; y++)
+  auto formatNodes = [&](size_t start, size_t end, std::string& out) {
+    for(size_t node = start; node < end; node++)
     {
-      for(size_t x = 0; x < pDims[0]; x++)
-      {
-        float xCoord = origin[0] + (x * spacing[0]);
-        float yCoord = origin[1] + (y * spacing[1]);
-        float zCoord = origin[2] + (z * spacing[2]);
-        fprintf(f, "%llu, %f, %f, %f\n", static_cast<unsigned long long int>(nodeIndex), xCoord, yCoord, zCoord);
-        if(nodeIndex % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Nodes (File 1/5) " << static_cast<int>((float)(nodeIndex) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)nodeIndex / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - nodeIndex) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++nodeIndex;
-      }
+      size_t x = node % pDims[0];
+      size_t y = (node / pDims[0]) % pDims[1];
+      size_t z = node / (pDims[0] * pDims[1]);
+      float xCoord = origin[0] + (x * spacing[0]);
+      float yCoord = origin[1] + (y * spacing[1]);
+      float zCoord = origin[2] + (z * spacing[2]);
+      ChunkedTextWriter::AppendInteger(out, static_cast<unsigned long long int>(node + 1));
+      out += ", ";
+      ChunkedTextWriter::AppendFloat(out, "%f", xCoord);
+      out += ", ";
+      ChunkedTextWriter::AppendFloat(out, "%f", yCoord);
+      out += ", ";
+      ChunkedTextWriter::AppendFloat(out, "%f", zCoord);
+      out += '\n';
     }
+  };
+  int32_t err = ChunkedTextWriter::Write(f, totalPoints, k_LinesPerBlock, formatNodes, this, "Writing Nodes (File 1/5)");
+  if(err != 0)
+  {
+    fclose(f);
+    return err;
   }
 
   // Write the last node, which is a dummy node used for stress - strain curves.
@@ -343,21 +325,8 @@ int32_t AbaqusHexahedronWriter::writeNodes(const QList<QString>& fileNames, size
 // -----------------------------------------------------------------------------
 int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size_t* cDims, size_t* pDims)
 {
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-  uint64_t startMillis = millis;
-  uint64_t estimatedTime = 0;
-  float timeDiff = 0.0f;
-  QString buf;
-  QTextStream ss(&buf);
   size_t totalPoints = cDims[0] * cDims[1] * cDims[2];
-  size_t increment = static_cast<size_t>(totalPoints * 0.01f);
-  if(increment == 0) // check to prevent divide by 0
-  {
-    increment = 1;
-  }
 
-  int32_t err = 0;
   FILE* f = nullptr;
   f = fopen(fileNames.at(1).toLatin1().data(), "wb");
   if(nullptr == f)
@@ -365,43 +334,33 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
     return -1;
   }
 
-  // Get a typedef to shorten up the printf codes
-  using _lli_t_ = long long int;
-
-  size_t index = 1;
   fprintf(f, "** Generated by : %s\n", ImportExport::Version::PackageComplete().toLatin1().data());
   fprintf(f, "** ----------------------------------------------------------------\n**\n*Element, type=C3D8\n");
-  for(size_t z = 0; z < cDims[2]; z++)
-  {
-    for(size_t y = 0; y < cDims[1]; y++)
+
+  // Abaqus node order of a C3D8 element in terms of the corners returned by getNodeIds()
+  const size_t cornerOrder[8] = {5, 1, 0, 4, 7, 3, 2, 6};
+  auto formatElements = [&](size_t start, size_t end, std::string& out) {
+    for(size_t index = start; index < end; index++)
     {
-      for(size_t x = 0; x < cDims[0]; x++)
+      size_t x = index % cDims[0];
+      size_t y = (index / cDims[0]) % cDims[1];
+      size_t z = index / (cDims[0] * cDims[1]);
+      int64_t nodeId[8];
+      getNodeIds(x, y, z, pDims, nodeId);
+      ChunkedTextWriter::AppendInteger(out, static_cast<unsigned long long int>(index + 1));
+      for(const auto& corner : cornerOrder)
       {
-        std::vector<int64_t> nodeId = getNodeIds(x, y, z, pDims);
-        fprintf(f, "%llu, %lld, %lld, %lld, %lld, %lld, %lld, %lld, %lld\n", (_lli_t_)index, (_lli_t_)nodeId[5], (_lli_t_)nodeId[1], (_lli_t_)nodeId[0], (_lli_t_)nodeId[4], (_lli_t_)nodeId[7],
-                (_lli_t_)nodeId[3], (_lli_t_)nodeId[2], (_lli_t_)nodeId[6]);
-        if(index % increment == 0)
-        {
-          currentMillis = QDateTime::currentMSecsSinceEpoch();
-          if(currentMillis - millis > 1000)
-          {
-            buf.clear();
-            ss << "Writing Elements (File 2/5) " << static_cast<int>((float)(index) / (float)(totalPoints)*100) << "% Completed ";
-            timeDiff = ((float)index / (float)(currentMillis - startMillis));
-            estimatedTime = (float)(totalPoints - index) / timeDiff;
-            ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-            notifyStatusMessage(buf);
-            millis = QDateTime::currentMSecsSinceEpoch();
-            if(getCancel()) // Filter has been cancelled
-            {
-              fclose(f);
-              return 1;
-            }
-          }
-        }
-        ++index;
+        out += ", ";
+        ChunkedTextWriter::AppendInteger(out, static_cast<long long int>(nodeId[corner]));
       }
+      out += '\n';
     }
+  };
+  int32_t err = ChunkedTextWriter::Write(f, totalPoints, k_LinesPerBlock, formatElements, this, "Writing Elements (File 2/5)");
+  if(err != 0)
+  {
+    fclose(f);
+    return err;
   }
 
   fprintf(f, "**\n** ----------------------------------------------------------------\n**\n");
@@ -417,15 +376,6 @@ int32_t AbaqusHexahedronWriter::writeElems(const QList<QString>& fileNames, size
 // -----------------------------------------------------------------------------
 int32_t AbaqusHexahedronWriter::writeElset(const QList<QString>& fileNames, size_t totalPoints)
 {
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-  uint64_t startMillis = millis;
-  uint64_t estimatedTime = 0;
-  float timeDiff = 0.0f;
-  QString buf;
-  QTextStream ss(&buf);
-
-  int32_t err = 0;
   FILE* f = nullptr;
   f = fopen(fileNames.at(3).toLatin1().data(), "wb");
   if(nullptr == f)
@@ -438,7 +388,7 @@ int32_t AbaqusHexahedronWriter::writeElset(const QList<QString>& fileNames, size
   fprintf(f, "*Elset, elset=cube, generate\n");
   fprintf(f, "1, %llu, 1\n", static_cast<unsigned long long int>(totalPoints));
   fprintf(f, "**\n** Each Grain is made up of multiple elements\n**");
-  notifyStatusMessage(("Writing Element Sets (File 4/5) 1% Completed || Est. Time Remain: "));
+  notifyStatusMessage(("Writing Element Sets (File 4/5) 1% Completed"));
 
   // find total number of Grain Ids
   int32_t maxGrainId = 0;
@@ -450,57 +400,53 @@ int32_t AbaqusHexahedronWriter::writeElset(const QList<QString>& fileNames, size
     }
   }
 
-  int32_t increment = static_cast<int32_t>(maxGrainId * 0.1f);
-  if(increment == 0) // check to prevent divide by 0
+  // Bucket the elements by grain in a single sweep; the elements of each grain stay in increasing order
+  std::vector<size_t> grainOffsets(static_cast<size_t>(maxGrainId) + 2, 0);
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    increment = 1;
+    if(m_FeatureIds[i] > 0)
+    {
+      grainOffsets[m_FeatureIds[i] + 1]++;
+    }
   }
-
-  int32_t voxelId = 1;
-  while(voxelId <= maxGrainId)
+  for(size_t g = 1; g < grainOffsets.size(); g++)
   {
-    size_t elementPerLine = 0;
-    fprintf(f, "\n*Elset, elset=Grain%d_set\n", voxelId);
-
-    for(size_t i = 0; i < totalPoints + 1; i++)
+    grainOffsets[g] += grainOffsets[g - 1];
+  }
+  std::vector<size_t> grainElements(grainOffsets.back());
+  {
+    std::vector<size_t> grainFill(grainOffsets.begin(), grainOffsets.end() - 1);
+    for(size_t i = 0; i < totalPoints; i++)
     {
-      if(m_FeatureIds[i] == voxelId)
+      if(m_FeatureIds[i] > 0)
       {
-        if(elementPerLine != 0) // no comma at start
-        {
-          if((elementPerLine % 16) != 0u) // 16 per line
-          {
-            fprintf(f, ", ");
-          }
-          else
-          {
-            fprintf(f, ",\n");
-          }
-        }
-        fprintf(f, "%llu", static_cast<unsigned long long int>(i + 1));
-        elementPerLine++;
+        grainElements[grainFill[m_FeatureIds[i]]++] = i;
       }
     }
-    if(voxelId % increment == 0)
+  }
+
+  auto formatElsets = [&](size_t start, size_t end, std::string& out) {
+    for(size_t grain = start + 1; grain <= end; grain++)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if(currentMillis - millis > 1000)
+      out += "\n*Elset, elset=Grain";
+      ChunkedTextWriter::AppendInteger(out, static_cast<int32_t>(grain));
+      out += "_set\n";
+      for(size_t e = grainOffsets[grain]; e < grainOffsets[grain + 1]; e++)
       {
-        buf.clear();
-        ss << "Writing Element Sets (File 4/5) " << static_cast<int>((float)(voxelId) / (float)(maxGrainId)*100) << "% Completed ";
-        timeDiff = ((float)voxelId / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(maxGrainId - voxelId) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-        if(getCancel()) // Filter has been cancelled
+        size_t elementPerLine = e - grainOffsets[grain];
+        if(elementPerLine != 0) // no comma at start
         {
-          fclose(f);
-          return 1;
+          out += (elementPerLine % 16) != 0u ? ", " : ",\n"; // 16 per line
         }
+        ChunkedTextWriter::AppendInteger(out, static_cast<unsigned long long int>(grainElements[e] + 1));
       }
     }
-    voxelId++;
+  };
+  int32_t err = ChunkedTextWriter::Write(f, static_cast<size_t>(maxGrainId), k_GrainsPerBlock, formatElsets, this, "Writing Element Sets (File 4/5)");
+  if(err != 0)
+  {
+    fclose(f);
+    return err;
   }
   fprintf(f, "\n**\n** ----------------------------------------------------------------\n**\n");
 
@@ -587,10 +533,8 @@ int32_t AbaqusHexahedronWriter::writeSects(const QString& file, size_t totalPoin
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims)
+void AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size_t z, size_t* pDims, int64_t* nodeId)
 {
-  std::vector<int64_t> nodeId(8, 0);
-
   nodeId[0] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + x);
   nodeId[1] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * y) + (x + 1));
   nodeId[2] = static_cast<int64_t>(1 + (pDims[0] * pDims[1] * z) + (pDims[0] * (y + 1)) + x);
@@ -614,7 +558,6 @@ std::vector<int64_t> AbaqusHexahedronWriter::getNodeIds(size_t x, size_t y, size
     printf("         | /        |/     \n");
     printf("        %lld--------%lld     \n", static_cast<long long int>(nodeId[2]), static_cast<long long int>(nodeId[3]));
 #endif
-  return nodeId;
 }
 
 // -----------------------------------------------------------------------------
@@ -41,6 +41,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
 
 #include <QtCore/QTextStream>
 
@@ -55,6 +56,11 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
+namespace
+{
+constexpr size_t k_ValuesPerBlock = 65536;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -250,21 +256,19 @@ int AvizoUniformCoordinateWriter::writeData(FILE* f)
   }
   else
   {
-    // The "20 Items" is purely arbitrary and is put in to try and save some space in the ASCII file
-    int count = 0;
-    for(size_t i = 0; i < totalPoints; ++i)
-    {
-      fprintf(f, "%d", m_FeatureIds[i]);
-      if(count < 20)
+    // The "20 Items" is purely arbitrary and is put in to try and save some space in the ASCII file. Every 21st value ends a line.
+    auto formatFeatureIds = [&](size_t start, size_t end, std::string& out) {
+      for(size_t i = start; i < end; ++i)
       {
-        fprintf(f, " ");
-        count++;
-      }
-      else
-      {
-        fprintf(f, "\n");
-        count = 0;
+        ChunkedTextWriter::AppendInteger(out, m_FeatureIds[i]);
+        out += (i % 21 == 20) ? '\n' : ' ';
       }
+    };
+    int32_t err = ChunkedTextWriter::Write(f, totalPoints, k_ValuesPerBlock, formatFeatureIds, this, "Writing Avizo File");
+    if(err != 0)
+    {
+      // A canceled write is not an error but the file is left incomplete
+      return err < 0 ? -1 : 0;
     }
   }
   fprintf(f, "\n");
@@ -53,6 +53,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextReader.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -63,6 +64,39 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief The DxFeatureIdsSink class stores the Feature Ids of a .dx file. The file lists the Z index fastest, then Y,
+ * then X while the cell array is X fastest.
+ */
+class DxFeatureIdsSink
+{
+public:
+  DxFeatureIdsSink(int32_t* featureIds, const std::vector<size_t>& tDims)
+  : m_FeatureIds(featureIds)
+  , m_XPoints(tDims[0])
+  , m_YPoints(tDims[1])
+  , m_ZPoints(tDims[2])
+  {
+  }
+
+  void operator()(size_t n, int32_t fId) const
+  {
+    size_t zIdx = n % m_ZPoints;
+    size_t yIdx = (n / m_ZPoints) % m_YPoints;
+    size_t xIdx = n / (m_ZPoints * m_YPoints);
+    m_FeatureIds[(zIdx * m_XPoints * m_YPoints) + (m_XPoints * yIdx) + xIdx] = fId;
+  }
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  size_t m_XPoints = 0;
+  size_t m_YPoints = 0;
+  size_t m_ZPoints = 0;
+};
+} // namespace
+
 /* ############## Start Private Implementation ############################### */
 // -----------------------------------------------------------------------------
 //
@@ -478,10 +512,6 @@ int32_t DxReader::readFile()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getVolumeDataContainerName());
 
-  bool finished_header = true;
-  bool finished_data = false;
-  size_t index = 0;
-
   // Resize the Cell Attribute Matrix based on the number of points about to be read.
   std::vector<size_t> tDims(3, 0);
   tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
@@ -496,62 +526,20 @@ int32_t DxReader::readFile()
     return -1;
   }
 
-  bool ok = false;
-  QByteArray buf = m_InStream.readLine();
-
-  size_t xIdx = 0, yIdx = 0, zIdx = 0;
+  // readHeader() stopped right after the header so the Feature Ids start at the current position. They run up to the
+  // "attribute" lines at the end of the file.
+  size_t total = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   size_t count = 0;
-
-  while(buf.size() > 0 && !m_InStream.atEnd())
+  ChunkedTextReader textReader(getInputFile());
+  if(textReader.isValid() && total > 0)
   {
-    // Get the remaining lines of the header and ignore
-    buf = buf.simplified();
-    QList<QByteArray> tokens = buf.split(' ');
-
-    size_t total = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-    if(count == total || (finished_header && !tokens.empty() && tokens[0] == "attribute"))
-    {
-      finished_data = true;
-    }
-
-    if(finished_header && !finished_data)
-    {
-      qint32 size = tokens.size();
-      for(qint32 in_spins = 0; in_spins < size; in_spins++)
-      {
-        int32_t fId = tokens[in_spins].toInt(&ok, 10);
-        count++;
-        index = (zIdx * tDims[0] * tDims[1]) + (tDims[0] * yIdx) + xIdx;
-
-        m_FeatureIds[index] = fId;
-
-        zIdx++; // Increment zIdx and then check all the indices and wrap back to zero if needed.
-
-        if(zIdx == tDims[2])
-        {
-          zIdx = 0;
-          yIdx++;
-        }
-
-        if(yIdx == tDims[1])
-        {
-          yIdx = 0;
-          xIdx++;
-        }
-
-        if(xIdx == tDims[0])
-        {
-          xIdx = 0;
-          Q_ASSERT(count == total);
-        }
-      }
-    }
-    buf = m_InStream.readLine();
+    DxFeatureIdsSink sink(m_FeatureIds, tDims);
+    count = textReader.readValues<int32_t>(static_cast<size_t>(m_InStream.pos()), total, sink);
   }
 
   if(count != static_cast<size_t>(m->getGeometryAs<ImageGeom>()->getNumberOfElements()))
   {
-    QString ss = QObject::tr("Data size does not match header dimensions\t%1\t%2").arg(index).arg(m->getGeometryAs<ImageGeom>()->getNumberOfElements());
+    QString ss = QObject::tr("Data size does not match header dimensions\t%1\t%2").arg(count).arg(m->getGeometryAs<ImageGeom>()->getNumberOfElements());
     setErrorCondition(-495, ss);
     m_InStream.close();
     return getErrorCode();
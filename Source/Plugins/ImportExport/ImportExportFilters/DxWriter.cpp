@@ -50,6 +50,12 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_ValuesPerBlock = 65536;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -257,55 +263,63 @@ int32_t DxWriter::writeFile()
     }
   }
 
-  int64_t index = 0;
-  for(int64_t x = 0; x < dims[0]; ++x)
+  // Each item is one line of voxels along Z. The lines are formatted in parallel and written in order.
+  std::string surfaceRowStart;
+  std::string surfaceRowEnd;
+  for(int64_t i = 0; m_AddSurfaceLayer && i < fileXDim; ++i)
   {
-    // Add a leading surface Row for this plane if needed
-    if(m_AddSurfaceLayer)
+    surfaceRowStart += "-4 ";
+    surfaceRowEnd += "-7 ";
+  }
+  auto formatLines = [&](size_t start, size_t end, std::string& buffer) {
+    for(size_t line = start; line < end; line++)
     {
-      for(int64_t i = 0; i < fileXDim; ++i)
+      int64_t x = static_cast<int64_t>(line) / dims[1];
+      int64_t y = static_cast<int64_t>(line) % dims[1];
+      // Add a leading surface Row for this plane if needed
+      if(m_AddSurfaceLayer && y == 0)
       {
-        out << "-4 ";
+        buffer += surfaceRowStart;
+        buffer += '\n';
       }
-      out << "\n";
-    }
-    for(int64_t y = 0; y < dims[1]; ++y)
-    {
       // write leading surface voxel for this row
       if(m_AddSurfaceLayer)
       {
-        out << "-5 ";
+        buffer += "-5 ";
       }
       // Write the actual voxel data
       for(int64_t z = 0; z < dims[2]; ++z)
       {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        if(m_FeatureIds[index] == 0)
-        {
-          out << "0"
-              << " ";
-        }
-        else
-        {
-          out << m_FeatureIds[index] << " ";
-        }
+        int64_t index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
+        ChunkedTextWriter::AppendInteger(buffer, m_FeatureIds[index]);
+        buffer += ' ';
       }
       // write trailing surface voxel for this row
       if(m_AddSurfaceLayer)
       {
-        out << "-6 ";
+        buffer += "-6 ";
       }
-      out << "\n";
-    }
-    // Add a trailing surface Row for this plane if needed
-    if(m_AddSurfaceLayer)
-    {
-      for(int64_t i = 0; i < fileXDim; ++i)
+      buffer += '\n';
+      // Add a trailing surface Row for this plane if needed
+      if(m_AddSurfaceLayer && y == dims[1] - 1)
       {
-        out << "-7 ";
+        buffer += surfaceRowEnd;
+        buffer += '\n';
       }
-      out << "\n";
     }
+  };
+  out.flush();
+  size_t linesPerBlock = k_ValuesPerBlock / std::max<size_t>(1, static_cast<size_t>(dims[2]));
+  err = ChunkedTextWriter::Write(file, static_cast<size_t>(dims[0] * dims[1]), linesPerBlock, formatLines, this, "Writing Dx File");
+  if(err != 0)
+  {
+    file.close();
+    if(err < 0)
+    {
+      QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+      setErrorCondition(-101, ss);
+    }
+    return getErrorCode();
   }
 
   // Add a complete layer of surface voxels
@@ -47,6 +47,12 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_LinesPerBlock = 65536;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -212,10 +218,37 @@ void LammpsFileWriter::execute()
   fprintf(lammpsFile, "\n");
 
   // Write the Atom positions (Vertices)
-  for(int64_t i = 0; i < numAtoms; i++)
+  auto formatAtoms = [&](size_t start, size_t end, std::string& out) {
+    float coords[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t i = start; i < end; i++)
+    {
+      vertices->getCoords(i, coords);
+      ChunkedTextWriter::AppendInteger(out, static_cast<long long int>(i));
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, atomType);
+      for(const float& coord : coords)
+      {
+        out += ' ';
+        ChunkedTextWriter::AppendFixed(out, coord, 6);
+      }
+      for(int32_t d = 0; d < 3; d++)
+      {
+        out += ' ';
+        ChunkedTextWriter::AppendInteger(out, dummy);
+      }
+      out += '\n';
+    }
+  };
+  int32_t err = ChunkedTextWriter::Write(lammpsFile, static_cast<size_t>(numAtoms), k_LinesPerBlock, formatAtoms, this, "Writing LAMMPS File");
+  if(err != 0)
   {
-    vertices->getCoords(i, pos);
-    fprintf(lammpsFile, "%lld %d %f %f %f %d %d %d\n", (long long int)(i), atomType, pos[0], pos[1], pos[2], dummy, dummy, dummy); // Write the positions to the output file
+    fclose(lammpsFile);
+    if(err < 0)
+    {
+      QString ss = QObject::tr(": Error writing LAMMPS output file '%1'").arg(getLammpsFile());
+      setErrorCondition(-11001, ss);
+    }
+    return;
   }
 
   fprintf(lammpsFile, "\n");
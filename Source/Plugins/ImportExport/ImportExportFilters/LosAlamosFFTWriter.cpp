@@ -50,6 +50,12 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_LinesPerBlock = 65536;
+} // namespace
 
 #define LLU_CAST(arg) static_cast<unsigned long long int>(arg)
 
@@ -208,31 +214,47 @@ int32_t LosAlamosFFTWriter::writeFile()
     return -1;
   }
 
-  float phi1 = 0.0f, phi = 0.0f, phi2 = 0.0f;
-  int32_t featureId = 0;
-  int32_t phaseId = 0;
-
-  size_t index = 0;
-  for(size_t z = 0; z < dims[2]; ++z)
+  // The cells are written X fastest, which is their order in memory
+  auto formatCells = [&](size_t start, size_t end, std::string& out) {
+    for(size_t index = start; index < end; index++)
+    {
+      size_t x = index % dims[0];
+      size_t y = (index / dims[0]) % dims[1];
+      size_t z = index / (dims[0] * dims[1]);
+      float phi1 = m_CellEulerAngles[index * 3] * 180.0 * SIMPLib::Constants::k_1OverPi;
+      float phi = m_CellEulerAngles[index * 3 + 1] * 180.0 * SIMPLib::Constants::k_1OverPi;
+      float phi2 = m_CellEulerAngles[index * 3 + 2] * 180.0 * SIMPLib::Constants::k_1OverPi;
+      ChunkedTextWriter::AppendFixed(out, phi1, 3);
+      out += ' ';
+      ChunkedTextWriter::AppendFixed(out, phi, 3);
+      out += ' ';
+      ChunkedTextWriter::AppendFixed(out, phi2, 3);
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, LLU_CAST(x + 1));
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, LLU_CAST(y + 1));
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, LLU_CAST(z + 1));
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, m_FeatureIds[index]);
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, m_CellPhases[index]);
+      out += '\n';
+    }
+  };
+  err = ChunkedTextWriter::Write(f, dims[0] * dims[1] * dims[2], k_LinesPerBlock, formatCells, this, "Writing Los Alamos FFT File");
+  fclose(f);
+  if(err != 0)
   {
-    for(size_t y = 0; y < dims[1]; ++y)
+    if(err < 0)
     {
-      for(size_t x = 0; x < dims[0]; ++x)
-      {
-        index = (z * dims[0] * dims[1]) + (dims[0] * y) + x;
-        phi1 = m_CellEulerAngles[index * 3] * 180.0 * SIMPLib::Constants::k_1OverPi;
-        phi = m_CellEulerAngles[index * 3 + 1] * 180.0 * SIMPLib::Constants::k_1OverPi;
-        phi2 = m_CellEulerAngles[index * 3 + 2] * 180.0 * SIMPLib::Constants::k_1OverPi;
-        featureId = m_FeatureIds[index];
-        phaseId = m_CellPhases[index];
-        fprintf(f, "%.3f %.3f %.3f %llu %llu %llu %d %d\n", phi1, phi, phi2, LLU_CAST(x + 1), LLU_CAST(y + 1), LLU_CAST(z + 1), featureId, phaseId);
-      }
+      QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+      setErrorCondition(-2, ss);
     }
+    return getErrorCode();
   }
 
-  fclose(f);
-
-  return err;
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -52,6 +52,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextReader.h"
 
 #define BUF_SIZE 1024
 
@@ -428,15 +429,15 @@ int32_t PhReader::readFile()
   m->getAttributeMatrix(getCellAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateCellInstancePointers();
 
-  for(size_t n = 0; n < totalPoints; ++n)
+  // The header has been read through m_InStream so the Feature Ids start at its current position
+  long dataOffset = std::ftell(m_InStream);
+  ChunkedTextReader textReader(getInputFile());
+  if(dataOffset < 0 || !textReader.isValid() || textReader.readValues<int32_t>(static_cast<size_t>(dataOffset), totalPoints, m_FeatureIds) != totalPoints)
   {
-    if(std::fscanf(m_InStream, "%d", m_FeatureIds + n) != 1)
-    {
-      fclose(m_InStream);
-      m_InStream = nullptr;
-      setErrorCondition(-48040, "Error reading Ph data");
-      return getErrorCode();
-    }
+    fclose(m_InStream);
+    m_InStream = nullptr;
+    setErrorCondition(-48040, "Error reading Ph data");
+    return getErrorCode();
   }
 
   // Now set the Spacing and Origin that the user provided on the GUI or as parameters
@@ -50,6 +50,12 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_LinesPerBlock = 65536;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -209,11 +215,24 @@ int32_t PhWriter::writeFile()
   outfile << "\'DREAM3\'              52.00  1.000  1.0       " << features << "\n";
   outfile << " 0.000 0.000 0.000          0        \n"; // << features << endl;
 
-  for(size_t k = 0; k < totalpoints; k++)
+  auto formatFeatureIds = [&](size_t start, size_t end, std::string& out) {
+    for(size_t k = start; k < end; k++)
+    {
+      ChunkedTextWriter::AppendInteger(out, m_FeatureIds[k]);
+      out += '\n';
+    }
+  };
+  int32_t err = ChunkedTextWriter::Write(outfile, totalpoints, k_LinesPerBlock, formatFeatureIds, this, "Writing Ph File");
+  outfile.close();
+  if(err != 0)
   {
-    outfile << m_FeatureIds[k] << '\n';
+    if(err < 0)
+    {
+      QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+      setErrorCondition(-101, ss);
+    }
+    return getErrorCode();
   }
-  outfile.close();
 
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage("Writing Ph File Complete");
@@ -35,6 +35,8 @@
 
 #include "SPParksDumpReader.h"
 
+#include <mutex>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
@@ -55,6 +57,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextReader.h"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -65,6 +68,205 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief The SPParksColumn struct is a data column of the dump file and the array it is parsed into
+ */
+struct SPParksColumn
+{
+  int64_t column = 0;
+  int32_t* int32Data = nullptr;
+  float* floatData = nullptr;
+  size_t size = 0;
+};
+
+/**
+ * @brief The SPParksLineError struct keeps the error of the first data line that could not be stored
+ */
+struct SPParksLineError
+{
+  std::mutex mutex;
+  size_t lineNum = std::numeric_limits<size_t>::max();
+  QString message;
+};
+
+/**
+ * @brief ConvertColumnToken Converts a token, accepting European style decimal commas
+ * @param first
+ * @param last
+ * @param value
+ * @return false if the token is not a number
+ */
+template <typename T>
+bool ConvertColumnToken(const char* first, const char* last, T& value)
+{
+  char buffer[64];
+  size_t length = static_cast<size_t>(last - first);
+  if(nullptr != std::memchr(first, ',', length) && length < sizeof(buffer))
+  {
+    std::replace_copy(first, last, buffer, ',', '.');
+    first = buffer;
+    last = buffer + length;
+  }
+  return ChunkedTextReader::ConvertToken<T>(first, last, value);
+}
+
+/**
+ * @brief The ParseDataLinesImpl class parses the data lines of a dump file. Every line is stored at the cell its x, y & z
+ * columns point to, so the lines are independent of each other and are parsed concurrently.
+ */
+class ParseDataLinesImpl
+{
+public:
+  ParseDataLinesImpl(ImageGeom* geom, const std::vector<SPParksColumn>& columns, int64_t xCol, int64_t yCol, int64_t zCol, int32_t oneBase, SPParksLineError& error)
+  : m_Geom(geom)
+  , m_Columns(columns)
+  , m_XCol(xCol)
+  , m_YCol(yCol)
+  , m_ZCol(zCol)
+  , m_OneBase(oneBase)
+  , m_Error(error)
+  {
+  }
+
+  void operator()(size_t n, const char* first, const char* last) const
+  {
+    // Line number within the file for error messages
+    size_t lineNum = n + 9;
+    int64_t xIdx = 0, yIdx = 0, zIdx = 0;
+    int64_t column = 0;
+    const char* token = first;
+    bool isEmpty = true;
+    while(true)
+    {
+      const char* tokenEnd = ChunkedTextReader::NextToken(token, last);
+      if(token == last)
+      {
+        break;
+      }
+      isEmpty = false;
+      if(column == m_XCol)
+      {
+        if(!ConvertColumnToken<int64_t>(token, tokenEnd, xIdx))
+        {
+          setConversionError(lineNum, column, token, tokenEnd, first, last);
+          return;
+        }
+        xIdx -= m_OneBase;
+      }
+      if(column == m_YCol)
+      {
+        if(!ConvertColumnToken<int64_t>(token, tokenEnd, yIdx))
+        {
+          setConversionError(lineNum, column, token, tokenEnd, first, last);
+          return;
+        }
+        yIdx -= m_OneBase;
+      }
+      if(column == m_ZCol)
+      {
+        if(!ConvertColumnToken<int64_t>(token, tokenEnd, zIdx))
+        {
+          setConversionError(lineNum, column, token, tokenEnd, first, last);
+          return;
+        }
+        zIdx -= m_OneBase;
+      }
+      column++;
+      token = tokenEnd;
+    }
+    if(isEmpty)
+    {
+      return;
+    }
+
+    float coords[3] = {static_cast<float>(xIdx), static_cast<float>(yIdx), static_cast<float>(zIdx)};
+    // Calculate the offset into the actual array based on the x, y & z values from the data line
+    size_t offset = std::numeric_limits<size_t>::max();
+    ImageGeom::ErrorType err = m_Geom->computeCellIndex(coords, offset);
+    if(err != ImageGeom::ErrorType::NoError)
+    {
+      QString msg;
+      QTextStream ss(&msg);
+      ss << "The calculated offset into the data array " << offset << " is larger "
+         << " than the total number of elements " << m_Geom->getNumberOfElements() << " in the array."
+         << "Line Number: " << lineNum << " Content\"" << QByteArray(first, static_cast<int>(last - first)) << "\"\n";
+      setError(lineNum, msg);
+      return;
+    }
+
+    column = 0;
+    token = first;
+    size_t found = 0;
+    while(found < m_Columns.size())
+    {
+      const char* tokenEnd = ChunkedTextReader::NextToken(token, last);
+      if(token == last)
+      {
+        break;
+      }
+      for(const SPParksColumn& dataColumn : m_Columns)
+      {
+        if(dataColumn.column != column)
+        {
+          continue;
+        }
+        found++;
+        if(offset >= dataColumn.size)
+        {
+          QString msg;
+          QTextStream ss(&msg);
+          ss << "The calculated offset into the data array " << offset << " is larger "
+             << " than the total number of elements " << dataColumn.size << " in the array."
+             << "The content of the current line is\"\n"
+             << QByteArray(first, static_cast<int>(last - first)) << "\"\n";
+          setError(lineNum, msg);
+          return;
+        }
+        bool converted = nullptr != dataColumn.int32Data ? ConvertColumnToken<int32_t>(token, tokenEnd, dataColumn.int32Data[offset])
+                                                         : ConvertColumnToken<float>(token, tokenEnd, dataColumn.floatData[offset]);
+        if(!converted)
+        {
+          setConversionError(lineNum, column, token, tokenEnd, first, last);
+          return;
+        }
+      }
+      column++;
+      token = tokenEnd;
+    }
+  }
+
+private:
+  ImageGeom* m_Geom = nullptr;
+  const std::vector<SPParksColumn>& m_Columns;
+  int64_t m_XCol = 0;
+  int64_t m_YCol = 0;
+  int64_t m_ZCol = 0;
+  int32_t m_OneBase = 0;
+  SPParksLineError& m_Error;
+
+  void setError(size_t lineNum, const QString& msg) const
+  {
+    std::lock_guard<std::mutex> lock(m_Error.mutex);
+    if(lineNum < m_Error.lineNum)
+    {
+      m_Error.lineNum = lineNum;
+      m_Error.message = msg;
+    }
+  }
+
+  void setConversionError(size_t lineNum, int64_t column, const char* token, const char* tokenEnd, const char* first, const char* last) const
+  {
+    QString msg;
+    QTextStream ss(&msg);
+    ss << "The value \"" << QByteArray(token, static_cast<int>(tokenEnd - token)) << "\" in column " << column << " could not be converted to a number. "
+       << "Line Number: " << lineNum << " Content\"" << QByteArray(first, static_cast<int>(last - first)) << "\"\n";
+    setError(lineNum, msg);
+  }
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -457,6 +659,7 @@ int32_t SPParksDumpReader::readFile()
   int64_t zCol = 0;
   qint32 size = tokens.size();
   bool didAllocate = false;
+  std::vector<SPParksColumn> columns;
   for(qint32 i = 2; i < size; ++i)
   {
     QString name = QString::fromLatin1(tokens[i]);
@@ -491,6 +694,11 @@ int32_t SPParksDumpReader::readFile()
       {
         ::memset(dparser->getVoidPointer(), 0xAB, sizeof(int32_t) * totalPoints);
         m_NamePointerMap.insert(name, dparser);
+        SPParksColumn dataColumn;
+        dataColumn.column = i - 2;
+        dataColumn.int32Data = static_cast<int32_t*>(dparser->getVoidPointer());
+        dataColumn.size = totalPoints;
+        columns.push_back(dataColumn);
       }
     }
     else if(SIMPL::NumericTypes::Type::Float == pType)
@@ -500,6 +708,11 @@ int32_t SPParksDumpReader::readFile()
       {
         ::memset(dparser->getVoidPointer(), 0xAB, sizeof(float) * totalPoints);
         m_NamePointerMap.insert(name, dparser);
+        SPParksColumn dataColumn;
+        dataColumn.column = i - 2;
+        dataColumn.floatData = static_cast<float*>(dparser->getVoidPointer());
+        dataColumn.size = totalPoints;
+        columns.push_back(dataColumn);
       }
     }
     else
@@ -517,26 +730,21 @@ int32_t SPParksDumpReader::readFile()
     }
   }
 
-  // Now loop over all the points in the file. This could get REALLY slow if the file gets large.
-  // Thank goodness we all like to save text files
-  for(size_t n = 0; n < totalPoints; ++n)
+  // Now parse all the data lines. They are independent of each other so they are parsed in parallel straight from
+  // the mapped file, starting right after the column header line.
+  ChunkedTextReader textReader(getInputFile());
+  if(!textReader.isValid())
   {
-    buf = m_InStream.readLine(); // Read the line into a QByteArray including the newline
-    buf = buf.trimmed();         // Remove leading and trailing whitespace
-
-    if(m_InStream.atEnd() && buf.isEmpty()) // We have to have read to the end of the file AND the buffer is empty
-    {
-      // otherwise we read EXACTLY the last line and we still need to parse the line.
-      break;
-    }
-    parseDataLine(buf, tDims, xCol, yCol, zCol, n + 9);
-    if(getErrorCode() < 0)
-    {
-      break;
-    }
+    QString msg = QObject::tr("Error opening input file '%1'").arg(getInputFile());
+    setErrorCondition(-100, msg);
+    return getErrorCode();
   }
-  if(getErrorCode() < 0)
+  int32_t oneBase = getOneBasedArrays() ? 1 : 0;
+  SPParksLineError lineError;
+  textReader.forEachLine(static_cast<size_t>(m_InStream.pos()), totalPoints, ParseDataLinesImpl(m_CachedGeometry, columns, xCol, yCol, zCol, oneBase, lineError));
+  if(lineError.lineNum != std::numeric_limits<size_t>::max())
   {
+    setErrorCondition(-48100, lineError.message);
     return getErrorCode();
   }
 
@@ -563,80 +771,6 @@ int32_t SPParksDumpReader::readFile()
   return 0;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SPParksDumpReader::parseDataLine(QByteArray& line, std::vector<size_t> dims, int64_t xCol, int64_t yCol, int64_t zCol, size_t lineNum)
-{
-  // Filter the line to convert European command style decimals to US/UK style points
-  for(qint32 c = 0; c < line.size(); ++c)
-  {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
-  }
-
-  int64_t xIdx = 0, yIdx = 0, zIdx = 0;
-  bool ok = false;
-  QList<QByteArray> tokens = line.split(' ');
-
-  int32_t oneBase = 0;
-  if(getOneBasedArrays())
-  {
-    oneBase = 1;
-  }
-
-  xIdx = tokens[xCol].toInt(&ok) - oneBase;
-  yIdx = tokens[yCol].toInt(&ok) - oneBase;
-  zIdx = tokens[zCol].toInt(&ok) - oneBase;
-
-  float coords[3] = {static_cast<float>(xIdx), static_cast<float>(yIdx), static_cast<float>(zIdx)};
-  // Calculate the offset into the actual array based on the x, y & z values from the data line we just read
-  // size_t offset = static_cast<size_t>((dims[1] * dims[0] * zIdx) + (dims[0] * yIdx) + xIdx);
-  size_t offset = std::numeric_limits<size_t>::max();
-  ImageGeom::ErrorType err = m_CachedGeometry->computeCellIndex(coords, offset);
-  if(err != ImageGeom::ErrorType::NoError)
-  {
-    QString msg;
-    QTextStream ss(&msg);
-    ss << "The calculated offset into the data array " << offset << " is larger "
-       << " than the total number of elements " << m_CachedGeometry->getNumberOfElements() << " in the array."
-       << "Line Number: " << lineNum << " Content\"" << line << "\"\n";
-    setErrorCondition(-48100, msg);
-    return;
-  }
-
-  QMapIterator<QString, GenericDataParser::Pointer> iter(m_NamePointerMap);
-  while(iter.hasNext())
-  {
-    iter.next();
-    GenericDataParser::Pointer dparser = iter.value();
-    // Make sure we dont' parse the x, y, z or id columns since they are pretty much useless data. At some point
-    // if the SPParks users actually wanted to read in the matching XYZ lattice site for the data then actually
-    // parsing and storing the data _may_ be of interest to them
-    if(dparser->getColumnName() == "x" || dparser->getColumnName() == "y" || dparser->getColumnName() == "z" || dparser->getColumnName() == "id")
-    {
-      continue;
-    }
-    if(offset < dparser->getSize())
-    {
-      dparser->parse(tokens[dparser->getColumnIndex()], offset);
-    }
-    else
-    {
-      QString msg;
-      QTextStream ss(&msg);
-      ss << "The calculated offset into the data array " << offset << " is larger "
-         << " than the total number of elements " << dparser->getSize() << " in the array."
-         << "The content of the current line is\"\n"
-         << line << "\"\n";
-      setErrorCondition(-48100, msg);
-      return;
-    }
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
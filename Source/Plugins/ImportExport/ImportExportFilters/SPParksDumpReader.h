@@ -284,17 +284,6 @@ protected:
    */
   int32_t getTypeSize(const QString& featureName);
 
-  /**
-   * @brief parseDataLine Reads a line of data from the .dump file
-   * @param line Line of data to read
-   * @param dims Dimensional offset
-   * @param xCol X coordinate
-   * @param yCol Y coordinate
-   * @param zCol Z coordinate
-   * @param lineNum
-   */
-  void parseDataLine(QByteArray& line, std::vector<size_t> dims, int64_t xCol, int64_t yCol, int64_t zCol, size_t lineNum);
-
 private:
   DataArrayPath m_VolumeDataContainerName = {};
   QString m_CellAttributeMatrixName = {};
@@ -35,7 +35,6 @@
 #include "SPParksSitesWriter.h"
 #include <fstream>
 
-#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -47,10 +46,15 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
-#include "SIMPLib/Utilities/TimeUtilities.h"
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+namespace
+{
+constexpr size_t k_LinesPerBlock = 65536;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -197,45 +201,26 @@ int32_t SPParksSitesWriter::writeFile()
     return getErrorCode();
   }
 
-  qint64 millis = QDateTime::currentMSecsSinceEpoch();
-  qint64 currentMillis = millis;
-  qint64 startMillis = millis;
-  qint64 estimatedTime = 0;
-  float timeDiff = 0.0f;
-
-  int64_t increment = static_cast<int64_t>(totalpoints * 0.01f);
-  size_t count = 0;
-  QString buf;
-  QTextStream ss(&buf);
-  // Buffer the output with 4096 Bytes which is typically the size of a "Block" on a
-  // modern Hard Drive. This should speed up the writes considerably
-  char buffer[4096];
-  outfile.rdbuf()->pubsetbuf(buffer, 4096);
-  for(size_t k = 0; k < totalpoints; k++)
+  auto formatSites = [&](size_t start, size_t end, std::string& out) {
+    for(size_t k = start; k < end; k++)
+    {
+      ChunkedTextWriter::AppendInteger(out, k + 1);
+      out += ' ';
+      ChunkedTextWriter::AppendInteger(out, m_FeatureIds[k]);
+      out += '\n';
+    }
+  };
+  int32_t err = ChunkedTextWriter::Write(outfile, totalpoints, k_LinesPerBlock, formatSites, this, "Writing SPParks Sites File");
+  outfile.close();
+  if(err != 0)
   {
-    if(count % increment == 0)
+    if(err < 0)
     {
-      currentMillis = QDateTime::currentMSecsSinceEpoch();
-      if(currentMillis - millis > 1000)
-      {
-        buf.clear();
-        ss << static_cast<int>((float)(k) / (float)(totalpoints)*100) << " % Completed ";
-        timeDiff = ((float)k / (float)(currentMillis - startMillis));
-        estimatedTime = (float)(totalpoints - k) / timeDiff;
-        ss << " || Est. Time Remain: " << DREAM3D::convertMillisToHrsMinSecs(estimatedTime);
-        notifyStatusMessage(buf);
-        millis = QDateTime::currentMSecsSinceEpoch();
-      }
+      QString ss = QObject::tr("Error writing output file '%1'").arg(getOutputFile());
+      setErrorCondition(-101, ss);
     }
-    count++;
-    //    double temp0 = 0.0;
-    //    double temp1 = 0.0;
-    outfile << k + 1 << " "
-            << m_FeatureIds[k]
-            /* << " " << temp0 << " " << temp1 */
-            << "\n";
+    return getErrorCode();
   }
-  outfile.close();
 
   return 0;
 }
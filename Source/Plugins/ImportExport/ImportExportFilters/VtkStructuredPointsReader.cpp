@@ -53,6 +53,7 @@
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
+#include "ImportExport/ImportExportFilters/util/ChunkedTextReader.h"
 
 #define vtkErrorMacro(msg) std::cout msg
 
@@ -301,7 +302,7 @@ size_t VtkStructuredPointsReader::parseByteSize(QString text)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> int32_t skipVolume(std::istream& in, bool binary, size_t totalSize)
+template <typename T> int32_t skipVolume(std::istream& in, bool binary, size_t totalSize, const ChunkedTextReader* textReader)
 {
   int32_t err = 0;
   if(binary)
@@ -318,11 +319,14 @@ template <typename T> int32_t skipVolume(std::istream& in, bool binary, size_t t
   }
   else
   {
-    T tmp;
-    for(size_t z = 0; z < totalSize; ++z)
+    // Find the end of the values in the mapped file and continue reading the stream from there
+    std::streamoff offset = in.tellg();
+    size_t endOffset = 0;
+    if(nullptr == textReader || offset < 0 || textReader->skipValues(static_cast<size_t>(offset), totalSize, &endOffset) != totalSize)
     {
-      in >> tmp;
+      return -1;
     }
+    in.seekg(static_cast<std::streamoff>(endOffset));
   }
   return err;
 }
@@ -400,7 +404,7 @@ template <typename T> int32_t vtkReadBinaryData(std::istream& in, T* data, int32
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, std::istream& in, bool inPreflight, bool binary, const QString& scalarName, int32_t scalarNumComp)
+template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, std::istream& in, bool inPreflight, bool binary, const QString& scalarName, int32_t scalarNumComp, const ChunkedTextReader* textReader)
 {
   size_t numTuples = attrMat->getNumberOfTuples();
 
@@ -412,7 +416,7 @@ template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, st
   attrMat->insertOrAssign(data);
   if(inPreflight)
   {
-    return skipVolume<T>(in, binary, numTuples * scalarNumComp);
+    return skipVolume<T>(in, binary, numTuples * scalarNumComp, textReader);
   }
 
   if(binary)
@@ -430,13 +434,15 @@ template <typename T> int32_t readDataChunk(AttributeMatrix::Pointer attrMat, st
   }
   else
   {
-    T value = static_cast<T>(0.0);
+    // Convert the values straight out of the mapped file and continue reading the stream after them
     size_t totalSize = numTuples * scalarNumComp;
-    for(size_t i = 0; i < totalSize; ++i)
+    std::streamoff offset = in.tellg();
+    size_t endOffset = 0;
+    if(nullptr == textReader || offset < 0 || textReader->readValues<T>(static_cast<size_t>(offset), totalSize, data->getPointer(0), &endOffset) != totalSize)
     {
-      in >> value;
-      data->setValue(i, value);
+      return -12022;
     }
+    in.seekg(static_cast<std::streamoff>(endOffset));
   }
 
   return 0;
@@ -600,6 +606,12 @@ int32_t VtkStructuredPointsReader::readFile()
   volDc->getGeometryAs<ImageGeom>()->setOrigin(origin);
   vertDc->getGeometryAs<ImageGeom>()->setOrigin(origin);
 
+  // ASCII values are parsed from a mapped view of the file instead of through the stream
+  if(!getFileIsBinary())
+  {
+    m_TextReader = std::make_shared<ChunkedTextReader>(getInputFile());
+  }
+
   // Read the first key word which should be POINT_DATA or CELL_DATA
   err = readLine(in, buffer, kBufferSize); // Read Line 6 which is the first type of data we are going to read
 
@@ -616,6 +628,7 @@ int32_t VtkStructuredPointsReader::readFile()
     if(m_CurrentAttrMat->getNumberOfTuples() != ncells)
     {
       setErrorCondition(-61006, QString("Number of cells does not match number of tuples in the Attribute Matrix"));
+      m_TextReader.reset();
       return getErrorCode();
     }
     this->readDataTypeSection(in, ncells, "point_data");
@@ -628,6 +641,7 @@ int32_t VtkStructuredPointsReader::readFile()
     if(m_CurrentAttrMat->getNumberOfTuples() != npts)
     {
       setErrorCondition(-61007, QString("Number of points does not match number of tuples in the Attribute Matrix"));
+      m_TextReader.reset();
       return getErrorCode();
     }
     this->readDataTypeSection(in, numPts, "cell_data");
@@ -635,6 +649,7 @@ int32_t VtkStructuredPointsReader::readFile()
 
   // Close the file since we are done with it.
   in.close();
+  m_TextReader.reset();
 
   return err;
 }
@@ -890,43 +905,49 @@ int32_t VtkStructuredPointsReader::readScalarData(std::istream& in, int32_t numP
   // Read the data
   if(scalarType.compare("unsigned_char") == 0)
   {
-    err = readDataChunk<uint8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("char") == 0)
   {
-    err = readDataChunk<int8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int8_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("unsigned_short") == 0)
   {
-    err = readDataChunk<uint16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("short") == 0)
   {
-    err = readDataChunk<int16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int16_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("unsigned_int") == 0)
   {
-    err = readDataChunk<uint32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("int") == 0)
   {
-    err = readDataChunk<int32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int32_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("unsigned_long") == 0)
   {
-    err = readDataChunk<int64_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<int64_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("long") == 0)
   {
-    err = readDataChunk<uint64_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<uint64_t>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("float") == 0)
   {
-    err = readDataChunk<float>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<float>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
   }
   else if(scalarType.compare("double") == 0)
   {
-    err = readDataChunk<double>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp);
+    err = readDataChunk<double>(m_CurrentAttrMat, in, getInPreflight(), getFileIsBinary(), name, numComp, m_TextReader.get());
+  }
+
+  if(err < 0 && !getFileIsBinary())
+  {
+    QString ss = QObject::tr("Error reading the ASCII values of the '%1' array. %2 values of type '%3' are needed").arg(name).arg(m_CurrentAttrMat->getNumberOfTuples() * numComp).arg(scalarType);
+    setErrorCondition(-61012, ss);
   }
 
   return err;
@@ -47,6 +47,8 @@
 
 #include "ImportExport/ImportExportDLLExport.h"
 
+class ChunkedTextReader;
+
 /**
  * @brief The VtkStructuredPointsReader class. See [Filter documentation](@ref vtkstructuredpointsreader) for details.
  */
@@ -382,6 +384,7 @@ private:
   bool m_FileIsBinary = {};
 
   AttributeMatrix::Pointer m_CurrentAttrMat;
+  std::shared_ptr<ChunkedTextReader> m_TextReader;
 
 public:
   VtkStructuredPointsReader(const VtkStructuredPointsReader&) = delete;            // Copy Constructor Not Implemented
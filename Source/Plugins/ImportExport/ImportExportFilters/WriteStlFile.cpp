@@ -34,6 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "WriteStlFile.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -46,12 +51,157 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include <QtCore/QDir>
 
 #include "ImportExport/ImportExportConstants.h"
 #include "ImportExport/ImportExportVersion.h"
 
+namespace
+{
+constexpr int64_t k_MaxDenseLabelRange = 1 << 20;
+constexpr int32_t k_WriteError = -1201;
+constexpr int32_t k_OpenError = -1202;
+constexpr size_t k_HeaderSize = 80;
+constexpr size_t k_RecordSize = 50;
+} // namespace
+
+/**
+ * @brief The WriteStlFilesImpl class writes the binary STL files of a range of Features. Each file is assembled
+ * in memory from the Feature's triangle bucket and written with a single call.
+ */
+class WriteStlFilesImpl
+{
+public:
+  WriteStlFilesImpl(const QString& filePrefix, bool groupByPhase, float* nodes, MeshIndexType* triangles, int32_t* faceLabels, const std::vector<int32_t>& grainIds,
+                    const std::vector<int32_t>& grainPhases, const std::vector<MeshIndexType>& bucketOffsets, const std::vector<MeshIndexType>& bucketTriangles, std::vector<int32_t>& errors)
+  : m_FilePrefix(filePrefix)
+  , m_GroupByPhase(groupByPhase)
+  , m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_GrainIds(grainIds)
+  , m_GrainPhases(grainPhases)
+  , m_BucketOffsets(bucketOffsets)
+  , m_BucketTriangles(bucketTriangles)
+  , m_Errors(errors)
+  {
+  }
+
+  void writeFeature(size_t slot) const
+  {
+    int32_t spin = m_GrainIds[slot];
+
+    // Generate the output file name
+    QString filename = m_FilePrefix;
+    if(m_GroupByPhase)
+    {
+      filename = filename + QString("Ensemble_") + QString::number(m_GrainPhases[slot]) + QString("_");
+    }
+    filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
+
+    QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
+    if(m_GroupByPhase)
+    {
+      header = header + " Phase " + QString::number(m_GrainPhases[slot]);
+    }
+
+    const MeshIndexType start = m_BucketOffsets[slot];
+    const MeshIndexType end = m_BucketOffsets[slot + 1];
+    const int32_t triCount = static_cast<int32_t>(end - start);
+    std::vector<unsigned char> buffer(k_HeaderSize + sizeof(int32_t) + k_RecordSize * (end - start), 0);
+    std::string c_str = header.toStdString();
+    ::memcpy(buffer.data(), c_str.data(), std::min(k_HeaderSize, c_str.size()));
+    ::memcpy(buffer.data() + k_HeaderSize, &triCount, sizeof(int32_t));
+
+    unsigned char* data = buffer.data() + k_HeaderSize + sizeof(int32_t);
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float vert1[3] = {0.0f, 0.0f, 0.0f};
+    float vert2[3] = {0.0f, 0.0f, 0.0f};
+    float vert3[3] = {0.0f, 0.0f, 0.0f};
+    float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
+    for(MeshIndexType b = start; b < end; b++, data += k_RecordSize)
+    {
+      MeshIndexType t = m_BucketTriangles[b];
+
+      // Get the true indices of the 3 nodes
+      MeshIndexType nId0 = m_Triangles[t * 3];
+      MeshIndexType nId1 = m_Triangles[t * 3 + 1];
+      MeshIndexType nId2 = m_Triangles[t * 3 + 2];
+      if(m_FaceLabels[t * 2] != spin)
+      {
+        // Write it using backward spin
+        std::swap(nId1, nId2);
+      }
+
+      for(size_t c = 0; c < 3; c++)
+      {
+        vert1[c] = m_Nodes[nId0 * 3 + c];
+        vert2[c] = m_Nodes[nId1 * 3 + c];
+        vert3[c] = m_Nodes[nId2 * 3 + c];
+      }
+
+      // Compute the normal
+      u[0] = vert2[0] - vert1[0];
+      u[1] = vert2[1] - vert1[1];
+      u[2] = vert2[2] - vert1[2];
+
+      w[0] = vert3[0] - vert1[0];
+      w[1] = vert3[1] - vert1[1];
+      w[2] = vert3[2] - vert1[2];
+
+      normal[0] = u[1] * w[2] - u[2] * w[1];
+      normal[1] = u[2] * w[0] - u[0] * w[2];
+      normal[2] = u[0] * w[1] - u[1] * w[0];
+
+      float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      normal[0] = normal[0] / length;
+      normal[1] = normal[1] / length;
+      normal[2] = normal[2] / length;
+
+      // The 2 attribute bytes stay zero
+      ::memcpy(data, normal, 12);
+      ::memcpy(data + 12, vert1, 12);
+      ::memcpy(data + 24, vert2, 12);
+      ::memcpy(data + 36, vert3, 12);
+    }
+
+    FILE* f = fopen(filename.toLatin1().data(), "wb");
+    if(nullptr == f)
+    {
+      m_Errors[slot] = k_OpenError;
+      return;
+    }
+    size_t totalWritten = fwrite(buffer.data(), 1, buffer.size(), f);
+    fclose(f);
+    if(totalWritten != buffer.size())
+    {
+      m_Errors[slot] = k_WriteError;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slot = range.min(); slot < range.max(); slot++)
+    {
+      writeFeature(slot);
+    }
+  }
+
+private:
+  QString m_FilePrefix;
+  bool m_GroupByPhase = false;
+  float* m_Nodes = nullptr;
+  MeshIndexType* m_Triangles = nullptr;
+  int32_t* m_FaceLabels = nullptr;
+  const std::vector<int32_t>& m_GrainIds;
+  const std::vector<int32_t>& m_GrainPhases;
+  const std::vector<MeshIndexType>& m_BucketOffsets;
+  const std::vector<MeshIndexType>& m_BucketTriangles;
+  std::vector<int32_t>& m_Errors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -191,7 +341,6 @@ void WriteStlFile::dataCheck()
 // -----------------------------------------------------------------------------
 void WriteStlFile::execute()
 {
-  int32_t err = 0;
   clearErrorCode();
   clearWarningCode();
   dataCheck();
@@ -222,178 +371,124 @@ void WriteStlFile::execute()
     return;
   }
 
-  // Store all the unique Spins
-  QMap<int32_t, int32_t> uniqueGrainIdtoPhase;
-  if(m_GroupByPhase)
+  // Find the unique Feature Ids in increasing order. Feature Ids are normally a compact range, which is looked up
+  // directly; anything else falls back to a sorted list
+  int32_t minLabel = std::numeric_limits<int32_t>::max();
+  int32_t maxLabel = std::numeric_limits<int32_t>::lowest();
+  for(MeshIndexType i = 0; i < nTriangles * 2; i++)
+  {
+    minLabel = std::min(minLabel, m_SurfaceMeshFaceLabels[i]);
+    maxLabel = std::max(maxLabel, m_SurfaceMeshFaceLabels[i]);
+  }
+  std::vector<int32_t> grainIds;
+  std::vector<size_t> grainSlots;
+  bool denseLabels = nTriangles > 0 && (static_cast<int64_t>(maxLabel) - minLabel) <= std::max<int64_t>(static_cast<int64_t>(nTriangles) * 2, k_MaxDenseLabelRange);
+  if(denseLabels)
   {
-    for(MeshIndexType i = 0; i < nTriangles; i++)
+    grainSlots.assign(static_cast<size_t>(static_cast<int64_t>(maxLabel) - minLabel + 1), 0);
+    for(MeshIndexType i = 0; i < nTriangles * 2; i++)
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], m_SurfaceMeshFacePhases[i * 2]);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], m_SurfaceMeshFacePhases[i * 2 + 1]);
+      grainSlots[m_SurfaceMeshFaceLabels[i] - minLabel] = 1;
+    }
+    for(size_t l = 0; l < grainSlots.size(); l++)
+    {
+      if(grainSlots[l] != 0)
+      {
+        grainSlots[l] = grainIds.size();
+        grainIds.push_back(static_cast<int32_t>(minLabel + static_cast<int64_t>(l)));
+      }
     }
   }
   else
   {
-    for(MeshIndexType i = 0; i < nTriangles; i++)
+    grainIds.assign(m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceLabels + nTriangles * 2);
+    std::sort(grainIds.begin(), grainIds.end());
+    grainIds.erase(std::unique(grainIds.begin(), grainIds.end()), grainIds.end());
+  }
+  auto slotOf = [&](int32_t label) -> size_t {
+    if(denseLabels)
     {
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2], 0);
-      uniqueGrainIdtoPhase.insert(m_SurfaceMeshFaceLabels[i * 2 + 1], 0);
+      return grainSlots[label - minLabel];
     }
-  }
-
-  unsigned char data[50];
-  float* normal = reinterpret_cast<float*>(data);
-  float* vert1 = reinterpret_cast<float*>(data + 12);
-  float* vert2 = reinterpret_cast<float*>(data + 24);
-  float* vert3 = reinterpret_cast<float*>(data + 36);
-  uint16_t* attrByteCount = reinterpret_cast<uint16_t*>(data + 48);
-  *attrByteCount = 0;
-
-  size_t totalWritten = 0;
-  float u[3] = {0.0f, 0.0f, 0.0f}, w[3] = {0.0f, 0.0f, 0.0f};
-  float length = 0.0f;
-
-  int32_t spin = 0;
-  int32_t triCount = 0;
+    return static_cast<size_t>(std::lower_bound(grainIds.begin(), grainIds.end(), label) - grainIds.begin());
+  };
 
-  // Loop over the unique Spins
-  for(QMap<int32_t, int32_t>::iterator spinIter = uniqueGrainIdtoPhase.begin(); spinIter != uniqueGrainIdtoPhase.end(); ++spinIter)
+  // Each Feature is labeled with the phase of the last triangle that references it
+  std::vector<int32_t> grainPhases(grainIds.size(), 0);
+  if(m_GroupByPhase)
   {
-    spin = spinIter.key();
-
-    // Generate the output file name
-    QString filename = getOutputStlDirectory() + "/" + getOutputStlPrefix();
-    if(m_GroupByPhase)
+    for(MeshIndexType i = 0; i < nTriangles * 2; i++)
     {
-      filename = filename + QString("Ensemble_") + QString::number(spinIter.value()) + QString("_");
+      grainPhases[slotOf(m_SurfaceMeshFaceLabels[i])] = m_SurfaceMeshFacePhases[i];
     }
-    filename = filename + QString("Feature_") + QString::number(spin) + ".stl";
-    FILE* f = fopen(filename.toLatin1().data(), "wb");
-
-      QString ss = QObject::tr("Writing STL for Feature Id %1").arg(spin);
-      notifyStatusMessage(ss);
+  }
 
-    QString header = "DREAM3D Generated For Feature ID " + QString::number(spin);
-    if(m_GroupByPhase)
+  // Bucket the triangles by Feature in a single pass; each bucket stays in triangle order
+  std::vector<MeshIndexType> bucketOffsets(grainIds.size() + 1, 0);
+  for(MeshIndexType t = 0; t < nTriangles; t++)
+  {
+    int32_t g1 = m_SurfaceMeshFaceLabels[t * 2];
+    int32_t g2 = m_SurfaceMeshFaceLabels[t * 2 + 1];
+    bucketOffsets[slotOf(g1) + 1]++;
+    if(g2 != g1)
     {
-      header = header + " Phase " + QString::number(spinIter.value());
+      bucketOffsets[slotOf(g2) + 1]++;
     }
-    err = writeHeader(f, header, 0);
-    if(err < 0)
+  }
+  for(size_t g = 1; g < bucketOffsets.size(); g++)
+  {
+    bucketOffsets[g] += bucketOffsets[g - 1];
+  }
+  std::vector<MeshIndexType> bucketTriangles(bucketOffsets.back());
+  {
+    std::vector<MeshIndexType> bucketFill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for(MeshIndexType t = 0; t < nTriangles; t++)
     {
+      int32_t g1 = m_SurfaceMeshFaceLabels[t * 2];
+      int32_t g2 = m_SurfaceMeshFaceLabels[t * 2 + 1];
+      bucketTriangles[bucketFill[slotOf(g1)]++] = t;
+      if(g2 != g1)
+      {
+        bucketTriangles[bucketFill[slotOf(g2)]++] = t;
+      }
     }
-    triCount = 0; // Reset this to Zero. Increment for every triangle written
+  }
 
-    // Loop over all the triangles for this spin
-    for(MeshIndexType t = 0; t < nTriangles; ++t)
+  // Write the Feature files a batch at a time so progress and cancel requests are serviced
+  std::vector<int32_t> errors(grainIds.size(), 0);
+  WriteStlFilesImpl impl(getOutputStlDirectory() + "/" + getOutputStlPrefix(), m_GroupByPhase, nodes, triangles, m_SurfaceMeshFaceLabels, grainIds, grainPhases, bucketOffsets, bucketTriangles, errors);
+  const size_t batchSize = std::max<size_t>(16, 4 * static_cast<size_t>(std::thread::hardware_concurrency()));
+  for(size_t batchStart = 0; batchStart < grainIds.size(); batchStart += batchSize)
+  {
+    if(getCancel())
     {
-      // Get the true indices of the 3 nodes
-      MeshIndexType nId0 = triangles[t * 3];
-      MeshIndexType nId1 = triangles[t * 3 + 1];
-      MeshIndexType nId2 = triangles[t * 3 + 2];
+      return;
+    }
+    size_t batchEnd = std::min(batchStart + batchSize, grainIds.size());
+    QString ss = QObject::tr("Writing STL for Feature Id %1").arg(grainIds[batchStart]);
+    notifyStatusMessage(ss);
 
-      vert1[0] = static_cast<float>(nodes[nId0 * 3]);
-      vert1[1] = static_cast<float>(nodes[nId0 * 3 + 1]);
-      vert1[2] = static_cast<float>(nodes[nId0 * 3 + 2]);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(batchStart, batchEnd);
+    dataAlg.setGrain(1);
+    dataAlg.execute(impl);
 
-      if(m_SurfaceMeshFaceLabels[t * 2] == spin)
-      {
-        // winding = 0; // 0 = Write it using forward spin
-      }
-      else if(m_SurfaceMeshFaceLabels[t * 2 + 1] == spin)
-      {
-        // winding = 1; // Write it using backward spin
-        // Switch the 2 node indices
-        MeshIndexType temp = nId1;
-        nId1 = nId2;
-        nId2 = temp;
-      }
-      else
+    for(size_t g = batchStart; g < batchEnd; g++)
+    {
+      if(errors[g] == k_OpenError)
       {
-        continue; // We do not match either spin so move to the next triangle
+        QString ss = QObject::tr("Error opening STL File for Feature Id %1.").arg(grainIds[g]);
+        setErrorCondition(k_OpenError, ss);
+        return;
       }
-
-      vert2[0] = static_cast<float>(nodes[nId1 * 3]);
-      vert2[1] = static_cast<float>(nodes[nId1 * 3 + 1]);
-      vert2[2] = static_cast<float>(nodes[nId1 * 3 + 2]);
-
-      vert3[0] = static_cast<float>(nodes[nId2 * 3]);
-      vert3[1] = static_cast<float>(nodes[nId2 * 3 + 1]);
-      vert3[2] = static_cast<float>(nodes[nId2 * 3 + 2]);
-
-      // Compute the normal
-      u[0] = vert2[0] - vert1[0];
-      u[1] = vert2[1] - vert1[1];
-      u[2] = vert2[2] - vert1[2];
-
-      w[0] = vert3[0] - vert1[0];
-      w[1] = vert3[1] - vert1[1];
-      w[2] = vert3[2] - vert1[2];
-
-      normal[0] = u[1] * w[2] - u[2] * w[1];
-      normal[1] = u[2] * w[0] - u[0] * w[2];
-      normal[2] = u[0] * w[1] - u[1] * w[0];
-
-      length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-      normal[0] = normal[0] / length;
-      normal[1] = normal[1] / length;
-      normal[2] = normal[2] / length;
-
-      totalWritten = fwrite(data, 1, 50, f);
-      if(totalWritten != 50)
+      if(errors[g] == k_WriteError)
       {
-        QString ss = QObject::tr("Error Writing STL File. Not enough elements written for Feature Id %1. Wrote %2 of 50.").arg(spin).arg(totalWritten);
-        setErrorCondition(-1201, ss);
+        QString ss = QObject::tr("Error Writing STL File. Not enough bytes written for Feature Id %1.").arg(grainIds[g]);
+        setErrorCondition(k_WriteError, ss);
+        return;
       }
-      triCount++;
     }
-    fclose(f);
-    err = writeNumTrianglesToFile(filename, triCount);
   }
-
-  clearErrorCode();
-  clearWarningCode();
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeHeader(FILE* f, const QString& header, int32_t triCount)
-{
-  if(nullptr == f)
-  {
-    return -1;
-  }
-  char h[80];
-  size_t headlength = 80;
-  if(header.length() < 80)
-  {
-    headlength = static_cast<size_t>(header.length());
-  }
-
-  std::string c_str = header.toStdString();
-  ::memset(h, 0, 80);
-  ::memcpy(h, c_str.data(), headlength);
-  // Return the number of bytes written - which should be 80
-  fwrite(h, 1, 80, f);
-  fwrite(&triCount, 1, 4, f);
-  return 0;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int32_t WriteStlFile::writeNumTrianglesToFile(const QString& filename, int32_t triCount)
-{
-  // We need to update the number of triangles in the file
-  int32_t err = 0;
-
-  FILE* out = fopen(filename.toLatin1().data(), "r+b");
-  fseek(out, 80L, SEEK_SET);
-  fwrite(reinterpret_cast<char*>(&triCount), 1, 4, out);
-  fclose(out);
-
-  return err;
 }
 
 // -----------------------------------------------------------------------------
@@ -245,23 +245,6 @@ private:
   DataArrayPath m_SurfaceMeshFaceLabelsArrayPath = {};
   DataArrayPath m_SurfaceMeshFacePhasesArrayPath = {};
 
-  /**
-   * @brief writeHeader Writes the header of the STL file
-   * @param f File instance pointer
-   * @param header Header to write to file
-   * @param triCount Number of triangles
-   * @return Integer error value
-   */
-  int32_t writeHeader(FILE* f, const QString& header, int32_t triCount);
-
-  /**
-   * @brief writeNumTrianglesToFile Writes the number of triangles to the STL file
-   * @param filename Name of the output file
-   * @param triCount Number of triangles
-   * @return Integer error value
-   */
-  int32_t writeNumTrianglesToFile(const QString& filename, int32_t triCount);
-
 public:
   WriteStlFile(const WriteStlFile&) = delete;            // Copy Constructor Not Implemented
   WriteStlFile(WriteStlFile&&) = delete;                 // Move Constructor Not Implemented
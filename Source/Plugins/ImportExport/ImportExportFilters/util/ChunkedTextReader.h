@@ -0,0 +1,646 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The ChunkedTextReader class parses large whitespace separated ASCII files. The file is memory mapped
+ * (or read into memory if it can not be mapped) and split into chunks that each start at the beginning of a line.
+ * The tokens or lines of each chunk are counted in parallel, a prefix sum over the counts gives every chunk the
+ * index of its first value and the chunks are then converted in parallel with std::from_chars, so each value ends
+ * up at the same index it would get from reading the file front to back.
+ *
+ * The file is processed in windows of a few chunks per thread so that a section of values that is followed by more
+ * data (another array, a footer) does not cause the rest of the file to be scanned.
+ */
+class ChunkedTextReader
+{
+public:
+  explicit ChunkedTextReader(const QString& filePath)
+  : m_File(filePath)
+  {
+    if(!m_File.open(QIODevice::ReadOnly))
+    {
+      return;
+    }
+    m_Size = static_cast<size_t>(m_File.size());
+    if(m_Size > 0)
+    {
+      m_Data = reinterpret_cast<const char*>(m_File.map(0, m_File.size()));
+    }
+    if(nullptr == m_Data && m_Size > 0)
+    {
+      // Some file systems can not be mapped; parsing from a copy in memory works the same way
+      m_Buffer = m_File.readAll();
+      m_Data = m_Buffer.constData();
+      m_Size = static_cast<size_t>(m_Buffer.size());
+    }
+    m_IsValid = true;
+  }
+
+  ~ChunkedTextReader() = default;
+
+  ChunkedTextReader(const ChunkedTextReader&) = delete;            // Copy Constructor Not Implemented
+  ChunkedTextReader(ChunkedTextReader&&) = delete;                 // Move Constructor Not Implemented
+  ChunkedTextReader& operator=(const ChunkedTextReader&) = delete; // Copy Assignment Not Implemented
+  ChunkedTextReader& operator=(ChunkedTextReader&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief isValid Returns whether the file could be opened
+   * @return
+   */
+  bool isValid() const
+  {
+    return m_IsValid;
+  }
+
+  /**
+   * @brief size Returns the size of the file in bytes
+   * @return
+   */
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  /**
+   * @brief readValues Converts up to count numeric values starting at the byte offset. Reading stops early at the
+   * first token that does not look like a number, such as the keyword that starts the next section of the file.
+   * @param offset Byte offset of the first value. It should be the start of a line.
+   * @param count Maximum number of values to convert
+   * @param sink Functor called as sink(size_t index, T value) for every value. It is called concurrently.
+   * @param endOffset If not nullptr, receives the byte offset just past the last value that was converted
+   * @return The number of values that were converted. This is less than count if the values ran out or a value
+   * could not be converted into a T.
+   */
+  template <typename T, typename Sink>
+  size_t readValues(size_t offset, size_t count, const Sink& sink, size_t* endOffset = nullptr) const
+  {
+    return scanValues<T, Sink>(offset, count, &sink, endOffset);
+  }
+
+  /**
+   * @brief readValues Converts up to count numeric values starting at the byte offset into destination
+   * @param offset
+   * @param count
+   * @param destination
+   * @param endOffset
+   * @return
+   */
+  template <typename T>
+  size_t readValues(size_t offset, size_t count, T* destination, size_t* endOffset = nullptr) const
+  {
+    ArraySink<T> sink(destination);
+    return scanValues<T, ArraySink<T>>(offset, count, &sink, endOffset);
+  }
+
+  /**
+   * @brief skipValues Finds the end of up to count numeric values starting at the byte offset without converting them
+   * @param offset
+   * @param count
+   * @param endOffset
+   * @return The number of values that were found
+   */
+  size_t skipValues(size_t offset, size_t count, size_t* endOffset = nullptr) const
+  {
+    return scanValues<int32_t, ArraySink<int32_t>>(offset, count, nullptr, endOffset);
+  }
+
+  /**
+   * @brief forEachLine Calls the functor for up to numLines lines starting at the byte offset
+   * @param offset Byte offset of the first line
+   * @param numLines Maximum number of lines
+   * @param functor Functor called as functor(size_t lineIndex, const char* first, const char* last) with the
+   * characters of the line excluding the line ending. It is called concurrently.
+   * @return The number of lines that were visited
+   */
+  template <typename LineFunctor>
+  size_t forEachLine(size_t offset, size_t numLines, const LineFunctor& functor) const
+  {
+    size_t visited = 0;
+    while(offset < m_Size && visited < numLines)
+    {
+      std::vector<size_t> bounds = chunkBoundaries(offset);
+      const size_t numChunks = bounds.size() - 1;
+      std::vector<size_t> counts(numChunks, 0);
+
+      ParallelDataAlgorithm countAlg;
+      countAlg.setRange(0, numChunks);
+      countAlg.setGrain(1);
+      countAlg.execute(CountLinesImpl(m_Data, bounds, counts));
+
+      std::vector<size_t> firstLine(numChunks, 0);
+      size_t windowLines = 0;
+      for(size_t c = 0; c < numChunks; c++)
+      {
+        firstLine[c] = visited + windowLines;
+        windowLines += counts[c];
+      }
+
+      ParallelDataAlgorithm lineAlg;
+      lineAlg.setRange(0, numChunks);
+      lineAlg.setGrain(1);
+      lineAlg.execute(VisitLinesImpl<LineFunctor>(m_Data, bounds, firstLine, numLines, functor));
+
+      visited = std::min(visited + windowLines, numLines);
+      offset = bounds.back();
+    }
+    return visited;
+  }
+
+  /**
+   * @brief IsWhiteSpace Returns whether the character separates tokens
+   * @param c
+   * @return
+   */
+  static bool IsWhiteSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  /**
+   * @brief NextToken Finds the next token in [first, last)
+   * @param first In: where to start looking. Out: the first character of the token, or last if there is none
+   * @param last
+   * @return One past the last character of the token
+   */
+  static const char* NextToken(const char*& first, const char* last)
+  {
+    while(first < last && IsWhiteSpace(*first))
+    {
+      ++first;
+    }
+    const char* tokenEnd = first;
+    while(tokenEnd < last && !IsWhiteSpace(*tokenEnd))
+    {
+      ++tokenEnd;
+    }
+    return tokenEnd;
+  }
+
+  /**
+   * @brief IsNumericToken Returns whether the token looks like a number. Keywords that end a section of values
+   * do not, so readers can use this to find where the values stop.
+   * @param first
+   * @param last
+   * @return
+   */
+  static bool IsNumericToken(const char* first, const char* last)
+  {
+    if(first < last && (*first == '+' || *first == '-'))
+    {
+      ++first;
+    }
+    if(first == last)
+    {
+      return false;
+    }
+    if((*first >= '0' && *first <= '9') || *first == '.')
+    {
+      return true;
+    }
+    // nan, inf and infinity in any case
+    const size_t length = static_cast<size_t>(last - first);
+    if(length != 3 && length != 8)
+    {
+      return false;
+    }
+    char lower[8];
+    for(size_t i = 0; i < length; i++)
+    {
+      lower[i] = static_cast<char>(first[i] | 0x20);
+    }
+    return ::strncmp(lower, "nan", length) == 0 || ::strncmp(lower, "inf", length) == 0 || ::strncmp(lower, "infinity", length) == 0;
+  }
+
+  /**
+   * @brief ConvertToken Converts the whole token [first, last) into value
+   * @param first
+   * @param last
+   * @param value
+   * @return false if the token is not a valid T
+   */
+  template <typename T>
+  static bool ConvertToken(const char* first, const char* last, T& value)
+  {
+    // std::from_chars does not accept an explicit plus sign
+    if(first < last && *first == '+')
+    {
+      ++first;
+      if(first < last && *first == '-')
+      {
+        return false;
+      }
+    }
+    if constexpr(std::is_integral<T>::value)
+    {
+      std::from_chars_result result = std::from_chars(first, last, value);
+      return result.ec == std::errc() && result.ptr == last;
+    }
+    else
+    {
+#if defined(__cpp_lib_to_chars)
+      std::from_chars_result result = std::from_chars(first, last, value);
+      return result.ec == std::errc() && result.ptr == last;
+#else
+      // Standard libraries without floating point std::from_chars (AppleClang) go through Qt, which always parses
+      // with the C locale unlike strtod
+      if(first == last)
+      {
+        return false;
+      }
+      // Qt only knows the lower case spellings of nan and inf
+      const char* digits = (*first == '-') ? first + 1 : first;
+      if(digits < last && !((*digits >= '0' && *digits <= '9') || *digits == '.'))
+      {
+        if(!IsNumericToken(first, last))
+        {
+          return false;
+        }
+        const bool isNan = (*digits | 0x20) == 'n';
+        value = isNan ? std::numeric_limits<T>::quiet_NaN() : (*first == '-' ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+        return true;
+      }
+      bool ok = false;
+      double converted = QByteArray::fromRawData(first, static_cast<int>(last - first)).toDouble(&ok);
+      value = static_cast<T>(converted);
+      return ok;
+#endif
+    }
+  }
+
+private:
+  static constexpr size_t k_ChunkSize = 1024 * 1024;
+
+  QFile m_File;
+  QByteArray m_Buffer;
+  const char* m_Data = nullptr;
+  size_t m_Size = 0;
+  bool m_IsValid = false;
+
+  template <typename T>
+  class ArraySink
+  {
+  public:
+    explicit ArraySink(T* destination)
+    : m_Destination(destination)
+    {
+    }
+
+    void operator()(size_t index, T value) const
+    {
+      m_Destination[index] = value;
+    }
+
+  private:
+    T* m_Destination = nullptr;
+  };
+
+  /**
+   * @brief lineStart Returns the start of the first line that begins at or after offset
+   * @param offset
+   * @return
+   */
+  size_t lineStart(size_t offset) const
+  {
+    if(offset == 0 || offset >= m_Size || m_Data[offset - 1] == '\n')
+    {
+      return std::min(offset, m_Size);
+    }
+    const void* newLine = std::memchr(m_Data + offset, '\n', m_Size - offset);
+    if(nullptr == newLine)
+    {
+      return m_Size;
+    }
+    return static_cast<size_t>(static_cast<const char*>(newLine) - m_Data) + 1;
+  }
+
+  /**
+   * @brief chunkBoundaries Splits the next window of the file starting at offset into chunks that start at
+   * the beginning of a line
+   * @param offset
+   * @return The chunk boundaries; chunk c is [bounds[c], bounds[c + 1])
+   */
+  std::vector<size_t> chunkBoundaries(size_t offset) const
+  {
+    const size_t numThreads = std::max<size_t>(1, static_cast<size_t>(std::thread::hardware_concurrency()));
+    const size_t chunksPerWindow = 4 * numThreads;
+    const size_t remaining = m_Size - offset;
+    const size_t numChunks = std::min(chunksPerWindow, (remaining + k_ChunkSize - 1) / k_ChunkSize);
+
+    std::vector<size_t> bounds(1, offset);
+    for(size_t c = 1; c <= numChunks; c++)
+    {
+      size_t bound = lineStart(offset + std::min(remaining, c * k_ChunkSize));
+      if(bound > bounds.back())
+      {
+        bounds.push_back(bound);
+      }
+    }
+    if(bounds.size() == 1)
+    {
+      bounds.push_back(m_Size);
+    }
+    return bounds;
+  }
+
+  template <typename T, typename Sink>
+  size_t scanValues(size_t offset, size_t count, const Sink* sink, size_t* endOffset) const
+  {
+    size_t found = 0;
+    size_t lastEnd = offset;
+    while(offset < m_Size && found < count)
+    {
+      std::vector<size_t> bounds = chunkBoundaries(offset);
+      const size_t numChunks = bounds.size() - 1;
+      std::vector<size_t> counts(numChunks, 0);
+      std::vector<uint8_t> stopped(numChunks, 0);
+
+      ParallelDataAlgorithm countAlg;
+      countAlg.setRange(0, numChunks);
+      countAlg.setGrain(1);
+      countAlg.execute(CountTokensImpl(m_Data, bounds, counts, stopped));
+
+      // Only the chunks up to the first one that hit a non numeric token hold values of this section
+      std::vector<size_t> firstIndex(numChunks, 0);
+      size_t usedChunks = 0;
+      size_t available = found;
+      bool sectionEnded = false;
+      for(size_t c = 0; c < numChunks && available < count; c++)
+      {
+        firstIndex[c] = available;
+        available += counts[c];
+        usedChunks++;
+        if(stopped[c] != 0)
+        {
+          sectionEnded = true;
+          break;
+        }
+      }
+      const size_t limit = std::min(available, count);
+
+      std::vector<size_t> converted(usedChunks, 0);
+      std::vector<size_t> chunkEnds(usedChunks, 0);
+      ParallelDataAlgorithm convertAlg;
+      convertAlg.setRange(0, usedChunks);
+      convertAlg.setGrain(1);
+      convertAlg.execute(ConvertTokensImpl<T, Sink>(m_Data, bounds, firstIndex, limit, sink, converted, chunkEnds));
+
+      for(size_t c = 0; c < usedChunks; c++)
+      {
+        const size_t expected = firstIndex[c] < limit ? std::min(limit, firstIndex[c] + counts[c]) - firstIndex[c] : 0;
+        if(converted[c] > 0)
+        {
+          lastEnd = chunkEnds[c];
+          found = firstIndex[c] + converted[c];
+        }
+        if(converted[c] < expected)
+        {
+          // A value of this chunk could not be converted
+          sectionEnded = true;
+          break;
+        }
+      }
+      if(sectionEnded)
+      {
+        break;
+      }
+      offset = bounds.back();
+    }
+    if(nullptr != endOffset)
+    {
+      *endOffset = lastEnd;
+    }
+    return found;
+  }
+
+  class CountTokensImpl
+  {
+  public:
+    CountTokensImpl(const char* data, const std::vector<size_t>& bounds, std::vector<size_t>& counts, std::vector<uint8_t>& stopped)
+    : m_Data(data)
+    , m_Bounds(bounds)
+    , m_Counts(counts)
+    , m_Stopped(stopped)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t c = range.min(); c < range.max(); c++)
+      {
+        const char* first = m_Data + m_Bounds[c];
+        const char* last = m_Data + m_Bounds[c + 1];
+        size_t count = 0;
+        while(true)
+        {
+          const char* tokenEnd = NextToken(first, last);
+          if(first == last)
+          {
+            break;
+          }
+          if(!IsNumericToken(first, tokenEnd))
+          {
+            m_Stopped[c] = 1;
+            break;
+          }
+          count++;
+          first = tokenEnd;
+        }
+        m_Counts[c] = count;
+      }
+    }
+
+  private:
+    const char* m_Data = nullptr;
+    const std::vector<size_t>& m_Bounds;
+    std::vector<size_t>& m_Counts;
+    std::vector<uint8_t>& m_Stopped;
+  };
+
+  template <typename T, typename Sink>
+  class ConvertTokensImpl
+  {
+  public:
+    ConvertTokensImpl(const char* data, const std::vector<size_t>& bounds, const std::vector<size_t>& firstIndex, size_t limit, const Sink* sink, std::vector<size_t>& converted,
+                      std::vector<size_t>& chunkEnds)
+    : m_Data(data)
+    , m_Bounds(bounds)
+    , m_FirstIndex(firstIndex)
+    , m_Limit(limit)
+    , m_Sink(sink)
+    , m_Converted(converted)
+    , m_ChunkEnds(chunkEnds)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t c = range.min(); c < range.max(); c++)
+      {
+        const char* first = m_Data + m_Bounds[c];
+        const char* last = m_Data + m_Bounds[c + 1];
+        size_t index = m_FirstIndex[c];
+        while(index < m_Limit)
+        {
+          const char* tokenEnd = NextToken(first, last);
+          if(first == last)
+          {
+            break;
+          }
+          if(nullptr != m_Sink)
+          {
+            T value = static_cast<T>(0);
+            if(!ConvertToken<T>(first, tokenEnd, value))
+            {
+              break;
+            }
+            (*m_Sink)(index, value);
+          }
+          else if(!IsNumericToken(first, tokenEnd))
+          {
+            break;
+          }
+          index++;
+          first = tokenEnd;
+          m_ChunkEnds[c] = static_cast<size_t>(tokenEnd - m_Data);
+        }
+        m_Converted[c] = index - m_FirstIndex[c];
+      }
+    }
+
+  private:
+    const char* m_Data = nullptr;
+    const std::vector<size_t>& m_Bounds;
+    const std::vector<size_t>& m_FirstIndex;
+    size_t m_Limit = 0;
+    const Sink* m_Sink = nullptr;
+    std::vector<size_t>& m_Converted;
+    std::vector<size_t>& m_ChunkEnds;
+  };
+
+  class CountLinesImpl
+  {
+  public:
+    CountLinesImpl(const char* data, const std::vector<size_t>& bounds, std::vector<size_t>& counts)
+    : m_Data(data)
+    , m_Bounds(bounds)
+    , m_Counts(counts)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t c = range.min(); c < range.max(); c++)
+      {
+        const char* first = m_Data + m_Bounds[c];
+        const char* last = m_Data + m_Bounds[c + 1];
+        size_t count = static_cast<size_t>(std::count(first, last, '\n'));
+        // The last line of the file does not need a line ending
+        if(first < last && last[-1] != '\n')
+        {
+          count++;
+        }
+        m_Counts[c] = count;
+      }
+    }
+
+  private:
+    const char* m_Data = nullptr;
+    const std::vector<size_t>& m_Bounds;
+    std::vector<size_t>& m_Counts;
+  };
+
+  template <typename LineFunctor>
+  class VisitLinesImpl
+  {
+  public:
+    VisitLinesImpl(const char* data, const std::vector<size_t>& bounds, const std::vector<size_t>& firstLine, size_t numLines, const LineFunctor& functor)
+    : m_Data(data)
+    , m_Bounds(bounds)
+    , m_FirstLine(firstLine)
+    , m_NumLines(numLines)
+    , m_Functor(functor)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t c = range.min(); c < range.max(); c++)
+      {
+        const char* first = m_Data + m_Bounds[c];
+        const char* last = m_Data + m_Bounds[c + 1];
+        size_t lineIndex = m_FirstLine[c];
+        while(first < last && lineIndex < m_NumLines)
+        {
+          const char* lineEnd = static_cast<const char*>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+          const char* next = nullptr == lineEnd ? last : lineEnd + 1;
+          lineEnd = nullptr == lineEnd ? last : lineEnd;
+          if(lineEnd > first && lineEnd[-1] == '\r')
+          {
+            --lineEnd;
+          }
+          m_Functor(lineIndex, first, lineEnd);
+          lineIndex++;
+          first = next;
+        }
+      }
+    }
+
+  private:
+    const char* m_Data = nullptr;
+    const std::vector<size_t>& m_Bounds;
+    const std::vector<size_t>& m_FirstLine;
+    size_t m_NumLines = 0;
+    const LineFunctor& m_Functor;
+  };
+};
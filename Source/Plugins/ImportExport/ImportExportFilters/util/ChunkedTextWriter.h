@@ -0,0 +1,281 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The ChunkedTextWriter class writes large ASCII files by formatting blocks of items into memory in parallel
+ * and then writing the blocks to the file in order, so the output is the same as formatting the items one after
+ * the other. The blocks can go to a FILE*, a std::ostream or a QIODevice so writers keep the output they already
+ * open for their headers. It also has formatting helpers that produce the same text as the equivalent printf conversions.
+ */
+class ChunkedTextWriter
+{
+public:
+  /**
+   * @brief AppendInteger Appends the decimal representation of an integer, as printf's %d / %lld / %llu would
+   * @param out
+   * @param value
+   */
+  template <typename T>
+  static void AppendInteger(std::string& out, T value)
+  {
+    static_assert(std::is_integral<T>::value, "AppendInteger requires an integer type");
+    char buffer[24];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+  }
+
+  /**
+   * @brief AppendFloat Appends a floating point value using a printf conversion such as "%f" or "%.4f"
+   * @param out
+   * @param format
+   * @param value
+   */
+  static void AppendFloat(std::string& out, const char* format, double value)
+  {
+    char buffer[64];
+    int count = snprintf(buffer, sizeof(buffer), format, value);
+    if(count >= static_cast<int>(sizeof(buffer)))
+    {
+      // Very large values printed with %f do not fit into the stack buffer
+      std::string large(static_cast<size_t>(count) + 1, '\0');
+      snprintf(&large[0], large.size(), format, value);
+      out.append(large.data(), static_cast<size_t>(count));
+      return;
+    }
+    out.append(buffer, static_cast<size_t>(std::max(count, 0)));
+  }
+
+  /**
+   * @brief AppendFixed Appends a floating point value with a fixed number of decimals, as printf's "%.<precision>f" would
+   * @param out
+   * @param value
+   * @param precision
+   */
+  static void AppendFixed(std::string& out, double value, int precision)
+  {
+#if defined(__cpp_lib_to_chars)
+    char buffer[64];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    if(result.ec == std::errc())
+    {
+      out.append(buffer, result.ptr);
+      return;
+    }
+#endif
+    // Standard libraries without floating point std::to_chars (AppleClang) and very large values use printf
+    char format[16];
+    snprintf(format, sizeof(format), "%%.%df", precision);
+    AppendFloat(out, format, value);
+  }
+
+  /**
+   * @brief Write Formats the items [0, count) and writes them to the file in order
+   * @param file Open output file
+   * @param count Number of items
+   * @param itemsPerBlock Number of items each formatting task handles
+   * @param formatter Functor called as formatter(start, end, std::string& out) that appends the text of items [start, end) to out.
+   * It is called concurrently for different blocks.
+   * @param filter Filter used for progress messages and cancellation; may be nullptr
+   * @param message Progress message prefix
+   * @return 0 on success, -1 if writing failed and 1 if the filter was canceled
+   */
+  template <typename Formatter>
+  static int32_t Write(FILE* file, size_t count, size_t itemsPerBlock, const Formatter& formatter, AbstractFilter* filter, const QString& message)
+  {
+    return WriteBlocks(FileSink(file), count, itemsPerBlock, formatter, filter, message);
+  }
+
+  /**
+   * @brief Write Formats the items [0, count) and writes them to the stream in order. See the FILE* overload for the arguments.
+   */
+  template <typename Formatter>
+  static int32_t Write(std::ostream& stream, size_t count, size_t itemsPerBlock, const Formatter& formatter, AbstractFilter* filter, const QString& message)
+  {
+    return WriteBlocks(StreamSink(stream), count, itemsPerBlock, formatter, filter, message);
+  }
+
+  /**
+   * @brief Write Formats the items [0, count) and writes them to the device in order. Any QTextStream on the device
+   * must be flushed first. See the FILE* overload for the arguments.
+   */
+  template <typename Formatter>
+  static int32_t Write(QIODevice& device, size_t count, size_t itemsPerBlock, const Formatter& formatter, AbstractFilter* filter, const QString& message)
+  {
+    return WriteBlocks(DeviceSink(device), count, itemsPerBlock, formatter, filter, message);
+  }
+
+private:
+  template <typename Sink, typename Formatter>
+  static int32_t WriteBlocks(const Sink& sink, size_t count, size_t itemsPerBlock, const Formatter& formatter, AbstractFilter* filter, const QString& message)
+  {
+    itemsPerBlock = std::max<size_t>(itemsPerBlock, 1);
+    const size_t numBlocks = (count + itemsPerBlock - 1) / itemsPerBlock;
+    const size_t blocksPerBatch = std::max<size_t>(4, 4 * static_cast<size_t>(std::thread::hardware_concurrency()));
+    std::vector<std::string> buffers(std::min(blocksPerBatch, numBlocks));
+
+    for(size_t batchStart = 0; batchStart < numBlocks; batchStart += blocksPerBatch)
+    {
+      const size_t batchEnd = std::min(batchStart + blocksPerBatch, numBlocks);
+      if(nullptr != filter)
+      {
+        if(filter->getCancel())
+        {
+          return 1;
+        }
+        size_t percent = static_cast<size_t>(static_cast<float>(batchStart) / static_cast<float>(numBlocks) * 100.0f);
+        filter->notifyStatusMessage(QObject::tr("%1 %2% Completed").arg(message).arg(percent));
+      }
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(batchStart, batchEnd);
+      dataAlg.setGrain(1);
+      dataAlg.execute(FormatBlocksImpl<Formatter>(formatter, count, itemsPerBlock, batchStart, buffers));
+
+      for(size_t b = 0; b < batchEnd - batchStart; b++)
+      {
+        if(!buffers[b].empty() && !sink(buffers[b]))
+        {
+          return -1;
+        }
+      }
+    }
+    return 0;
+  }
+
+  class FileSink
+  {
+  public:
+    explicit FileSink(FILE* file)
+    : m_File(file)
+    {
+    }
+
+    bool operator()(const std::string& block) const
+    {
+      return fwrite(block.data(), 1, block.size(), m_File) == block.size();
+    }
+
+  private:
+    FILE* m_File = nullptr;
+  };
+
+  class StreamSink
+  {
+  public:
+    explicit StreamSink(std::ostream& stream)
+    : m_Stream(stream)
+    {
+    }
+
+    bool operator()(const std::string& block) const
+    {
+      m_Stream.write(block.data(), static_cast<std::streamsize>(block.size()));
+      return m_Stream.good();
+    }
+
+  private:
+    std::ostream& m_Stream;
+  };
+
+  class DeviceSink
+  {
+  public:
+    explicit DeviceSink(QIODevice& device)
+    : m_Device(device)
+    {
+    }
+
+    bool operator()(const std::string& block) const
+    {
+      return m_Device.write(block.data(), static_cast<qint64>(block.size())) == static_cast<qint64>(block.size());
+    }
+
+  private:
+    QIODevice& m_Device;
+  };
+
+  template <typename Formatter>
+  class FormatBlocksImpl
+  {
+  public:
+    FormatBlocksImpl(const Formatter& formatter, size_t count, size_t itemsPerBlock, size_t firstBlock, std::vector<std::string>& buffers)
+    : m_Formatter(formatter)
+    , m_Count(count)
+    , m_ItemsPerBlock(itemsPerBlock)
+    , m_FirstBlock(firstBlock)
+    , m_Buffers(buffers)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t block = range.min(); block < range.max(); block++)
+      {
+        std::string& out = m_Buffers[block - m_FirstBlock];
+        out.clear();
+        size_t start = block * m_ItemsPerBlock;
+        m_Formatter(start, std::min(start + m_ItemsPerBlock, m_Count), out);
+      }
+    }
+
+  private:
+    const Formatter& m_Formatter;
+    size_t m_Count = 0;
+    size_t m_ItemsPerBlock = 1;
+    size_t m_FirstBlock = 0;
+    std::vector<std::string>& m_Buffers;
+  };
+};
@@ -0,0 +1,253 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/ChunkedTextReader.h"
+
+#include "ImportExportTestFileLocations.h"
+
+class ChunkedTextReaderTest
+{
+public:
+  ChunkedTextReaderTest() = default;
+  virtual ~ChunkedTextReaderTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::ChunkedTextReaderTest::ValuesFile);
+    QFile::remove(UnitTest::ChunkedTextReaderTest::SectionsFile);
+    QFile::remove(UnitTest::ChunkedTextReaderTest::TokensFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteFile(const QString& filePath, const std::string& contents)
+  {
+    std::ofstream out(filePath.toStdString(), std::ios::out | std::ios::binary);
+    out << contents;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Several MB of values on lines of varying length so the 1 MB chunk boundaries fall in the middle of
+  // tokens, alternating between LF and CRLF line endings
+  // -----------------------------------------------------------------------------
+  int TestChunkBoundaries()
+  {
+    const int32_t numValues = 700000;
+    std::string contents;
+    int32_t value = 0;
+    int32_t line = 0;
+    while(value < numValues)
+    {
+      int32_t valuesOnLine = 1 + (line % 17);
+      for(int32_t i = 0; i < valuesOnLine && value < numValues; i++)
+      {
+        contents += (i == 0 ? "" : (i % 3 == 0 ? "\t" : " ")) + std::to_string(value);
+        value++;
+      }
+      contents += (line % 2 == 0) ? "\r\n" : "\n";
+      line++;
+    }
+    WriteFile(UnitTest::ChunkedTextReaderTest::ValuesFile, contents);
+
+    ChunkedTextReader reader(UnitTest::ChunkedTextReaderTest::ValuesFile);
+    DREAM3D_REQUIRE(reader.isValid())
+    DREAM3D_REQUIRE_EQUAL(reader.size(), contents.size())
+
+    std::vector<int32_t> ints(numValues, -1);
+    size_t endOffset = 0;
+    DREAM3D_REQUIRE_EQUAL(reader.readValues<int32_t>(0, numValues, ints.data(), &endOffset), numValues)
+    for(int32_t i = 0; i < numValues; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(ints[i], i)
+    }
+    // The end offset points just past the last value, before its line ending
+    DREAM3D_REQUIRE_EQUAL(endOffset, contents.find_last_of("0123456789") + 1)
+
+    std::vector<double> doubles(numValues, -1.0);
+    DREAM3D_REQUIRE_EQUAL(reader.readValues<double>(0, numValues, doubles.data()), numValues)
+    for(int32_t i = 0; i < numValues; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(doubles[i], static_cast<double>(i))
+    }
+
+    // Asking for fewer values stops right after the last requested one
+    const size_t partial = numValues / 2 + 1;
+    DREAM3D_REQUIRE_EQUAL(reader.skipValues(0, partial, &endOffset), partial)
+    size_t tokenStart = contents.rfind(std::to_string(partial - 1), endOffset);
+    DREAM3D_REQUIRE_EQUAL(endOffset, tokenStart + std::to_string(partial - 1).size())
+
+    // Lines are visited in order and handed over without their line ending
+    const size_t numLines = static_cast<size_t>(line);
+    std::vector<int32_t> firstValueOfLine(numLines, -1);
+    std::vector<uint8_t> hasCarriageReturn(numLines, 0);
+    size_t visited = reader.forEachLine(0, numLines, [&](size_t lineIndex, const char* first, const char* last) {
+      const char* tokenEnd = ChunkedTextReader::NextToken(first, last);
+      int32_t firstValue = -1;
+      ChunkedTextReader::ConvertToken<int32_t>(first, tokenEnd, firstValue);
+      firstValueOfLine[lineIndex] = firstValue;
+      hasCarriageReturn[lineIndex] = (last > first && last[-1] == '\r') ? 1 : 0;
+    });
+    DREAM3D_REQUIRE_EQUAL(visited, numLines)
+    int32_t expectedFirst = 0;
+    for(size_t l = 0; l < numLines; l++)
+    {
+      DREAM3D_REQUIRE_EQUAL(firstValueOfLine[l], expectedFirst)
+      DREAM3D_REQUIRE_EQUAL(hasCarriageReturn[l], 0)
+      expectedFirst += 1 + static_cast<int32_t>(l % 17);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A keyword in the middle of the values ends the section; the values after it can be read from the next line
+  // -----------------------------------------------------------------------------
+  int TestKeywordMidStream()
+  {
+    std::string header = "SCALARS FeatureIds int 1\r\nLOOKUP_TABLE default\r\n";
+    std::string contents = header + "1 2 3\r\n4 5\r\nPOINT_DATA 4\r\n6 7 8 9\r\n";
+    WriteFile(UnitTest::ChunkedTextReaderTest::SectionsFile, contents);
+
+    ChunkedTextReader reader(UnitTest::ChunkedTextReaderTest::SectionsFile);
+    DREAM3D_REQUIRE(reader.isValid())
+
+    std::vector<int32_t> values(10, 0);
+    size_t endOffset = 0;
+    DREAM3D_REQUIRE_EQUAL(reader.readValues<int32_t>(header.size(), values.size(), values.data(), &endOffset), 5)
+    for(int32_t i = 0; i < 5; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(values[i], i + 1)
+    }
+    DREAM3D_REQUIRE_EQUAL(endOffset, contents.find("5\r\n") + 1)
+
+    size_t skipEnd = 0;
+    DREAM3D_REQUIRE_EQUAL(reader.skipValues(header.size(), values.size(), &skipEnd), 5)
+    DREAM3D_REQUIRE_EQUAL(skipEnd, endOffset)
+
+    // The keyword itself is not a value
+    DREAM3D_REQUIRE_EQUAL(reader.skipValues(contents.find("POINT_DATA"), 1), 0)
+
+    size_t nextSection = contents.find("6 7");
+    DREAM3D_REQUIRE_EQUAL(reader.readValues<int32_t>(nextSection, 4, values.data(), &endOffset), 4)
+    for(int32_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(values[i], i + 6)
+    }
+    DREAM3D_REQUIRE_EQUAL(endOffset, contents.size() - 2)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Explicit plus signs and the special floating point values are numbers
+  // -----------------------------------------------------------------------------
+  int TestSpecialTokens()
+  {
+    std::string contents = "+1.5 -2 +3e2 nan NaN inf -inf +Infinity .25\n";
+    WriteFile(UnitTest::ChunkedTextReaderTest::TokensFile, contents);
+
+    ChunkedTextReader reader(UnitTest::ChunkedTextReaderTest::TokensFile);
+    DREAM3D_REQUIRE(reader.isValid())
+
+    std::vector<float> values(9, 0.0f);
+    DREAM3D_REQUIRE_EQUAL(reader.readValues<float>(0, values.size(), values.data()), 9)
+    DREAM3D_REQUIRE_EQUAL(values[0], 1.5f)
+    DREAM3D_REQUIRE_EQUAL(values[1], -2.0f)
+    DREAM3D_REQUIRE_EQUAL(values[2], 300.0f)
+    DREAM3D_REQUIRE(std::isnan(values[3]))
+    DREAM3D_REQUIRE(std::isnan(values[4]))
+    DREAM3D_REQUIRE(std::isinf(values[5]) && values[5] > 0.0f)
+    DREAM3D_REQUIRE(std::isinf(values[6]) && values[6] < 0.0f)
+    DREAM3D_REQUIRE(std::isinf(values[7]) && values[7] > 0.0f)
+    DREAM3D_REQUIRE_EQUAL(values[8], 0.25f)
+
+    // Integers accept a plus sign but not a fraction, a second sign or a decimal comma
+    int32_t intValue = 0;
+    std::string token = "+42";
+    DREAM3D_REQUIRE(ChunkedTextReader::ConvertToken<int32_t>(token.data(), token.data() + token.size(), intValue))
+    DREAM3D_REQUIRE_EQUAL(intValue, 42)
+    token = "+-42";
+    DREAM3D_REQUIRE(!ChunkedTextReader::ConvertToken<int32_t>(token.data(), token.data() + token.size(), intValue))
+    token = "4.2";
+    DREAM3D_REQUIRE(!ChunkedTextReader::ConvertToken<int32_t>(token.data(), token.data() + token.size(), intValue))
+    float floatValue = 0.0f;
+    token = "4,2";
+    DREAM3D_REQUIRE(!ChunkedTextReader::ConvertToken<float>(token.data(), token.data() + token.size(), floatValue))
+
+    token = "LOOKUP_TABLE";
+    DREAM3D_REQUIRE(!ChunkedTextReader::IsNumericToken(token.data(), token.data() + token.size()))
+    token = "nano";
+    DREAM3D_REQUIRE(!ChunkedTextReader::IsNumericToken(token.data(), token.data() + token.size()))
+    token = "-.5";
+    DREAM3D_REQUIRE(ChunkedTextReader::IsNumericToken(token.data(), token.data() + token.size()))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestChunkBoundaries())
+    DREAM3D_REGISTER_TEST(TestKeywordMidStream())
+    DREAM3D_REGISTER_TEST(TestSpecialTokens())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  ChunkedTextReaderTest(const ChunkedTextReaderTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ChunkedTextReaderTest&) = delete;        // Move assignment Not Implemented
+};
@@ -0,0 +1,343 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "ImportExport/ImportExportFilters/util/ChunkedTextWriter.h"
+
+#include "ImportExportTestFileLocations.h"
+
+class ChunkedTextWriterTest
+{
+public:
+  ChunkedTextWriterTest() = default;
+  virtual ~ChunkedTextWriterTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::ChunkedTextWriterTest::BlocksFile);
+    QFile::remove(UnitTest::ChunkedTextWriterTest::PhFile);
+    QFile::remove(UnitTest::ChunkedTextWriterTest::FFTFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::string ReadFile(const QString& filePath)
+  {
+    std::ifstream in(filePath.toStdString(), std::ios::in | std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  std::string Printf(const char* format, double value)
+  {
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), format, value);
+    return std::string(buffer);
+  }
+
+  // -----------------------------------------------------------------------------
+  // The formatting helpers must produce the same text as the printf conversions the writers used before
+  // -----------------------------------------------------------------------------
+  int TestAppendHelpers()
+  {
+    char buffer[64];
+    std::vector<int32_t> ints = {0, 1, -1, 9, 10, -10, 123456789, std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min()};
+    for(int32_t value : ints)
+    {
+      std::string out;
+      ChunkedTextWriter::AppendInteger(out, value);
+      snprintf(buffer, sizeof(buffer), "%d", value);
+      DREAM3D_REQUIRE(out == buffer)
+    }
+    std::vector<unsigned long long int> ulls = {0ULL, 1ULL, 4294967296ULL, std::numeric_limits<unsigned long long int>::max()};
+    for(unsigned long long int value : ulls)
+    {
+      std::string out;
+      ChunkedTextWriter::AppendInteger(out, value);
+      snprintf(buffer, sizeof(buffer), "%llu", value);
+      DREAM3D_REQUIRE(out == buffer)
+    }
+
+    // Exact binary ties, signed zeros, values that round up to the next power of 10 and very large values
+    std::vector<double> doubles = {0.0, -0.0, 0.0625, -0.0625, 2.5, 0.0005, 0.9995, 9.9999996, -359.9996, 1.0e-7, 123456.789, 1.0e20, 1.0e300, -1.0e300};
+    std::mt19937 generator(5489u);
+    std::uniform_real_distribution<double> angles(-720.0, 720.0);
+    for(int i = 0; i < 20000; i++)
+    {
+      doubles.push_back(angles(generator));
+      doubles.push_back(static_cast<float>(angles(generator)));
+    }
+    for(double value : doubles)
+    {
+      for(int precision : {0, 3, 6})
+      {
+        std::string out;
+        ChunkedTextWriter::AppendFixed(out, value, precision);
+        std::string format = "%." + std::to_string(precision) + "f";
+        DREAM3D_REQUIRE(out == Printf(format.c_str(), value))
+      }
+      std::string out;
+      ChunkedTextWriter::AppendFloat(out, "%f", value);
+      DREAM3D_REQUIRE(out == Printf("%f", value))
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocks that are formatted in parallel end up in the output in order, for every sink
+  // -----------------------------------------------------------------------------
+  int TestBlockOrder()
+  {
+    const size_t count = 100003;
+    auto formatter = [](size_t start, size_t end, std::string& out) {
+      for(size_t i = start; i < end; i++)
+      {
+        ChunkedTextWriter::AppendInteger(out, static_cast<unsigned long long int>(i) * 7919ULL);
+        out += (i % 5 == 4) ? '\n' : ' ';
+      }
+    };
+    std::string expected;
+    formatter(0, count, expected);
+
+    std::vector<size_t> blockSizes = {1, 7, 4096, count, 2 * count};
+    for(size_t itemsPerBlock : blockSizes)
+    {
+      std::ostringstream stream;
+      DREAM3D_REQUIRE_EQUAL(ChunkedTextWriter::Write(stream, count, itemsPerBlock, formatter, nullptr, "Writing"), 0)
+      DREAM3D_REQUIRE(stream.str() == expected)
+
+      FILE* f = fopen(UnitTest::ChunkedTextWriterTest::BlocksFile.toLatin1().data(), "wb");
+      DREAM3D_REQUIRE_VALID_POINTER(f)
+      int32_t err = ChunkedTextWriter::Write(f, count, itemsPerBlock, formatter, nullptr, "Writing");
+      fclose(f);
+      DREAM3D_REQUIRE_EQUAL(err, 0)
+      DREAM3D_REQUIRE(ReadFile(UnitTest::ChunkedTextWriterTest::BlocksFile) == expected)
+
+      QFile device(UnitTest::ChunkedTextWriterTest::BlocksFile);
+      DREAM3D_REQUIRE(device.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      err = ChunkedTextWriter::Write(device, count, itemsPerBlock, formatter, nullptr, "Writing");
+      device.close();
+      DREAM3D_REQUIRE_EQUAL(err, 0)
+      DREAM3D_REQUIRE(ReadFile(UnitTest::ChunkedTextWriterTest::BlocksFile) == expected)
+    }
+
+    // Nothing to write
+    std::ostringstream stream;
+    DREAM3D_REQUIRE_EQUAL(ChunkedTextWriter::Write(stream, 0, 16, formatter, nullptr, "Writing"), 0)
+    DREAM3D_REQUIRE(stream.str().empty())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A cell volume large enough to be written in several blocks
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(SIMPL::Defaults::DataContainerName);
+    dca->addOrReplaceDataContainer(m);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {UnitTest::ChunkedTextWriterTest::XSize, UnitTest::ChunkedTextWriterTest::YSize, UnitTest::ChunkedTextWriterTest::ZSize};
+    image->setDimensions(dims);
+    m->setGeometry(image);
+
+    std::vector<size_t> tDims(dims, dims + 3);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    m->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    size_t totalPoints = cellAttrMat->getNumberOfTuples();
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, std::vector<size_t>(1, 1), SIMPL::CellData::FeatureIds, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, std::vector<size_t>(1, 1), SIMPL::CellData::Phases, true);
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(tDims, std::vector<size_t>(1, 3), SIMPL::CellData::EulerAngles, true);
+
+    std::mt19937 generator(5489u);
+    std::uniform_int_distribution<int32_t> ids(-1, 5000);
+    std::uniform_real_distribution<float> angles(0.0f, static_cast<float>(SIMPLib::Constants::k_2Pi));
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, ids(generator));
+      phases->setValue(i, static_cast<int32_t>(i % 3) + 1);
+      for(size_t c = 0; c < 3; c++)
+      {
+        eulers->setComponent(i, c, angles(generator));
+      }
+    }
+    cellAttrMat->insertOrAssign(featureIds);
+    cellAttrMat->insertOrAssign(phases);
+    cellAttrMat->insertOrAssign(eulers);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateWriter(const QString& filtName, const DataContainerArray::Pointer& dca, const QString& outputFile)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputFile", outputFile), true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // PhWriter output must match the iostream output it produced before the ChunkedTextWriter
+  // -----------------------------------------------------------------------------
+  int TestPhWriterOutput()
+  {
+    DataContainerArray::Pointer dca = CreateDataContainerArray();
+    AbstractFilter::Pointer phWriter = CreateWriter("PhWriter", dca, UnitTest::ChunkedTextWriterTest::PhFile);
+    phWriter->execute();
+    DREAM3D_REQUIRE_EQUAL(phWriter->getErrorCode(), 0)
+
+    Int32ArrayType::Pointer featureIds =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    size_t totalPoints = featureIds->getNumberOfTuples();
+    std::set<int32_t> used(featureIds->getPointer(0), featureIds->getPointer(0) + totalPoints);
+
+    std::ostringstream expected;
+    expected << "     " << UnitTest::ChunkedTextWriterTest::XSize << "     " << UnitTest::ChunkedTextWriterTest::YSize << "     " << UnitTest::ChunkedTextWriterTest::ZSize << "\n";
+    expected << "\'DREAM3\'              52.00  1.000  1.0       " << used.size() << "\n";
+    expected << " 0.000 0.000 0.000          0        \n";
+    for(size_t k = 0; k < totalPoints; k++)
+    {
+      expected << featureIds->getValue(k) << '\n';
+    }
+    DREAM3D_REQUIRE(ReadFile(UnitTest::ChunkedTextWriterTest::PhFile) == expected.str())
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // LosAlamosFFTWriter output must match the fprintf output it produced before the ChunkedTextWriter
+  // -----------------------------------------------------------------------------
+  int TestLosAlamosFFTWriterOutput()
+  {
+    DataContainerArray::Pointer dca = CreateDataContainerArray();
+    AbstractFilter::Pointer fftWriter = CreateWriter("LosAlamosFFTWriter", dca, UnitTest::ChunkedTextWriterTest::FFTFile);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+    DREAM3D_REQUIRE_EQUAL(fftWriter->setProperty("CellPhasesArrayPath", var), true)
+    var.setValue(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::EulerAngles));
+    DREAM3D_REQUIRE_EQUAL(fftWriter->setProperty("CellEulerAnglesArrayPath", var), true)
+    fftWriter->execute();
+    DREAM3D_REQUIRE_EQUAL(fftWriter->getErrorCode(), 0)
+
+    AttributeMatrix::Pointer cellAttrMat = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::DataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    Int32ArrayType::Pointer featureIds = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+
+    std::string expected;
+    char line[256];
+    size_t index = 0;
+    for(size_t z = 0; z < UnitTest::ChunkedTextWriterTest::ZSize; ++z)
+    {
+      for(size_t y = 0; y < UnitTest::ChunkedTextWriterTest::YSize; ++y)
+      {
+        for(size_t x = 0; x < UnitTest::ChunkedTextWriterTest::XSize; ++x)
+        {
+          float phi1 = eulers->getComponent(index, 0) * 180.0 * SIMPLib::Constants::k_1OverPi;
+          float phi = eulers->getComponent(index, 1) * 180.0 * SIMPLib::Constants::k_1OverPi;
+          float phi2 = eulers->getComponent(index, 2) * 180.0 * SIMPLib::Constants::k_1OverPi;
+          snprintf(line, sizeof(line), "%.3f %.3f %.3f %llu %llu %llu %d %d\n", phi1, phi, phi2, static_cast<unsigned long long int>(x + 1), static_cast<unsigned long long int>(y + 1),
+                   static_cast<unsigned long long int>(z + 1), featureIds->getValue(index), phases->getValue(index));
+          expected += line;
+          index++;
+        }
+      }
+    }
+    DREAM3D_REQUIRE(ReadFile(UnitTest::ChunkedTextWriterTest::FFTFile) == expected)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestAppendHelpers())
+    DREAM3D_REGISTER_TEST(TestBlockOrder())
+    DREAM3D_REGISTER_TEST(TestPhWriterOutput())
+    DREAM3D_REGISTER_TEST(TestLosAlamosFFTWriterOutput())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  ChunkedTextWriterTest(const ChunkedTextWriterTest&) = delete; // Copy Constructor Not Implemented
+  void operator=(const ChunkedTextWriterTest&) = delete;        // Move assignment Not Implemented
+};
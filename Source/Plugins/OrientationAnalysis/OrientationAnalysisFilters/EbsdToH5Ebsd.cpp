@@ -34,24 +34,613 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "EbsdToH5Ebsd.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 
+#include <hdf5.h>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/pipeline.h>
+#endif
+
 #include "H5Support/H5ScopedSentinel.h"
 #include "H5Support/H5Utilities.h"
 #include "H5Support/QH5Lite.h"
 
-#include "EbsdLib/IO/HKL/H5CtfImporter.h"
-#include "EbsdLib/IO/TSL/H5AngImporter.h"
+#include "EbsdLib/IO/HKL/CtfReader.h"
+#include "EbsdLib/IO/TSL/AngReader.h"
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "OrientationAnalysis/FilterParameters/EbsdToH5EbsdFilterParameter.h"
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+namespace
+{
+/**
+ * @brief The EbsdSliceToken struct carries one input file through the conversion pipeline. The file is parsed into
+ * its own reader which the writer then writes into the output file.
+ */
+struct EbsdSliceToken
+{
+  int64_t z = 0;
+  int32_t fileIndex = 0;
+  QString filePath;
+  std::unique_ptr<AngReader> angReader;
+  std::unique_ptr<CtfReader> ctfReader;
+  int32_t errorCode = 0;
+  QString errorMessage;
+};
+
+/**
+ * @brief The EbsdSliceConverter class holds what the stages of the conversion pipeline share. Any number of files
+ * may be parsed at the same time, each by its own reader, which makes no HDF5 calls. The parsed slices are written
+ * to the output file one at a time in the order of the file list, so only a single thread ever uses HDF5.
+ */
+class EbsdSliceConverter
+{
+public:
+  EbsdSliceConverter(EbsdToH5Ebsd* filter, hid_t fileId, const QVector<QString>& fileList, const std::string& ext, int64_t zStart)
+  : m_Filter(filter)
+  , m_FileId(fileId)
+  , m_FileList(fileList)
+  , m_Ext(ext)
+  , m_ZStart(zStart)
+  {
+  }
+
+  /**
+   * @brief nextSlice Hands out the next file to parse, or nullptr once all files have been handed out or the
+   * conversion has failed or was canceled
+   */
+  EbsdSliceToken* nextSlice()
+  {
+    if(m_NextFileIndex >= m_FileList.size() || m_ErrorCode < 0 || m_Filter->getCancel())
+    {
+      return nullptr;
+    }
+    EbsdSliceToken* token = new EbsdSliceToken;
+    token->fileIndex = m_NextFileIndex;
+    token->z = m_ZStart + m_NextFileIndex;
+    token->filePath = m_FileList[m_NextFileIndex];
+    m_NextFileIndex++;
+    return token;
+  }
+
+  /**
+   * @brief importSlice Parses the file of the token into a reader that is kept in the token
+   */
+  EbsdSliceToken* importSlice(EbsdSliceToken* token)
+  {
+    if(m_ErrorCode < 0 || m_Filter->getCancel())
+    {
+      return token;
+    }
+    int32_t err = 0;
+    if(m_Ext == EbsdLib::Ang::FileExt)
+    {
+      token->angReader = std::make_unique<AngReader>();
+      token->angReader->setFileName(token->filePath.toStdString());
+      err = token->angReader->readFile();
+      if(err < 0)
+      {
+        token->errorCode = err;
+        token->errorMessage = QString::fromStdString(token->angReader->getErrorMessage());
+      }
+      else if(token->angReader->getGrid() == EbsdLib::Ang::HexGrid)
+      {
+        token->errorCode = -400;
+        token->errorMessage = QObject::tr("'%1' is a HEX grid .ang file. Please use the 'Convert Hexagonal Grid Data to Square Grid Data (TSL - .ang)' filter first to batch convert the Hex grid files.")
+                                  .arg(token->filePath);
+      }
+    }
+    else
+    {
+      token->ctfReader = std::make_unique<CtfReader>();
+      token->ctfReader->setFileName(token->filePath.toStdString());
+      err = token->ctfReader->readFile();
+      if(err < 0)
+      {
+        token->errorCode = err;
+        token->errorMessage = QString::fromStdString(token->ctfReader->getErrorMessage());
+      }
+    }
+    return token;
+  }
+
+  /**
+   * @brief writeSlice Writes the parsed slice into the output file and releases the token along with its reader
+   */
+  void writeSlice(EbsdSliceToken* token)
+  {
+    std::unique_ptr<EbsdSliceToken> slice(token);
+    if(m_ErrorCode >= 0 && slice->errorCode < 0)
+    {
+      m_ErrorCode = slice->errorCode;
+      m_ErrorMessage = slice->errorMessage;
+    }
+    if(m_ErrorCode < 0 || m_Filter->getCancel())
+    {
+      return;
+    }
+
+    herr_t err = 0;
+    if(nullptr != slice->angReader)
+    {
+      AngReader& reader = *(slice->angReader);
+      err = writeAngSlice(reader, slice->z);
+      m_TotalSlicesImported += 1;
+      m_BiggestXDim = std::max<int64_t>(m_BiggestXDim, reader.getXDimension());
+      m_BiggestYDim = std::max<int64_t>(m_BiggestYDim, reader.getYDimension());
+      m_XRes = reader.getXStep();
+      m_YRes = reader.getYStep();
+    }
+    else
+    {
+      CtfReader& reader = *(slice->ctfReader);
+      // A 3D .ctf file holds several slices, each of which gets its own slice group
+      int32_t zCells = std::max(reader.getZCells(), 1);
+      for(int32_t s = 0; s < zCells && err >= 0; s++)
+      {
+        err = writeCtfSlice(reader, slice->z + s, s);
+      }
+      m_TotalSlicesImported += zCells;
+      m_BiggestXDim = std::max<int64_t>(m_BiggestXDim, reader.getXCells());
+      m_BiggestYDim = std::max<int64_t>(m_BiggestYDim, reader.getYCells());
+      m_XRes = reader.getXStep();
+      m_YRes = reader.getYStep();
+    }
+    if(err < 0)
+    {
+      m_ErrorCode = -1;
+      m_ErrorMessage = QObject::tr("Could not write dataset for slice to HDF5 file");
+      return;
+    }
+    m_Indices.push_back(static_cast<int32_t>(slice->z));
+
+    QString msg = QString("Converting File [%1/%2]: %3").arg(slice->fileIndex + 1).arg(m_FileList.size()).arg(slice->filePath);
+    m_Filter->notifyStatusMessage(msg);
+  }
+
+  /**
+   * @brief setCompression Sets the filters applied to the chunked datasets of each slice
+   * @param deflateLevel 0 disables the deflate filter, 1-9 is the gzip compression level
+   * @param useShuffle Whether the bytes of each chunk are shuffled before they are compressed
+   */
+  void setCompression(int32_t deflateLevel, bool useShuffle)
+  {
+    m_DeflateLevel = deflateLevel;
+    m_UseShuffle = useShuffle;
+  }
+
+  int32_t getErrorCode() const
+  {
+    return m_ErrorCode;
+  }
+  QString getErrorMessage() const
+  {
+    return m_ErrorMessage;
+  }
+  int32_t getTotalSlicesImported() const
+  {
+    return m_TotalSlicesImported;
+  }
+  int64_t getBiggestXDim() const
+  {
+    return m_BiggestXDim;
+  }
+  int64_t getBiggestYDim() const
+  {
+    return m_BiggestYDim;
+  }
+  float getXRes() const
+  {
+    return m_XRes;
+  }
+  float getYRes() const
+  {
+    return m_YRes;
+  }
+  const QVector<int32_t>& getIndices() const
+  {
+    return m_Indices;
+  }
+
+private:
+  static constexpr hsize_t k_MaxChunkElements = 1024 * 1024;
+
+  EbsdToH5Ebsd* m_Filter = nullptr;
+  hid_t m_FileId = -1;
+  const QVector<QString>& m_FileList;
+  std::string m_Ext;
+  int64_t m_ZStart = 0;
+  int32_t m_DeflateLevel = 0;
+  bool m_UseShuffle = false;
+
+  int32_t m_NextFileIndex = 0;
+  std::atomic<int32_t> m_ErrorCode = {0};
+  QString m_ErrorMessage;
+  int32_t m_TotalSlicesImported = 0;
+  int64_t m_BiggestXDim = 0;
+  int64_t m_BiggestYDim = 0;
+  float m_XRes = 0.0f;
+  float m_YRes = 0.0f;
+  QVector<int32_t> m_Indices;
+
+  /**
+   * @brief writeAngSlice Writes the Header, Phases and Data groups of one .ang file the way H5AngImporter lays them out
+   */
+  herr_t writeAngSlice(AngReader& reader, int64_t z)
+  {
+    hid_t sliceGid = H5Utilities::createGroup(m_FileId, std::to_string(z));
+    if(sliceGid < 0)
+    {
+      return -1;
+    }
+    hid_t gid = H5Utilities::createGroup(sliceGid, EbsdLib::H5Ebsd::Header);
+    herr_t err = gid < 0 ? -1 : 0;
+    if(err >= 0)
+    {
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::TEMPIXPerUM, reader.getTEMpixPerum()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::XStar, reader.getXStar()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::YStar, reader.getYStar()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::ZStar, reader.getZStar()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::WorkingDistance, reader.getWorkingDistance()));
+      err = std::min(err, writeAngPhases(reader, gid));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ang::Grid, reader.getGrid()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::XStep, reader.getXStep()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::YStep, reader.getYStep()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::NColsOdd, reader.getNumOddCols()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::NColsEven, reader.getNumEvenCols()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ang::NRows, reader.getNumRows()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ang::OPERATOR, reader.getOIMOperator()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ang::SAMPLEID, reader.getSampleID()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ang::SCANID, reader.getSCANID()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::H5Ebsd::OriginalHeader, reader.getOriginalHeader()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::H5Ebsd::OriginalFile, reader.getFileName()));
+      H5Gclose(gid);
+    }
+
+    if(err >= 0)
+    {
+      std::vector<std::string> names = {EbsdLib::Ang::Phi1,         EbsdLib::Ang::Phi,       EbsdLib::Ang::Phi2,      EbsdLib::Ang::XPosition, EbsdLib::Ang::YPosition,
+                                        EbsdLib::Ang::ImageQuality, EbsdLib::Ang::ConfidenceIndex, EbsdLib::Ang::PhaseData, EbsdLib::Ang::SEMSignal, EbsdLib::Ang::Fit};
+      hsize_t numElements = static_cast<hsize_t>(reader.getXDimension()) * static_cast<hsize_t>(reader.getYDimension());
+      err = writeDataGroup(reader, sliceGid, names, numElements, 0);
+    }
+    H5Gclose(sliceGid);
+    return err;
+  }
+
+  /**
+   * @brief writeAngPhases Writes one group per phase, including its HKL families, into a new Phases group
+   */
+  herr_t writeAngPhases(AngReader& reader, hid_t headerGid)
+  {
+    hid_t phasesGid = H5Utilities::createGroup(headerGid, EbsdLib::H5Ebsd::Phases);
+    if(phasesGid < 0)
+    {
+      return -1;
+    }
+    herr_t err = 0;
+    std::vector<AngPhase::Pointer> phases = reader.getPhaseVector();
+    for(const AngPhase::Pointer& phase : phases)
+    {
+      hid_t pid = H5Utilities::createGroup(phasesGid, std::to_string(phase->getPhaseIndex()));
+      if(pid < 0)
+      {
+        err = -1;
+        break;
+      }
+      std::vector<float> latticeConstants = phase->getLatticeConstants();
+      std::vector<int> categories = phase->getCategories();
+      hsize_t lcDims[1] = {static_cast<hsize_t>(latticeConstants.size())};
+      hsize_t catDims[1] = {static_cast<hsize_t>(categories.size())};
+      err = std::min(err, H5Lite::writeScalarDataset(pid, EbsdLib::Ang::Phase, phase->getPhaseIndex()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ang::MaterialName, phase->getMaterialName()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ang::Formula, phase->getFormula()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ang::Info, phase->getInfo()));
+      err = std::min(err, H5Lite::writeScalarDataset(pid, EbsdLib::Ang::Symmetry, static_cast<int32_t>(phase->getSymmetry())));
+      err = std::min(err, H5Lite::writePointerDataset<float>(pid, EbsdLib::Ang::LatticeConstants, 1, lcDims, latticeConstants.data()));
+      err = std::min(err, H5Lite::writeScalarDataset(pid, EbsdLib::Ang::NumberFamilies, phase->getNumberFamilies()));
+      if(phase->getNumberFamilies() > 0)
+      {
+        err = std::min(err, writeHKLFamilies(*phase, pid));
+      }
+      if(!categories.empty())
+      {
+        err = std::min(err, H5Lite::writePointerDataset<int>(pid, EbsdLib::Ang::Categories, 1, catDims, categories.data()));
+      }
+      H5Gclose(pid);
+    }
+    H5Gclose(phasesGid);
+    return err;
+  }
+
+  /**
+   * @brief writeHKLFamilies Writes every HKL family of the phase as its own compound dataset
+   */
+  herr_t writeHKLFamilies(AngPhase& phase, hid_t phaseGid)
+  {
+    hid_t hklGid = H5Utilities::createGroup(phaseGid, EbsdLib::Ang::HKLFamilies);
+    if(hklGid < 0)
+    {
+      return -1;
+    }
+    hid_t memType = H5Tcreate(H5T_COMPOUND, sizeof(HKLFamily_t));
+    H5Tinsert(memType, "H", HOFFSET(HKLFamily_t, h), H5T_NATIVE_INT);
+    H5Tinsert(memType, "K", HOFFSET(HKLFamily_t, k), H5T_NATIVE_INT);
+    H5Tinsert(memType, "L", HOFFSET(HKLFamily_t, l), H5T_NATIVE_INT);
+    H5Tinsert(memType, "Solution 1", HOFFSET(HKLFamily_t, s1), H5T_NATIVE_INT);
+    H5Tinsert(memType, "Diffraction Intensity", HOFFSET(HKLFamily_t, diffractionIntensity), H5T_NATIVE_FLOAT);
+    H5Tinsert(memType, "Solution 2", HOFFSET(HKLFamily_t, s2), H5T_NATIVE_INT);
+    hsize_t dims[1] = {1};
+    hid_t spaceId = H5Screate_simple(1, dims, nullptr);
+
+    herr_t err = 0;
+    int32_t index = 0;
+    for(const HKLFamily::Pointer& family : phase.getHKLFamilies())
+    {
+      HKLFamily_t hkl;
+      family->copyToStruct(&hkl);
+      hid_t dsetId = H5Dcreate2(hklGid, std::to_string(index++).c_str(), memType, spaceId, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      err = std::min(err, dsetId < 0 ? -1 : H5Dwrite(dsetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, &hkl));
+      if(dsetId >= 0)
+      {
+        H5Dclose(dsetId);
+      }
+    }
+    H5Sclose(spaceId);
+    H5Tclose(memType);
+    H5Gclose(hklGid);
+    return err;
+  }
+
+  /**
+   * @brief writeCtfSlice Writes the Header, Phases and Data groups of one slice of a .ctf file the way H5CtfImporter
+   * lays them out
+   */
+  herr_t writeCtfSlice(CtfReader& reader, int64_t z, int32_t slice)
+  {
+    hid_t sliceGid = H5Utilities::createGroup(m_FileId, std::to_string(z));
+    if(sliceGid < 0)
+    {
+      return -1;
+    }
+    hid_t gid = H5Utilities::createGroup(sliceGid, EbsdLib::H5Ebsd::Header);
+    herr_t err = gid < 0 ? -1 : 0;
+    if(err >= 0)
+    {
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ctf::ChannelTextFile, reader.getChannel()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ctf::Prj, reader.getPrj()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ctf::Author, reader.getAuthor()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ctf::JobMode, reader.getJobMode()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::XCells, reader.getXCells()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::YCells, reader.getYCells()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::XStep, reader.getXStep()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::YStep, reader.getYStep()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::AcqE1, reader.getAcqE1()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::AcqE2, reader.getAcqE2()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::AcqE3, reader.getAcqE3()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::Ctf::Euler, reader.getEuler()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::Mag, reader.getMag()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::Coverage, reader.getCoverage()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::Device, reader.getDevice()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::KV, reader.getKV()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::TiltAngle, reader.getTiltAngle()));
+      err = std::min(err, H5Lite::writeScalarDataset(gid, EbsdLib::Ctf::TiltAxis, reader.getTiltAxis()));
+      err = std::min(err, writeCtfPhases(reader, gid));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::H5Ebsd::OriginalHeader, reader.getOriginalHeader()));
+      err = std::min(err, H5Lite::writeStringDataset(gid, EbsdLib::H5Ebsd::OriginalFile, reader.getFileName()));
+      H5Gclose(gid);
+    }
+
+    if(err >= 0)
+    {
+      std::vector<std::string> names = {EbsdLib::Ctf::Phase,  EbsdLib::Ctf::X,      EbsdLib::Ctf::Y,      EbsdLib::Ctf::Bands, EbsdLib::Ctf::Error, EbsdLib::Ctf::Euler1,
+                                        EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3, EbsdLib::Ctf::MAD,    EbsdLib::Ctf::BC,    EbsdLib::Ctf::BS};
+      hsize_t numElements = static_cast<hsize_t>(reader.getXCells()) * static_cast<hsize_t>(reader.getYCells());
+      err = writeDataGroup(reader, sliceGid, names, numElements, static_cast<hsize_t>(slice) * numElements);
+    }
+    H5Gclose(sliceGid);
+    return err;
+  }
+
+  /**
+   * @brief writeCtfPhases Writes one group per phase into a new Phases group
+   */
+  herr_t writeCtfPhases(CtfReader& reader, hid_t headerGid)
+  {
+    hid_t phasesGid = H5Utilities::createGroup(headerGid, EbsdLib::H5Ebsd::Phases);
+    if(phasesGid < 0)
+    {
+      return -1;
+    }
+    herr_t err = 0;
+    std::vector<CtfPhase::Pointer> phases = reader.getPhaseVector();
+    for(const CtfPhase::Pointer& phase : phases)
+    {
+      hid_t pid = H5Utilities::createGroup(phasesGid, std::to_string(phase->getPhaseIndex()));
+      if(pid < 0)
+      {
+        err = -1;
+        break;
+      }
+      std::vector<float> latticeConstants = phase->getLatticeConstants();
+      hsize_t lcDims[1] = {static_cast<hsize_t>(latticeConstants.size())};
+      err = std::min(err, H5Lite::writePointerDataset<float>(pid, EbsdLib::Ctf::LatticeConstants, 1, lcDims, latticeConstants.data()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ctf::PhaseName, phase->getPhaseName()));
+      err = std::min(err, H5Lite::writeScalarDataset(pid, EbsdLib::Ctf::LaueGroup, static_cast<int32_t>(phase->getLaueGroup())));
+      err = std::min(err, H5Lite::writeScalarDataset(pid, EbsdLib::Ctf::SpaceGroup, phase->getSpaceGroup()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ctf::Internal1, phase->getInternal1()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ctf::Internal2, phase->getInternal2()));
+      err = std::min(err, H5Lite::writeStringDataset(pid, EbsdLib::Ctf::Comment, phase->getComment()));
+      H5Gclose(pid);
+    }
+    H5Gclose(phasesGid);
+    return err;
+  }
+
+  /**
+   * @brief writeDataGroup Writes the named columns of the reader into a new Data group. Columns the file does not
+   * have are skipped.
+   * @param offset The index of the first element of this slice within the columns of the reader
+   */
+  herr_t writeDataGroup(EbsdReader& reader, hid_t sliceGid, const std::vector<std::string>& names, hsize_t numElements, hsize_t offset)
+  {
+    hid_t gid = H5Utilities::createGroup(sliceGid, EbsdLib::H5Ebsd::Data);
+    if(gid < 0)
+    {
+      return -1;
+    }
+    herr_t err = 0;
+    for(const std::string& name : names)
+    {
+      void* dataPtr = reader.getPointerByName(name);
+      if(nullptr == dataPtr)
+      {
+        continue;
+      }
+      EbsdLib::NumericTypes::Type type = reader.getPointerType(name);
+      if(type == EbsdLib::NumericTypes::Type::Int32)
+      {
+        err = writeDatasetChunked(gid, name, H5T_NATIVE_INT32, static_cast<int32_t*>(dataPtr) + offset, numElements);
+      }
+      else if(type == EbsdLib::NumericTypes::Type::Float)
+      {
+        err = writeDatasetChunked(gid, name, H5T_NATIVE_FLOAT, static_cast<float*>(dataPtr) + offset, numElements);
+      }
+      if(err < 0)
+      {
+        break;
+      }
+    }
+    H5Gclose(gid);
+    return err;
+  }
+
+  /**
+   * @brief writeDatasetChunked Writes a one dimensional dataset with chunked storage and the requested filters
+   */
+  herr_t writeDatasetChunked(hid_t gid, const std::string& name, hid_t typeId, const void* data, hsize_t numElements)
+  {
+    hsize_t dims[1] = {numElements};
+    hsize_t chunkDims[1] = {std::max<hsize_t>(1, std::min(numElements, k_MaxChunkElements))};
+    hid_t spaceId = H5Screate_simple(1, dims, nullptr);
+    hid_t dcplId = H5Pcreate(H5P_DATASET_CREATE);
+    herr_t err = (spaceId < 0 || dcplId < 0) ? -1 : 0;
+    if(err >= 0 && numElements > 0)
+    {
+      err = H5Pset_chunk(dcplId, 1, chunkDims);
+      if(err >= 0 && m_UseShuffle)
+      {
+        err = H5Pset_shuffle(dcplId);
+      }
+      if(err >= 0 && m_DeflateLevel > 0)
+      {
+        err = H5Pset_deflate(dcplId, static_cast<uint32_t>(m_DeflateLevel));
+      }
+    }
+    if(err >= 0)
+    {
+      hid_t dsetId = H5Dcreate2(gid, name.c_str(), typeId, spaceId, H5P_DEFAULT, dcplId, H5P_DEFAULT);
+      err = dsetId < 0 ? -1 : H5Dwrite(dsetId, typeId, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+      if(dsetId >= 0)
+      {
+        H5Dclose(dsetId);
+      }
+    }
+    if(dcplId >= 0)
+    {
+      H5Pclose(dcplId);
+    }
+    if(spaceId >= 0)
+    {
+      H5Sclose(spaceId);
+    }
+    return err;
+  }
+};
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+/**
+ * @brief The NextSliceStage class is the serial input stage of the conversion pipeline
+ */
+class NextSliceStage
+{
+public:
+  explicit NextSliceStage(EbsdSliceConverter& converter)
+  : m_Converter(converter)
+  {
+  }
+
+  EbsdSliceToken* operator()(tbb::flow_control& fc) const
+  {
+    EbsdSliceToken* token = m_Converter.nextSlice();
+    if(nullptr == token)
+    {
+      fc.stop();
+    }
+    return token;
+  }
+
+private:
+  EbsdSliceConverter& m_Converter;
+};
+
+/**
+ * @brief The ImportSliceStage class is the parallel parsing stage of the conversion pipeline
+ */
+class ImportSliceStage
+{
+public:
+  explicit ImportSliceStage(EbsdSliceConverter& converter)
+  : m_Converter(converter)
+  {
+  }
+
+  EbsdSliceToken* operator()(EbsdSliceToken* token) const
+  {
+    return m_Converter.importSlice(token);
+  }
+
+private:
+  EbsdSliceConverter& m_Converter;
+};
+
+/**
+ * @brief The WriteSliceStage class is the serial, in order, output stage of the conversion pipeline
+ */
+class WriteSliceStage
+{
+public:
+  explicit WriteSliceStage(EbsdSliceConverter& converter)
+  : m_Converter(converter)
+  {
+  }
+
+  void operator()(EbsdSliceToken* token) const
+  {
+    m_Converter.writeSlice(token);
+  }
+
+private:
+  EbsdSliceConverter& m_Converter;
+};
+#endif
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -91,6 +680,8 @@ void EbsdToH5Ebsd::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(EbsdToH5EbsdFilterParameter::New("Import Orientation Data", "OrientationData", getOutputFile(), FilterParameter::Parameter, this));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Compression Level (0-9)", CompressionLevel, FilterParameter::Parameter, EbsdToH5Ebsd));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Shuffle Filter", UseShuffleFilter, FilterParameter::Parameter, EbsdToH5Ebsd));
 
   setFilterParameters(parameters);
 }
@@ -113,6 +704,8 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
+  setUseShuffleFilter(reader->readValue("UseShuffleFilter", getUseShuffleFilter()));
   reader->closeFilterGroup();
 }
 
@@ -138,6 +731,12 @@ void EbsdToH5Ebsd::dataCheck()
     setErrorCondition(-12, ss);
   }
 
+  if(m_CompressionLevel < 0 || m_CompressionLevel > 9)
+  {
+    ss = QObject::tr("The compression level must be between 0 (no compression) and 9");
+    setErrorCondition(-14, ss);
+  }
+
   QFileInfo fi(m_InputPath);
   if(m_InputPath.isEmpty())
   {
@@ -310,8 +909,6 @@ void EbsdToH5Ebsd::execute()
   QVector<QString> fileList =
       FilePathGenerator::GenerateFileList(m_ZStartIndex, m_ZEndIndex, increment, hasMissingFiles, stackLowToHigh, m_InputPath, m_FilePrefix, m_FileSuffix, m_FileExtension, m_PaddingDigits);
 
-  EbsdImporter::Pointer fileImporter;
-
   // Write the Manufacturer of the OIM file here
   // This list will grow to be the number of EBSD file formats we support
   QFileInfo fiExt(fileList.front());
@@ -325,7 +922,6 @@ void EbsdToH5Ebsd::execute()
       QString ss = QObject::tr("Could not write the Manufacturer Data to the HDF5 File");
       setErrorCondition(-1, ss);
     }
-    fileImporter = H5AngImporter::New();
   }
   else if(ext == EbsdLib::Ctf::FileExt)
   {
@@ -336,7 +932,6 @@ void EbsdToH5Ebsd::execute()
       QString ss = QObject::tr("Could not write the Manufacturer Data to the HDF5 File");
       setErrorCondition(-1, ss);
     }
-    fileImporter = H5CtfImporter::New();
     CtfReader ctfReader;
     ctfReader.setFileName(fileList.front().toStdString());
     err = ctfReader.readHeaderOnly();
@@ -356,13 +951,7 @@ void EbsdToH5Ebsd::execute()
     return;
   }
 
-  QVector<int32_t> indices;
   // Loop on Each EBSD File
-  float total = static_cast<float>(m_ZEndIndex - m_ZStartIndex);
-  int32_t progress = 0;
-  int64_t z = m_ZStartIndex;
-  int64_t xDim = 0, yDim = 0;
-  float xRes = 0.0f, yRes = 0.0f;
   /* There is a frailness about the z index and the file list. The programmer
    * using this code MUST ensure that the list of files that is sent into this
    * class is in the appropriate order to match up with the z index (slice index)
@@ -386,49 +975,38 @@ void EbsdToH5Ebsd::execute()
    * which is going to cause problems because the data is going to be placed
    * into the HDF5 file at the wrong index. YOU HAVE BEEN WARNED.
    */
-  int64_t biggestxDim = 0;
-  int64_t biggestyDim = 0;
-  int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
-    progress = static_cast<int32_t>(z - m_ZStartIndex);
-    progress = (int32_t)(100.0f * (float)(progress) / total);
-    QString msg = "Converting File: " + ebsdFName;
-
-    notifyStatusMessage(msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName.toStdString());
-    if(err < 0)
-    {
-      setErrorCondition(err, QString::fromStdString(fileImporter->getPipelineMessage()));
-      return;
-    }
-    totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
-
-    fileImporter->getDims(xDim, yDim);
-    fileImporter->getSpacing(xRes, yRes);
-    if(xDim > biggestxDim)
-    {
-      biggestxDim = xDim;
-    }
-    if(yDim > biggestyDim)
-    {
-      biggestyDim = yDim;
-    }
-
-    if(err < 0)
-    {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1, ss);
-    }
+  EbsdSliceConverter converter(this, fileId, fileList, ext, m_ZStartIndex);
+  converter.setCompression(m_CompressionLevel, m_UseShuffleFilter);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  // The files are parsed concurrently while a single serial stage writes them to the output file in order. Each
+  // parsed file that has not been written yet is held in memory, so the number of files in flight is bounded.
+  size_t maxFilesInFlight = 2 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  tbb::parallel_pipeline(maxFilesInFlight, tbb::make_filter<void, EbsdSliceToken*>(tbb::filter::serial_in_order, NextSliceStage(converter)) &
+                                               tbb::make_filter<EbsdSliceToken*, EbsdSliceToken*>(tbb::filter::parallel, ImportSliceStage(converter)) &
+                                               tbb::make_filter<EbsdSliceToken*, void>(tbb::filter::serial_in_order, WriteSliceStage(converter)));
+#else
+  for(EbsdSliceToken* token = converter.nextSlice(); token != nullptr; token = converter.nextSlice())
+  {
+    converter.writeSlice(converter.importSlice(token));
+  }
+#endif
 
-    indices.push_back(static_cast<int32_t>(z));
-    ++z;
-    if(getCancel())
-    {
-      return;
-    }
+  if(converter.getErrorCode() < 0)
+  {
+    setErrorCondition(converter.getErrorCode(), converter.getErrorMessage());
+    return;
   }
+  if(getCancel())
+  {
+    return;
+  }
+  int64_t biggestxDim = converter.getBiggestXDim();
+  int64_t biggestyDim = converter.getBiggestYDim();
+  int32_t totalSlicesImported = converter.getTotalSlicesImported();
+  float xRes = converter.getXRes();
+  float yRes = converter.getYRes();
+  QVector<int32_t> indices = converter.getIndices();
 
   // Write Z index start, Z index end and Z Spacing to the HDF5 file
   err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZStartIndex, m_ZStartIndex);
@@ -508,6 +1086,8 @@ AbstractFilter::Pointer EbsdToH5Ebsd::newFilterInstance(bool copyFilterParameter
     filter->setPaddingDigits(getPaddingDigits());
     filter->setSampleTransformation(getSampleTransformation());
     filter->setEulerTransformation(getEulerTransformation());
+    filter->setCompressionLevel(getCompressionLevel());
+    filter->setUseShuffleFilter(getUseShuffleFilter());
   }
   return filter;
 }
@@ -742,3 +1322,27 @@ AxisAngleInput_t EbsdToH5Ebsd::getEulerTransformation() const
 {
   return m_EulerTransformation;
 }
+
+// -----------------------------------------------------------------------------
+void EbsdToH5Ebsd::setCompressionLevel(int value)
+{
+  m_CompressionLevel = value;
+}
+
+// -----------------------------------------------------------------------------
+int EbsdToH5Ebsd::getCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
+
+// -----------------------------------------------------------------------------
+void EbsdToH5Ebsd::setUseShuffleFilter(bool value)
+{
+  m_UseShuffleFilter = value;
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdToH5Ebsd::getUseShuffleFilter() const
+{
+  return m_UseShuffleFilter;
+}
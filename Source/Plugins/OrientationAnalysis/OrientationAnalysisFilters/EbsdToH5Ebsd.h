@@ -69,6 +69,8 @@ class OrientationAnalysis_EXPORT EbsdToH5Ebsd : public AbstractFilter
   PYB11_PROPERTY(float ZResolution READ getZResolution WRITE setZResolution)
   PYB11_PROPERTY(AxisAngleInput_t SampleTransformation READ getSampleTransformation WRITE setSampleTransformation)
   PYB11_PROPERTY(AxisAngleInput_t EulerTransformation READ getEulerTransformation WRITE setEulerTransformation)
+  PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
+  PYB11_PROPERTY(bool UseShuffleFilter READ getUseShuffleFilter WRITE setUseShuffleFilter)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -222,6 +224,26 @@ public:
    */
   AxisAngleInput_t getEulerTransformation() const;
 
+  /**
+   * @brief Setter property for CompressionLevel
+   */
+  void setCompressionLevel(int value);
+  /**
+   * @brief Getter property for CompressionLevel
+   * @return Value of CompressionLevel
+   */
+  int getCompressionLevel() const;
+
+  /**
+   * @brief Setter property for UseShuffleFilter
+   */
+  void setUseShuffleFilter(bool value);
+  /**
+   * @brief Getter property for UseShuffleFilter
+   * @return Value of UseShuffleFilter
+   */
+  bool getUseShuffleFilter() const;
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -313,4 +335,6 @@ private:
   int m_PaddingDigits = {};
   AxisAngleInput_t m_SampleTransformation = {};
   AxisAngleInput_t m_EulerTransformation = {};
+  int m_CompressionLevel = 0;
+  bool m_UseShuffleFilter = false;
 };
@@ -35,6 +35,10 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <algorithm>
+#include <array>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -48,6 +52,7 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
@@ -57,6 +62,163 @@
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/Core/EbsdLibConstants.h"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class computes the Kernel Average Misorientation for a range of z slabs.
+ * The misorientation of a pair of Cells only depends on the pair, so each pair inside a kernel is computed once and
+ * credited to both Cells. Sums for the planes still receiving contributions are held in a sliding window of
+ * (KernelZ + 1) planes that is finalized one plane at a time.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(const SizeVec3Type& dims, const IntVec3Type& kernelSize, int64_t slabThickness, int32_t* featureIds, int32_t* cellPhases, float* quats, uint32_t* crystalStructures,
+                                   float* kernelAverageMisorientations)
+  : m_XPoints(static_cast<int64_t>(dims[0]))
+  , m_YPoints(static_cast<int64_t>(dims[1]))
+  , m_ZPoints(static_cast<int64_t>(dims[2]))
+  , m_SlabThickness(slabThickness)
+  , m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_Quats(quats)
+  , m_CrystalStructures(crystalStructures)
+  , m_KernelAverageMisorientations(kernelAverageMisorientations)
+  {
+    // Keep the offsets that come after the central Cell in memory order. Their mirror images are covered by
+    // crediting each pair to both of its Cells
+    for(int64_t j = 0; j <= kernelSize[2]; j++)
+    {
+      for(int64_t k = -kernelSize[1]; k <= kernelSize[1]; k++)
+      {
+        for(int64_t l = -kernelSize[0]; l <= kernelSize[0]; l++)
+        {
+          if(j > 0 || k > 0 || (k == 0 && l > 0))
+          {
+            m_Offsets.push_back({l, k, j});
+          }
+        }
+      }
+    }
+    m_WindowPlanes = std::max<int64_t>(kernelSize[2], 0) + 1;
+  }
+
+  virtual ~FindKernelAvgMisorientationsImpl() = default;
+
+  bool isActive(int64_t point) const
+  {
+    return m_FeatureIds[point] > 0 && m_CellPhases[point] > 0;
+  }
+
+  void compute(int64_t zStart, int64_t zEnd) const
+  {
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    const int64_t planeSize = m_XPoints * m_YPoints;
+    std::vector<float> windowSums(static_cast<size_t>(m_WindowPlanes * planeSize), 0.0f);
+    std::vector<int32_t> windowCounts(static_cast<size_t>(m_WindowPlanes * planeSize), 0);
+
+    auto credit = [&](int64_t point, float misorientation) {
+      size_t slot = static_cast<size_t>((point / planeSize) % m_WindowPlanes * planeSize + point % planeSize);
+      windowSums[slot] += misorientation;
+      windowCounts[slot]++;
+    };
+    auto misorientation = [&](int64_t point1, int64_t point2) {
+      QuatF q1(m_Quats + point1 * 4);
+      QuatF q2(m_Quats + point2 * 4);
+      OrientationF axisAngle = orientationOps[m_CrystalStructures[m_CellPhases[point1]]]->calculateMisorientation(q1, q2);
+      return static_cast<float>(axisAngle[3] * SIMPLib::Constants::k_180OverPi);
+    };
+
+    // Planes below the slab only contribute the pairs that reach into it
+    for(int64_t plane = std::max<int64_t>(zStart - (m_WindowPlanes - 1), 0); plane < zEnd; plane++)
+    {
+      bool planeOwned = plane >= zStart;
+      for(int64_t row = 0; row < m_YPoints; row++)
+      {
+        for(int64_t col = 0; col < m_XPoints; col++)
+        {
+          int64_t point = (plane * planeSize) + (row * m_XPoints) + col;
+          int32_t featureId = m_FeatureIds[point];
+          if(featureId <= 0)
+          {
+            continue;
+          }
+          bool pointActive = planeOwned && isActive(point);
+          if(pointActive)
+          {
+            credit(point, misorientation(point, point));
+          }
+          for(const auto& offset : m_Offsets)
+          {
+            if(col + offset[0] < 0 || col + offset[0] > m_XPoints - 1 || row + offset[1] < 0 || row + offset[1] > m_YPoints - 1 || plane + offset[2] > m_ZPoints - 1)
+            {
+              continue;
+            }
+            int64_t neighbor = point + (offset[2] * planeSize) + (offset[1] * m_XPoints) + offset[0];
+            if(m_FeatureIds[neighbor] != featureId)
+            {
+              continue;
+            }
+            bool neighborActive = plane + offset[2] >= zStart && plane + offset[2] < zEnd && isActive(neighbor);
+            bool shared = pointActive && neighborActive && m_CrystalStructures[m_CellPhases[point]] == m_CrystalStructures[m_CellPhases[neighbor]];
+            if(pointActive)
+            {
+              float value = misorientation(point, neighbor);
+              credit(point, value);
+              if(shared)
+              {
+                credit(neighbor, value);
+              }
+            }
+            if(neighborActive && !shared)
+            {
+              credit(neighbor, misorientation(neighbor, point));
+            }
+          }
+        }
+      }
+
+      // Nothing below can reach this plane any more
+      if(planeOwned)
+      {
+        size_t slotStart = static_cast<size_t>(plane % m_WindowPlanes * planeSize);
+        for(int64_t i = 0; i < planeSize; i++)
+        {
+          int64_t point = plane * planeSize + i;
+          size_t slot = slotStart + static_cast<size_t>(i);
+          m_KernelAverageMisorientations[point] = 0.0f;
+          if(isActive(point) && windowCounts[slot] > 0)
+          {
+            m_KernelAverageMisorientations[point] = windowSums[slot] / static_cast<float>(windowCounts[slot]);
+          }
+          windowSums[slot] = 0.0f;
+          windowCounts[slot] = 0;
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      int64_t zStart = static_cast<int64_t>(slab) * m_SlabThickness;
+      compute(zStart, std::min(zStart + m_SlabThickness, m_ZPoints));
+    }
+  }
+
+private:
+  int64_t m_XPoints = 0;
+  int64_t m_YPoints = 0;
+  int64_t m_ZPoints = 0;
+  int64_t m_SlabThickness = 1;
+  int64_t m_WindowPlanes = 1;
+  std::vector<std::array<int64_t, 3>> m_Offsets;
+  int32_t* m_FeatureIds = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  float* m_Quats = nullptr;
+  uint32_t* m_CrystalStructures = nullptr;
+  float* m_KernelAverageMisorientations = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -205,100 +367,21 @@ void FindKernelAvgMisorientations::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-  FloatArrayType::Pointer quatPtr = m_QuatsPtr.lock();
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float totalmisorientation = 0.0f;
-
-  uint32_t phase1 = EbsdLib::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = EbsdLib::CrystalStructure::UnknownCrystalStructure;
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
-
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
   int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
 
-  for(int64_t col = 0; col < xPoints; col++)
-  {
-    for(int64_t row = 0; row < yPoints; row++)
-    {
-      for(int64_t plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuatF q1(quatPtr->getTuplePointer(point));
-
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize[2]; j < m_KernelSize[2] + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize[1]; k < m_KernelSize[1] + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize[0]; l < m_KernelSize[0] + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  QuatF q2(quatPtr->getTuplePointer(neighbor));
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-
-                  totalmisorientation = totalmisorientation + (axisAngle[3] * SIMPLib::Constants::k_180OverPi);
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
-  }
+  // Split the volume into z slabs. Each slab recomputes the pairs that cross into it from the slab below, so keep
+  // the slabs thick compared to the kernel
+  int64_t kernelZ = std::max(m_KernelSize[2], 0);
+  int64_t slabCount = std::max<int64_t>(1, 4 * static_cast<int64_t>(std::thread::hardware_concurrency()));
+  int64_t slabThickness = std::max<int64_t>((zPoints + slabCount - 1) / slabCount, 4 * kernelZ);
+  slabThickness = std::max<int64_t>(slabThickness, 1);
+  slabCount = (zPoints + slabThickness - 1) / slabThickness;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabCount);
+  dataAlg.setGrain(1);
+  dataAlg.execute(FindKernelAvgMisorientationsImpl(udims, m_KernelSize, slabThickness, m_FeatureIds, m_CellPhases, m_Quats, m_CrystalStructures, m_KernelAverageMisorientations));
 }
 
 // -----------------------------------------------------------------------------
@@ -31,6 +31,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ImportEbsdMontage.h"
 
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
 #include <QtCore/QTextStream>
 #include <QtCore/QFileInfo>
 
@@ -41,6 +46,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/Montages/GridMontage.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -51,6 +57,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Montages/GridMontage.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
@@ -63,7 +70,11 @@
 
 enum createdPathID : RenameDataPath::DataID_t
 {
-  DataArrayID31 = 31
+  AttributeMatrixID21 = 21,
+
+  DataArrayID31 = 31,
+
+  DataContainerID = 1
 };
 
 // -----------------------------------------------------------------------------
@@ -101,7 +112,11 @@ void ImportEbsdMontage::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_EbsdMontageListInfo_FP("Input File List", InputFileListInfo, FilterParameter::Parameter, ImportEbsdMontage));
-  // parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportEbsdMontage));
+  {
+    QStringList linkedProps("DataContainerName");
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Stitch Tiles Into One Geometry", StitchTiles, FilterParameter::Parameter, ImportEbsdMontage, linkedProps));
+    parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ImportEbsdMontage));
+  }
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_STRING_FP("Name of Created Montage", MontageName, FilterParameter::CreatedArray, ImportEbsdMontage));
   parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix Name", CellAttributeMatrixName, FilterParameter::CreatedArray, ImportEbsdMontage));
@@ -126,23 +141,183 @@ void ImportEbsdMontage::setupFilterParameters()
   setFilterParameters(parameters);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <class EbsdReaderClass>
-void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<QString, AbstractFilter::Pointer>& prevFilterCache, std::map<QString, AbstractFilter::Pointer>& newFilterCache)
+namespace
 {
-  QFileInfo fi(fileName);
-  QString fname = fi.completeBaseName();
-  if(filter->getDataContainerArray()->doesDataContainerExist(fname))
+/**
+ * @brief The EbsdTile struct holds the reader and the data of one montage tile while the tiles are read concurrently.
+ */
+struct EbsdTile
+{
+  FilePathGenerator::TileRCIndex2D rcIndex;
+  QString name;
+  AbstractFilter::Pointer reader;
+  DataContainerArray::Pointer dca;
+  SizeVec3Type dims = {0, 0, 0};
+  std::array<size_t, 2> pixelOffset = {{0, 0}};
+  std::array<size_t, 2> pixelExtent = {{0, 0}};
+  bool keepData = true;
+  int32_t errorCode = 0;
+  QString errorMessage;
+};
+
+/**
+ * @brief The TileReadSettings struct holds what every tile needs to know while it is read on a worker thread.
+ */
+struct TileReadSettings
+{
+  bool readData = false;
+  QString phasesName;
+  QString eulersName;
+  QString xtalName;
+  FloatVec3Type referenceDir = {0.0f, 0.0f, 1.0f};
+  AttributeMatrix::Pointer montageAttrMat;
+  size_t montageDimX = 0;
+};
+
+/**
+ * @brief The ReadEbsdTilesImpl class runs the reader filter of each tile on its own DataContainerArray, followed by
+ * the optional IPF color generation for that tile. When a montage AttributeMatrix is given the tile is copied into it
+ * and released straight away, so only the tiles in flight are ever held in memory.
+ */
+class ReadEbsdTilesImpl
+{
+public:
+  ReadEbsdTilesImpl(ImportEbsdMontage* filter, std::vector<EbsdTile>& tiles, const TileReadSettings& settings)
+  : m_Filter(filter)
+  , m_Tiles(tiles)
+  , m_Settings(settings)
   {
-    QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(fname);
-    filter->setErrorCondition(-74000, msg);
-    return;
   }
 
-  DataContainerArray::Pointer dca = DataContainerArray::New();
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t t = range.min(); t < range.max(); t++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      readTile(m_Tiles[t]);
+    }
+  }
+
+private:
+  ImportEbsdMontage* m_Filter = nullptr;
+  std::vector<EbsdTile>& m_Tiles;
+  const TileReadSettings& m_Settings;
+
+  void readTile(EbsdTile& tile) const
+  {
+    tile.dca = DataContainerArray::New();
+    tile.reader->setDataContainerArray(tile.dca);
+    if(m_Settings.readData)
+    {
+      tile.reader->execute();
+    }
+    else
+    {
+      tile.reader->preflight();
+    }
+    if(tile.reader->getErrorCode() < 0)
+    {
+      tile.errorCode = tile.reader->getErrorCode();
+      tile.errorMessage = QString("Sub filter (%1) caused an error.").arg(tile.reader->getHumanLabel());
+      return;
+    }
+    tile.dims = tile.dca->getDataContainer(tile.name)->getGeometryAs<ImageGeom>()->getDimensions();
+
+    if(m_Filter->getGenerateIPFColorMap())
+    {
+      generateIPFColors(tile);
+      if(tile.errorCode < 0)
+      {
+        return;
+      }
+    }
+
+    if(m_Settings.readData && nullptr != m_Settings.montageAttrMat)
+    {
+      copyIntoMontage(tile);
+      if(tile.errorCode < 0)
+      {
+        return;
+      }
+      if(!tile.keepData)
+      {
+        tile.dca = DataContainerArray::NullPointer();
+      }
+    }
+  }
 
+  void generateIPFColors(EbsdTile& tile) const
+  {
+    DataArrayPath dap(tile.name, m_Filter->getCellAttributeMatrixName(), m_Filter->getCellIPFColorsArrayName());
+
+    GenerateIPFColors::Pointer generateIPFColors = GenerateIPFColors::New();
+    generateIPFColors->setDataContainerArray(tile.dca);
+    generateIPFColors->setReferenceDir(m_Settings.referenceDir);
+    dap.setDataArrayName(m_Settings.phasesName);
+    generateIPFColors->setCellPhasesArrayPath(dap);
+    dap.setDataArrayName(m_Settings.eulersName);
+    generateIPFColors->setCellEulerAnglesArrayPath(dap);
+
+    dap.setAttributeMatrixName(m_Filter->getCellEnsembleAttributeMatrixName());
+    dap.setDataArrayName(m_Settings.xtalName);
+    generateIPFColors->setCrystalStructuresArrayPath(dap);
+    generateIPFColors->setUseGoodVoxels(false);
+
+    generateIPFColors->setCellIPFColorsArrayName(m_Filter->getCellIPFColorsArrayName());
+    if(m_Settings.readData)
+    {
+      generateIPFColors->execute();
+    }
+    else
+    {
+      generateIPFColors->preflight();
+    }
+    if(generateIPFColors->getErrorCode() < 0)
+    {
+      tile.errorCode = generateIPFColors->getErrorCode();
+      tile.errorMessage = QObject::tr("GenerateIPFColors failed with error code %1").arg(generateIPFColors->getErrorCode());
+    }
+  }
+
+  /**
+   * @brief copyIntoMontage Copies the rows of the tile that are not covered by a later tile into the montage arrays.
+   * The copied regions of the tiles never overlap so the tiles can be copied concurrently.
+   */
+  void copyIntoMontage(EbsdTile& tile) const
+  {
+    AttributeMatrix::Pointer tileAttrMat = tile.dca->getDataContainer(tile.name)->getAttributeMatrix(m_Filter->getCellAttributeMatrixName());
+    for(const QString& arrayName : m_Settings.montageAttrMat->getAttributeArrayNames())
+    {
+      IDataArray::Pointer destArray = m_Settings.montageAttrMat->getAttributeArray(arrayName);
+      IDataArray::Pointer srcArray = tileAttrMat->getAttributeArray(arrayName);
+      if(nullptr == srcArray)
+      {
+        continue;
+      }
+      for(size_t y = 0; y < tile.pixelExtent[1]; y++)
+      {
+        size_t destTuple = (tile.pixelOffset[1] + y) * m_Settings.montageDimX + tile.pixelOffset[0];
+        if(!destArray->copyFromArray(destTuple, srcArray, y * tile.dims[0], tile.pixelExtent[0]))
+        {
+          tile.errorCode = -56510;
+          tile.errorMessage = QObject::tr("Error copying row %1 of the array '%2' into the montage").arg(y).arg(arrayName);
+          return;
+        }
+      }
+    }
+  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <class EbsdReaderClass>
+AbstractFilter::Pointer createEbsdReader(ImportEbsdMontage* filter, const QString& fileName, const QString& fname, std::map<QString, AbstractFilter::Pointer>& prevFilterCache,
+                                         std::map<QString, AbstractFilter::Pointer>& newFilterCache)
+{
   typename EbsdReaderClass::Pointer reader = EbsdReaderClass::NullPointer();
   if(prevFilterCache.find(fileName) != prevFilterCache.end())
   {
@@ -155,27 +330,115 @@ void readEbsdFile(ImportEbsdMontage* filter, const QString& fileName, std::map<Q
     reader->setDataContainerName(DataArrayPath(fname));
   }
   newFilterCache[fileName] = reader;
-  reader->setDataContainerArray(dca);
   reader->setCellEnsembleAttributeMatrixName(filter->getCellEnsembleAttributeMatrixName());
   reader->setCellAttributeMatrixName(filter->getCellAttributeMatrixName());
-  if(filter->getInPreflight())
+  return reader;
+}
+
+/**
+ * @brief readTiles Reads the tiles concurrently, one batch of tiles at a time, and reports their progress and errors on
+ * the filter once the batch is done since the filter can only be notified from the thread that runs it.
+ * @return false if any of the tiles failed or the filter was canceled
+ */
+bool readTiles(ImportEbsdMontage* filter, std::vector<EbsdTile>& tiles, const TileReadSettings& settings)
+{
+  const size_t totalTiles = tiles.size();
+  const size_t batchSize = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  for(size_t start = 0; start < totalTiles && !filter->getCancel(); start += batchSize)
   {
-    reader->preflight();
+    size_t end = std::min(start + batchSize, totalTiles);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(start, end);
+    dataAlg.setGrain(1);
+    dataAlg.execute(ReadEbsdTilesImpl(filter, tiles, settings));
+
+    for(size_t t = start; t < end; t++)
+    {
+      if(settings.readData)
+      {
+        filter->notifyStatusMessage(QString("Read EBSD File: [%1/%2] %3").arg(t + 1).arg(totalTiles).arg(tiles[t].rcIndex.FileName));
+      }
+      else
+      {
+        filter->notifyStatusMessage(QString("Caching EBSD Header: [%1/%2] %3").arg(t + 1).arg(totalTiles).arg(tiles[t].rcIndex.FileName));
+      }
+    }
   }
-  else
+
+  // The tiles were read on worker threads, so their errors are only reported now
+  for(const EbsdTile& tile : tiles)
   {
-    reader->execute();
+    if(tile.errorCode < 0)
+    {
+      filter->setErrorCondition(tile.errorCode, QString("%1: %2").arg(tile.name, tile.errorMessage));
+    }
   }
-  if(reader->getErrorCode() < 0)
+  return filter->getErrorCode() >= 0 && !filter->getCancel();
+}
+
+/**
+ * @brief stitchTiles Creates the stitched montage DataContainer and, when executing, reads every tile straight into it.
+ */
+DataContainer::Pointer stitchTiles(ImportEbsdMontage* filter, std::vector<EbsdTile>& tiles, const std::array<size_t, 2>& montageDims, TileReadSettings settings)
+{
+  DataContainer::Pointer m = filter->getDataContainerArray()->createNonPrereqDataContainer(filter, filter->getDataContainerName(), DataContainerID);
+  if(filter->getErrorCode() < 0)
   {
-    QString msg = QString("Sub filter (%1) caused an error.").arg(reader->getHumanLabel());
-    filter->setErrorCondition(reader->getErrorCode(), msg);
-    return;
+    return DataContainer::NullPointer();
+  }
+
+  // The geometry and the arrays of the montage follow the first tile
+  const EbsdTile& firstTile = tiles.front();
+  DataContainer::Pointer firstDC = firstTile.dca->getDataContainer(firstTile.name);
+  ImageGeom::Pointer firstGeom = firstDC->getGeometryAs<ImageGeom>();
+  FloatVec3Type origin = firstGeom->getOrigin();
+
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(filter->getDataContainerName().getDataContainerName());
+  image->setDimensions(SizeVec3Type(montageDims[0], montageDims[1], 1));
+  image->setSpacing(firstGeom->getSpacing());
+  image->setOrigin(FloatVec3Type(0.0f, 0.0f, origin[2]));
+  m->setGeometry(image);
+
+  std::vector<size_t> tDims = {montageDims[0], montageDims[1], 1};
+  size_t totalPoints = montageDims[0] * montageDims[1];
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(filter, filter->getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  if(filter->getErrorCode() < 0)
+  {
+    return DataContainer::NullPointer();
+  }
+  AttributeMatrix::Pointer firstAttrMat = firstDC->getAttributeMatrix(filter->getCellAttributeMatrixName());
+  for(const QString& arrayName : firstAttrMat->getAttributeArrayNames())
+  {
+    IDataArray::Pointer p = firstAttrMat->getAttributeArray(arrayName);
+    IDataArray::Pointer data = p->createNewArray(totalPoints, p->getComponentDimensions(), p->getName(), settings.readData);
+    if(settings.readData)
+    {
+      data->initializeWithZeros();
+    }
+    cellAttrMat->insertOrAssign(data);
   }
 
-  DataContainer::Pointer dc = dca->getDataContainer(fname);
-  filter->getDataContainerArray()->addOrReplaceDataContainer(dc);
+  if(settings.readData)
+  {
+    // Now read the cell data of every tile straight into the montage arrays
+    settings.montageAttrMat = cellAttrMat;
+    settings.montageDimX = montageDims[0];
+    if(!readTiles(filter, tiles, settings))
+    {
+      return DataContainer::NullPointer();
+    }
+    firstDC = firstTile.dca->getDataContainer(firstTile.name);
+  }
+
+  // All tiles are expected to have been collected with the same phases, so the ensemble data comes from the first tile
+  AttributeMatrix::Pointer ensembleAttrMat = firstDC->getAttributeMatrix(filter->getCellEnsembleAttributeMatrixName());
+  if(nullptr != ensembleAttrMat)
+  {
+    m->addOrReplaceAttributeMatrix(ensembleAttrMat);
+  }
+  return m;
 }
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -227,28 +490,46 @@ void ImportEbsdMontage::dataCheck()
     return;
   }
 
+  if(getGenerateIPFColorMap() && getCellIPFColorsArrayName().isEmpty())
+  {
+    ss = QObject::tr("Generate IPF Colors is ENABLED. Please set name for the generated IPColors DataArray");
+    setErrorCondition(-23500, ss);
+    return;
+  }
+
   int32_t numRows = static_cast<int32_t>(tileLayout2d.size());
   int32_t numCols = static_cast<int32_t>(tileLayout2d[0].size());
   int32_t totalTiles = numRows * numCols;
-  int32_t tilesRead = 0;
-
-  std::array<double, 2> globalTileOrigin = {{0.0, 0.0}};
 
-  std::map<QString, AbstractFilter::Pointer> oldCache = m_FilterCache;
+  QString phasesName;
+  QString eulersName;
+  QString xtalName;
+  if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ang::FileExt))
+  {
+    phasesName = S2Q(EbsdLib::AngFile::Phases);
+    eulersName = S2Q(EbsdLib::AngFile::EulerAngles);
+    xtalName = S2Q(EbsdLib::AngFile::CrystalStructures);
+  }
+  if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ctf::FileExt))
+  {
+    phasesName = S2Q(EbsdLib::CtfFile::Phases);
+    eulersName = S2Q(EbsdLib::CtfFile::EulerAngles);
+    xtalName = S2Q(EbsdLib::CtfFile::CrystalStructures);
+  }
 
   std::map<QString, AbstractFilter::Pointer> newFilterCache;
 
   size_t rows = static_cast<size_t>(m_InputFileListInfo.RowEnd - m_InputFileListInfo.RowStart);
   size_t cols = static_cast<size_t>(m_InputFileListInfo.ColEnd - m_InputFileListInfo.ColStart);
-  GridMontage::Pointer gridMontage = GridMontage::New(getMontageName(), rows, cols);
 
-  // Read all the files, caching the pertainent information....
-  for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
+  // Set up one reader filter per tile, reusing the cached readers so that the file headers are only parsed once.
+  std::vector<std::vector<size_t>> tileIndices(tileLayout2d.size());
+  std::vector<EbsdTile> tiles;
+  tiles.reserve(static_cast<size_t>(totalTiles));
+  for(size_t r = 0; r < tileLayout2d.size(); r++)
   {
-    globalTileOrigin[0] = 0.0; // Reset the X Coord back to Zero for each row.
-    for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
+    for(const FilePathGenerator::TileRCIndex2D& tile2D : tileLayout2d[r])
     {
-      tilesRead++;
       QFileInfo fi(tile2D.FileName);
       QString fname = fi.completeBaseName();
       if(!fi.exists())
@@ -257,26 +538,31 @@ void ImportEbsdMontage::dataCheck()
         setErrorCondition(-56500, msg);
         continue;
       }
-      if(getInPreflight())
-      {
-        QString msg = QString("Caching EBSD Header: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
-      }
-      else
+      if(!m_StitchTiles && getDataContainerArray()->doesDataContainerExist(fname))
       {
-        QString msg = QString("Read EBSD File: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-        notifyStatusMessage(msg);
+        QString msg = QString("Error: DataContainer '%1' already exists in the DataContainerArray.").arg(fname);
+        setErrorCondition(-74000, msg);
+        continue;
       }
-      GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
 
+      EbsdTile tile;
+      tile.rcIndex = tile2D;
+      tile.name = fname;
+      tile.keepData = !m_StitchTiles || tiles.empty();
       if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ang::FileExt))
       {
-        readEbsdFile<ReadAngData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        tile.reader = createEbsdReader<ReadAngData>(this, tile2D.FileName, fname, m_FilterCache, newFilterCache);
       }
       if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ctf::FileExt))
       {
-        readEbsdFile<ReadCtfData>(this, tile2D.FileName, m_FilterCache, newFilterCache);
+        tile.reader = createEbsdReader<ReadCtfData>(this, tile2D.FileName, fname, m_FilterCache, newFilterCache);
+      }
+      if(nullptr == tile.reader)
+      {
+        continue;
       }
+      tileIndices[r].push_back(tiles.size());
+      tiles.push_back(tile);
     }
   }
   // If anything went wrong bail out now.....
@@ -285,7 +571,20 @@ void ImportEbsdMontage::dataCheck()
     return;
   }
 
-  tilesRead = 0;
+  // Read all the tiles concurrently, each into its own DataContainerArray. When stitching, only the headers are read here
+  // since the size of the montage has to be known before the cell data can be copied into it.
+  bool readData = !getInPreflight();
+  bool readTilesNow = readData && !m_StitchTiles;
+  TileReadSettings settings;
+  settings.readData = readTilesNow;
+  settings.phasesName = phasesName;
+  settings.eulersName = eulersName;
+  settings.xtalName = xtalName;
+  settings.referenceDir = m_ReferenceDir;
+  if(!readTiles(this, tiles, settings))
+  {
+    return;
+  }
 
   // Copy to local variable since we may be modifying the value.....
   IntVec2Type scanOverlapPixel = m_ScanOverlapPixel;
@@ -302,71 +601,41 @@ void ImportEbsdMontage::dataCheck()
       m_ScanOverlapPercent[1] = m_ScanOverlapPercent[1] / 100.0f;
     }
     scanOverlapPixel = {0, 0};
-    QFileInfo fi;
-    if(cols < 3) // 1 or 2 colums
-    {
-      fi = QFileInfo(tileLayout2d[0][0].FileName);
-    }
-    else
+    size_t tileIndex = tileIndices[0][0];
+    if(cols >= 3 && tileIndices[0].size() > 1) // 3 or more columns
     {
-      fi = QFileInfo(tileLayout2d[0][1].FileName);
+      tileIndex = tileIndices[0][1];
     }
+    scanOverlapPixel[0] = static_cast<int32_t>(static_cast<float>(tiles[tileIndex].dims[0]) * m_ScanOverlapPercent[0]);
 
-    QString fname = fi.completeBaseName();
-    DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(fname);
-    ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
-
-    SizeVec3Type dims = imageGeom->getDimensions();
-    FloatVec3Type spacing = imageGeom->getSpacing();
-    FloatVec3Type origin = imageGeom->getOrigin();
-
-    scanOverlapPixel[0] = static_cast<int32_t>(static_cast<float>(dims[0]) * m_ScanOverlapPercent[0]);
-
-    if(rows > 3) // 3 or more rows
+    if(rows > 3 && tileIndices.size() > 1 && !tileIndices[1].empty()) // 3 or more rows
     {
-      fi = QFileInfo(tileLayout2d[1][0].FileName);
+      tileIndex = tileIndices[1][0];
     }
-
-    fname = fi.completeBaseName();
-    dc = getDataContainerArray()->getDataContainer(fname);
-    imageGeom = dc->getGeometryAs<ImageGeom>();
-
-    dims = imageGeom->getDimensions();
-    spacing = imageGeom->getSpacing();
-    origin = imageGeom->getOrigin();
-
-    scanOverlapPixel[1] = static_cast<int32_t>(static_cast<float>(dims[1]) * m_ScanOverlapPercent[1]);
+    scanOverlapPixel[1] = static_cast<int32_t>(static_cast<float>(tiles[tileIndex].dims[1]) * m_ScanOverlapPercent[1]);
+  }
+  if(m_DefineScanOverlap == OverlapType::None)
+  {
+    scanOverlapPixel = {0, 0};
   }
 
-  // Now roll back over all the input files and calculate the proper origins of each tile.
-  for(const FilePathGenerator::TileRCIndexRow2D& tileRow2D : tileLayout2d)
+  GridMontage::Pointer gridMontage = GridMontage::New(getMontageName(), rows, cols);
+
+  // Now roll back over all the tiles and calculate the proper origins, and pixel offsets within the stitched montage, of each tile.
+  std::array<double, 2> globalTileOrigin = {{0.0, 0.0}};
+  std::array<size_t, 2> globalPixelOffset = {{0, 0}};
+  std::array<size_t, 2> montageDims = {{0, 0}};
+  for(size_t r = 0; r < tileIndices.size(); r++)
   {
     globalTileOrigin[0] = 0.0; // Reset the X Coord back to Zero for each row.
+    globalPixelOffset[0] = 0;
     double tileHeight = 0.0;
-    for(const FilePathGenerator::TileRCIndex2D& tile2D : tileRow2D)
+    size_t tilePixelHeight = 0;
+    for(size_t c = 0; c < tileIndices[r].size(); c++)
     {
-      QFileInfo fi(tile2D.FileName);
-      QString fname = fi.completeBaseName();
-
-      GridTileIndex gridIndex = gridMontage->getTileIndex(tile2D.data[0], tile2D.data[1]);
-      QString phasesName;
-      QString eulersName;
-      QString xtalName;
+      EbsdTile& tile = tiles[tileIndices[r][c]];
 
-      if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ang::FileExt))
-      {
-        phasesName = S2Q(EbsdLib::AngFile::Phases);
-        eulersName = S2Q(EbsdLib::AngFile::EulerAngles);
-        xtalName = S2Q(EbsdLib::AngFile::CrystalStructures);
-      }
-      if(m_InputFileListInfo.FileExtension == S2Q(EbsdLib::Ctf::FileExt))
-      {
-        phasesName = S2Q(EbsdLib::CtfFile::Phases);
-        eulersName = S2Q(EbsdLib::CtfFile::EulerAngles);
-        xtalName = S2Q(EbsdLib::CtfFile::CrystalStructures);
-      }
-
-      DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(fname);
+      DataContainer::Pointer dc = tile.dca->getDataContainer(tile.name);
       ImageGeom::Pointer imageGeom = dc->getGeometryAs<ImageGeom>();
 
       SizeVec3Type dims = imageGeom->getDimensions();
@@ -379,91 +648,55 @@ void ImportEbsdMontage::dataCheck()
       imageGeom->setOrigin(origin);
 
       // Now update the globalTileOrigin values
-      switch(m_DefineScanOverlap)
-      {
-      case OverlapType::None:
-        globalTileOrigin[0] = origin[0] + (dims[0] * spacing[0]);
-        tileHeight = (dims[1] * spacing[1]);
-        break;
-      case OverlapType::Pixels:
-        globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
-        tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
-        break;
-      case OverlapType::Percent:
-        globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
-        tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
-        break;
-      }
-
-      // Set the montage's DataContainer for the current index
-      gridMontage->setDataContainer(gridIndex, dc);
-
-      if(getCancel())
-      {
-        return;
-      }
-      tilesRead++;
-
-      if(getGenerateIPFColorMap())
+      globalTileOrigin[0] = origin[0] + ((dims[0] - scanOverlapPixel[0]) * spacing[0]);
+      tileHeight = ((dims[1] - scanOverlapPixel[1]) * spacing[1]);
+
+      // The overlapping pixels of a tile are taken from the tile to its right or below it, when there is one
+      size_t overlapX = (c + 1 < tileIndices[r].size()) ? std::min(static_cast<size_t>(std::max(scanOverlapPixel[0], 0)), dims[0]) : 0;
+      size_t overlapY = (r + 1 < tileIndices.size()) ? std::min(static_cast<size_t>(std::max(scanOverlapPixel[1], 0)), dims[1]) : 0;
+      tile.pixelOffset = globalPixelOffset;
+      tile.pixelExtent = {{dims[0] - overlapX, dims[1] - overlapY}};
+      montageDims[0] = std::max(montageDims[0], tile.pixelOffset[0] + tile.pixelExtent[0]);
+      montageDims[1] = std::max(montageDims[1], tile.pixelOffset[1] + tile.pixelExtent[1]);
+      globalPixelOffset[0] += dims[0] - std::min(static_cast<size_t>(std::max(scanOverlapPixel[0], 0)), dims[0]);
+      tilePixelHeight = dims[1] - std::min(static_cast<size_t>(std::max(scanOverlapPixel[1], 0)), dims[1]);
+
+      if(!m_StitchTiles)
       {
-        if(getCellIPFColorsArrayName().isEmpty())
-        {
-          ss = QObject::tr("Generate IPF Colors is ENABLED. Please set name for the generated IPColors DataArray");
-          setErrorCondition(-23500, ss);
-        }
-        else
-        {
-          DataArrayPath dap(fname, getCellAttributeMatrixName(), getCellIPFColorsArrayName());
-          // QVector<size_t> cDims = {3};
-
-          GenerateIPFColors::Pointer generateIPFColors = GenerateIPFColors::New();
-          generateIPFColors->setDataContainerArray(getDataContainerArray());
-          generateIPFColors->setReferenceDir(m_ReferenceDir);
-          dap.setDataArrayName(phasesName);
-          generateIPFColors->setCellPhasesArrayPath(dap);
-          dap.setDataArrayName(eulersName);
-          generateIPFColors->setCellEulerAnglesArrayPath(dap);
-
-          dap.setAttributeMatrixName(getCellEnsembleAttributeMatrixName());
-          dap.setDataArrayName(xtalName);
-          generateIPFColors->setCrystalStructuresArrayPath(dap);
-          generateIPFColors->setUseGoodVoxels(false);
-
-          generateIPFColors->setCellIPFColorsArrayName(getCellIPFColorsArrayName());
-          if(getInPreflight())
-          {
-            generateIPFColors->preflight();
-            if(generateIPFColors->getErrorCode() < 0)
-            {
-              ss = QObject::tr("Preflight of GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
-              setErrorCondition(generateIPFColors->getErrorCode(), ss);
-            }
-          }
-          else
-          {
-            QString msg = QString("Generating IPF Colors: [%1/%2] %3").arg(tilesRead).arg(totalTiles).arg(tile2D.FileName);
-            notifyStatusMessage(msg);
-            generateIPFColors->execute();
-            if(generateIPFColors->getErrorCode() < 0)
-            {
-              ss = QObject::tr("GenerateIPFColors failed with error code ").arg(generateIPFColors->getErrorCode());
-              setErrorCondition(generateIPFColors->getErrorCode(), ss);
-            }
-          }
-        }
+        // Set the montage's DataContainer for the current index
+        GridTileIndex gridIndex = gridMontage->getTileIndex(tile.rcIndex.data[0], tile.rcIndex.data[1]);
+        getDataContainerArray()->addOrReplaceDataContainer(dc);
+        gridMontage->setDataContainer(gridIndex, dc);
       }
     }
 
-    // Now that we have all the tiles, if we are using percent overlaps we can now calculate the overlaps.
-
     globalTileOrigin[1] += tileHeight;
+    globalPixelOffset[1] += tilePixelHeight;
   }
+
+  if(m_StitchTiles)
+  {
+    if(readData)
+    {
+      notifyStatusMessage(QString("Stitching %1 EBSD Files").arg(totalTiles));
+    }
+    settings.readData = readData;
+    DataContainer::Pointer stitchedDC = stitchTiles(this, tiles, montageDims, settings);
+    if(getErrorCode() < 0 || getCancel())
+    {
+      return;
+    }
+    gridMontage = GridMontage::New(getMontageName(), 1, 1);
+    gridMontage->setDataContainer(gridMontage->getTileIndex(0, 0), stitchedDC);
+  }
+
   getDataContainerArray()->addOrReplaceMontage(gridMontage);
 
   m_FilterCache = newFilterCache; // Swap our maps. This dumps any previous instantiations of the reader filter that are not used any more.
   clearWarningCode();
 }
 
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -636,6 +869,18 @@ bool ImportEbsdMontage::getGenerateIPFColorMap() const
 {
   return m_GenerateIPFColorMap;
 }
+// -----------------------------------------------------------------------------
+void ImportEbsdMontage::setStitchTiles(bool value)
+{
+  m_StitchTiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ImportEbsdMontage::getStitchTiles() const
+{
+  return m_StitchTiles;
+}
+
 // -----------------------------------------------------------------------------
 void ImportEbsdMontage::setCellIPFColorsArrayName(const QString& value)
 {
@@ -66,6 +66,7 @@ class OrientationAnalysis_EXPORT ImportEbsdMontage : public AbstractFilter
   PYB11_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
   PYB11_PROPERTY(EbsdMontageListInfo InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
   PYB11_PROPERTY(bool GenerateIPFColorMap READ getGenerateIPFColorMap WRITE setGenerateIPFColorMap)
+  PYB11_PROPERTY(bool StitchTiles READ getStitchTiles WRITE setStitchTiles)
   PYB11_PROPERTY(QString CellIPFColorsArrayName READ getCellIPFColorsArrayName WRITE setCellIPFColorsArrayName)
   PYB11_PROPERTY(int32_t DefineScanOverlap READ getDefineScanOverlap WRITE setDefineScanOverlap)
   PYB11_PROPERTY(FloatVec2Type ScanOverlapPercent READ getScanOverlapPercent WRITE setScanOverlapPercent)
@@ -176,6 +177,17 @@ public:
   bool getGenerateIPFColorMap() const;
   Q_PROPERTY(bool GenerateIPFColorMap READ getGenerateIPFColorMap WRITE setGenerateIPFColorMap)
 
+  /**
+   * @brief Setter property for StitchTiles
+   */
+  void setStitchTiles(bool value);
+  /**
+   * @brief Getter property for StitchTiles
+   * @return Value of StitchTiles
+   */
+  bool getStitchTiles() const;
+  Q_PROPERTY(bool StitchTiles READ getStitchTiles WRITE setStitchTiles)
+
   /**
    * @brief Setter property for CellIPFColorsArrayName
    */
@@ -303,6 +315,7 @@ private:
   FloatVec3Type m_ReferenceDir = {0.0f, 0.0f, 1.0f};
 
   bool m_GenerateIPFColorMap = false;
+  bool m_StitchTiles = false;
   QString m_CellIPFColorsArrayName = QString(SIMPL::CellData::IPFColor);
 
 public:
@@ -34,26 +34,40 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ReadH5Ebsd.h"
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include <hdf5.h>
+
 #include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/IO/H5EbsdVolumeInfo.h"
 #include "EbsdLib/IO/HKL/CtfFields.h"
+#include "EbsdLib/IO/HKL/H5CtfReader.h"
 #include "EbsdLib/IO/HKL/H5CtfVolumeReader.h"
 #include "EbsdLib/IO/TSL/AngFields.h"
+#include "EbsdLib/IO/TSL/H5AngReader.h"
 #include "EbsdLib/IO/TSL/H5AngVolumeReader.h"
 
 #include "OrientationAnalysis/FilterParameters/ReadH5EbsdFilterParameter.h"
@@ -81,6 +95,219 @@ std::set<std::string> convertToStl(const QSet<QString>& in)
   return out;
 }
 
+/**
+ * @brief The SliceLoadSettings struct describes where the cells of every slice of the file are placed and how
+ * their values are converted on the way
+ */
+struct SliceLoadSettings
+{
+  std::string fileName;
+  std::set<std::string> arraysToRead;
+  int32_t sliceStart = 0;
+  size_t zPoints = 0;
+  bool reverseStacking = false;
+
+  // Size of the volume in the file and the inclusive x/y window of it that is kept
+  int64_t fileXPoints = 0;
+  int64_t fileYPoints = 0;
+  int64_t xStart = 0;
+  int64_t xEnd = 0;
+  int64_t yStart = 0;
+  int64_t yEnd = 0;
+
+  // Arrays that are copied without any conversion
+  std::vector<std::pair<std::string, float*>> floatArrays;
+  std::vector<std::pair<std::string, int32_t*>> intArrays;
+
+  std::array<std::string, 3> eulerNames;
+  float* eulers = nullptr;
+  float degToRad = 1.0f;
+  std::string phaseName;
+  int32_t* phases = nullptr;
+
+  // HKL files store hexagonal orientations with the other axis alignment, see the filter documentation
+  bool hexagonalOffset = false;
+  const uint32_t* crystalStructures = nullptr;
+  size_t numEnsembles = 0;
+
+  bool rotateEulers = false;
+  float rotMat[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
+  std::mutex hdf5Mutex;
+  std::mutex errorMutex;
+  std::atomic<int32_t> errorCode{0};
+  QString errorMessage;
+};
+
+void getSliceDimensions(H5AngReader* reader, int64_t& xPoints, int64_t& yPoints)
+{
+  xPoints = reader->getNumEvenCols();
+  yPoints = reader->getNumRows();
+}
+
+void getSliceDimensions(H5CtfReader* reader, int64_t& xPoints, int64_t& yPoints)
+{
+  xPoints = reader->getXCells();
+  yPoints = reader->getYCells();
+}
+
+/**
+ * @brief The ReadSlicesImpl class reads a range of slices with its own slice reader and places their cells directly
+ * into the cell arrays. Slices smaller than the volume are centered in it, the same way H5EbsdVolumeReader::loadData()
+ * places them.
+ */
+template <typename ReaderType>
+class ReadSlicesImpl
+{
+public:
+  ReadSlicesImpl(SliceLoadSettings& settings)
+  : m_Settings(settings)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slice = range.min(); slice < range.max(); slice++)
+    {
+      if(m_Settings.errorCode < 0 || !readSlice(slice))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  SliceLoadSettings& m_Settings;
+
+  void setError(int32_t code, const QString& message) const
+  {
+    std::lock_guard<std::mutex> lock(m_Settings.errorMutex);
+    if(m_Settings.errorCode == 0)
+    {
+      m_Settings.errorMessage = message;
+      m_Settings.errorCode = code;
+    }
+  }
+
+  bool readSlice(size_t slice) const
+  {
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->setFileName(m_Settings.fileName);
+    reader->setHDF5Path(std::to_string(m_Settings.sliceStart + static_cast<int32_t>(slice)));
+    reader->readAllArrays(false);
+    reader->setArraysToRead(m_Settings.arraysToRead);
+    {
+#if !defined(H5_HAVE_THREADSAFE)
+      // Without a thread safe HDF5 library only one thread may be inside it at a time. The placement and
+      // conversion of the cells below still runs concurrently.
+      std::lock_guard<std::mutex> lock(m_Settings.hdf5Mutex);
+#endif
+      int32_t err = reader->readFile();
+      if(err < 0)
+      {
+        setError(err, QObject::tr("Error reading slice %1 of the H5Ebsd file: %2").arg(m_Settings.sliceStart + static_cast<int32_t>(slice)).arg(S2Q(reader->getErrorMessage())));
+        return false;
+      }
+    }
+
+    std::vector<std::pair<const float*, float*>> floatCopies;
+    for(const auto& array : m_Settings.floatArrays)
+    {
+      const float* source = reinterpret_cast<const float*>(reader->getPointerByName(array.first));
+      if(nullptr != source)
+      {
+        floatCopies.emplace_back(source, array.second);
+      }
+    }
+    std::vector<std::pair<const int32_t*, int32_t*>> intCopies;
+    for(const auto& array : m_Settings.intArrays)
+    {
+      const int32_t* source = reinterpret_cast<const int32_t*>(reader->getPointerByName(array.first));
+      if(nullptr != source)
+      {
+        intCopies.emplace_back(source, array.second);
+      }
+    }
+    const float* e1 = nullptr;
+    const float* e2 = nullptr;
+    const float* e3 = nullptr;
+    if(nullptr != m_Settings.eulers)
+    {
+      e1 = reinterpret_cast<const float*>(reader->getPointerByName(m_Settings.eulerNames[0]));
+      e2 = reinterpret_cast<const float*>(reader->getPointerByName(m_Settings.eulerNames[1]));
+      e3 = reinterpret_cast<const float*>(reader->getPointerByName(m_Settings.eulerNames[2]));
+    }
+    const bool hasEulers = (nullptr != e1 && nullptr != e2 && nullptr != e3);
+    const int32_t* phaseSource = m_Settings.phaseName.empty() ? nullptr : reinterpret_cast<const int32_t*>(reader->getPointerByName(m_Settings.phaseName));
+
+    int64_t sliceXPoints = 0;
+    int64_t sliceYPoints = 0;
+    getSliceDimensions(reader.get(), sliceXPoints, sliceYPoints);
+    const int64_t xOffset = (m_Settings.fileXPoints - sliceXPoints) / 2;
+    const int64_t yOffset = (m_Settings.fileYPoints - sliceYPoints) / 2;
+    const size_t width = static_cast<size_t>(m_Settings.xEnd - m_Settings.xStart + 1);
+    const size_t height = static_cast<size_t>(m_Settings.yEnd - m_Settings.yStart + 1);
+    const size_t z = m_Settings.reverseStacking ? (m_Settings.zPoints - 1 - slice) : slice;
+
+    // Only the columns of the slice that fall inside the window are visited
+    const int64_t iStart = std::max<int64_t>(0, m_Settings.xStart - xOffset);
+    const int64_t iEnd = std::min<int64_t>(sliceXPoints, m_Settings.xEnd - xOffset + 1);
+    const int64_t jStart = std::max<int64_t>(0, m_Settings.yStart - yOffset);
+    const int64_t jEnd = std::min<int64_t>(sliceYPoints, m_Settings.yEnd - yOffset + 1);
+
+    const float degToRad = m_Settings.degToRad;
+    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float gNew[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    for(int64_t j = jStart; j < jEnd; j++)
+    {
+      const size_t row = (z * height + static_cast<size_t>(j + yOffset - m_Settings.yStart)) * width;
+      for(int64_t i = iStart; i < iEnd; i++)
+      {
+        const size_t source = static_cast<size_t>(j * sliceXPoints + i);
+        const size_t index = row + static_cast<size_t>(i + xOffset - m_Settings.xStart);
+        for(const auto& copy : floatCopies)
+        {
+          copy.second[index] = copy.first[source];
+        }
+        for(const auto& copy : intCopies)
+        {
+          copy.second[index] = copy.first[source];
+        }
+        if(nullptr != m_Settings.phases && nullptr != phaseSource)
+        {
+          m_Settings.phases[index] = phaseSource[source];
+        }
+        if(!hasEulers)
+        {
+          continue;
+        }
+        float* eu = m_Settings.eulers + 3 * index;
+        eu[0] = e1[source] * degToRad;
+        eu[1] = e2[source] * degToRad;
+        eu[2] = e3[source] * degToRad;
+        if(m_Settings.hexagonalOffset && nullptr != phaseSource)
+        {
+          int32_t phase = phaseSource[source];
+          if(phase >= 0 && static_cast<size_t>(phase) < m_Settings.numEnsembles && m_Settings.crystalStructures[phase] == EbsdLib::CrystalStructure::Hexagonal_High)
+          {
+            eu[2] = eu[2] + (30.0 * degToRad);
+          }
+        }
+        if(m_Settings.rotateEulers)
+        {
+          // Same as RotateEulerRefFrame
+          OrientationTransformation::eu2om<OrientationF, OrientationF>(OrientationF(eu[0], eu[1], eu[2])).toGMatrix(g);
+          MatrixMath::Multiply3x3with3x3(g, m_Settings.rotMat, gNew);
+          MatrixMath::Normalize3x3(gNew);
+          OrientationF rotated(eu, 3);
+          rotated = OrientationTransformation::om2eu<OrientationF, OrientationF>(OrientationF(gNew));
+        }
+      }
+    }
+    return true;
+  }
+};
+
 #if 0
 QSet<QString> convertToQt(std::set<std::string>& in)
 {
@@ -104,6 +331,11 @@ ReadH5Ebsd::ReadH5Ebsd()
 , m_PhaseNameArrayName("")
 , m_MaterialNameArrayName(SIMPL::EnsembleData::MaterialName)
 , m_InputFile("")
+, m_UseXYWindow(false)
+, m_XStartIndex(0)
+, m_XEndIndex(0)
+, m_YStartIndex(0)
+, m_YEndIndex(0)
 , m_UseTransformations(true)
 , m_AngleRepresentation(EbsdLib::AngleRepresentation::Radians)
 , m_RefFrameZDir(SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
@@ -138,6 +370,12 @@ void ReadH5Ebsd::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(ReadH5EbsdFilterParameter::New("Import H5Ebsd File", "ReadH5Ebsd", "__NULL__", FilterParameter::Parameter, this, "h5ebsd", "H5Ebsd"));
+  QStringList linkedProps = {"XStartIndex", "XEndIndex", "YStartIndex", "YEndIndex"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Read X/Y Window", UseXYWindow, FilterParameter::Parameter, ReadH5Ebsd, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("X Start Index", XStartIndex, FilterParameter::Parameter, ReadH5Ebsd));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("X End Index", XEndIndex, FilterParameter::Parameter, ReadH5Ebsd));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Y Start Index", YStartIndex, FilterParameter::Parameter, ReadH5Ebsd));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Y End Index", YEndIndex, FilterParameter::Parameter, ReadH5Ebsd));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadH5Ebsd));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadH5Ebsd));
@@ -157,6 +395,11 @@ void ReadH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader, in
   setRefFrameZDir((reader->readValue("RefFrameZDir", getRefFrameZDir())));
   setZStartIndex(reader->readValue("ZStartIndex", getZStartIndex()));
   setZEndIndex(reader->readValue("ZEndIndex", getZEndIndex()));
+  setUseXYWindow(reader->readValue("UseXYWindow", getUseXYWindow()));
+  setXStartIndex(reader->readValue("XStartIndex", getXStartIndex()));
+  setXEndIndex(reader->readValue("XEndIndex", getXEndIndex()));
+  setYStartIndex(reader->readValue("YStartIndex", getYStartIndex()));
+  setYEndIndex(reader->readValue("YEndIndex", getYEndIndex()));
   setUseTransformations(reader->readValue("UseTransformations", getUseTransformations()));
   setSelectedArrayNames(reader->readArraySelections("SelectedArrayNames", getSelectedArrayNames()));
   setAngleRepresentation(reader->readValue("AngleRepresentation", getAngleRepresentation()));
@@ -375,6 +618,23 @@ void ReadH5Ebsd::dataCheck()
   size_t dcDims[3] = {static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2])};
   // Now Calculate our "subvolume" of slices, ie, those start and end values that the user selected from the GUI
   dcDims[2] = m_ZEndIndex - m_ZStartIndex + 1;
+  if(m_UseXYWindow)
+  {
+    if(m_XEndIndex < m_XStartIndex || m_YEndIndex < m_YStartIndex)
+    {
+      QString ss = QObject::tr("The X/Y window end indices [%1, %2] MUST NOT be smaller than the start indices [%3, %4]").arg(m_XEndIndex).arg(m_YEndIndex).arg(m_XStartIndex).arg(m_YStartIndex);
+      setErrorCondition(-13, ss);
+      return;
+    }
+    if(m_XStartIndex < 0 || m_YStartIndex < 0 || m_XEndIndex >= dims[0] || m_YEndIndex >= dims[1])
+    {
+      QString ss = QObject::tr("The X/Y window [%1-%2, %3-%4] is outside of the volume, which has %5 x %6 cells").arg(m_XStartIndex).arg(m_XEndIndex).arg(m_YStartIndex).arg(m_YEndIndex).arg(dims[0]).arg(dims[1]);
+      setErrorCondition(-14, ss);
+      return;
+    }
+    dcDims[0] = m_XEndIndex - m_XStartIndex + 1;
+    dcDims[1] = m_YEndIndex - m_YStartIndex + 1;
+  }
   m->getGeometryAs<ImageGeom>()->setDimensions(dcDims);
   m->getGeometryAs<ImageGeom>()->setSpacing(res);
 
@@ -510,6 +770,8 @@ void ReadH5Ebsd::execute()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   std::string manufacturer;
+  int64_t fileXPoints = 0;
+  int64_t fileYPoints = 0;
   // Get the Size and Spacing of the Volume
   {
     H5EbsdVolumeInfo::Pointer volumeInfoReader = H5EbsdVolumeInfo::New();
@@ -524,12 +786,10 @@ void ReadH5Ebsd::execute()
     FloatVec3Type res = {0.0f, 0.0f, 0.0f};
     volumeInfoReader->getDimsAndResolution(dims[0], dims[1], dims[2], res[0], res[1], res[2]);
 
-    size_t dcDims[3] = {static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2])};
-    m->getGeometryAs<ImageGeom>()->setDimensions(dcDims);
+    // The dimensions of the (sub)volume were already set by dataCheck()
+    fileXPoints = dims[0];
+    fileYPoints = dims[1];
     m->getGeometryAs<ImageGeom>()->setSpacing(res);
-    // Now Calculate our "subvolume" of slices, ie, those start and end values that the user selected from the GUI
-    dcDims[2] = m_ZEndIndex - m_ZStartIndex + 1;
-    m->getGeometryAs<ImageGeom>()->setDimensions(dcDims);
     manufacturer = volumeInfoReader->getManufacturer();
     m_RefFrameZDir = volumeInfoReader->getStackingOrder();
 
@@ -546,14 +806,15 @@ void ReadH5Ebsd::execute()
     m_EulerTransformation.angle = volumeInfoReader->getEulerTransformationAngle();
     volumeInfoReader = H5EbsdVolumeInfo::NullPointer();
   }
-  H5EbsdVolumeReader::Pointer ebsdReader;
+  // Fill the Ensemble arrays from the phase information in the file
+  int32_t err = 0;
   if(manufacturer == EbsdLib::Ang::Manufacturer)
   {
-    ebsdReader = initTSLEbsdVolumeReader();
+    err = readTSLEnsembleInfo();
   }
   else if(manufacturer == EbsdLib::Ctf::Manufacturer)
   {
-    ebsdReader = initHKLEbsdVolumeReader();
+    err = readHKLEnsembleInfo();
   }
   else
   {
@@ -564,8 +825,8 @@ void ReadH5Ebsd::execute()
     return;
   }
 
-  // Sanity Check the Error Condition or the state of the EBSD Reader Object.
-  if(getErrorCode() < 0 || nullptr == ebsdReader.get())
+  // Sanity Check the Error Condition
+  if(getErrorCode() < 0 || err < 0)
   {
     return;
   }
@@ -575,34 +836,21 @@ void ReadH5Ebsd::execute()
     QString ss = QObject::tr("Reading Ebsd Data from file %1").arg(getInputFile());
     notifyStatusMessage(ss);
   }
-  ebsdReader->setSliceStart(m_ZStartIndex);
-  ebsdReader->setSliceEnd(m_ZEndIndex);
-  ebsdReader->readAllArrays(false);
-  ebsdReader->setArraysToRead(::convertToStl(m_SelectedArrayNames));
-  int err = ebsdReader->loadData(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
-  if(err < 0)
-  {
-    setErrorCondition(err, S2Q(ebsdReader->getErrorMessage()));
-    setErrorCondition(-1, "Error Loading Data from Ebsd Data file.");
-    return;
-  }
-
-  // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
+  std::vector<std::string> featureNames;
   if(manufacturer == EbsdLib::Ang::Manufacturer)
   {
-    copyTSLArrays(ebsdReader.get());
+    AngFields angFeatures;
+    featureNames = angFeatures.getFilterFeatures<std::vector<std::string>>();
   }
-  else if(manufacturer == EbsdLib::Ctf::Manufacturer)
+  else
   {
-    copyHKLArrays(ebsdReader.get());
+    CtfFields ctfFeatures;
+    featureNames = ctfFeatures.getFilterFeatures<std::vector<std::string>>();
   }
-
-  else
+  // The Euler transformation is applied while the slices are read
+  readSlices(featureNames, fileXPoints, fileYPoints);
+  if(getErrorCode() < 0)
   {
-    QString ss = QObject::tr("Could not determine or match a supported manufacturer from the data file. Supported manufacturer codes are: %1 and %2")
-                     .arg(S2Q(EbsdLib::Ctf::Manufacturer))
-                     .arg(S2Q(EbsdLib::Ang::Manufacturer));
-    setErrorCondition(-109875, ss);
     return;
   }
 
@@ -680,90 +928,26 @@ void ReadH5Ebsd::execute()
         setErrorCondition(-109870, ss);
       }
     }
-
-    if(m_EulerTransformation.angle > 0)
-    {
-      FloatVec3Type eulerAxis;
-      eulerAxis[0] = m_EulerTransformation.h;
-      eulerAxis[1] = m_EulerTransformation.k;
-      eulerAxis[2] = m_EulerTransformation.l;
-
-      QString filtName = "RotateEulerRefFrame";
-      FilterManager* fm = FilterManager::Instance();
-      IFilterFactory::Pointer rotEulerFactory = fm->getFactoryFromClassName(filtName);
-      if(nullptr != rotEulerFactory.get())
-      {
-        // If we get this far, the Factory is good so creating the filter should not fail unless something has
-        // horribly gone wrong in which case the system is going to come down quickly after this.
-        AbstractFilter::Pointer rot_Euler = rotEulerFactory->create();
-
-        // Connect up the Error/Warning/Progress object so the filter can report those things
-        connect(rot_Euler.get(), SIGNAL(messageGenerated(const AbstractMessage::Pointer&)), this, SIGNAL(messageGenerated(const AbstractMessage::Pointer&)));
-        rot_Euler->setDataContainerArray(getDataContainerArray()); // AbstractFilter implements this so no problem
-        // Now set the filter parameters for the filter using QProperty System since we can not directly
-        // instantiate the filter since it resides in a plugin. These calls are SLOW. DO NOT EVER do this in a
-        // tight loop. Your filter will slow down by 10X.
-        bool propWasSet = rot_Euler->setProperty("RotationAngle", m_EulerTransformation.angle);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAngle")
-                           .arg(filtName);
-          setErrorCondition(-109884, ss);
-        }
-        QVariant v;
-        v.setValue(eulerAxis);
-        propWasSet = rot_Euler->setProperty("RotationAxis", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("RotationAxis")
-                           .arg(filtName);
-          setErrorCondition(-109873, ss);
-        }
-        DataArrayPath tempPath;
-        tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
-        v.setValue(tempPath);
-        propWasSet = rot_Euler->setProperty("CellEulerAnglesArrayPath", v);
-        if(!propWasSet)
-        {
-          QString ss = QObject::tr("ReadH5Ebsd Error Setting Property '%1' into filter '%2' which is a subfilter called by ReadH5Ebsd. The property was not set which could mean the property was not "
-                                   "exposed with a Q_PROPERTY macro. Please notify the developers")
-                           .arg("CellEulerAnglesArrayPath")
-                           .arg(filtName);
-          setErrorCondition(-109872, ss);
-        }
-        rot_Euler->execute();
-      }
-      else
-      {
-        QString ss = QObject::tr("ReadH5Ebsd Error creating filter '%1' which is a subfilter called by ReadH5Ebsd. Filter was not created/executed. Please notify the developers").arg(filtName);
-        setErrorCondition(-109881, ss);
-      }
-    }
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-H5EbsdVolumeReader::Pointer ReadH5Ebsd::initTSLEbsdVolumeReader()
+int32_t ReadH5Ebsd::readTSLEnsembleInfo()
 {
   int32_t err = 0;
-  H5EbsdVolumeReader::Pointer ebsdReader = H5AngVolumeReader::New();
-  if(nullptr == ebsdReader)
+  H5AngVolumeReader::Pointer angReader = H5AngVolumeReader::New();
+  if(nullptr == angReader)
   {
     setErrorCondition(-1, "Could not Create H5AngVolumeReader object.");
-    return H5EbsdVolumeReader::NullPointer();
+    return -1;
   }
-  H5AngVolumeReader* angReader = dynamic_cast<H5AngVolumeReader*>(ebsdReader.get());
-  err = loadInfo<H5AngVolumeReader, AngPhase>(angReader);
+  err = loadInfo<H5AngVolumeReader, AngPhase>(angReader.get());
   if(err < 0)
   {
     setErrorCondition(-1, "Could not read information about the Ebsd Volume.");
-    return H5EbsdVolumeReader::NullPointer();
+    return err;
   }
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
@@ -775,27 +959,26 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initTSLEbsdVolumeReader()
   {
     m_SelectedArrayNames.insert(S2Q(EbsdLib::Ang::PhaseData));
   }
-  return ebsdReader;
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
+int32_t ReadH5Ebsd::readHKLEnsembleInfo()
 {
   int32_t err = 0;
-  H5EbsdVolumeReader::Pointer ebsdReader = H5CtfVolumeReader::New();
-  if(nullptr == ebsdReader)
+  H5CtfVolumeReader::Pointer ctfReader = H5CtfVolumeReader::New();
+  if(nullptr == ctfReader)
   {
     setErrorCondition(-1, "Could not Create H5CtfVolumeReader object.");
-    return H5EbsdVolumeReader::NullPointer();
+    return -1;
   }
-  H5CtfVolumeReader* ctfReader = dynamic_cast<H5CtfVolumeReader*>(ebsdReader.get());
-  err = loadInfo<H5CtfVolumeReader, CtfPhase>(ctfReader);
+  err = loadInfo<H5CtfVolumeReader, CtfPhase>(ctfReader.get());
   if(err < 0)
   {
     setErrorCondition(-1, "Could not read information about the Ebsd Volume.");
-    return H5EbsdVolumeReader::NullPointer();
+    return err;
   }
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
@@ -807,222 +990,103 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
   {
     m_SelectedArrayNames.insert(S2Q(EbsdLib::Ctf::Phase));
   }
-  return ebsdReader;
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::readSlices(const std::vector<std::string>& featureNames, int64_t fileXPoints, int64_t fileYPoints)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
-  std::vector<size_t> tDims(3, 0);
-  tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
-  tDims[1] = m->getGeometryAs<ImageGeom>()->getYPoints();
-  tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
-  cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
-
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  std::vector<size_t> cDims(1, 1);
-  if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
+  const bool isTSL = (m_Manufacturer == EbsdLib::OEM::EDAX);
+
+  SliceLoadSettings settings;
+  settings.fileName = m_InputFile.toStdString();
+  settings.arraysToRead = ::convertToStl(m_SelectedArrayNames);
+  settings.sliceStart = m_ZStartIndex;
+  settings.zPoints = m->getGeometryAs<ImageGeom>()->getZPoints();
+  settings.reverseStacking = (m_RefFrameZDir == SIMPL::RefFrameZDir::HightoLow);
+  settings.fileXPoints = fileXPoints;
+  settings.fileYPoints = fileYPoints;
+  settings.xStart = m_UseXYWindow ? m_XStartIndex : 0;
+  settings.xEnd = m_UseXYWindow ? m_XEndIndex : fileXPoints - 1;
+  settings.yStart = m_UseXYWindow ? m_YStartIndex : 0;
+  settings.yEnd = m_UseXYWindow ? m_YEndIndex : fileYPoints - 1;
+
+  for(const auto& name : featureNames)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ang::PhaseData));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-
-  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::Phi));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::Phi2));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles, true);
-    float* cellEulerAngles = fArray->getPointer(0);
-    float degToRad = 1.0f;
-    if(m_AngleRepresentation != EbsdLib::AngleRepresentation::Radians && m_UseTransformations)
+    if(!m_SelectedArrayNames.contains(S2Q(name)))
     {
-      degToRad = SIMPLib::Constants::k_PiOver180;
+      continue;
     }
-    for(size_t i = 0; i < totalPoints; i++)
+    IDataArray::Pointer array = cellAttrMatrix->getAttributeArray(S2Q(name));
+    FloatArrayType::Pointer floatArray = std::dynamic_pointer_cast<FloatArrayType>(array);
+    Int32ArrayType::Pointer intArray = std::dynamic_pointer_cast<Int32ArrayType>(array);
+    if(nullptr != floatArray.get())
     {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
+      settings.floatArrays.emplace_back(name, floatArray->getPointer(0));
+    }
+    else if(nullptr != intArray.get())
+    {
+      settings.intArrays.emplace_back(name, intArray->getPointer(0));
     }
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  // Reset this back to 1 for the rest of the arrays
-  cDims[0] = 1;
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::ImageQuality)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::ImageQuality));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::ImageQuality), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::ConfidenceIndex)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::ConfidenceIndex));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::ConfidenceIndex), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::SEMSignal)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::SEMSignal));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::SEMSignal), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::Fit)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::Fit));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::Fit), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::XPosition)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::XPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::XPosition), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
   }
 
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ang::YPosition)) != m_SelectedArrayNames.end())
+  std::string phaseName = isTSL ? EbsdLib::Ang::PhaseData : EbsdLib::Ctf::Phase;
+  if(m_SelectedArrayNames.contains(m_CellPhasesArrayName) && nullptr != m_CellPhasesPtr.lock())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ang::YPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ang::YPosition), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
+    settings.phases = m_CellPhasesPtr.lock()->getPointer(0);
+    settings.phaseName = phaseName;
   }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
-{
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-  AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
-  std::vector<size_t> tDims(3, 0);
-  tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
-  tDims[1] = m->getGeometryAs<ImageGeom>()->getYPoints();
-  tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
-  cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
-
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-  std::vector<size_t> cDims(1, 1);
-  phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Phase));
-  iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases, true);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-  cellAttrMatrix->insertOrAssign(iArray);
 
-  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
+  if(m_SelectedArrayNames.contains(m_CellEulerAnglesArrayName) && nullptr != m_CellEulerAnglesPtr.lock())
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Euler3));
-    cDims[0] = 3;
-    fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles, true);
-    float* cellEulerAngles = fArray->getPointer(0);
-    int32_t* cellPhases = iArray->getPointer(0);
-    float degToRad = 1.0f;
+    settings.eulers = m_CellEulerAnglesPtr.lock()->getPointer(0);
+    if(isTSL)
+    {
+      settings.eulerNames = {{EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2}};
+    }
+    else
+    {
+      settings.eulerNames = {{EbsdLib::Ctf::Euler1, EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3}};
+      // The phase of every cell is needed for the hexagonal correction even if the phases are not kept
+      settings.hexagonalOffset = true;
+      settings.phaseName = phaseName;
+      settings.arraysToRead.insert(phaseName);
+      settings.crystalStructures = m_CrystalStructures;
+      settings.numEnsembles = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
+    }
     if(m_AngleRepresentation != EbsdLib::AngleRepresentation::Radians && m_UseTransformations)
     {
-      degToRad = SIMPLib::Constants::k_PiOver180;
+      settings.degToRad = SIMPLib::Constants::k_PiOver180;
     }
-    for(size_t i = 0; i < totalPoints; i++)
+    if(m_UseTransformations && m_EulerTransformation.angle > 0)
     {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == EbsdLib::CrystalStructure::Hexagonal_High)
-      {
-        cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
-      }
+      float rotAngle = m_EulerTransformation.angle * SIMPLib::Constants::k_Pi / 180.0f;
+      float rotAxis[3] = {m_EulerTransformation.h, m_EulerTransformation.k, m_EulerTransformation.l};
+      MatrixMath::Normalize3x1(rotAxis);
+      OrientationTransformation::ax2om<OrientationF, OrientationF>(OrientationF(rotAxis[0], rotAxis[1], rotAxis[2], rotAngle)).toGMatrix(settings.rotMat);
+      settings.rotateEulers = true;
     }
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  cDims[0] = 1;
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::Bands)) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Bands));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Bands), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
   }
 
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::Error)) != m_SelectedArrayNames.end())
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, settings.zPoints);
+  dataAlg.setGrain(1);
+  if(isTSL)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Error));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Error), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
+    dataAlg.execute(ReadSlicesImpl<H5AngReader>(settings));
   }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::MAD)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::MAD));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::MAD), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::BC)) != m_SelectedArrayNames.end())
+  else
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::BC));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::BC), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
+    dataAlg.execute(ReadSlicesImpl<H5CtfReader>(settings));
   }
 
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::BS)) != m_SelectedArrayNames.end())
-  {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(EbsdLib::Ctf::BS));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::BS), true);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->insertOrAssign(iArray);
-  }
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::X)) != m_SelectedArrayNames.end())
+  if(settings.errorCode < 0)
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::X));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::X), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
-  }
-  if(m_SelectedArrayNames.find(S2Q(EbsdLib::Ctf::Y)) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(EbsdLib::Ctf::Y));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, S2Q(EbsdLib::Ctf::Y), true);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->insertOrAssign(fArray);
+    setErrorCondition(settings.errorCode, settings.errorMessage);
   }
 }
 
@@ -1046,6 +1110,11 @@ AbstractFilter::Pointer ReadH5Ebsd::newFilterInstance(bool copyFilterParameters)
     filter->setInputFile(getInputFile());
     filter->setZStartIndex(getZStartIndex());
     filter->setZEndIndex(getZEndIndex());
+    filter->setUseXYWindow(getUseXYWindow());
+    filter->setXStartIndex(getXStartIndex());
+    filter->setXEndIndex(getXEndIndex());
+    filter->setYStartIndex(getYStartIndex());
+    filter->setYEndIndex(getYEndIndex());
     filter->setUseTransformations(getUseTransformations());
     filter->setSelectedArrayNames(getSelectedArrayNames());
     filter->setDataArrayNames(getDataArrayNames());
@@ -1237,6 +1306,66 @@ int ReadH5Ebsd::getZEndIndex() const
   return m_ZEndIndex;
 }
 
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::setUseXYWindow(bool value)
+{
+  m_UseXYWindow = value;
+}
+
+// -----------------------------------------------------------------------------
+bool ReadH5Ebsd::getUseXYWindow() const
+{
+  return m_UseXYWindow;
+}
+
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::setXStartIndex(int value)
+{
+  m_XStartIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+int ReadH5Ebsd::getXStartIndex() const
+{
+  return m_XStartIndex;
+}
+
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::setXEndIndex(int value)
+{
+  m_XEndIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+int ReadH5Ebsd::getXEndIndex() const
+{
+  return m_XEndIndex;
+}
+
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::setYStartIndex(int value)
+{
+  m_YStartIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+int ReadH5Ebsd::getYStartIndex() const
+{
+  return m_YStartIndex;
+}
+
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::setYEndIndex(int value)
+{
+  m_YEndIndex = value;
+}
+
+// -----------------------------------------------------------------------------
+int ReadH5Ebsd::getYEndIndex() const
+{
+  return m_YEndIndex;
+}
+
 // -----------------------------------------------------------------------------
 void ReadH5Ebsd::setUseTransformations(bool value)
 {
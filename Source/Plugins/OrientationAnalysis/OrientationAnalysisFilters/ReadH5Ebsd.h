@@ -70,6 +70,11 @@ class OrientationAnalysis_EXPORT ReadH5Ebsd : public AbstractFilter
   PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
   PYB11_PROPERTY(int ZStartIndex READ getZStartIndex WRITE setZStartIndex)
   PYB11_PROPERTY(int ZEndIndex READ getZEndIndex WRITE setZEndIndex)
+  PYB11_PROPERTY(bool UseXYWindow READ getUseXYWindow WRITE setUseXYWindow)
+  PYB11_PROPERTY(int XStartIndex READ getXStartIndex WRITE setXStartIndex)
+  PYB11_PROPERTY(int XEndIndex READ getXEndIndex WRITE setXEndIndex)
+  PYB11_PROPERTY(int YStartIndex READ getYStartIndex WRITE setYStartIndex)
+  PYB11_PROPERTY(int YEndIndex READ getYEndIndex WRITE setYEndIndex)
   PYB11_PROPERTY(bool UseTransformations READ getUseTransformations WRITE setUseTransformations)
   PYB11_PROPERTY(int AngleRepresentation READ getAngleRepresentation WRITE setAngleRepresentation)
   PYB11_PROPERTY(QSet<QString> SelectedArrayNames READ getSelectedArrayNames WRITE setSelectedArrayNames)
@@ -192,6 +197,61 @@ public:
   int getZEndIndex() const;
   Q_PROPERTY(int ZEndIndex READ getZEndIndex WRITE setZEndIndex)
 
+  /**
+   * @brief Setter property for UseXYWindow
+   */
+  void setUseXYWindow(bool value);
+  /**
+   * @brief Getter property for UseXYWindow
+   * @return Value of UseXYWindow
+   */
+  bool getUseXYWindow() const;
+  Q_PROPERTY(bool UseXYWindow READ getUseXYWindow WRITE setUseXYWindow)
+
+  /**
+   * @brief Setter property for XStartIndex
+   */
+  void setXStartIndex(int value);
+  /**
+   * @brief Getter property for XStartIndex
+   * @return Value of XStartIndex
+   */
+  int getXStartIndex() const;
+  Q_PROPERTY(int XStartIndex READ getXStartIndex WRITE setXStartIndex)
+
+  /**
+   * @brief Setter property for XEndIndex
+   */
+  void setXEndIndex(int value);
+  /**
+   * @brief Getter property for XEndIndex
+   * @return Value of XEndIndex
+   */
+  int getXEndIndex() const;
+  Q_PROPERTY(int XEndIndex READ getXEndIndex WRITE setXEndIndex)
+
+  /**
+   * @brief Setter property for YStartIndex
+   */
+  void setYStartIndex(int value);
+  /**
+   * @brief Getter property for YStartIndex
+   * @return Value of YStartIndex
+   */
+  int getYStartIndex() const;
+  Q_PROPERTY(int YStartIndex READ getYStartIndex WRITE setYStartIndex)
+
+  /**
+   * @brief Setter property for YEndIndex
+   */
+  void setYEndIndex(int value);
+  /**
+   * @brief Getter property for YEndIndex
+   * @return Value of YEndIndex
+   */
+  int getYEndIndex() const;
+  Q_PROPERTY(int YEndIndex READ getYEndIndex WRITE setYEndIndex)
+
   /**
    * @brief Setter property for UseTransformations
    */
@@ -412,28 +472,25 @@ protected:
   void readVolumeInfo();
 
   /**
-   * @brief initTSLEbsdVolumeReader Initializes the H5EbsdVolumeReader to a H5AngReader pointer
-   * @return H5EbsdVolumeReader instance pointer
-   */
-  H5EbsdVolumeReader::Pointer initTSLEbsdVolumeReader();
-
-  /**
-   * @brief initHKLEbsdVolumeReader Initializes the H5EbsdVolumeReader to a H5CtfVolumeReader pointer
-   * @return H5EbsdVolumeReader instance pointer
+   * @brief readTSLEnsembleInfo Reads the TSL phase information into the Ensemble arrays
+   * @return Error code
    */
-  H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
+  int32_t readTSLEnsembleInfo();
 
   /**
-   * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
-   * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @brief readHKLEnsembleInfo Reads the HKL phase information into the Ensemble arrays
+   * @return Error code
    */
-  void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
+  int32_t readHKLEnsembleInfo();
 
   /**
-   * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
-   * @param ebsdReader H5EbsdVolumeReader instance pointer
+   * @brief readSlices Decodes the selected slices of the file straight into the cell arrays. Slices are read
+   * concurrently and the angle conversions and the Euler transformation are applied while each slice is placed.
+   * @param featureNames Names of the plain cell arrays the manufacturer provides
+   * @param fileXPoints Number of cells along X of the volume in the file
+   * @param fileYPoints Number of cells along Y of the volume in the file
    */
-  void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
+  void readSlices(const std::vector<std::string>& featureNames, int64_t fileXPoints, int64_t fileYPoints);
 
   /**
    * @brief loadInfo Reads the values for the phase type, crystal structure
@@ -530,6 +587,11 @@ private:
   QString m_InputFile = {};
   int m_ZStartIndex = {};
   int m_ZEndIndex = {};
+  bool m_UseXYWindow = {};
+  int m_XStartIndex = {};
+  int m_XEndIndex = {};
+  int m_YStartIndex = {};
+  int m_YEndIndex = {};
   bool m_UseTransformations = {};
   QSet<QString> m_SelectedArrayNames = {};
   QSet<QString> m_DataArrayNames = {};
@@ -0,0 +1,491 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "H5Support/H5Lite.h"
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/H5Utilities.h"
+#include "H5Support/QH5Lite.h"
+
+#include "EbsdLib/IO/HKL/H5CtfImporter.h"
+#include "EbsdLib/IO/TSL/H5AngImporter.h"
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/ReadH5Ebsd.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+namespace
+{
+const int32_t k_Cols = 4;
+const int32_t k_Rows = 3;
+const int32_t k_AngSlices = 3;
+const int32_t k_CtfSlices = 3;
+const float k_Step = 0.5f;
+} // namespace
+
+/**
+ * @brief The EbsdToH5EbsdTest class converts a small .ang stack and a 3D .ctf file with EbsdToH5Ebsd and checks
+ * that ReadH5Ebsd reads back exactly what it reads from a file written by the EbsdLib importers.
+ */
+class EbsdToH5EbsdTest
+{
+
+public:
+  EbsdToH5EbsdTest() = default;
+  virtual ~EbsdToH5EbsdTest() = default;
+  EbsdToH5EbsdTest(const EbsdToH5EbsdTest&) = delete;            // Copy Constructor
+  EbsdToH5EbsdTest(EbsdToH5EbsdTest&&) = delete;                 // Move Constructor
+  EbsdToH5EbsdTest& operator=(const EbsdToH5EbsdTest&) = delete; // Copy Assignment
+  EbsdToH5EbsdTest& operator=(EbsdToH5EbsdTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString AngFilePath(int32_t slice)
+  {
+    return UnitTest::EbsdToH5EbsdTest::InputDir + QDir::separator() + UnitTest::EbsdToH5EbsdTest::AngPrefix + QString::number(slice) + ".ang";
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString CtfFilePath()
+  {
+    return UnitTest::EbsdToH5EbsdTest::InputDir + QDir::separator() + UnitTest::EbsdToH5EbsdTest::CtfPrefix + "0.ctf";
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two phases, one of which has HKL families, and values that differ from slice to slice
+  // -----------------------------------------------------------------------------
+  int WriteAngFile(const QString& filePath, int32_t slice)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+      DREAM3D_REQUIRE_EQUAL(0, 1)
+    }
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\n";
+    out << "# x-star                0.510000\n";
+    out << "# y-star                0.720000\n";
+    out << "# z-star                0.630000\n";
+    out << "# WorkingDistance       15.000000\n";
+    out << "#\n";
+    out << "# Phase 1\n";
+    out << "# MaterialName  \tNickel\n";
+    out << "# Formula     \tNi\n";
+    out << "# Info \t\t\n";
+    out << "# Symmetry              43\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+    out << "# NumberFamilies        2\n";
+    out << "# hklFamilies   \t 1  1  1 1 100.000000 1\n";
+    out << "# hklFamilies   \t 2  0  0 1 52.500000 1\n";
+    out << "# Categories 0 0 0 0 0 \n";
+    out << "#\n";
+    out << "# Phase 2\n";
+    out << "# MaterialName  \tTitanium\n";
+    out << "# Formula     \tTi\n";
+    out << "# Info \t\t\n";
+    out << "# Symmetry              62\n";
+    out << "# LatticeConstants      2.950 2.950 4.680  90.000  90.000 120.000\n";
+    out << "# NumberFamilies        0\n";
+    out << "# Categories 0 0 0 0 0 \n";
+    out << "#\n";
+    out << "# GRID: SqrGrid\n";
+    out << "# XSTEP: " << k_Step << "\n";
+    out << "# YSTEP: " << k_Step << "\n";
+    out << "# NCOLS_ODD: " << k_Cols << "\n";
+    out << "# NCOLS_EVEN: " << k_Cols << "\n";
+    out << "# NROWS: " << k_Rows << "\n";
+    out << "#\n";
+    out << "# OPERATOR: \tEbsdToH5EbsdTest\n";
+    out << "#\n";
+    out << "# SAMPLEID: \tSlice " << slice << "\n";
+    out << "#\n";
+    out << "# SCANID: \t\n";
+    out << "#\n";
+
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(5);
+    for(int32_t y = 0; y < k_Rows; y++)
+    {
+      for(int32_t x = 0; x < k_Cols; x++)
+      {
+        int32_t i = (slice * k_Rows + y) * k_Cols + x;
+        out << "  " << 0.1f * static_cast<float>(i % 31) << "  " << 0.05f * static_cast<float>(i % 29) << "  " << 0.2f * static_cast<float>(i % 23);
+        out << "  " << k_Step * static_cast<float>(x) << "  " << k_Step * static_cast<float>(y);
+        out << "  " << 100.0f + static_cast<float>(i) << "  " << 0.01f * static_cast<float>(i % 97);
+        out << "  " << 1 + (i % 2) << "  " << 500 + i << "  " << 0.25f * static_cast<float>(i % 7) << "\n";
+      }
+    }
+    file.close();
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A .ctf file that holds k_CtfSlices slices
+  // -----------------------------------------------------------------------------
+  int WriteCtfFile(const QString& filePath)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+      DREAM3D_REQUIRE_EQUAL(0, 1)
+    }
+    QTextStream out(&file);
+    out << "Channel Text File\n";
+    out << "Prj\tEbsdToH5EbsdTest\n";
+    out << "Author\t[Unknown]\n";
+    out << "JobMode\tGrid\n";
+    out << "XCells\t" << k_Cols << "\n";
+    out << "YCells\t" << k_Rows << "\n";
+    out << "ZCells\t" << k_CtfSlices << "\n";
+    out << "XStep\t" << k_Step << "\n";
+    out << "YStep\t" << k_Step << "\n";
+    out << "ZStep\t" << k_Step << "\n";
+    out << "AcqE1\t0\n";
+    out << "AcqE2\t0\n";
+    out << "AcqE3\t0\n";
+    out << "Euler angles refer to Sample Coordinate system (CS0)!\tMag\t100\tCoverage\t100\tDevice\t0\tKV\t20\tTiltAngle\t70\tTiltAxis\t0\n";
+    out << "Phases\t2\n";
+    out << "3.524;3.524;3.524\t90;90;90\tNickel\t11\t225\t\t\tFirst phase\n";
+    out << "2.950;2.950;4.680\t90;90;120\tTitanium\t9\t194\t\t\tSecond phase\n";
+    out << "Phase\tX\tY\tBands\tError\tEuler1\tEuler2\tEuler3\tMAD\tBC\tBS\n";
+
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(4);
+    for(int32_t z = 0; z < k_CtfSlices; z++)
+    {
+      for(int32_t y = 0; y < k_Rows; y++)
+      {
+        for(int32_t x = 0; x < k_Cols; x++)
+        {
+          int32_t i = (z * k_Rows + y) * k_Cols + x;
+          out << (i % 3) << "\t" << k_Step * static_cast<float>(x) << "\t" << k_Step * static_cast<float>(y);
+          out << "\t" << 5 + (i % 6) << "\t" << (i % 3 == 0 ? 3 : 0);
+          out << "\t" << 3.5f * static_cast<float>(i % 41) << "\t" << 1.25f * static_cast<float>(i % 37) << "\t" << 2.75f * static_cast<float>(i % 43);
+          out << "\t" << 0.01f * static_cast<float>(i % 53) << "\t" << 100 + i << "\t" << 200 + i << "\n";
+        }
+      }
+    }
+    file.close();
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int WriteTestFiles()
+  {
+    QDir dir;
+    dir.mkpath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    for(int32_t slice = 0; slice < k_AngSlices; slice++)
+    {
+      DREAM3D_REQUIRE_EQUAL(WriteAngFile(AngFilePath(slice), slice), EXIT_SUCCESS)
+    }
+    DREAM3D_REQUIRE_EQUAL(WriteCtfFile(CtfFilePath()), EXIT_SUCCESS)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    for(int32_t slice = 0; slice < k_AngSlices; slice++)
+    {
+      QFile::remove(AngFilePath(slice));
+    }
+    QFile::remove(CtfFilePath());
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::BaselineFile);
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::OutputFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the files through the EbsdLib importers with the defaults of EbsdToH5Ebsd, the way the filter did before
+  // it parsed and wrote the slices on its own
+  // -----------------------------------------------------------------------------
+  int WriteBaselineFile(const QVector<QString>& fileList, bool isAng, const QString& outputFile)
+  {
+    hid_t fileId = H5Utilities::createFile(outputFile.toStdString());
+    DREAM3D_REQUIRE(fileId >= 0)
+    H5ScopedFileSentinel sentinel(&fileId, true);
+
+    float zResolution = 1.0f;
+    uint32_t refFrameZDir = SIMPL::RefFrameZDir::LowtoHigh;
+    float transformationAngle = 0.0f;
+    float transformationAxis[3] = {0.0f, 0.0f, 1.0f};
+    int32_t rank = 1;
+    hsize_t dims[3] = {3, 0, 0};
+    herr_t err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZResolution, zResolution);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::StackingOrder, refFrameZDir);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeStringAttribute(fileId, EbsdLib::H5Ebsd::StackingOrder, "Name", EbsdLib::StackingOrder::Utils::getStringForEnum(refFrameZDir));
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::SampleTransformationAngle, transformationAngle);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writePointerDataset<float>(fileId, EbsdLib::H5Ebsd::SampleTransformationAxis, rank, dims, transformationAxis);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::EulerTransformationAngle, transformationAngle);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writePointerDataset<float>(fileId, EbsdLib::H5Ebsd::EulerTransformationAxis, rank, dims, transformationAxis);
+    DREAM3D_REQUIRE(err >= 0)
+
+    EbsdImporter::Pointer fileImporter;
+    if(isAng)
+    {
+      err = H5Lite::writeStringDataset(fileId, EbsdLib::H5Ebsd::Manufacturer, EbsdLib::Ang::Manufacturer);
+      fileImporter = H5AngImporter::New();
+    }
+    else
+    {
+      err = H5Lite::writeStringDataset(fileId, EbsdLib::H5Ebsd::Manufacturer, EbsdLib::Ctf::Manufacturer);
+      fileImporter = H5CtfImporter::New();
+    }
+    DREAM3D_REQUIRE(err >= 0)
+
+    QVector<int32_t> indices;
+    int64_t z = 0;
+    int64_t xDim = 0;
+    int64_t yDim = 0;
+    float xRes = 0.0f;
+    float yRes = 0.0f;
+    int32_t totalSlicesImported = 0;
+    for(const QString& filePath : fileList)
+    {
+      err = fileImporter->importFile(fileId, z, filePath.toStdString());
+      DREAM3D_REQUIRE(err >= 0)
+      totalSlicesImported += fileImporter->numberOfSlicesImported();
+      fileImporter->getDims(xDim, yDim);
+      fileImporter->getSpacing(xRes, yRes);
+      indices.push_back(static_cast<int32_t>(z));
+      ++z;
+    }
+
+    int64_t zStartIndex = 0;
+    int64_t zEndIndex = totalSlicesImported - 1;
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZStartIndex, zStartIndex);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZEndIndex, zEndIndex);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XPoints, xDim);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YPoints, yDim);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XResolution, xRes);
+    DREAM3D_REQUIRE(err >= 0)
+    err = H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YResolution, yRes);
+    DREAM3D_REQUIRE(err >= 0)
+    QVector<hsize_t> dimsL = {static_cast<hsize_t>(indices.size())};
+    err = QH5Lite::writeVectorDataset(fileId, QString::fromStdString(EbsdLib::H5Ebsd::Index), dimsL, indices);
+    DREAM3D_REQUIRE(err >= 0)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int ConvertFiles(const QString& prefix, const QString& extension, int64_t zEndIndex, const QString& outputFile)
+  {
+    EbsdToH5Ebsd::Pointer filter = EbsdToH5Ebsd::New();
+    filter->setInputPath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    filter->setFilePrefix(prefix);
+    filter->setFileSuffix("");
+    filter->setFileExtension(extension);
+    filter->setPaddingDigits(0);
+    filter->setZStartIndex(0);
+    filter->setZEndIndex(zEndIndex);
+    filter->setOutputFile(outputFile);
+    filter->setCompressionLevel(6);
+    filter->setUseShuffleFilter(true);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reads every array of the file with ReadH5Ebsd, without applying the transformations
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer ReadFile(const QString& inputFile, int32_t zEndIndex)
+  {
+    ReadH5Ebsd::Pointer reader = ReadH5Ebsd::New();
+    reader->setDataContainerArray(DataContainerArray::New());
+    reader->setInputFile(inputFile);
+    reader->setZStartIndex(0);
+    reader->setZEndIndex(zEndIndex);
+    reader->setUseTransformations(false);
+    reader->preflight();
+    DREAM3D_REQUIRED(reader->getErrorCode(), >=, 0)
+
+    QSet<QString> selectedArrayNames = reader->getDataArrayNames();
+    selectedArrayNames.insert(SIMPL::CellData::EulerAngles);
+    selectedArrayNames.insert(SIMPL::CellData::Phases);
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    reader = ReadH5Ebsd::New();
+    reader->setDataContainerArray(dca);
+    reader->setInputFile(inputFile);
+    reader->setZStartIndex(0);
+    reader->setZEndIndex(zEndIndex);
+    reader->setUseTransformations(false);
+    reader->setSelectedArrayNames(selectedArrayNames);
+    reader->execute();
+    DREAM3D_REQUIRED(reader->getErrorCode(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  bool CompareArrays(const IDataArray::Pointer& expected, const IDataArray::Pointer& actual)
+  {
+    typename DataArray<T>::Pointer expectedArray = std::dynamic_pointer_cast<DataArray<T>>(expected);
+    typename DataArray<T>::Pointer actualArray = std::dynamic_pointer_cast<DataArray<T>>(actual);
+    if(nullptr == expectedArray.get())
+    {
+      return false;
+    }
+    DREAM3D_REQUIRE_VALID_POINTER(actualArray.get())
+    DREAM3D_REQUIRE_EQUAL(actualArray->getNumberOfTuples(), expectedArray->getNumberOfTuples())
+    DREAM3D_REQUIRE_EQUAL(actualArray->getNumberOfComponents(), expectedArray->getNumberOfComponents())
+    for(size_t i = 0; i < expectedArray->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(actualArray->getValue(i), expectedArray->getValue(i))
+    }
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareAttributeMatrices(const DataContainerArray::Pointer& expectedDca, const DataContainerArray::Pointer& actualDca, const QString& attributeMatrixName)
+  {
+    DataArrayPath amPath(SIMPL::Defaults::ImageDataContainerName, attributeMatrixName, "");
+    AttributeMatrix::Pointer expectedAM = expectedDca->getAttributeMatrix(amPath);
+    AttributeMatrix::Pointer actualAM = actualDca->getAttributeMatrix(amPath);
+    DREAM3D_REQUIRE_VALID_POINTER(expectedAM.get())
+    DREAM3D_REQUIRE_VALID_POINTER(actualAM.get())
+    DREAM3D_REQUIRE_EQUAL(actualAM->getNumAttributeArrays(), expectedAM->getNumAttributeArrays())
+
+    QList<QString> names = expectedAM->getAttributeArrayNames();
+    DREAM3D_REQUIRED(names.size(), >, 0)
+    for(const QString& name : names)
+    {
+      IDataArray::Pointer expected = expectedAM->getAttributeArray(name);
+      IDataArray::Pointer actual = actualAM->getAttributeArray(name);
+      DREAM3D_REQUIRE_VALID_POINTER(actual.get())
+
+      StringDataArray::Pointer expectedStrings = std::dynamic_pointer_cast<StringDataArray>(expected);
+      if(nullptr != expectedStrings.get())
+      {
+        StringDataArray::Pointer actualStrings = std::dynamic_pointer_cast<StringDataArray>(actual);
+        DREAM3D_REQUIRE_VALID_POINTER(actualStrings.get())
+        DREAM3D_REQUIRE_EQUAL(actualStrings->getNumberOfTuples(), expectedStrings->getNumberOfTuples())
+        for(size_t i = 0; i < expectedStrings->getNumberOfTuples(); i++)
+        {
+          DREAM3D_REQUIRE(actualStrings->getValue(i) == expectedStrings->getValue(i))
+        }
+        continue;
+      }
+      bool compared = CompareArrays<int32_t>(expected, actual) || CompareArrays<float>(expected, actual) || CompareArrays<uint32_t>(expected, actual);
+      DREAM3D_REQUIRE_EQUAL(compared, true)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAngStack()
+  {
+    QVector<QString> fileList;
+    for(int32_t slice = 0; slice < k_AngSlices; slice++)
+    {
+      fileList.push_back(AngFilePath(slice));
+    }
+    DREAM3D_REQUIRE_EQUAL(WriteBaselineFile(fileList, true, UnitTest::EbsdToH5EbsdTest::BaselineFile), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(ConvertFiles(UnitTest::EbsdToH5EbsdTest::AngPrefix, "ang", k_AngSlices - 1, UnitTest::EbsdToH5EbsdTest::OutputFile), EXIT_SUCCESS)
+
+    DataContainerArray::Pointer expected = ReadFile(UnitTest::EbsdToH5EbsdTest::BaselineFile, k_AngSlices - 1);
+    DataContainerArray::Pointer actual = ReadFile(UnitTest::EbsdToH5EbsdTest::OutputFile, k_AngSlices - 1);
+    CompareAttributeMatrices(expected, actual, SIMPL::Defaults::CellAttributeMatrixName);
+    CompareAttributeMatrices(expected, actual, SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCtfVolume()
+  {
+    QVector<QString> fileList = {CtfFilePath()};
+    DREAM3D_REQUIRE_EQUAL(WriteBaselineFile(fileList, false, UnitTest::EbsdToH5EbsdTest::BaselineFile), EXIT_SUCCESS)
+    DREAM3D_REQUIRE_EQUAL(ConvertFiles(UnitTest::EbsdToH5EbsdTest::CtfPrefix, "ctf", 0, UnitTest::EbsdToH5EbsdTest::OutputFile), EXIT_SUCCESS)
+
+    DataContainerArray::Pointer expected = ReadFile(UnitTest::EbsdToH5EbsdTest::BaselineFile, k_CtfSlices - 1);
+    DataContainerArray::Pointer actual = ReadFile(UnitTest::EbsdToH5EbsdTest::OutputFile, k_CtfSlices - 1);
+    CompareAttributeMatrices(expected, actual, SIMPL::Defaults::CellAttributeMatrixName);
+    CompareAttributeMatrices(expected, actual, SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(WriteTestFiles())
+    DREAM3D_REGISTER_TEST(TestAngStack())
+    DREAM3D_REGISTER_TEST(TestCtfVolume())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -0,0 +1,287 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindKernelAvgMisorientationsTest
+{
+
+public:
+  FindKernelAvgMisorientationsTest() = default;
+  virtual ~FindKernelAvgMisorientationsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindKernelAvgMisorientations Filter from the FilterManager
+    QString filtName = "FindKernelAvgMisorientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindKernelAvgMisorientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocky Features of two crystal structures with noisy orientations, a few unindexed Cells and a few Cells of
+  // phase 0 inside Features. The volume is tall in z so the filter splits it into several slabs.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(size_t dims[3])
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    igeom->setDimensions(dims);
+    dc->setGeometry(igeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases, true);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 4), SIMPL::CellData::Quats, true);
+
+    std::mt19937_64 generator(5489);
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+
+    // One base orientation per block of 3 x 3 x 5 Cells
+    size_t blocksX = (dims[0] + 2) / 3;
+    size_t blocksY = (dims[1] + 2) / 3;
+    size_t blocksZ = (dims[2] + 4) / 5;
+    std::vector<std::vector<double>> baseQuats(blocksX * blocksY * blocksZ, std::vector<double>(4, 0.0));
+    for(auto& q : baseQuats)
+    {
+      double norm = 0.0;
+      for(double& value : q)
+      {
+        value = distribution(generator) - 0.5;
+        norm += value * value;
+      }
+      norm = std::sqrt(norm);
+      for(double& value : q)
+      {
+        value /= norm;
+      }
+    }
+
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t point = (z * dims[1] + y) * dims[0] + x;
+          size_t block = ((z / 5) * blocksY + (y / 3)) * blocksX + (x / 3);
+          int32_t featureId = static_cast<int32_t>(block) + 1;
+          int32_t phase = (featureId % 2 == 1) ? 1 : 2;
+          double random = distribution(generator);
+          if(random < 0.03)
+          {
+            featureId = 0;
+            phase = 0;
+          }
+          else if(random < 0.06)
+          {
+            phase = 0;
+          }
+          featureIds->setValue(point, featureId);
+          phases->setValue(point, phase);
+
+          double norm = 0.0;
+          float* q = quats->getTuplePointer(point);
+          for(size_t c = 0; c < 4; c++)
+          {
+            double value = baseQuats[block][c] + 0.05 * (distribution(generator) - 0.5);
+            q[c] = static_cast<float>(value);
+            norm += value * value;
+          }
+          norm = std::sqrt(norm);
+          for(size_t c = 0; c < 4; c++)
+          {
+            q[c] = static_cast<float>(q[c] / norm);
+          }
+        }
+      }
+    }
+    cellAM->insertOrAssign(featureIds);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(quats);
+
+    std::vector<size_t> eDims(1, 3);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(eDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    crystalStructures->setValue(2, EbsdLib::CrystalStructure::Hexagonal_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial column, row, plane walk the filter used before it was split into z slabs
+  // -----------------------------------------------------------------------------
+  std::vector<float> ComputeSerialKernelAverages(const DataContainerArray::Pointer& dca, size_t dims[3], const IntVec3Type& kernelSize)
+  {
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    AttributeMatrix::Pointer ensembleAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    int32_t* featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds)->getPointer(0);
+    int32_t* cellPhases = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases)->getPointer(0);
+    float* quats = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::Quats)->getPointer(0);
+    uint32_t* crystalStructures = ensembleAM->getAttributeArrayAs<UInt32ArrayType>(SIMPL::EnsembleData::CrystalStructures)->getPointer(0);
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+    int64_t xPoints = static_cast<int64_t>(dims[0]);
+    int64_t yPoints = static_cast<int64_t>(dims[1]);
+    int64_t zPoints = static_cast<int64_t>(dims[2]);
+    std::vector<float> kernelAverages(dims[0] * dims[1] * dims[2], 0.0f);
+
+    for(int64_t col = 0; col < xPoints; col++)
+    {
+      for(int64_t row = 0; row < yPoints; row++)
+      {
+        for(int64_t plane = 0; plane < zPoints; plane++)
+        {
+          int64_t point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+          if(featureIds[point] <= 0 || cellPhases[point] <= 0)
+          {
+            continue;
+          }
+          float totalmisorientation = 0.0f;
+          int32_t numVoxel = 0;
+          QuatF q1(quats + point * 4);
+          uint32_t phase1 = crystalStructures[cellPhases[point]];
+          for(int64_t j = -kernelSize[2]; j <= kernelSize[2]; j++)
+          {
+            for(int64_t k = -kernelSize[1]; k <= kernelSize[1]; k++)
+            {
+              for(int64_t l = -kernelSize[0]; l <= kernelSize[0]; l++)
+              {
+                if(plane + j < 0 || plane + j > zPoints - 1 || row + k < 0 || row + k > yPoints - 1 || col + l < 0 || col + l > xPoints - 1)
+                {
+                  continue;
+                }
+                int64_t neighbor = point + (j * xPoints * yPoints) + (k * xPoints) + l;
+                if(featureIds[point] == featureIds[neighbor])
+                {
+                  QuatF q2(quats + neighbor * 4);
+                  OrientationF axisAngle = orientationOps[phase1]->calculateMisorientation(q1, q2);
+                  totalmisorientation = totalmisorientation + (axisAngle[3] * SIMPLib::Constants::k_180OverPi);
+                  numVoxel++;
+                }
+              }
+            }
+          }
+          kernelAverages[point] = numVoxel == 0 ? 0.0f : totalmisorientation / static_cast<float>(numVoxel);
+        }
+      }
+    }
+    return kernelAverages;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunAndCompare(size_t dims[3], const IntVec3Type& kernelSize)
+  {
+    DataContainerArray::Pointer dca = CreateTestData(dims);
+    std::vector<float> expected = ComputeSerialKernelAverages(dca, dims, kernelSize);
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("FindKernelAvgMisorientations");
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(kernelSize);
+    bool propWasSet = filter->setProperty("KernelSize", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    FloatArrayType::Pointer kamPtr = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::KernelAverageMisorientations);
+    DREAM3D_REQUIRE_VALID_POINTER(kamPtr.get())
+    DREAM3D_REQUIRE_EQUAL(kamPtr->getNumberOfTuples(), expected.size())
+
+    // The slabs sum each kernel in a different order, so only float rounding may differ
+    bool nonZero = false;
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      float actual = kamPtr->getValue(i);
+      float tolerance = 1.0E-4f * std::max(1.0f, std::fabs(expected[i]));
+      DREAM3D_REQUIRED(std::fabs(actual - expected[i]), <=, tolerance)
+      nonZero = nonZero || expected[i] > 0.0f;
+    }
+    DREAM3D_REQUIRE(nonZero)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSlabsMatchSerialWalk()
+  {
+    size_t dims[3] = {7, 6, 61};
+    RunAndCompare(dims, IntVec3Type(1, 1, 1));
+    RunAndCompare(dims, IntVec3Type(2, 1, 3));
+    RunAndCompare(dims, IntVec3Type(1, 2, 0));
+
+    size_t thinDims[3] = {9, 8, 2};
+    RunAndCompare(thinDims, IntVec3Type(1, 1, 2));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSlabsMatchSerialWalk())
+  }
+
+private:
+  FindKernelAvgMisorientationsTest(const FindKernelAvgMisorientationsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindKernelAvgMisorientationsTest&);                   // Move assignment Not Implemented
+};
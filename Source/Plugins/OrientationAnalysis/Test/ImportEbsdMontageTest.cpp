@@ -3,22 +3,44 @@
 // -----------------------------------------------------------------------------
 #pragma once
 
+#include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+
+#include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/IO/TSL/AngConstants.h"
 
-#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
-#include "SIMPLib/DataArrays/DataArray.hpp"
-#include "SIMPLib/Filtering/FilterFactory.hpp"
-#include "SIMPLib/Filtering/FilterManager.h"
-#include "SIMPLib/Filtering/FilterPipeline.h"
-#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
-#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "SIMPLib/SIMPLib.h"
-#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/MontageFileListInfo.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
 
 #include "UnitTestSupport.hpp"
 
-#include "EbsdMontageTestFileLocations.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/ImportEbsdMontage.h"
 
+#include "OrientationAnalysisTestFileLocations.h"
+
+namespace
+{
+const int32_t k_TileCols = 6;
+const int32_t k_TileRows = 4;
+const int32_t k_MontageRows = 2;
+const int32_t k_MontageCols = 3;
+const int32_t k_OverlapX = 2;
+const int32_t k_OverlapY = 1;
+const float k_Step = 0.5f;
+const QString k_StitchedName("Stitched");
+} // namespace
+
+/**
+ * @brief The ImportEbsdMontageTest class imports a small grid of .ang tiles with an overlap, once as separate tiles and
+ * once stitched into one geometry, and checks that every cell of the stitched montage holds the values of the tile
+ * that owns that cell.
+ */
 class ImportEbsdMontageTest
 {
 
@@ -30,59 +52,240 @@ public:
   ImportEbsdMontageTest& operator=(const ImportEbsdMontageTest&) = delete; // Copy Assignment
   ImportEbsdMontageTest& operator=(ImportEbsdMontageTest&&) = delete;      // Move Assignment
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  MontageFileListInfo CreateFileListInfo()
+  {
+    MontageFileListInfo info;
+    info.InputPath = UnitTest::ImportEbsdMontageTest::InputDir;
+    info.FilePrefix = UnitTest::ImportEbsdMontageTest::FilePrefix;
+    info.FileSuffix = "";
+    info.FileExtension = "ang";
+    info.PaddingDigits = 1;
+    info.Ordering = 0;
+    info.RowStart = 0;
+    info.RowEnd = k_MontageRows;
+    info.ColStart = 0;
+    info.ColEnd = k_MontageCols;
+    return info;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The file names are generated the same way the filter generates them
+  // -----------------------------------------------------------------------------
+  FilePathGenerator::TileRCIndexLayout2D GenerateTileLayout()
+  {
+    MontageFileListInfo info = CreateFileListInfo();
+    bool hasMissingFiles = false;
+    return FilePathGenerator::GenerateRCIndexMontageFileList(info.RowStart, info.RowEnd, info.ColStart, info.ColEnd, hasMissingFiles, true, info.InputPath, info.FilePrefix, info.FileSuffix,
+                                                             info.FileExtension, info.PaddingDigits);
+  }
+
+  // -----------------------------------------------------------------------------
+  // The image quality of every point holds the tile index and the position of the point within the tile
+  // -----------------------------------------------------------------------------
+  float ExpectedImageQuality(int32_t tileIndex, int32_t x, int32_t y)
+  {
+    return static_cast<float>(1000 * tileIndex + y * k_TileCols + x);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int WriteAngFile(const QString& filePath, int32_t tileIndex)
+  {
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+      DREAM3D_REQUIRE_EQUAL(0, 1)
+    }
+
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\n";
+    out << "# x-star                0.510000\n";
+    out << "# y-star                0.720000\n";
+    out << "# z-star                0.630000\n";
+    out << "# WorkingDistance       15.000000\n";
+    out << "#\n";
+    out << "# Phase 1\n";
+    out << "# MaterialName  \tNickel\n";
+    out << "# Formula     \tNi\n";
+    out << "# Info \t\t\n";
+    out << "# Symmetry              43\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\n";
+    out << "# NumberFamilies        0\n";
+    out << "# Categories 0 0 0 0 0 \n";
+    out << "#\n";
+    out << "# GRID: SqrGrid\n";
+    out << "# XSTEP: " << k_Step << "\n";
+    out << "# YSTEP: " << k_Step << "\n";
+    out << "# NCOLS_ODD: " << k_TileCols << "\n";
+    out << "# NCOLS_EVEN: " << k_TileCols << "\n";
+    out << "# NROWS: " << k_TileRows << "\n";
+    out << "#\n";
+    out << "# OPERATOR: \tImportEbsdMontageTest\n";
+    out << "#\n";
+    out << "# SAMPLEID: \tTile " << tileIndex << "\n";
+    out << "#\n";
+    out << "# SCANID: \t\n";
+    out << "#\n";
+
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(5);
+    for(int32_t y = 0; y < k_TileRows; y++)
+    {
+      for(int32_t x = 0; x < k_TileCols; x++)
+      {
+        int32_t i = (tileIndex * k_TileRows + y) * k_TileCols + x;
+        out << "  " << 0.1f * static_cast<float>(i % 31) << "  " << 0.05f * static_cast<float>(i % 29) << "  " << 0.2f * static_cast<float>(i % 23);
+        out << "  " << k_Step * static_cast<float>(x) << "  " << k_Step * static_cast<float>(y);
+        out << "  " << ExpectedImageQuality(tileIndex, x, y) << "  " << 0.01f * static_cast<float>(i % 97);
+        out << "  " << 1 << "  " << 500 + i << "  " << 0.25f * static_cast<float>(i % 7) << "\n";
+      }
+    }
+    file.close();
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int WriteTestFiles()
+  {
+    QDir().mkpath(UnitTest::ImportEbsdMontageTest::InputDir);
+    FilePathGenerator::TileRCIndexLayout2D tileLayout = GenerateTileLayout();
+    DREAM3D_REQUIRE_EQUAL(tileLayout.size(), static_cast<size_t>(k_MontageRows))
+    int32_t tileIndex = 0;
+    for(const auto& row : tileLayout)
+    {
+      DREAM3D_REQUIRE_EQUAL(row.size(), static_cast<size_t>(k_MontageCols))
+      for(const FilePathGenerator::TileRCIndex2D& tile : row)
+      {
+        DREAM3D_REQUIRE_EQUAL(WriteAngFile(tile.FileName, tileIndex), EXIT_SUCCESS)
+        tileIndex++;
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
   void RemoveTestFiles()
   {
 #if REMOVE_TEST_FILES
-    QFile::remove(UnitTest::ImportEbsdMontageTest::TestFile1);
-    QFile::remove(UnitTest::ImportEbsdMontageTest::TestFile2);
+    for(const auto& row : GenerateTileLayout())
+    {
+      for(const FilePathGenerator::TileRCIndex2D& tile : row)
+      {
+        QFile::remove(tile.FileName);
+      }
+    }
+    QDir().rmdir(UnitTest::ImportEbsdMontageTest::InputDir);
 #endif
   }
 
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
-  int TestFilterAvailability()
+  DataContainerArray::Pointer ImportMontage(bool stitchTiles)
   {
-    // Now instantiate the ImportEbsdMontageTest Filter from the FilterManager
-    QString filtName = "ImportEbsdMontage";
-    FilterManager* fm = FilterManager::Instance();
-    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
-    if(nullptr == filterFactory.get())
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    ImportEbsdMontage::Pointer filter = ImportEbsdMontage::New();
+    filter->setDataContainerArray(dca);
+    filter->setInputFileListInfo(CreateFileListInfo());
+    filter->setStitchTiles(stitchTiles);
+    filter->setDataContainerName(DataArrayPath(k_StitchedName, "", ""));
+    filter->setDefineScanOverlap(static_cast<int32_t>(ImportEbsdMontage::OverlapType::Pixels));
+    filter->setScanOverlapPixel(IntVec2Type(k_OverlapX, k_OverlapY));
+    filter->setGenerateIPFColorMap(false);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  bool CompareTuple(const IDataArray::Pointer& tileData, size_t tileTuple, const IDataArray::Pointer& montageData, size_t montageTuple)
+  {
+    typename DataArray<T>::Pointer tileArray = std::dynamic_pointer_cast<DataArray<T>>(tileData);
+    typename DataArray<T>::Pointer montageArray = std::dynamic_pointer_cast<DataArray<T>>(montageData);
+    if(nullptr == tileArray.get())
+    {
+      return false;
+    }
+    DREAM3D_REQUIRE_VALID_POINTER(montageArray.get())
+    size_t numComps = tileArray->getNumberOfComponents();
+    DREAM3D_REQUIRE_EQUAL(montageArray->getNumberOfComponents(), numComps)
+    for(size_t comp = 0; comp < numComps; comp++)
     {
-      std::stringstream ss;
-      ss << "The ImportEbsdMontageTest Requires the use of the " << filtName.toStdString() << " filter which is found in the EbsdMontage Plugin";
-      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      DREAM3D_REQUIRE_EQUAL(montageArray->getComponent(montageTuple, comp), tileArray->getComponent(tileTuple, comp))
     }
-    return 0;
+    return true;
   }
 
   // -----------------------------------------------------------------------------
-  //
+  // The overlapping cells of a tile are taken from the tile to its right or below it, so every cell of the montage
+  // belongs to exactly one tile
   // -----------------------------------------------------------------------------
-  int TestImportEbsdMontageTest()
+  int TestStitchedMontage()
   {
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    /* Please write ImportEbsdMontageTest test code here.
-     *
-     * Your IO test files are:
-     * UnitTest::ImportEbsdMontageTest::TestFile1
-     * UnitTest::ImportEbsdMontageTest::TestFile2
-     *
-     * SIMPLib provides some macros that will throw exceptions when a test fails
-     * and thus report that during testing. These macros are located in the
-     * SIMPLib/Utilities/UnitTestSupport.hpp file. Some examples are:
-     *
-     * SIMPLib_REQUIRE_EQUAL(foo, 0)
-     * This means that if the variable foo is NOT equal to Zero then test will fail
-     * and the current test will exit immediately. If there are more tests registered
-     * with the SIMPLib_REGISTER_TEST() macro, the next test will execute. There are
-     * lots of examples in the SIMPLib/Test folder to look at.
-     */
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    DataContainerArray::Pointer tilesDca = ImportMontage(false);
+    DataContainerArray::Pointer stitchedDca = ImportMontage(true);
+
+    const size_t montageX = static_cast<size_t>(k_MontageCols * (k_TileCols - k_OverlapX) + k_OverlapX);
+    const size_t montageY = static_cast<size_t>(k_MontageRows * (k_TileRows - k_OverlapY) + k_OverlapY);
+
+    DataContainer::Pointer stitchedDC = stitchedDca->getDataContainer(k_StitchedName);
+    DREAM3D_REQUIRE_VALID_POINTER(stitchedDC.get())
+    ImageGeom::Pointer image = stitchedDC->getGeometryAs<ImageGeom>();
+    DREAM3D_REQUIRE_VALID_POINTER(image.get())
+    SizeVec3Type dims = image->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], montageX)
+    DREAM3D_REQUIRE_EQUAL(dims[1], montageY)
+    DREAM3D_REQUIRE_EQUAL(dims[2], 1)
+
+    ImportEbsdMontage::Pointer defaults = ImportEbsdMontage::New();
+    AttributeMatrix::Pointer montageAttrMat = stitchedDC->getAttributeMatrix(defaults->getCellAttributeMatrixName());
+    DREAM3D_REQUIRE_VALID_POINTER(montageAttrMat.get())
+    DREAM3D_REQUIRE_EQUAL(montageAttrMat->getNumberOfTuples(), montageX * montageY)
+    DREAM3D_REQUIRE_VALID_POINTER(stitchedDC->getAttributeMatrix(defaults->getCellEnsembleAttributeMatrixName()).get())
 
+    FloatArrayType::Pointer imageQuality = montageAttrMat->getAttributeArrayAs<FloatArrayType>(S2Q(EbsdLib::Ang::ImageQuality));
+    DREAM3D_REQUIRE_VALID_POINTER(imageQuality.get())
+
+    FilePathGenerator::TileRCIndexLayout2D tileLayout = GenerateTileLayout();
+    for(size_t y = 0; y < montageY; y++)
+    {
+      int32_t r = std::min(static_cast<int32_t>(y) / (k_TileRows - k_OverlapY), k_MontageRows - 1);
+      int32_t tileY = static_cast<int32_t>(y) - r * (k_TileRows - k_OverlapY);
+      for(size_t x = 0; x < montageX; x++)
+      {
+        int32_t c = std::min(static_cast<int32_t>(x) / (k_TileCols - k_OverlapX), k_MontageCols - 1);
+        int32_t tileX = static_cast<int32_t>(x) - c * (k_TileCols - k_OverlapX);
+        size_t montageTuple = y * montageX + x;
+        size_t tileTuple = static_cast<size_t>(tileY * k_TileCols + tileX);
+
+        DREAM3D_REQUIRE_EQUAL(imageQuality->getValue(montageTuple), ExpectedImageQuality(r * k_MontageCols + c, tileX, tileY))
+
+        // Every array of the montage holds the values of the tile that was imported on its own
+        QString tileName = QFileInfo(tileLayout[r][c].FileName).completeBaseName();
+        AttributeMatrix::Pointer tileAttrMat = tilesDca->getAttributeMatrix(DataArrayPath(tileName, defaults->getCellAttributeMatrixName(), ""));
+        DREAM3D_REQUIRE_VALID_POINTER(tileAttrMat.get())
+        DREAM3D_REQUIRE_EQUAL(montageAttrMat->getNumAttributeArrays(), tileAttrMat->getNumAttributeArrays())
+        for(const QString& arrayName : tileAttrMat->getAttributeArrayNames())
+        {
+          IDataArray::Pointer tileData = tileAttrMat->getAttributeArray(arrayName);
+          IDataArray::Pointer montageData = montageAttrMat->getAttributeArray(arrayName);
+          DREAM3D_REQUIRE_VALID_POINTER(montageData.get())
+          bool compared = CompareTuple<float>(tileData, tileTuple, montageData, montageTuple) || CompareTuple<int32_t>(tileData, tileTuple, montageData, montageTuple);
+          DREAM3D_REQUIRE_EQUAL(compared, true)
+        }
+      }
+    }
     return EXIT_SUCCESS;
   }
 
@@ -93,12 +296,8 @@ public:
   {
     int err = EXIT_SUCCESS;
 
-    DREAM3D_REGISTER_TEST(TestFilterAvailability());
-
-    DREAM3D_REGISTER_TEST(TestImportEbsdMontageTest())
-
+    DREAM3D_REGISTER_TEST(WriteTestFiles())
+    DREAM3D_REGISTER_TEST(TestStitchedMontage())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
-
-private:
 };
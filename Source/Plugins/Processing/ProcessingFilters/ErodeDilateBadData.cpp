@@ -48,6 +48,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/TupleRemapPlan.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -320,6 +322,9 @@ void ErodeDilateBadData::execute()
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
+    // The Feature Ids decide which Cells are replaced, so they are updated while the plan is built
+    bool copyFeatureIds = voxelArrayNames.removeAll(m_FeatureIdsArrayPath.getDataArrayName()) > 0;
+    TupleRemapPlan remapPlan(m->getAttributeMatrix(attrMatName), voxelArrayNames);
 
     for(size_t j = 0; j < totalPoints; j++)
     {
@@ -329,14 +334,15 @@ void ErodeDilateBadData::execute()
       {
         if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
         {
-          for(const auto& arrayName : voxelArrayNames)
+          remapPlan.addCopy(neighbor, j);
+          if(copyFeatureIds)
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-            p->copyTuple(neighbor, j);
+            m_FeatureIds[j] = m_FeatureIds[neighbor];
           }
         }
       }
     }
+    remapPlan.apply();
   }
 }
 
@@ -47,6 +47,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/TupleRemapPlan.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -192,6 +194,10 @@ void ErodeDilateCoordinationNumber::execute()
   {
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
+  // The scan reads the Feature Ids of Cells that were already replaced, so they are updated immediately
+  // and every other array is remapped once per pass
+  bool copyFeatureIds = voxelArrayNames.removeAll(m_FeatureIdsArrayPath.getDataArrayName()) > 0;
+  TupleRemapPlan remapPlan(m->getAttributeMatrix(attrMatName), voxelArrayNames);
 
   QVector<int32_t> n(numfeatures + 1, 0);
   QVector<int32_t> coordinationNumber(totalPoints, 0);
@@ -267,10 +273,10 @@ void ErodeDilateCoordinationNumber::execute()
           int32_t neighbor = m_Neighbors[point];
           if(coordinationNumber[point] >= m_CoordinationNumber && coordinationNumber[point] > 0)
           {
-            for(const auto& arrayName : voxelArrayNames)
+            remapPlan.addCopy(neighbor, point);
+            if(copyFeatureIds)
             {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-              p->copyTuple(neighbor, point);
+              m_FeatureIds[point] = m_FeatureIds[neighbor];
             }
           }
           for(int32_t l = 0; l < 6; l++)
@@ -313,6 +319,9 @@ void ErodeDilateCoordinationNumber::execute()
         }
       }
     }
+    remapPlan.apply();
+    remapPlan.clear();
+
     for(int64_t k = 0; k < dims[2]; k++)
     {
       kstride = static_cast<int64_t>(dims[0] * dims[1] * k);
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ErodeDilateMask.h"
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -193,10 +195,7 @@ void ErodeDilateMask::execute()
 
   for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      m_MaskCopy[j] = m_Mask[j];
-    }
+    std::copy(m_Mask, m_Mask + totalPoints, m_MaskCopy);
     for(int64_t k = 0; k < dims[2]; k++)
     {
       kstride = dims[0] * dims[1] * k;
@@ -252,10 +251,7 @@ void ErodeDilateMask::execute()
         }
       }
     }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      m_Mask[j] = m_MaskCopy[j];
-    }
+    std::copy(m_MaskCopy, m_MaskCopy + totalPoints, m_Mask);
   }
 }
 
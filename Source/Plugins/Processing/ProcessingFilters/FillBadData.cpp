@@ -48,6 +48,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/TupleRemapPlan.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -409,6 +411,9 @@ void FillBadData::execute()
 
     QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
     QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    // The Feature Ids decide which Cells are filled, so they are updated while the plan is built
+    bool copyFeatureIds = voxelArrayNames.removeAll(m_FeatureIdsArrayPath.getDataArrayName()) > 0;
+    TupleRemapPlan remapPlan(m->getAttributeMatrix(attrMatName), voxelArrayNames);
 
     for(size_t j = 0; j < totalPoints; j++)
     {
@@ -416,13 +421,14 @@ void FillBadData::execute()
       neighbor = m_Neighbors[j];
       if(featurename < 0 && neighbor != -1 && m_FeatureIds[neighbor] > 0)
       {
-        for(const auto& arrayName : voxelArrayNames)
+        remapPlan.addCopy(neighbor, j);
+        if(copyFeatureIds)
         {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-          p->copyTuple(neighbor, j);
+          m_FeatureIds[j] = m_FeatureIds[neighbor];
         }
       }
     }
+    remapPlan.apply();
   }
 }
 
@@ -47,6 +47,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/TupleRemapPlan.h"
+
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
@@ -398,7 +400,9 @@ void MinSize::assign_badpoints()
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
+    // The Feature Ids decide which Cells are replaced, so they are updated while the plan is built
+    bool copyFeatureIds = voxelArrayNames.removeAll(m_FeatureIdsArrayPath.getDataArrayName()) > 0;
+    TupleRemapPlan remapPlan(m->getAttributeMatrix(attrMatName), voxelArrayNames);
     for(size_t j = 0; j < totalPoints; j++)
     {
       featurename = m_FeatureIds[j];
@@ -407,14 +411,15 @@ void MinSize::assign_badpoints()
       {
         if(featurename < 0 && m_FeatureIds[neighbor] >= 0)
         {
-          for(auto& voxelArrayName : voxelArrayNames)
+          remapPlan.addCopy(neighbor, j);
+          if(copyFeatureIds)
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(voxelArrayName);
-            p->copyTuple(neighbor, j);
+            m_FeatureIds[j] = m_FeatureIds[neighbor];
           }
         }
       }
     }
+    remapPlan.apply();
   }
 }
 
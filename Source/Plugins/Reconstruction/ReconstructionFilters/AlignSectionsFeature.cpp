@@ -48,6 +48,69 @@
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
+#include "Reconstruction/ReconstructionFilters/util/SliceShiftSearch.h"
+
+/**
+ * @brief The MaskShiftCost class computes the fraction of sampled Cells whose mask value differs across a
+ * candidate shift, abandoning the shift once it can no longer beat the best fraction found so far.
+ */
+class MaskShiftCost
+{
+public:
+  MaskShiftCost(const int64_t dims[3], bool* goodVoxels)
+  : m_GoodVoxels(goodVoxels)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  float operator()(int64_t slice, int64_t xShift, int64_t yShift, int64_t stride, float bound) const
+  {
+    float rowCount = 0.0f;
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      rowCount += ((l + yShift) >= 0 && (l + yShift) < m_Dims[1]) ? 1.0f : 0.0f;
+    }
+    float columnCount = 0.0f;
+    for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+    {
+      columnCount += ((n + xShift) >= 0 && (n + xShift) < m_Dims[0]) ? 1.0f : 0.0f;
+    }
+    const float count = rowCount * columnCount;
+
+    float disorientation = 0.0f;
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      if((l + yShift) < 0 || (l + yShift) >= m_Dims[1])
+      {
+        continue;
+      }
+      for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+      {
+        if((n + xShift) >= 0 && (n + xShift) < m_Dims[0])
+        {
+          int64_t refposition = ((slice + 1) * sliceSize) + (l * m_Dims[0]) + n;
+          int64_t curposition = (slice * sliceSize) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+          if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+          {
+            disorientation++;
+          }
+        }
+      }
+      if(disorientation / count > bound)
+      {
+        return disorientation / count;
+      }
+    }
+    return disorientation / count;
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  bool* m_GoodVoxels = nullptr;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -131,11 +194,6 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -144,88 +202,27 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int32_t newxshift = 0;
-  int32_t newyshift = 0;
-  int32_t oldxshift = 0;
-  int32_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  std::vector<std::vector<float>> misorients(dims[0]);
-
-  for(int64_t a = 0; a < dims[0]; a++)
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  SliceShiftSearch<MaskShiftCost> search(dims, MaskShiftCost(dims, m_GoodVoxels), false, false, newxshifts, newyshifts);
+  if(!search.execute(this))
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(((float)iter / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0.0f && abs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
-                  {
-                    disorientation++;
-                  }
-                  count++;
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
     }
   }
   if(getWriteAlignmentShifts())
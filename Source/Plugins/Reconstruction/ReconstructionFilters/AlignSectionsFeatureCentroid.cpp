@@ -51,6 +51,57 @@
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
+#include "Reconstruction/ReconstructionFilters/util/SliceShiftSearch.h"
+
+/**
+ * @brief The SliceCentroidsImpl class computes the centroid of the masked Cells of each slice. Slices are
+ * independent, so they are processed in parallel.
+ */
+class SliceCentroidsImpl
+{
+public:
+  SliceCentroidsImpl(const SizeVec3Type& dims, const FloatVec3Type& spacing, bool* goodVoxels, std::vector<float>& xCentroid, std::vector<float>& yCentroid)
+  : m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_GoodVoxels(goodVoxels)
+  , m_XCentroid(xCentroid.data())
+  , m_YCentroid(yCentroid.data())
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      size_t count = 0;
+      float xCentroid = 0.0f;
+      float yCentroid = 0.0f;
+      size_t slice = (m_Dims[2] - 1) - iter;
+      for(size_t l = 0; l < m_Dims[1]; l++)
+      {
+        size_t point = (slice * m_Dims[0] * m_Dims[1]) + (l * m_Dims[0]);
+        for(size_t n = 0; n < m_Dims[0]; n++, point++)
+        {
+          if(m_GoodVoxels[point])
+          {
+            xCentroid = xCentroid + (static_cast<float>(n) * m_Spacing[0]);
+            yCentroid = yCentroid + (static_cast<float>(l) * m_Spacing[1]);
+            count++;
+          }
+        }
+      }
+      m_XCentroid[iter] = xCentroid / static_cast<float>(count);
+      m_YCentroid[iter] = yCentroid / static_cast<float>(count);
+    }
+  }
+
+private:
+  SizeVec3Type m_Dims;
+  FloatVec3Type m_Spacing;
+  bool* m_GoodVoxels = nullptr;
+  float* m_XCentroid = nullptr;
+  float* m_YCentroid = nullptr;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -155,13 +206,6 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-    outFile << "#"
-            << "Slice_A,Slice_B,New X Shift,New Y Shift,X Shift, Y Shift, X Centroid, Y Centroid" << std::endl;
-  }
   SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t sdims[3] = {
@@ -172,37 +216,22 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
 
   size_t newxshift = 0;
   size_t newyshift = 0;
-  size_t count = 0;
   size_t slice = 0;
-  size_t point = 0;
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
   std::vector<float> xCentroid(dims[2], 0.0f);
   std::vector<float> yCentroid(dims[2], 0.0f);
 
-  for(size_t iter = 0; iter < dims[2]; iter++)
+  if(!SliceBatchDriver::Execute(this, 0, sdims[2], SliceCentroidsImpl(dims, spacing, m_GoodVoxels, xCentroid, yCentroid)))
   {
-    count = 0;
-    xCentroid[iter] = 0;
-    yCentroid[iter] = 0;
-
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg((static_cast<double>(iter) / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    slice = static_cast<size_t>((dims[2] - 1) - iter);
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
-      {
-        point = ((slice)*dims[0] * dims[1]) + (l * dims[0]) + n;
-        if(m_GoodVoxels[point])
-        {
-          xCentroid[iter] = xCentroid[iter] + (static_cast<float>(n) * spacing[0]);
-          yCentroid[iter] = yCentroid[iter] + (static_cast<float>(l) * spacing[1]);
-          count++;
-        }
-      }
-    }
-    xCentroid[iter] = xCentroid[iter] / static_cast<float>(count);
-    yCentroid[iter] = yCentroid[iter] / static_cast<float>(count);
+    return;
+  }
+
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+    outFile << "#"
+            << "Slice_A,Slice_B,New X Shift,New Y Shift,X Shift, Y Shift, X Centroid, Y Centroid" << std::endl;
   }
 
   bool xWarning = false;
@@ -42,6 +42,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -56,6 +57,102 @@
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
+#include "Reconstruction/ReconstructionFilters/util/SliceShiftSearch.h"
+
+/**
+ * @brief The MisorientationShiftCost class computes the fraction of sampled Cells whose misorientation across a
+ * candidate shift is larger than the tolerance. Rows are summed one at a time, so a shift is abandoned as soon as
+ * its fraction can no longer be at or below the best fraction found so far.
+ */
+class MisorientationShiftCost
+{
+public:
+  MisorientationShiftCost(const int64_t dims[3], float* quats, int32_t* cellPhases, uint32_t* crystalStructures, bool* goodVoxels, float misorientationTolerance)
+  : m_OrientationOps(LaueOps::GetAllOrientationOps())
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_MisorientationTolerance(misorientationTolerance)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  float operator()(int64_t slice, int64_t xShift, int64_t yShift, int64_t stride, float bound) const
+  {
+    // The number of sampled Cells that overlap is known up front, which lets the partial sum be normalized
+    float rowCount = 0.0f;
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      rowCount += ((l + yShift) >= 0 && (l + yShift) < m_Dims[1]) ? 1.0f : 0.0f;
+    }
+    float columnCount = 0.0f;
+    for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+    {
+      columnCount += ((n + xShift) >= 0 && (n + xShift) < m_Dims[0]) ? 1.0f : 0.0f;
+    }
+    const float count = rowCount * columnCount;
+
+    float disorientation = 0.0f;
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      if((l + yShift) < 0 || (l + yShift) >= m_Dims[1])
+      {
+        continue;
+      }
+      for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+      {
+        if((n + xShift) < 0 || (n + xShift) >= m_Dims[0])
+        {
+          continue;
+        }
+        int64_t refposition = ((slice + 1) * sliceSize) + (l * m_Dims[0]) + n;
+        int64_t curposition = (slice * sliceSize) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+        if(nullptr == m_GoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+        {
+          float w = std::numeric_limits<float>::max();
+          if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+          {
+            uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+            uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+            if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
+            {
+              QuatF q1(m_Quats + refposition * 4); // BEWARE POINTER MATH!!
+              QuatF q2(m_Quats + curposition * 4); // BEWARE POINTER MATH!!
+              OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+              w = axisAngle[3];
+            }
+          }
+          if(w > m_MisorientationTolerance)
+          {
+            disorientation++;
+          }
+        }
+        if(nullptr != m_GoodVoxels && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+        {
+          disorientation++;
+        }
+      }
+      if(disorientation / count > bound)
+      {
+        return disorientation / count;
+      }
+    }
+    return disorientation / count;
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  std::vector<LaueOps::Pointer> m_OrientationOps;
+  float* m_Quats = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  uint32_t* m_CrystalStructures = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  float m_MisorientationTolerance = 0.0f;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -63,6 +160,7 @@
 AlignSectionsMisorientation::AlignSectionsMisorientation()
 : m_MisorientationTolerance(5.0f)
 , m_UseGoodVoxels(true)
+, m_UseCoarseToFineSearch(false)
 , m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_GoodVoxelsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask)
@@ -89,6 +187,7 @@ void AlignSectionsMisorientation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, AlignSectionsMisorientation));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, AlignSectionsMisorientation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Coarse to Fine Search", UseCoarseToFineSearch, FilterParameter::Parameter, AlignSectionsMisorientation));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -122,6 +221,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseCoarseToFineSearch(reader->readValue("UseCoarseToFineSearch", getUseCoarseToFineSearch()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
@@ -208,12 +308,6 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -222,139 +316,31 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[2]),
   };
 
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
+  float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180;
+  MisorientationShiftCost cost(dims, m_Quats, m_CellPhases, m_CrystalStructures, m_UseGoodVoxels ? m_GoodVoxels : nullptr, misorientationTolerance);
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], std::string("_INTERNAL_USE_ONLY_Misorients"), true);
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
-
-  const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
-  const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
+  // Every slice pair is searched independently, then the relative shifts are accumulated in order
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  SliceShiftSearch<MisorientationShiftCost> search(dims, cost, true, m_UseCoarseToFineSearch, newxshifts, newyshifts);
+  if(!search.execute(this))
+  {
+    return;
+  }
 
-  // Loop over the Z Direction
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    progInt = ((float)iter / dims[2]) * 100.0f;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-    if(getCancel())
-    {
-      return;
-    }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
-
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180;
-
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-
-                      QuatF q1(m_Quats + refposition * 4); // BEWARE POINTER MATH!!
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuatF q2(m_Quats + curposition * 4); // BEWARE POINTER MATH!!
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                        w = axisAngle[3];
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
   }
   if(getWriteAlignmentShifts())
@@ -504,6 +490,18 @@ bool AlignSectionsMisorientation::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void AlignSectionsMisorientation::setUseCoarseToFineSearch(bool value)
+{
+  m_UseCoarseToFineSearch = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AlignSectionsMisorientation::getUseCoarseToFineSearch() const
+{
+  return m_UseCoarseToFineSearch;
+}
+
 // -----------------------------------------------------------------------------
 void AlignSectionsMisorientation::setQuatsArrayPath(const DataArrayPath& value)
 {
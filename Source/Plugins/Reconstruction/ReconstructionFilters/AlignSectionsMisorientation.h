@@ -59,6 +59,7 @@ class Reconstruction_EXPORT AlignSectionsMisorientation : public AlignSections
   PYB11_FILTER_NEW_MACRO(AlignSectionsMisorientation)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+  PYB11_PROPERTY(bool UseCoarseToFineSearch READ getUseCoarseToFineSearch WRITE setUseCoarseToFineSearch)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
@@ -118,6 +119,17 @@ public:
   bool getUseGoodVoxels() const;
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  /**
+   * @brief Setter property for UseCoarseToFineSearch
+   */
+  void setUseCoarseToFineSearch(bool value);
+  /**
+   * @brief Getter property for UseCoarseToFineSearch
+   * @return Value of UseCoarseToFineSearch
+   */
+  bool getUseCoarseToFineSearch() const;
+  Q_PROPERTY(bool UseCoarseToFineSearch READ getUseCoarseToFineSearch WRITE setUseCoarseToFineSearch)
+
   /**
    * @brief Setter property for QuatsArrayPath
    */
@@ -251,6 +263,7 @@ private:
 
   float m_MisorientationTolerance = {};
   bool m_UseGoodVoxels = {};
+  bool m_UseCoarseToFineSearch = {};
   DataArrayPath m_QuatsArrayPath = {};
   DataArrayPath m_CellPhasesArrayPath = {};
   DataArrayPath m_GoodVoxelsArrayPath = {};
@@ -54,6 +54,95 @@
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
+#include "Reconstruction/ReconstructionFilters/util/SliceShiftSearch.h"
+
+/**
+ * @brief The MutualInformationShiftCost class computes the inverse of the mutual information between the
+ * per-section features of two neighboring slices for a candidate shift.
+ */
+class MutualInformationShiftCost
+{
+public:
+  MutualInformationShiftCost(const int64_t dims[3], int32_t* miFeatureIds, int32_t* featureCounts)
+  : m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  float operator()(int64_t slice, int64_t xShift, int64_t yShift, int64_t stride, float bound) const
+  {
+    (void)bound;
+    const int32_t featurecount1 = m_FeatureCounts[slice];
+    const int32_t featurecount2 = m_FeatureCounts[slice + 1];
+    std::vector<float> mutualinfo12(static_cast<size_t>(featurecount1) * featurecount2, 0.0f);
+    std::vector<float> mutualinfo1(featurecount1, 0.0f);
+    std::vector<float> mutualinfo2(featurecount2, 0.0f);
+
+    float count = 0.0f;
+    const int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(int64_t l = 0; l < m_Dims[1]; l = l + stride)
+    {
+      for(int64_t n = 0; n < m_Dims[0]; n = n + stride)
+      {
+        if((l + yShift) >= 0 && (l + yShift) < m_Dims[1] && (n + xShift) >= 0 && (n + xShift) < m_Dims[0])
+        {
+          int64_t refposition = ((slice + 1) * sliceSize) + (l * m_Dims[0]) + n;
+          int64_t curposition = (slice * sliceSize) + ((l + yShift) * m_Dims[0]) + (n + xShift);
+          int32_t refgnum = m_MIFeatureIds[refposition];
+          int32_t curgnum = m_MIFeatureIds[curposition];
+          if(curgnum >= 0 && refgnum >= 0)
+          {
+            mutualinfo12[curgnum * featurecount2 + refgnum]++;
+            mutualinfo1[curgnum]++;
+            mutualinfo2[refgnum]++;
+            count++;
+          }
+        }
+        else
+        {
+          mutualinfo12[0]++;
+          mutualinfo1[0]++;
+          mutualinfo2[0]++;
+        }
+      }
+    }
+
+    for(int32_t b = 0; b < featurecount1; b++)
+    {
+      mutualinfo1[b] = mutualinfo1[b] / count;
+    }
+    for(int32_t c = 0; c < featurecount2; c++)
+    {
+      mutualinfo2[c] = mutualinfo2[c] / count;
+    }
+    float disorientation = 0.0f;
+    for(int32_t b = 0; b < featurecount1; b++)
+    {
+      for(int32_t c = 0; c < featurecount2; c++)
+      {
+        float joint = mutualinfo12[b * featurecount2 + c] / count;
+        float value = 0.0f;
+        if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
+        {
+          value = (joint / (mutualinfo1[b] * mutualinfo2[c]));
+        }
+        if(value != 0)
+        {
+          disorientation = disorientation + (joint * logf(value));
+        }
+      }
+    }
+    return 1.0f / disorientation;
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int32_t* m_MIFeatureIds = nullptr;
+  int32_t* m_FeatureCounts = nullptr;
+};
 
 // -----------------------------------------------------------------------------
 //
@@ -216,12 +305,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   m_MIFeaturesPtr->initializeWithZeros();
   int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -230,180 +313,30 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  SliceShiftSearch<MutualInformationShiftCost> search(dims, MutualInformationShiftCost(dims, miFeatureIds, featurecounts), false, false, newxshifts, newyshifts);
+  if(!search.execute(this))
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
+      outFile << slice << "\t" << slice + 1 << "\t" << newxshifts[iter] << "\t" << newyshifts[iter] << "\t" << xshifts[iter] << "\t" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -69,6 +69,67 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The CAxisGroupingPredicate class groups neighboring cells of the same phase whose c-axes are aligned
+ * within the tolerance. It is the @see UnionFindSegmentation counterpart of CAxisSegmentFeatures::determineGrouping()
+ */
+class CAxisGroupingPredicate
+{
+public:
+  CAxisGroupingPredicate(float* quats, int32_t* cellPhases, bool* goodVoxels, float misoTolerance)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_MisoTolerance(misoTolerance)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return nullptr == m_GoodVoxels || m_GoodVoxels[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return isValid(index) && m_CellPhases[index] > 0;
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    if(m_CellPhases[index] != m_CellPhases[neighbor])
+    {
+      return false;
+    }
+    float g1[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g2[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g1t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float g2t[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    float caxis[3] = {0.0f, 0.0f, 1.0f};
+    float c1[3] = {0.0f, 0.0f, 0.0f};
+    float c2[3] = {0.0f, 0.0f, 0.0f};
+
+    QuatF q1(m_Quats + index * 4);
+    QuatF q2(m_Quats + neighbor * 4);
+    OrientationTransformation::qu2om<QuatF, Orientation<float>>(q1).toGMatrix(g1);
+    OrientationTransformation::qu2om<QuatF, Orientation<float>>(q2).toGMatrix(g2);
+    MatrixMath::Transpose3x3(g1, g1t);
+    MatrixMath::Transpose3x3(g2, g2t);
+    MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+    MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+    MatrixMath::Normalize3x1(c1);
+    MatrixMath::Normalize3x1(c2);
+
+    float w = acosf((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2]));
+    return w <= m_MisoTolerance || (SIMPLib::Constants::k_Pi - w) <= m_MisoTolerance;
+  }
+
+private:
+  float* m_Quats = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  float m_MisoTolerance = 0.0f;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -310,7 +371,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -337,9 +397,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -436,7 +493,20 @@ void CAxisSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  CAxisGroupingPredicate predicate(m_Quats, m_CellPhases, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_MisoTolerance);
+  int32_t numFeatures = segmentInParallel(predicate, m_FeatureIds);
+#else
+  int32_t numFeatures = burnFeatures();
+#endif
+  if(getCancel())
+  {
+    return;
+  }
+  // Size the feature AttributeMatrix once now that the number of features is known
+  tDims[0] = static_cast<size_t>(numFeatures) + 1;
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
@@ -66,6 +66,59 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The EBSDGroupingPredicate class groups neighboring cells of the same phase whose misorientation
+ * is below the tolerance. It is the @see UnionFindSegmentation counterpart of EBSDSegmentFeatures::determineGrouping()
+ */
+class EBSDGroupingPredicate
+{
+public:
+  EBSDGroupingPredicate(float* quats, int32_t* cellPhases, uint32_t* crystalStructures, bool* goodVoxels, const LaueOpsContainer& orientationOps, float misoTolerance)
+  : m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_GoodVoxels(goodVoxels)
+  , m_OrientationOps(orientationOps)
+  , m_MisoTolerance(misoTolerance)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return nullptr == m_GoodVoxels || m_GoodVoxels[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return isValid(index) && m_CellPhases[index] > 0;
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    if(m_CellPhases[index] != m_CellPhases[neighbor])
+    {
+      return false;
+    }
+    uint32_t phase = m_CrystalStructures[m_CellPhases[index]];
+    if(phase >= m_OrientationOps.size())
+    {
+      return false;
+    }
+    QuatF q1(m_Quats + index * 4);
+    QuatF q2(m_Quats + neighbor * 4);
+    OrientationF axisAngle = m_OrientationOps[phase]->calculateMisorientation(q1, q2);
+    return axisAngle[3] < m_MisoTolerance;
+  }
+
+private:
+  float* m_Quats = nullptr;
+  int32_t* m_CellPhases = nullptr;
+  uint32_t* m_CrystalStructures = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  LaueOpsContainer m_OrientationOps;
+  float m_MisoTolerance = 0.0f;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -293,7 +346,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -320,9 +372,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -401,7 +450,20 @@ void EBSDSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  EBSDGroupingPredicate predicate(m_Quats, m_CellPhases, m_CrystalStructures, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_OrientationOps, m_MisoTolerance);
+  int32_t numFeatures = segmentInParallel(predicate, m_FeatureIds);
+#else
+  int32_t numFeatures = burnFeatures();
+#endif
+  if(getCancel())
+  {
+    return;
+  }
+  // Size the feature AttributeMatrix once now that the number of features is known
+  tDims[0] = static_cast<size_t>(numFeatures) + 1;
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
@@ -35,6 +35,7 @@
 #include "ScalarSegmentFeatures.h"
 
 #include <chrono>
+#include <type_traits>
 
 #include <QtCore/QTextStream>
 
@@ -170,6 +171,54 @@ private:
   int32_t* m_FeatureIds = nullptr;   // The Feature Ids
 };
 
+/**
+ * @brief The ScalarGroupingPredicate class groups neighboring cells whose scalar values differ by no more than the
+ * tolerance (boolean data must be equal). It is the non-virtual @see UnionFindSegmentation counterpart of
+ * @see TSpecificCompareFunctor and @see TSpecificCompareFunctorBool
+ */
+template <typename T>
+class ScalarGroupingPredicate
+{
+public:
+  ScalarGroupingPredicate(void* data, T tolerance, bool* goodVoxels)
+  : m_Data(reinterpret_cast<T*>(data))
+  , m_Tolerance(tolerance)
+  , m_GoodVoxels(goodVoxels)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return nullptr == m_GoodVoxels || m_GoodVoxels[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return isValid(index);
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    if constexpr(std::is_same<T, bool>::value)
+    {
+      return m_Data[index] == m_Data[neighbor];
+    }
+    else
+    {
+      if(m_Data[index] >= m_Data[neighbor])
+      {
+        return (m_Data[index] - m_Data[neighbor]) <= m_Tolerance;
+      }
+      return (m_Data[neighbor] - m_Data[index]) <= m_Tolerance;
+    }
+  }
+
+private:
+  T* m_Data = nullptr;
+  T m_Tolerance = static_cast<T>(0);
+  bool* m_GoodVoxels = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -384,7 +433,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -411,9 +459,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -465,9 +510,57 @@ void ScalarSegmentFeatures::execute()
   updateFeatureInstancePointers();
 
   int64_t totalPoints = static_cast<int64_t>(m_FeatureIdsPtr.lock()->getNumberOfTuples());
-  int64_t inDataPoints = static_cast<int64_t>(m_InputDataPtr.lock()->getNumberOfTuples());
 
   QString dType = m_InputDataPtr.lock()->getTypeAsString();
+  int32_t numFeatures = 0;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  bool* goodVoxels = m_UseGoodVoxels ? m_GoodVoxels : nullptr;
+  if(dType.compare("int8_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<int8_t>(m_InputData, static_cast<int8_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("uint8_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<uint8_t>(m_InputData, static_cast<uint8_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("bool") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<bool>(m_InputData, static_cast<bool>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("int16_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<int16_t>(m_InputData, static_cast<int16_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("uint16_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<uint16_t>(m_InputData, static_cast<uint16_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("int32_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<int32_t>(m_InputData, static_cast<int32_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("uint32_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<uint32_t>(m_InputData, static_cast<uint32_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("int64_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<int64_t>(m_InputData, static_cast<int64_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("uint64_t") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<uint64_t>(m_InputData, static_cast<uint64_t>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("float") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<float>(m_InputData, m_ScalarTolerance, goodVoxels), m_FeatureIds);
+  }
+  else if(dType.compare("double") == 0)
+  {
+    numFeatures = segmentInParallel(ScalarGroupingPredicate<double>(m_InputData, static_cast<double>(m_ScalarTolerance), goodVoxels), m_FeatureIds);
+  }
+#else
+  int64_t inDataPoints = static_cast<int64_t>(m_InputDataPtr.lock()->getNumberOfTuples());
   if(m_InputDataPtr.lock()->getNumberOfComponents() != 1)
   {
     m_Compare = std::shared_ptr<CompareFunctor>(new CompareFunctor()); // The default CompareFunctor which ALWAYS returns false for the comparison
@@ -522,7 +615,16 @@ void ScalarSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  numFeatures = burnFeatures();
+#endif
+  if(getCancel())
+  {
+    return;
+  }
+  // Size the feature AttributeMatrix once now that the number of features is known
+  tDims[0] = static_cast<size_t>(numFeatures) + 1;
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
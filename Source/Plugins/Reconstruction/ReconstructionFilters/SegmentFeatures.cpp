@@ -101,6 +101,18 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::getGridDimensions(int64_t dims[3])
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  SizeVec3Type udims = m->getGeometryAs<IGeometryGrid>()->getDimensions();
+  dims[0] = static_cast<int64_t>(udims[0]);
+  dims[1] = static_cast<int64_t>(udims[1]);
+  dims[2] = static_cast<int64_t>(udims[2]);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -114,15 +126,16 @@ void SegmentFeatures::execute()
     return;
   }
 
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
-  SizeVec3Type udims = m->getGeometryAs<IGeometryGrid>()->getDimensions();
+  burnFeatures();
+}
 
-  int64_t dims[3] = {
-      static_cast<int64_t>(udims[0]),
-      static_cast<int64_t>(udims[1]),
-      static_cast<int64_t>(udims[2]),
-  };
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t SegmentFeatures::burnFeatures()
+{
+  int64_t dims[3] = {0, 0, 0};
+  getGridDimensions(dims);
 
   int32_t gnum = 1;
   int64_t seed = 0;
@@ -198,18 +211,13 @@ void SegmentFeatures::execute()
               if(size >= voxelslist.size())
               {
                 size = voxelslist.size();
-                voxelslist.resize(size + initialVoxelsListSize);
-                for(std::vector<int64_t>::size_type j = size; j < voxelslist.size(); ++j)
-                {
-                  voxelslist[j] = -1;
-                }
+                voxelslist.resize(size * 2, -1);
               }
             }
           }
         }
       }
 
-      voxelslist.assign(initialVoxelsListSize, -1);
       gnum++;
       QString ss = QObject::tr("Total Features: %1").arg(gnum);
       if(gnum % 100 == 0)
@@ -222,6 +230,7 @@ void SegmentFeatures::execute()
       break;
     }
   }
+  return gnum - 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -41,6 +41,7 @@
 #include "SIMPLib/SIMPLib.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/util/UnionFindSegmentation.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
 #include "Reconstruction/ReconstructionDLLExport.h"
@@ -188,6 +189,38 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief burnFeatures Runs the serial burn, seeding features with getSeed() and growing them with
+   * determineGrouping(). The feature AttributeMatrix is not touched while burning; the caller sizes it
+   * once to the returned number of features + 1 instead of growing it every time a feature is seeded.
+   * @return Number of features found, not counting feature 0
+   */
+  int32_t burnFeatures();
+
+  /**
+   * @brief getGridDimensions Returns the dimensions of the grid geometry that is being segmented
+   * @param dims Output dimensions
+   */
+  void getGridDimensions(int64_t dims[3]);
+
+  /**
+   * @brief segmentInParallel Segments the grid with the parallel union-find engine instead of the serial burn
+   * in execute(). The Feature Ids match the serial burn; the caller is responsible for sizing the feature
+   * AttributeMatrix to the returned number of features + 1.
+   * @param predicate Grouping predicate, see @see UnionFindSegmentation for the required interface
+   * @param featureIds Feature Ids to fill in
+   * @return Number of features found, not counting feature 0, or -1 if the filter was canceled
+   */
+  template <typename GroupingPredicate>
+  int32_t segmentInParallel(const GroupingPredicate& predicate, int32_t* featureIds)
+  {
+    int64_t dims[3] = {0, 0, 0};
+    getGridDimensions(dims);
+    notifyStatusMessage("Segmenting Features");
+    UnionFindSegmentation<GroupingPredicate> engine(dims, predicate, featureIds);
+    return engine.execute(this);
+  }
+
 public:
   SegmentFeatures(const SegmentFeatures&) = delete;            // Copy Constructor Not Implemented
   SegmentFeatures(SegmentFeatures&&) = delete;                 // Move Constructor Not Implemented
@@ -60,6 +60,49 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The SineParamsGroupingPredicate class groups neighboring cells whose sine curves differ by less than
+ * the fixed threshold on average. It is the @see UnionFindSegmentation counterpart of SineParamsSegmentFeatures::determineGrouping()
+ */
+class SineParamsGroupingPredicate
+{
+public:
+  SineParamsGroupingPredicate(float* sineParams, bool* goodVoxels)
+  : m_SineParams(sineParams)
+  , m_GoodVoxels(goodVoxels)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return nullptr == m_GoodVoxels || m_GoodVoxels[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return isValid(index);
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    const float step = 45.0f * SIMPLib::Constants::k_PiOver180;
+    float avgDiff = 0;
+    for(int i = 0; i < 8; i++)
+    {
+      float shift = float(i) * step;
+      float v1 = m_SineParams[3 * index] * sin(2.0 * (shift + m_SineParams[3 * index + 2])) + m_SineParams[3 * index + 1];
+      float v2 = m_SineParams[3 * neighbor] * sin(2.0 * (shift + m_SineParams[3 * neighbor + 2])) + m_SineParams[3 * neighbor + 1];
+      avgDiff += fabs(v1 - v2);
+    }
+    avgDiff /= 8.0;
+    return avgDiff < 7;
+  }
+
+private:
+  float* m_SineParams = nullptr;
+  bool* m_GoodVoxels = nullptr;
+};
+
 #define ERROR_TXT_OUT 1
 #define ERROR_TXT_OUT1 1
 
@@ -252,7 +295,20 @@ void SineParamsSegmentFeatures::execute()
   const size_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  SineParamsGroupingPredicate predicate(m_SineParams, m_UseGoodVoxels ? m_GoodVoxels : nullptr);
+  int32_t numFeatures = segmentInParallel(predicate, m_FeatureIds);
+#else
+  int32_t numFeatures = burnFeatures();
+#endif
+  if(getCancel())
+  {
+    return;
+  }
+  // Size the feature AttributeMatrix once now that the number of features is known
+  tDims[0] = static_cast<size_t>(numFeatures) + 1;
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->getNumberOfTuples();
   if(totalFeatures < 2)
@@ -320,7 +376,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -347,9 +402,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
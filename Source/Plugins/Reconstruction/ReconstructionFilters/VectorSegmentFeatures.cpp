@@ -63,6 +63,56 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The VectorGroupingPredicate class groups neighboring cells whose vectors (taken as undirected axes) are
+ * within the angle tolerance. It is the @see UnionFindSegmentation counterpart of VectorSegmentFeatures::determineGrouping()
+ */
+class VectorGroupingPredicate
+{
+public:
+  VectorGroupingPredicate(float* vectors, bool* goodVoxels, float angleToleranceRad)
+  : m_Vectors(vectors)
+  , m_GoodVoxels(goodVoxels)
+  , m_AngleToleranceRad(angleToleranceRad)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return nullptr == m_GoodVoxels || m_GoodVoxels[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return isValid(index);
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    float v1[3] = {m_Vectors[3 * index + 0], m_Vectors[3 * index + 1], m_Vectors[3 * index + 2]};
+    float v2[3] = {m_Vectors[3 * neighbor + 0], m_Vectors[3 * neighbor + 1], m_Vectors[3 * neighbor + 2]};
+    if(v1[2] < 0)
+    {
+      MatrixMath::Multiply3x1withConstant(v1, -1.0f);
+    }
+    if(v2[2] < 0)
+    {
+      MatrixMath::Multiply3x1withConstant(v2, -1.0f);
+    }
+    float w = acosf(GeometryMath::CosThetaBetweenVectors(v1, v2));
+    if(w > SIMPLib::Constants::k_PiOver2)
+    {
+      w = SIMPLib::Constants::k_Pi - w;
+    }
+    return w < m_AngleToleranceRad;
+  }
+
+private:
+  float* m_Vectors = nullptr;
+  bool* m_GoodVoxels = nullptr;
+  float m_AngleToleranceRad = 0.0f;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -274,7 +324,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -301,9 +350,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -388,7 +434,20 @@ void VectorSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  VectorGroupingPredicate predicate(m_Vectors, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_AngleToleranceRad);
+  int32_t numFeatures = segmentInParallel(predicate, m_FeatureIds);
+#else
+  int32_t numFeatures = burnFeatures();
+#endif
+  if(getCancel())
+  {
+    return;
+  }
+  // Size the feature AttributeMatrix once now that the number of features is known
+  tDims[0] = static_cast<size_t>(numFeatures) + 1;
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int32_t totalFeatures = static_cast<int32_t>(m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->getNumberOfTuples());
   if(totalFeatures < 2)
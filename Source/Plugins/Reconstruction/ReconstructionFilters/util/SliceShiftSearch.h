@@ -0,0 +1,224 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The SliceBatchDriver class runs a functor over a range of slices with ParallelDataAlgorithm. The range
+ * is split into batches so that progress messages and cancel requests are handled on the calling thread.
+ */
+class SliceBatchDriver
+{
+public:
+  /**
+   * @brief Execute Runs body over the slices [start, end)
+   * @param filter Filter used for progress messages and cancellation
+   * @param start First slice
+   * @param end One past the last slice
+   * @param body Functor taking a SIMPLRange of slices
+   * @return false if the filter was canceled
+   */
+  template <typename Body>
+  static bool Execute(AbstractFilter* filter, int64_t start, int64_t end, const Body& body)
+  {
+    const int64_t batchSize = std::max<int64_t>(16, 4 * static_cast<int64_t>(std::thread::hardware_concurrency()));
+    for(int64_t batchStart = start; batchStart < end; batchStart += batchSize)
+    {
+      if(filter->getCancel())
+      {
+        return false;
+      }
+      float progress = (static_cast<float>(batchStart) / end) * 100.0f;
+      filter->notifyStatusMessage(QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(progress, 'f', 0)));
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(batchStart, std::min(batchStart + batchSize, end));
+      dataAlg.setGrain(1);
+      dataAlg.execute(body);
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief The SliceShiftSearch class finds the in-plane shift between every pair of neighboring slices by
+ * walking a 7x7 window of candidate shifts downhill on a cost function until the best shift stops moving.
+ * The pairs are independent, so they are searched in parallel; only the running sum of the shifts, done by
+ * the caller, is sequential.
+ *
+ * The cost function is called concurrently for different slice pairs and must provide
+ *
+ *     float operator()(int64_t slice, int64_t xShift, int64_t yShift, int64_t stride, float bound) const
+ *
+ * returning the cost of shifting slice against slice + 1, sampling every stride-th cell in X and Y. It may
+ * stop early and return any value larger than bound once the cost is known to be larger than bound.
+ *
+ * In coarse-to-fine mode the walk is first made on a sparse sampling of the slices and each finer level
+ * starts from the shift found on the previous one, which needs far fewer evaluations for large shifts.
+ */
+template <typename CostFunction>
+class SliceShiftSearch
+{
+public:
+  /**
+   * @brief SliceShiftSearch
+   * @param dims Dimensions of the volume
+   * @param cost Cost function
+   * @param preferSmallerShifts Whether a tie in cost is resolved in favor of the smaller shift
+   * @param coarseToFine Whether to search on sparser samplings first
+   * @param xShifts Output relative X shift of each slice pair, indexed like the filters' shift vectors
+   * @param yShifts Output relative Y shift of each slice pair, indexed like the filters' shift vectors
+   */
+  SliceShiftSearch(const int64_t dims[3], const CostFunction& cost, bool preferSmallerShifts, bool coarseToFine, std::vector<int64_t>& xShifts, std::vector<int64_t>& yShifts)
+  : m_Cost(cost)
+  , m_PreferSmallerShifts(preferSmallerShifts)
+  , m_CoarseToFine(coarseToFine)
+  , m_XShifts(xShifts.data())
+  , m_YShifts(yShifts.data())
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  /**
+   * @brief execute Finds the relative shift of every slice pair
+   * @param filter Filter used for progress messages and cancellation
+   * @return false if the filter was canceled
+   */
+  bool execute(AbstractFilter* filter) const
+  {
+    return SliceBatchDriver::Execute(filter, 1, m_Dims[2], *this);
+  }
+
+  /**
+   * @brief findShift Finds the shift between slice (dims[2] - 1) - iter and the slice above it
+   * @param iter
+   */
+  void findShift(int64_t iter) const
+  {
+    const int64_t slice = (m_Dims[2] - 1) - iter;
+    int64_t xShift = 0;
+    int64_t yShift = 0;
+    if(m_CoarseToFine)
+    {
+      for(int64_t stride = k_FinestStride * 4; stride > k_FinestStride; stride /= 2)
+      {
+        if(m_Dims[0] / stride >= k_MinimumSamples && m_Dims[1] / stride >= k_MinimumSamples)
+        {
+          walk(slice, stride, xShift, yShift);
+        }
+      }
+    }
+    walk(slice, k_FinestStride, xShift, yShift);
+    m_XShifts[iter] = xShift;
+    m_YShifts[iter] = yShift;
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t iter = range.min(); iter < range.max(); iter++)
+    {
+      findShift(static_cast<int64_t>(iter));
+    }
+  }
+
+private:
+  static constexpr int64_t k_FinestStride = 4;
+  static constexpr int64_t k_MinimumSamples = 8;
+
+  void walk(int64_t slice, int64_t stride, int64_t& newxshift, int64_t& newyshift) const
+  {
+    const int64_t halfDim0 = m_Dims[0] / 2;
+    const int64_t halfDim1 = m_Dims[1] / 2;
+    float mindisorientation = std::numeric_limits<float>::max();
+    std::unordered_set<int64_t> visited;
+
+    int64_t oldxshift = newxshift - 1;
+    int64_t oldyshift = newyshift - 1;
+    while(newxshift != oldxshift || newyshift != oldyshift)
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          const int64_t xShift = k + oldxshift;
+          const int64_t yShift = j + oldyshift;
+          if(llabs(xShift) >= halfDim0 || llabs(yShift) >= halfDim1)
+          {
+            continue;
+          }
+          if(!visited.insert((xShift + halfDim0) * m_Dims[1] + (yShift + halfDim1)).second)
+          {
+            continue;
+          }
+          float disorientation = m_Cost(slice, xShift, yShift, stride, mindisorientation);
+          bool smaller = m_PreferSmallerShifts && disorientation == mindisorientation && (llabs(xShift) < llabs(newxshift) || llabs(yShift) < llabs(newyshift));
+          if(disorientation < mindisorientation || smaller)
+          {
+            newxshift = xShift;
+            newyshift = yShift;
+            mindisorientation = disorientation;
+          }
+        }
+      }
+    }
+  }
+
+  int64_t m_Dims[3] = {0, 0, 0};
+  CostFunction m_Cost;
+  bool m_PreferSmallerShifts = false;
+  bool m_CoarseToFine = false;
+  int64_t* m_XShifts = nullptr;
+  int64_t* m_YShifts = nullptr;
+};
@@ -0,0 +1,484 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The UnionFindSegmentation class labels the 6-connected regions of a structured grid in parallel.
+ *
+ * The grid is split into blocks of whole X lines. Each block is flood filled on its own, giving every
+ * connected region inside the block a provisional label. The labels that touch across block faces are
+ * then merged with a lock-free union-find, and a final pass renumbers the merged regions in the order of
+ * their lowest seed cell. That is the same order the serial SegmentFeatures burn uses, so the resulting
+ * Feature Ids are identical to the serial ones.
+ *
+ * The GroupingPredicate is passed by value and called directly (no virtual dispatch). It must be safe to
+ * call concurrently and provide:
+ * @code
+ *   bool isValid(int64_t index) const;                  // may the cell belong to any feature
+ *   bool isSeed(int64_t index) const;                   // may the cell start a feature (implies isValid)
+ *   bool compare(int64_t index, int64_t neighbor) const; // symmetric grouping test, index < neighbor
+ * @endcode
+ */
+template <typename GroupingPredicate>
+class UnionFindSegmentation
+{
+public:
+  UnionFindSegmentation(const int64_t dims[3], const GroupingPredicate& predicate, int32_t* featureIds)
+  : m_Predicate(predicate)
+  , m_FeatureIds(featureIds)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  ~UnionFindSegmentation() = default;
+
+  UnionFindSegmentation(const UnionFindSegmentation&) = delete;            // Copy Constructor Not Implemented
+  UnionFindSegmentation(UnionFindSegmentation&&) = delete;                 // Move Constructor Not Implemented
+  UnionFindSegmentation& operator=(const UnionFindSegmentation&) = delete; // Copy Assignment Not Implemented
+  UnionFindSegmentation& operator=(UnionFindSegmentation&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief execute Segments the grid and writes the Feature Ids. Cells that do not belong to a feature are set to 0.
+   * @param filter Filter whose cancel request is checked between passes; may be nullptr
+   * @return The number of features found, not counting feature 0, or -1 if the filter was canceled
+   */
+  int32_t execute(AbstractFilter* filter = nullptr)
+  {
+    const int64_t numLines = m_Dims[1] * m_Dims[2];
+    if(numLines <= 0 || m_Dims[0] <= 0)
+    {
+      return 0;
+    }
+
+    // Several blocks per core keeps the load balanced when features are unevenly distributed
+    int64_t numBlocks = static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency())) * 4;
+    numBlocks = std::min(numBlocks, numLines);
+    m_BlockLineStart.resize(numBlocks + 1);
+    for(int64_t b = 0; b <= numBlocks; b++)
+    {
+      m_BlockLineStart[b] = b * numLines / numBlocks;
+    }
+    m_BlockSeeds.assign(numBlocks, std::vector<int64_t>());
+
+    ParallelDataAlgorithm labelAlg;
+    labelAlg.setRange(0, numBlocks);
+    labelAlg.setGrain(1);
+    labelAlg.execute(LabelBlocksImpl(this));
+    if(filter != nullptr && filter->getCancel())
+    {
+      return -1;
+    }
+
+    // Give each block a contiguous range of provisional labels
+    m_BlockOffset.assign(numBlocks + 1, 0);
+    for(int64_t b = 0; b < numBlocks; b++)
+    {
+      m_BlockOffset[b + 1] = m_BlockOffset[b] + static_cast<int64_t>(m_BlockSeeds[b].size());
+    }
+    const int64_t numLabels = m_BlockOffset[numBlocks];
+    m_Parents.reset(new std::atomic<int64_t>[numLabels]);
+    for(int64_t i = 0; i < numLabels; i++)
+    {
+      m_Parents[i].store(i, std::memory_order_relaxed);
+    }
+
+    ParallelDataAlgorithm mergeAlg;
+    mergeAlg.setRange(1, numBlocks);
+    mergeAlg.setGrain(1);
+    mergeAlg.execute(MergeBlockFacesImpl(this));
+    if(filter != nullptr && filter->getCancel())
+    {
+      m_Parents.reset();
+      return -1;
+    }
+
+    // Each merged region keeps the lowest seed cell of any of its provisional labels
+    std::vector<int64_t> rootSeed(numLabels, -1);
+    std::vector<int64_t> labelRoot(numLabels, 0);
+    for(int64_t b = 0; b < numBlocks; b++)
+    {
+      const std::vector<int64_t>& seeds = m_BlockSeeds[b];
+      for(size_t l = 0; l < seeds.size(); l++)
+      {
+        int64_t label = m_BlockOffset[b] + static_cast<int64_t>(l);
+        int64_t root = find(label);
+        labelRoot[label] = root;
+        if(seeds[l] >= 0 && (rootSeed[root] < 0 || seeds[l] < rootSeed[root]))
+        {
+          rootSeed[root] = seeds[l];
+        }
+      }
+    }
+
+    // Number the regions in seed order, which is the order the serial burn discovers them in
+    std::vector<std::pair<int64_t, int64_t>> seededRoots;
+    for(int64_t l = 0; l < numLabels; l++)
+    {
+      if(labelRoot[l] == l && rootSeed[l] >= 0)
+      {
+        seededRoots.emplace_back(rootSeed[l], l);
+      }
+    }
+    std::sort(seededRoots.begin(), seededRoots.end());
+
+    std::vector<int32_t> rootFeature(numLabels, 0);
+    for(size_t f = 0; f < seededRoots.size(); f++)
+    {
+      rootFeature[seededRoots[f].second] = static_cast<int32_t>(f + 1);
+    }
+    m_LabelFeature.resize(numLabels);
+    for(int64_t l = 0; l < numLabels; l++)
+    {
+      m_LabelFeature[l] = rootFeature[labelRoot[l]];
+    }
+    if(filter != nullptr && filter->getCancel())
+    {
+      m_Parents.reset();
+      return -1;
+    }
+
+    ParallelDataAlgorithm relabelAlg;
+    relabelAlg.setRange(0, numBlocks);
+    relabelAlg.setGrain(1);
+    relabelAlg.execute(RelabelBlocksImpl(this));
+
+    m_Parents.reset();
+    return static_cast<int32_t>(seededRoots.size());
+  }
+
+private:
+  /**
+   * @brief The LabelBlocksImpl class flood fills each block independently
+   */
+  class LabelBlocksImpl
+  {
+  public:
+    LabelBlocksImpl(UnionFindSegmentation* engine)
+    : m_Engine(engine)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t b = range.min(); b < range.max(); b++)
+      {
+        m_Engine->labelBlock(static_cast<int64_t>(b));
+      }
+    }
+
+  private:
+    UnionFindSegmentation* m_Engine = nullptr;
+  };
+
+  /**
+   * @brief The MergeBlockFacesImpl class unions the labels of each block with those of the blocks before it
+   */
+  class MergeBlockFacesImpl
+  {
+  public:
+    MergeBlockFacesImpl(UnionFindSegmentation* engine)
+    : m_Engine(engine)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t b = range.min(); b < range.max(); b++)
+      {
+        m_Engine->mergeBlockFaces(static_cast<int64_t>(b));
+      }
+    }
+
+  private:
+    UnionFindSegmentation* m_Engine = nullptr;
+  };
+
+  /**
+   * @brief The RelabelBlocksImpl class replaces the provisional labels with the final Feature Ids
+   */
+  class RelabelBlocksImpl
+  {
+  public:
+    RelabelBlocksImpl(UnionFindSegmentation* engine)
+    : m_Engine(engine)
+    {
+    }
+
+    void operator()(const SIMPLRange& range) const
+    {
+      for(size_t b = range.min(); b < range.max(); b++)
+      {
+        m_Engine->relabelBlock(static_cast<int64_t>(b));
+      }
+    }
+
+  private:
+    UnionFindSegmentation* m_Engine = nullptr;
+  };
+
+  /**
+   * @brief labelBlock Burns every region inside one block, storing block local labels (starting at 1) in the Feature Ids
+   * @param block
+   */
+  void labelBlock(int64_t block)
+  {
+    const int64_t lineStart = m_BlockLineStart[block];
+    const int64_t lineEnd = m_BlockLineStart[block + 1];
+    const int64_t planeSize = m_Dims[0] * m_Dims[1];
+    const int64_t first = lineStart * m_Dims[0];
+    const int64_t last = lineEnd * m_Dims[0];
+
+    std::fill(m_FeatureIds + first, m_FeatureIds + last, 0);
+
+    std::vector<int64_t>& seeds = m_BlockSeeds[block];
+    std::vector<int64_t> voxelsList;
+    int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
+    for(int64_t index = first; index < last; index++)
+    {
+      if(m_FeatureIds[index] != 0 || !m_Predicate.isValid(index))
+      {
+        continue;
+      }
+      seeds.push_back(-1);
+      const int32_t label = static_cast<int32_t>(seeds.size());
+      int64_t& lowestSeed = seeds.back();
+
+      m_FeatureIds[index] = label;
+      voxelsList.push_back(index);
+      while(!voxelsList.empty())
+      {
+        const int64_t currentPoint = voxelsList.back();
+        voxelsList.pop_back();
+        if(m_Predicate.isSeed(currentPoint) && (lowestSeed < 0 || currentPoint < lowestSeed))
+        {
+          lowestSeed = currentPoint;
+        }
+
+        const int64_t col = currentPoint % m_Dims[0];
+        const int64_t line = currentPoint / m_Dims[0];
+        const int64_t row = line % m_Dims[1];
+        const int64_t plane = line / m_Dims[1];
+        int32_t numNeighbors = 0;
+        if(plane > 0 && line - m_Dims[1] >= lineStart)
+        {
+          neighbors[numNeighbors++] = currentPoint - planeSize;
+        }
+        if(row > 0 && line - 1 >= lineStart)
+        {
+          neighbors[numNeighbors++] = currentPoint - m_Dims[0];
+        }
+        if(col > 0)
+        {
+          neighbors[numNeighbors++] = currentPoint - 1;
+        }
+        if(col < m_Dims[0] - 1)
+        {
+          neighbors[numNeighbors++] = currentPoint + 1;
+        }
+        if(row < m_Dims[1] - 1 && line + 1 < lineEnd)
+        {
+          neighbors[numNeighbors++] = currentPoint + m_Dims[0];
+        }
+        if(plane < m_Dims[2] - 1 && line + m_Dims[1] < lineEnd)
+        {
+          neighbors[numNeighbors++] = currentPoint + planeSize;
+        }
+
+        for(int32_t i = 0; i < numNeighbors; i++)
+        {
+          const int64_t neighbor = neighbors[i];
+          if(m_FeatureIds[neighbor] != 0 || !m_Predicate.isValid(neighbor))
+          {
+            continue;
+          }
+          if(compare(currentPoint, neighbor))
+          {
+            m_FeatureIds[neighbor] = label;
+            voxelsList.push_back(neighbor);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief mergeBlockFaces Unions the labels across the -Y and -Z faces of a block whose neighbor cells lie in an earlier block
+   * @param block
+   */
+  void mergeBlockFaces(int64_t block)
+  {
+    const int64_t lineStart = m_BlockLineStart[block];
+    const int64_t lineEnd = m_BlockLineStart[block + 1];
+
+    // Only the first line of the block can have a -Y neighbor before the block, and only the
+    // first plane's worth of lines can have a -Z neighbor before the block
+    const int64_t lastFaceLine = std::min(lineEnd, lineStart + m_Dims[1]);
+    for(int64_t line = lineStart; line < lastFaceLine; line++)
+    {
+      const int64_t row = line % m_Dims[1];
+      const int64_t plane = line / m_Dims[1];
+      if(line == lineStart && row > 0)
+      {
+        mergeLines(block, line, line - 1);
+      }
+      if(plane > 0)
+      {
+        mergeLines(block, line, line - m_Dims[1]);
+      }
+    }
+  }
+
+  /**
+   * @brief mergeLines Unions the labels of two adjacent X lines where the cells group
+   * @param block Block that owns @p line
+   * @param line Line inside the block
+   * @param otherLine Adjacent line in an earlier block
+   */
+  void mergeLines(int64_t block, int64_t line, int64_t otherLine)
+  {
+    const int64_t otherBlock = std::upper_bound(m_BlockLineStart.begin(), m_BlockLineStart.end(), otherLine) - m_BlockLineStart.begin() - 1;
+    const int64_t offset = m_BlockOffset[block] - 1;
+    const int64_t otherOffset = m_BlockOffset[otherBlock] - 1;
+    for(int64_t col = 0; col < m_Dims[0]; col++)
+    {
+      const int64_t index = line * m_Dims[0] + col;
+      const int64_t neighbor = otherLine * m_Dims[0] + col;
+      if(m_FeatureIds[index] == 0 || m_FeatureIds[neighbor] == 0)
+      {
+        continue;
+      }
+      if(compare(neighbor, index))
+      {
+        unite(offset + m_FeatureIds[index], otherOffset + m_FeatureIds[neighbor]);
+      }
+    }
+  }
+
+  /**
+   * @brief relabelBlock Converts the block local labels of one block into final Feature Ids
+   * @param block
+   */
+  void relabelBlock(int64_t block)
+  {
+    const int64_t first = m_BlockLineStart[block] * m_Dims[0];
+    const int64_t last = m_BlockLineStart[block + 1] * m_Dims[0];
+    const int64_t offset = m_BlockOffset[block] - 1;
+    for(int64_t index = first; index < last; index++)
+    {
+      if(m_FeatureIds[index] > 0)
+      {
+        m_FeatureIds[index] = m_LabelFeature[offset + m_FeatureIds[index]];
+      }
+    }
+  }
+
+  /**
+   * @brief compare Always evaluates the predicate with the lower index first so the result does not depend on the block layout
+   */
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    return index < neighbor ? m_Predicate.compare(index, neighbor) : m_Predicate.compare(neighbor, index);
+  }
+
+  /**
+   * @brief find Returns the root of a label, halving the path on the way
+   */
+  int64_t find(int64_t label)
+  {
+    while(true)
+    {
+      int64_t parent = m_Parents[label].load();
+      if(parent == label)
+      {
+        return label;
+      }
+      int64_t grandParent = m_Parents[parent].load();
+      if(grandParent != parent)
+      {
+        // A failed exchange only means another thread already shortened this link
+        m_Parents[label].compare_exchange_weak(parent, grandParent);
+      }
+      label = grandParent;
+    }
+  }
+
+  /**
+   * @brief unite Merges the sets of two labels. Roots always link to the smaller root so no cycles can form.
+   */
+  void unite(int64_t label1, int64_t label2)
+  {
+    while(true)
+    {
+      label1 = find(label1);
+      label2 = find(label2);
+      if(label1 == label2)
+      {
+        return;
+      }
+      if(label1 < label2)
+      {
+        std::swap(label1, label2);
+      }
+      int64_t expected = label1;
+      if(m_Parents[label1].compare_exchange_strong(expected, label2))
+      {
+        return;
+      }
+    }
+  }
+
+  GroupingPredicate m_Predicate;
+  int32_t* m_FeatureIds = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+
+  std::vector<int64_t> m_BlockLineStart;
+  std::vector<int64_t> m_BlockOffset;
+  std::vector<std::vector<int64_t>> m_BlockSeeds;
+  std::unique_ptr<std::atomic<int64_t>[]> m_Parents;
+  std::vector<int32_t> m_LabelFeature;
+};
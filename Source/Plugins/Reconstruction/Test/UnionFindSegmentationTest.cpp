@@ -0,0 +1,174 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "Reconstruction/ReconstructionFilters/util/UnionFindSegmentation.h"
+
+#include "ReconstructionTestFileLocations.h"
+
+/**
+ * @brief The TestGroupingPredicate class groups neighboring cells with equal values. Cells with value 3 are
+ * never used as seeds so that regions made only of those cells stay unassigned.
+ */
+class TestGroupingPredicate
+{
+public:
+  TestGroupingPredicate(const int32_t* values, const bool* mask)
+  : m_Values(values)
+  , m_Mask(mask)
+  {
+  }
+
+  bool isValid(int64_t index) const
+  {
+    return m_Mask[index];
+  }
+
+  bool isSeed(int64_t index) const
+  {
+    return m_Mask[index] && m_Values[index] != 3;
+  }
+
+  bool compare(int64_t index, int64_t neighbor) const
+  {
+    return m_Values[index] == m_Values[neighbor];
+  }
+
+private:
+  const int32_t* m_Values = nullptr;
+  const bool* m_Mask = nullptr;
+};
+
+class UnionFindSegmentationTest
+{
+
+public:
+  UnionFindSegmentationTest() = default;
+  virtual ~UnionFindSegmentationTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // Same burn algorithm as SegmentFeatures::execute()
+  // -----------------------------------------------------------------------------
+  int32_t SerialBurn(const int64_t dims[3], const TestGroupingPredicate& predicate, std::vector<int32_t>& featureIds)
+  {
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+    const int64_t neighpoints[6] = {-(dims[0] * dims[1]), -dims[0], -1, 1, dims[0], (dims[0] * dims[1])};
+    int32_t gnum = 1;
+    for(int64_t seed = 0; seed < totalPoints; seed++)
+    {
+      if(featureIds[seed] != 0 || !predicate.isSeed(seed))
+      {
+        continue;
+      }
+      featureIds[seed] = gnum;
+      std::vector<int64_t> voxelsList(1, seed);
+      while(!voxelsList.empty())
+      {
+        int64_t currentPoint = voxelsList.back();
+        voxelsList.pop_back();
+        int64_t col = currentPoint % dims[0];
+        int64_t row = (currentPoint / dims[0]) % dims[1];
+        int64_t plane = currentPoint / (dims[0] * dims[1]);
+        bool good[6] = {plane > 0, row > 0, col > 0, col < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+        for(int32_t i = 0; i < 6; i++)
+        {
+          int64_t neighbor = currentPoint + neighpoints[i];
+          if(good[i] && featureIds[neighbor] == 0 && predicate.isValid(neighbor) && predicate.compare(currentPoint, neighbor))
+          {
+            featureIds[neighbor] = gnum;
+            voxelsList.push_back(neighbor);
+          }
+        }
+      }
+      gnum++;
+    }
+    return gnum - 1;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesSerialBurn()
+  {
+    std::mt19937 generator(5489u);
+    for(int32_t trial = 0; trial < 100; trial++)
+    {
+      int64_t dims[3] = {1 + static_cast<int64_t>(generator() % 17), 1 + static_cast<int64_t>(generator() % 13), 1 + static_cast<int64_t>(generator() % 11)};
+      const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+      std::vector<int32_t> values(totalPoints, 0);
+      std::unique_ptr<bool[]> mask(new bool[totalPoints]);
+      for(int64_t i = 0; i < totalPoints; i++)
+      {
+        values[i] = static_cast<int32_t>(generator() % 4);
+        mask[i] = (generator() % 10) != 0;
+      }
+      TestGroupingPredicate predicate(values.data(), mask.get());
+
+      std::vector<int32_t> serialIds(totalPoints, 0);
+      int32_t serialFeatures = SerialBurn(dims, predicate, serialIds);
+
+      // Start from garbage to make sure the engine initializes every cell
+      std::vector<int32_t> parallelIds(totalPoints, -1);
+      UnionFindSegmentation<TestGroupingPredicate> engine(dims, predicate, parallelIds.data());
+      int32_t parallelFeatures = engine.execute();
+
+      DREAM3D_REQUIRE_EQUAL(parallelFeatures, serialFeatures)
+      for(int64_t i = 0; i < totalPoints; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(parallelIds[i], serialIds[i])
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCancel()
+  {
+    int64_t dims[3] = {9, 7, 5};
+    const int64_t totalPoints = dims[0] * dims[1] * dims[2];
+    std::vector<int32_t> values(totalPoints, 0);
+    std::unique_ptr<bool[]> mask(new bool[totalPoints]);
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      values[i] = static_cast<int32_t>(i % 2);
+      mask[i] = true;
+    }
+    TestGroupingPredicate predicate(values.data(), mask.get());
+
+    AbstractFilter::Pointer filter = AbstractFilter::New();
+    std::vector<int32_t> featureIds(totalPoints, 0);
+    UnionFindSegmentation<TestGroupingPredicate> engine(dims, predicate, featureIds.data());
+    DREAM3D_REQUIRED(engine.execute(filter.get()), >, 0)
+
+    filter->setCancel(true);
+    UnionFindSegmentation<TestGroupingPredicate> canceledEngine(dims, predicate, featureIds.data());
+    DREAM3D_REQUIRE_EQUAL(canceledEngine.execute(filter.get()), -1)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestMatchesSerialBurn())
+    DREAM3D_REGISTER_TEST(TestCancel())
+  }
+
+private:
+  UnionFindSegmentationTest(const UnionFindSegmentationTest&); // Copy Constructor Not Implemented
+  void operator=(const UnionFindSegmentationTest&);            // Move assignment Not Implemented
+};
@@ -37,6 +37,7 @@
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -101,6 +102,7 @@ void RegularGridSampleSurfaceMesh::setupFilterParameters()
   PreflightUpdatedValueFilterParameter::Pointer param = SIMPL_NEW_PREFLIGHTUPDATEDVALUE_FP("Box Size in Length Units", BoxDimensions, FilterParameter::Parameter, RegularGridSampleSurfaceMesh);
   param->setReadOnly(true);
   parameters.push_back(param);
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Scanline Voxelization", UseScanlineVoxelization, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, RegularGridSampleSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
@@ -122,6 +124,7 @@ void RegularGridSampleSurfaceMesh::readFilterParameters(AbstractFilterParameters
   setDataContainerName(reader->readDataArrayPath("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
+  setUseScanlineVoxelization(reader->readValue("UseScanlineVoxelization", getUseScanlineVoxelization()));
   reader->closeFilterGroup();
 }
 
@@ -224,6 +227,25 @@ void RegularGridSampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RegularGridSampleSurfaceMesh::get_regular_grid(SizeVec3Type& dims, FloatVec3Type& spacing, FloatVec3Type& origin) const
+{
+  dims = SizeVec3Type(static_cast<size_t>(m_Dimensions[0]), static_cast<size_t>(m_Dimensions[1]), static_cast<size_t>(m_Dimensions[2]));
+  spacing = m_Spacing;
+  origin = m_Origin;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RegularGridSampleSurfaceMesh::use_scanline_sampling() const
+{
+  return m_UseScanlineVoxelization;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -433,3 +455,15 @@ QString RegularGridSampleSurfaceMesh::getFeatureIdsArrayName() const
 {
   return m_FeatureIdsArrayName;
 }
+
+// -----------------------------------------------------------------------------
+void RegularGridSampleSurfaceMesh::setUseScanlineVoxelization(bool value)
+{
+  m_UseScanlineVoxelization = value;
+}
+
+// -----------------------------------------------------------------------------
+bool RegularGridSampleSurfaceMesh::getUseScanlineVoxelization() const
+{
+  return m_UseScanlineVoxelization;
+}
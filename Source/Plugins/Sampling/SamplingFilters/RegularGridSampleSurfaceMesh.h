@@ -66,6 +66,7 @@ class Sampling_EXPORT RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
   PYB11_PROPERTY(FloatVec3Type Spacing READ getSpacing WRITE setSpacing)
   PYB11_PROPERTY(FloatVec3Type Origin READ getOrigin WRITE setOrigin)
   PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
+  PYB11_PROPERTY(bool UseScanlineVoxelization READ getUseScanlineVoxelization WRITE setUseScanlineVoxelization)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -176,6 +177,17 @@ public:
   QString getFeatureIdsArrayName() const;
   Q_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
+  /**
+   * @brief Setter property for UseScanlineVoxelization
+   */
+  void setUseScanlineVoxelization(bool value);
+  /**
+   * @brief Getter property for UseScanlineVoxelization
+   * @return Value of UseScanlineVoxelization
+   */
+  bool getUseScanlineVoxelization() const;
+  Q_PROPERTY(bool UseScanlineVoxelization READ getUseScanlineVoxelization WRITE setUseScanlineVoxelization)
+
   /**
    * @brief getBoxDimensions Returns a string describing the box dimensions and size/volume
    * @return
@@ -262,6 +274,16 @@ protected:
    */
   void assign_points(Int32ArrayType::Pointer iArray) override;
 
+  /**
+   * @brief get_regular_grid Reimplemented from @see SampleSurfaceMesh class
+   */
+  bool get_regular_grid(SizeVec3Type& dims, FloatVec3Type& spacing, FloatVec3Type& origin) const override;
+
+  /**
+   * @brief use_scanline_sampling Reimplemented from @see SampleSurfaceMesh class
+   */
+  bool use_scanline_sampling() const override;
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_FeatureIdsPtr;
   int32_t* m_FeatureIds = nullptr;
@@ -273,6 +295,7 @@ private:
   FloatVec3Type m_Spacing = {1.0f, 1.0f, 1.0f};
   FloatVec3Type m_Origin = {0.0f, 0.0f, 0.0f};
   QString m_FeatureIdsArrayName = {SIMPL::CellData::FeatureIds};
+  bool m_UseScanlineVoxelization = {false};
 
 public:
   RegularGridSampleSurfaceMesh(const RegularGridSampleSurfaceMesh&) = delete;            // Copy Constructor Not Implemented
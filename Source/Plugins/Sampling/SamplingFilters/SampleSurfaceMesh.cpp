@@ -34,8 +34,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SampleSurfaceMesh.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -49,6 +55,7 @@
 #include "SIMPLib/Geometry/VertexGeom.h"
 #include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -56,13 +63,166 @@
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#include <tbb/tbb_machine.h>
-#endif
+/**
+ * @brief The SamplePointIndex class finds the sample points that may lie inside a bounding box. Points on a
+ * regular grid are addressed directly by their index ranges; any other set of points is bucketed into a
+ * uniform grid of bins.
+ */
+class SamplePointIndex
+{
+public:
+  SamplePointIndex(const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin)
+  : m_RegularGrid(true)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = static_cast<int64_t>(dims[d]);
+      m_Spacing[d] = spacing[d];
+      m_Origin[d] = origin[d];
+    }
+  }
+
+  explicit SamplePointIndex(const VertexGeom::Pointer& points)
+  {
+    int64_t numPoints = static_cast<int64_t>(points->getNumberOfVertices());
+    std::array<float, 3> maxCoords = {0.0F, 0.0F, 0.0F};
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Origin[d] = std::numeric_limits<float>::max();
+      maxCoords[d] = std::numeric_limits<float>::lowest();
+    }
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float* point = points->getVertexPointer(i);
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Origin[d] = std::min(m_Origin[d], point[d]);
+        maxCoords[d] = std::max(maxCoords[d], point[d]);
+      }
+    }
+
+    // Aim for a handful of points per bin
+    int64_t binsPerAxis = std::max<int64_t>(1, static_cast<int64_t>(std::cbrt(static_cast<double>(numPoints) / k_PointsPerBin)));
+    for(size_t d = 0; d < 3; d++)
+    {
+      float extent = numPoints > 0 ? maxCoords[d] - m_Origin[d] : 0.0f;
+      m_Dims[d] = extent > 0.0f ? binsPerAxis : 1;
+      m_Spacing[d] = extent > 0.0f ? extent / static_cast<float>(m_Dims[d]) : 1.0f;
+    }
+
+    m_BinOffsets.assign(m_Dims[0] * m_Dims[1] * m_Dims[2] + 1, 0);
+    std::vector<int64_t> pointBins(numPoints, 0);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float* point = points->getVertexPointer(i);
+      pointBins[i] = (findBin(point[2], 2) * m_Dims[1] + findBin(point[1], 1)) * m_Dims[0] + findBin(point[0], 0);
+      m_BinOffsets[pointBins[i] + 1]++;
+    }
+    for(size_t b = 1; b < m_BinOffsets.size(); b++)
+    {
+      m_BinOffsets[b] += m_BinOffsets[b - 1];
+    }
+    m_BinPoints.resize(numPoints);
+    std::vector<int64_t> binFill(m_BinOffsets.begin(), m_BinOffsets.end() - 1);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      m_BinPoints[binFill[pointBins[i]]++] = i;
+    }
+  }
+
+  /**
+   * @brief findCandidates Collects the points that may lie inside the box; the caller still tests the box itself
+   * @param lowerLeft
+   * @param upperRight
+   * @param candidates
+   */
+  void findCandidates(const float* lowerLeft, const float* upperRight, std::vector<int64_t>& candidates) const
+  {
+    candidates.clear();
+    std::array<int64_t, 3> lo = {0, 0, 0};
+    std::array<int64_t, 3> hi = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(m_RegularGrid)
+      {
+        // Cell centers sit at (i + 0.5) * spacing + origin; widen by one Cell to absorb round off
+        lo[d] = std::max<int64_t>(0, static_cast<int64_t>(std::floor((lowerLeft[d] - m_Origin[d]) / m_Spacing[d] - 0.5f)) - 1);
+        hi[d] = std::min<int64_t>(m_Dims[d] - 1, static_cast<int64_t>(std::ceil((upperRight[d] - m_Origin[d]) / m_Spacing[d] - 0.5f)) + 1);
+      }
+      else
+      {
+        lo[d] = findBin(lowerLeft[d], d);
+        hi[d] = findBin(upperRight[d], d);
+      }
+      if(lo[d] > hi[d])
+      {
+        return;
+      }
+    }
 
+    for(int64_t k = lo[2]; k <= hi[2]; k++)
+    {
+      for(int64_t j = lo[1]; j <= hi[1]; j++)
+      {
+        int64_t rowStart = (k * m_Dims[1] + j) * m_Dims[0];
+        for(int64_t i = lo[0]; i <= hi[0]; i++)
+        {
+          if(m_RegularGrid)
+          {
+            candidates.push_back(rowStart + i);
+            continue;
+          }
+          for(int64_t b = m_BinOffsets[rowStart + i]; b < m_BinOffsets[rowStart + i + 1]; b++)
+          {
+            candidates.push_back(m_BinPoints[b]);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr double k_PointsPerBin = 8.0;
+
+  int64_t findBin(float coord, size_t d) const
+  {
+    int64_t bin = static_cast<int64_t>((coord - m_Origin[d]) / m_Spacing[d]);
+    return std::min<int64_t>(std::max<int64_t>(bin, 0), m_Dims[d] - 1);
+  }
+
+  bool m_RegularGrid = false;
+  std::array<int64_t, 3> m_Dims = {1, 1, 1};
+  std::array<float, 3> m_Spacing = {1.0F, 1.0F, 1.0F};
+  std::array<float, 3> m_Origin = {0.0F, 0.0F, 0.0F};
+  std::vector<int64_t> m_BinOffsets;
+  std::vector<int64_t> m_BinPoints;
+};
+
+namespace
+{
+/**
+ * @brief checkCandidate Runs the point in polyhedron test for a single point against a feature
+ */
+void checkCandidate(const TriangleGeom::Pointer& faces, const Int32Int32DynamicListArray::Pointer& faceIds, const VertexGeom::Pointer& faceBBs, const VertexGeom::Pointer& points, int32_t featureId,
+                    const float* lowerLeft, const float* upperRight, float radius, int64_t pointId, int32_t* polyIds)
+{
+  float distToBoundary = 0.0f;
+  float* point = points->getVertexPointer(pointId);
+  if(polyIds[pointId] == 0 && GeometryMath::PointInBox(point, const_cast<float*>(lowerLeft), const_cast<float*>(upperRight)))
+  {
+    char code = GeometryMath::PointInPolyhedron(faces.get(), faceIds->getElementList(featureId), faceBBs.get(), point, const_cast<float*>(lowerLeft), const_cast<float*>(upperRight), radius,
+                                                distToBoundary);
+    if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
+    {
+      polyIds[pointId] = featureId;
+    }
+  }
+}
+} // namespace
+
+/**
+ * @brief The SampleSurfaceMeshImplByPoints class tests the candidate points of a single feature in parallel.
+ */
 class SampleSurfaceMeshImplByPoints
 {
   SampleSurfaceMesh* m_Filter = nullptr;
@@ -70,18 +230,27 @@ class SampleSurfaceMeshImplByPoints
   Int32Int32DynamicListArray::Pointer m_FaceIds;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
-  size_t m_FeatureId = 0;
+  int32_t m_FeatureId = 0;
+  const std::vector<int64_t>& m_Candidates;
+  std::array<float, 3> m_LowerLeft = {0.0F, 0.0F, 0.0F};
+  std::array<float, 3> m_UpperRight = {0.0F, 0.0F, 0.0F};
+  float m_Radius = 0.0f;
   int32_t* m_PolyIds = nullptr;
 
 public:
   SampleSurfaceMeshImplByPoints(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points,
-                                size_t featureId, int32_t* polyIds)
+                                int32_t featureId, const std::vector<int64_t>& candidates, const std::array<float, 3>& lowerLeft, const std::array<float, 3>& upperRight, float radius,
+                                int32_t* polyIds)
   : m_Filter(filter)
   , m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
   , m_FeatureId(featureId)
+  , m_Candidates(candidates)
+  , m_LowerLeft(lowerLeft)
+  , m_UpperRight(upperRight)
+  , m_Radius(radius)
   , m_PolyIds(polyIds)
   {
   }
@@ -89,38 +258,16 @@ public:
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
-    float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
-    std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
-    std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
-    float* point = nullptr;
-    char code = ' ';
-
-    size_t iter = m_FeatureId;
-
-    // find bounding box for current feature
-    GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), lowerLeft.data(), upperRight.data());
-    GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
     int64_t pointsVisited = 0;
-    // check points in vertex array to see if they are in the bounding box of the feature
-    for(int64_t i = static_cast<int64_t>(start); i < static_cast<int64_t>(end); i++)
+    for(size_t i = start; i < end; i++)
     {
-      point = m_Points->getVertexPointer(i);
-      if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, lowerLeft.data(), upperRight.data()))
-      {
-        code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, lowerLeft.data(), upperRight.data(), radius, distToBoundary);
-        if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-        {
-          m_PolyIds[i] = iter;
-        }
-      }
+      checkCandidate(m_Faces, m_FaceIds, m_FaceBBs, m_Points, m_FeatureId, m_LowerLeft.data(), m_UpperRight.data(), m_Radius, m_Candidates[i], m_PolyIds);
       pointsVisited++;
 
       // Send some feedback
       if(pointsVisited % 1000 == 0)
       {
-        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, 1000, numPoints);
+        m_Filter->sendThreadSafeProgressMessage(m_FeatureId, 1000, m_Candidates.size());
       }
       // Check for the filter being cancelled.
       if(m_Filter->getCancel())
@@ -130,17 +277,15 @@ public:
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
   {
-    checkPoints(r.begin(), r.end());
+    checkPoints(range.min(), range.max());
   }
-#endif
-private:
 };
 
 /**
  * @brief The SampleSurfaceMeshImpl class implements a threaded algorithm that samples a surface mesh based on points passed from subclassed Filters.
+ * Each feature only visits the points that the SamplePointIndex reports inside its bounding box.
  */
 class SampleSurfaceMeshImpl
 {
@@ -149,15 +294,18 @@ class SampleSurfaceMeshImpl
   Int32Int32DynamicListArray::Pointer m_FaceIds;
   VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const SamplePointIndex& m_PointIndex;
   int32_t* m_PolyIds = nullptr;
 
 public:
-  SampleSurfaceMeshImpl(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, int32_t* polyIds)
+  SampleSurfaceMeshImpl(SampleSurfaceMesh* filter, TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points,
+                        const SamplePointIndex& pointIndex, int32_t* polyIds)
   : m_Filter(filter)
   , m_Faces(faces)
   , m_FaceIds(faceIds)
   , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_PointIndex(pointIndex)
   , m_PolyIds(polyIds)
   {
   }
@@ -166,48 +314,221 @@ public:
   void checkPoints(size_t start, size_t end) const
   {
     float radius = 0.0f;
-    float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
     std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
     std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
-    float* point = nullptr;
-    char code = ' ';
+    std::vector<int64_t> candidates;
 
     for(size_t iter = start; iter < end; iter++)
     {
+      // Check for the filter being cancelled.
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      if(m_FaceIds->getNumberOfElements(iter) == 0)
+      {
+        continue;
+      }
+
       // find bounding box for current feature
       GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), lowerLeft.data(), upperRight.data());
       GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
 
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(int64_t i = 0; i < numPoints; i++)
+      // check the points near the bounding box of the feature
+      m_PointIndex.findCandidates(lowerLeft.data(), upperRight.data(), candidates);
+      for(const auto& i : candidates)
+      {
+        checkCandidate(m_Faces, m_FaceIds, m_FaceBBs, m_Points, static_cast<int32_t>(iter), lowerLeft.data(), upperRight.data(), radius, i, m_PolyIds);
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    checkPoints(range.min(), range.max());
+  }
+};
+
+/**
+ * @brief The ScanlineSampleImpl class labels the Cells of a regular grid one X row at a time. A ray is cast along
+ * each row and intersected with the triangles that the row passes through. For every feature, the crossings
+ * of the triangles bounding it are sorted along the row and each pair of consecutive crossings encloses a run of
+ * Cells inside the feature.
+ *
+ * A row that passes exactly through a triangle edge or vertex is nudged by an infinitesimal amount in Y and Z, so
+ * every crossing is counted exactly once. Such a row is cast once for each of the four directions it can be nudged
+ * in and a Cell is labeled if any of them finds it inside, which keeps Cells lying on the surface inside the
+ * feature as the point in polyhedron test does. A Cell inside more than one feature gets the lowest feature id.
+ */
+class ScanlineSampleImpl
+{
+  SampleSurfaceMesh* m_Filter = nullptr;
+  float* m_Vertices = nullptr;
+  MeshIndexType* m_Triangles = nullptr;
+  int32_t* m_FaceLabels = nullptr;
+  const std::vector<int64_t>& m_RowOffsets;
+  const std::vector<MeshIndexType>& m_RowTriangles;
+  SizeVec3Type m_Dims;
+  FloatVec3Type m_Spacing;
+  FloatVec3Type m_Origin;
+  int32_t* m_PolyIds = nullptr;
+
+public:
+  ScanlineSampleImpl(SampleSurfaceMesh* filter, float* vertices, MeshIndexType* triangles, int32_t* faceLabels, const std::vector<int64_t>& rowOffsets,
+                     const std::vector<MeshIndexType>& rowTriangles, const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin, int32_t* polyIds)
+  : m_Filter(filter)
+  , m_Vertices(vertices)
+  , m_Triangles(triangles)
+  , m_FaceLabels(faceLabels)
+  , m_RowOffsets(rowOffsets)
+  , m_RowTriangles(rowTriangles)
+  , m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_Origin(origin)
+  , m_PolyIds(polyIds)
+  {
+  }
+  virtual ~ScanlineSampleImpl() = default;
+
+  /**
+   * @brief intersectRow Finds where the row through (y, z), nudged to (y + nudgeY * e, z + nudgeZ * e * e), crosses a triangle
+   * @param triangle
+   * @param y
+   * @param z
+   * @param nudgeY +1 or -1
+   * @param nudgeZ +1 or -1
+   * @param x Crossing along the row
+   * @param onEdge Set to true if the un-nudged row passes through an edge or vertex of the triangle
+   * @return false if the row misses the triangle
+   */
+  bool intersectRow(MeshIndexType triangle, double y, double z, double nudgeY, double nudgeZ, float& x, bool& onEdge) const
+  {
+    const float* v[3] = {m_Vertices + 3 * m_Triangles[3 * triangle], m_Vertices + 3 * m_Triangles[3 * triangle + 1], m_Vertices + 3 * m_Triangles[3 * triangle + 2]};
+    double w[3] = {0.0, 0.0, 0.0};
+    double area = 0.0;
+    for(size_t e = 0; e < 3; e++)
+    {
+      const float* p = v[(e + 1) % 3];
+      const float* q = v[(e + 2) % 3];
+      w[e] = (static_cast<double>(q[1]) - p[1]) * (z - p[2]) - (static_cast<double>(q[2]) - p[2]) * (y - p[1]);
+      area += w[e];
+    }
+    if(area == 0.0)
+    {
+      // The triangle is seen edge on from the row
+      return false;
+    }
+    const double sign = area > 0.0 ? 1.0 : -1.0;
+    bool touchesEdge = false;
+    for(size_t e = 0; e < 3; e++)
+    {
+      double we = w[e] * sign;
+      if(we == 0.0)
+      {
+        // Decide the side from the leading term of the edge function at the nudged point
+        const float* p = v[(e + 1) % 3];
+        const float* q = v[(e + 2) % 3];
+        double dz = static_cast<double>(q[2]) - p[2];
+        double dy = static_cast<double>(q[1]) - p[1];
+        we = sign * (dz != 0.0 ? -dz * nudgeY : dy * nudgeZ);
+        touchesEdge = true;
+      }
+      if(we < 0.0)
+      {
+        onEdge = onEdge || touchesEdge;
+        return false;
+      }
+    }
+    onEdge = onEdge || touchesEdge;
+    x = static_cast<float>((w[0] * v[0][0] + w[1] * v[1][0] + w[2] * v[2][0]) / area);
+    return true;
+  }
+
+  /**
+   * @brief castRow Labels the Cells of one row for one nudge direction
+   * @return Whether the row passes through an edge or vertex
+   */
+  bool castRow(size_t row, double y, double z, double nudgeY, double nudgeZ, std::vector<std::pair<int32_t, float>>& crossings) const
+  {
+    bool onEdge = false;
+    crossings.clear();
+    for(int64_t t = m_RowOffsets[row]; t < m_RowOffsets[row + 1]; t++)
+    {
+      MeshIndexType triangle = m_RowTriangles[t];
+      float x = 0.0f;
+      if(intersectRow(triangle, y, z, nudgeY, nudgeZ, x, onEdge))
       {
-        // Check for the filter being cancelled.
-        if(m_Filter->getCancel())
+        int32_t g1 = m_FaceLabels[2 * triangle];
+        int32_t g2 = m_FaceLabels[2 * triangle + 1];
+        if(g1 > 0)
         {
-          return;
+          crossings.emplace_back(g1, x);
         }
-
-        point = m_Points->getVertexPointer(i);
-        if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, lowerLeft.data(), upperRight.data()))
+        if(g2 > 0 && g2 != g1)
         {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, lowerLeft.data(), upperRight.data(), radius, distToBoundary);
-          if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
-          {
-            m_PolyIds[i] = iter;
-          }
+          crossings.emplace_back(g2, x);
         }
       }
     }
+    std::sort(crossings.begin(), crossings.end());
+
+    size_t rowStart = row * m_Dims[0];
+    for(size_t c = 0; c + 1 < crossings.size();)
+    {
+      if(crossings[c].first != crossings[c + 1].first)
+      {
+        // An unpaired crossing means the feature is not closed along this row
+        c++;
+        continue;
+      }
+      fillRun(rowStart, crossings[c].first, crossings[c].second, crossings[c + 1].second);
+      c += 2;
+    }
+    return onEdge;
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void fillRun(size_t rowStart, int32_t featureId, float xMin, float xMax) const
   {
-    checkPoints(r.begin(), r.end());
+    int64_t first = std::max<int64_t>(0, static_cast<int64_t>(std::floor((xMin - m_Origin[0]) / m_Spacing[0] - 0.5f)));
+    int64_t last = std::min<int64_t>(static_cast<int64_t>(m_Dims[0]) - 1, static_cast<int64_t>(std::ceil((xMax - m_Origin[0]) / m_Spacing[0] - 0.5f)));
+    for(int64_t i = first; i <= last; i++)
+    {
+      float x = (static_cast<float>(i) + 0.5f) * m_Spacing[0] + m_Origin[0];
+      int32_t& polyId = m_PolyIds[rowStart + i];
+      if(x >= xMin && x <= xMax && (polyId == 0 || featureId < polyId))
+      {
+        polyId = featureId;
+      }
+    }
+  }
+
+  void sampleRows(size_t start, size_t end) const
+  {
+    std::vector<std::pair<int32_t, float>> crossings;
+    for(size_t row = start; row < end; row++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      size_t j = row % m_Dims[1];
+      size_t k = row / m_Dims[1];
+      float y = (static_cast<float>(j) + 0.5f) * m_Spacing[1] + m_Origin[1];
+      float z = (static_cast<float>(k) + 0.5f) * m_Spacing[2] + m_Origin[2];
+
+      if(castRow(row, y, z, 1.0, 1.0, crossings))
+      {
+        castRow(row, y, z, -1.0, 1.0, crossings);
+        castRow(row, y, z, 1.0, -1.0, crossings);
+        castRow(row, y, z, -1.0, -1.0, crossings);
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    sampleRows(range.min(), range.max());
   }
-#endif
-private:
 };
 
 // -----------------------------------------------------------------------------
@@ -301,6 +622,110 @@ void SampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
 {
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SampleSurfaceMesh::get_regular_grid(SizeVec3Type& dims, FloatVec3Type& spacing, FloatVec3Type& origin) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SampleSurfaceMesh::use_scanline_sampling() const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SampleSurfaceMesh::sampleRows(const TriangleGeom::Pointer& triangleGeom, const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin, int32_t* polyIds)
+{
+  notifyStatusMessage("Binning triangles by grid row ...");
+
+  float* vertices = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+  MeshIndexType numTris = triangleGeom->getNumberOfTris();
+  const int64_t numRows = static_cast<int64_t>(dims[1] * dims[2]);
+
+  // Find the range of rows each triangle's YZ bounding box covers
+  auto rowRange = [&](MeshIndexType t, std::array<int64_t, 4>& range) {
+    range = {1, 0, 1, 0};
+    if(m_SurfaceMeshFaceLabels[2 * t] <= 0 && m_SurfaceMeshFaceLabels[2 * t + 1] <= 0)
+    {
+      return;
+    }
+    for(size_t d = 1; d < 3; d++)
+    {
+      float minCoord = std::numeric_limits<float>::max();
+      float maxCoord = std::numeric_limits<float>::lowest();
+      for(size_t v = 0; v < 3; v++)
+      {
+        float coord = vertices[3 * triangles[3 * t + v] + d];
+        minCoord = std::min(minCoord, coord);
+        maxCoord = std::max(maxCoord, coord);
+      }
+      range[2 * (d - 1)] = std::max<int64_t>(0, static_cast<int64_t>(std::floor((minCoord - origin[d]) / spacing[d] - 0.5f)));
+      range[2 * (d - 1) + 1] = std::min<int64_t>(static_cast<int64_t>(dims[d]) - 1, static_cast<int64_t>(std::ceil((maxCoord - origin[d]) / spacing[d] - 0.5f)));
+    }
+  };
+
+  std::vector<int64_t> rowOffsets(numRows + 1, 0);
+  std::array<int64_t, 4> range = {0, 0, 0, 0};
+  for(MeshIndexType t = 0; t < numTris; t++)
+  {
+    rowRange(t, range);
+    for(int64_t k = range[2]; k <= range[3]; k++)
+    {
+      for(int64_t j = range[0]; j <= range[1]; j++)
+      {
+        rowOffsets[k * dims[1] + j + 1]++;
+      }
+    }
+  }
+  for(int64_t r = 0; r < numRows; r++)
+  {
+    rowOffsets[r + 1] += rowOffsets[r];
+  }
+  std::vector<MeshIndexType> rowTriangles(rowOffsets[numRows]);
+  std::vector<int64_t> rowFill(rowOffsets.begin(), rowOffsets.end() - 1);
+  for(MeshIndexType t = 0; t < numTris; t++)
+  {
+    rowRange(t, range);
+    for(int64_t k = range[2]; k <= range[3]; k++)
+    {
+      for(int64_t j = range[0]; j <= range[1]; j++)
+      {
+        rowTriangles[rowFill[k * dims[1] + j]++] = t;
+      }
+    }
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Rows are handed out a few slices at a time so progress and cancel requests are serviced
+  const size_t slicesPerBatch = 16;
+  ScanlineSampleImpl impl(this, vertices, triangles, m_SurfaceMeshFaceLabels, rowOffsets, rowTriangles, dims, spacing, origin, polyIds);
+  for(size_t k = 0; k < dims[2]; k += slicesPerBatch)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+    QString ss = QObject::tr("Sampling triangle geometry || Slice %1 of %2").arg(k).arg(dims[2]);
+    notifyStatusMessage(ss);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(k * dims[1], std::min(k + slicesPerBatch, dims[2]) * dims[1]);
+    dataAlg.execute(impl);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -419,6 +844,26 @@ void SampleSurfaceMesh::execute()
     return;
   }
 
+  SizeVec3Type gridDims = {0, 0, 0};
+  FloatVec3Type gridSpacing = {0.0f, 0.0f, 0.0f};
+  FloatVec3Type gridOrigin = {0.0f, 0.0f, 0.0f};
+  bool regularGrid = get_regular_grid(gridDims, gridSpacing, gridOrigin);
+
+  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
+  if(regularGrid && use_scanline_sampling())
+  {
+    iArray = Int32ArrayType::CreateArray(gridDims[0] * gridDims[1] * gridDims[2], std::string("_INTERNAL_USE_ONLY_polyhedronIds"), true);
+    iArray->initializeWithZeros();
+    sampleRows(triangleGeom, gridDims, gridSpacing, gridOrigin, iArray->getPointer(0));
+    if(getCancel())
+    {
+      return;
+    }
+    assign_points(iArray);
+    notifyStatusMessage("Complete");
+    return;
+  }
+
   notifyStatusMessage("Vertex Geometry generating sampling points");
 
   // generate the list of sampling points from subclass
@@ -430,44 +875,62 @@ void SampleSurfaceMesh::execute()
   int64_t numPoints = points->getNumberOfVertices();
 
   // create array to hold which polyhedron (feature) each point falls in
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   iArray = Int32ArrayType::CreateArray(numPoints, std::string("_INTERNAL_USE_ONLY_polyhedronIds"), true);
   iArray->initializeWithZeros();
   int32_t* polyIds = iArray->getPointer(0);
 
+  notifyStatusMessage("Indexing sampling points ...");
+  std::unique_ptr<SamplePointIndex> pointIndex;
+  if(regularGrid)
+  {
+    pointIndex = std::make_unique<SamplePointIndex>(gridDims, gridSpacing, gridOrigin);
+  }
+  else
+  {
+    pointIndex = std::make_unique<SamplePointIndex>(points);
+  }
+
   notifyStatusMessage("Sampling triangle geometry ...");
 
   // C++11 RIGHT HERE....
   int32_t nthreads = static_cast<int32_t>(std::thread::hardware_concurrency()); // Returns ZERO if not defined on this platform
   // If the number of features is larger than the number of cores to do the work then parallelize over the number of features
-  // otherwise parallelize over the number of triangle points.
+  // otherwise parallelize over the candidate points of each feature.
   if(numFeatures > nthreads)
   {
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
-#else
-    SampleSurfaceMeshImpl serial(this, triangleGeom, faceLists, faceBBs, points, polyIds);
-    serial.checkPoints(0, numFeatures);
-#endif
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numFeatures);
+    dataAlg.execute(SampleSurfaceMeshImpl(this, triangleGeom, faceLists, faceBBs, points, *pointIndex, polyIds));
   }
   else
   {
-    for(int featureId = 0; featureId < numFeatures; featureId++)
+    std::array<float, 3> lowerLeft = {0.0F, 0.0F, 0.0F};
+    std::array<float, 3> upperRight = {0.0F, 0.0F, 0.0F};
+    float radius = 0.0f;
+    std::vector<int64_t> candidates;
+    for(int32_t featureId = 0; featureId < numFeatures; featureId++)
     {
+      if(faceLists->getNumberOfElements(featureId) == 0)
+      {
+        continue;
+      }
       m_NumCompleted = 0;
       m_StartMillis = QDateTime::currentMSecsSinceEpoch();
       m_Millis = m_StartMillis;
-      size_t numPoints = points->getNumberOfVertices();
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds), tbb::auto_partitioner());
+      GeometryMath::FindBoundingBoxOfFaces(triangleGeom.get(), faceLists->getElementList(featureId), lowerLeft.data(), upperRight.data());
+      GeometryMath::FindDistanceBetweenPoints(lowerLeft.data(), upperRight.data(), radius);
+      pointIndex->findCandidates(lowerLeft.data(), upperRight.data(), candidates);
 
-#else
-      SampleSurfaceMeshImplByPoints serial(this, triangleGeom, faceLists, faceBBs, points, featureId, polyIds);
-      serial.checkPoints(0, numPoints);
-#endif
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, candidates.size());
+      dataAlg.execute(SampleSurfaceMeshImplByPoints(this, triangleGeom, faceLists, faceBBs, points, featureId, candidates, lowerLeft, upperRight, radius, polyIds));
     }
   }
+  if(getCancel())
+  {
+    return;
+  }
   assign_points(iArray);
 
   notifyStatusMessage("Complete");
@@ -38,7 +38,9 @@
 #include <memory>
 
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
@@ -193,6 +195,33 @@ protected:
    */
   virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+  /**
+   * @brief get_regular_grid Lets subclasses whose sampling points are the Cell centers of a regular grid, generated
+   * with X varying fastest, describe that grid so a feature's bounding box can be mapped straight to index ranges
+   * @param dims Grid dimensions
+   * @param spacing Grid spacing
+   * @param origin Grid origin
+   * @return Whether the sampling points form a regular grid
+   */
+  virtual bool get_regular_grid(SizeVec3Type& dims, FloatVec3Type& spacing, FloatVec3Type& origin) const;
+
+  /**
+   * @brief use_scanline_sampling Whether a regular grid should be labeled a row at a time by casting rays through
+   * the surface mesh instead of testing each point against each feature
+   * @return
+   */
+  virtual bool use_scanline_sampling() const;
+
+  /**
+   * @brief sampleRows Labels every Cell of a regular grid with the feature that contains it using one ray per X row
+   * @param triangleGeom Surface mesh
+   * @param dims Grid dimensions
+   * @param spacing Grid spacing
+   * @param origin Grid origin
+   * @param polyIds Output feature id of each Cell
+   */
+  void sampleRows(const TriangleGeom::Pointer& triangleGeom, const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin, int32_t* polyIds);
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_SurfaceMeshFaceLabelsPtr;
   int32_t* m_SurfaceMeshFaceLabels = nullptr;
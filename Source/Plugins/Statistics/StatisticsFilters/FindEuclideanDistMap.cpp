@@ -42,9 +42,13 @@
 #include <tbb/tick_count.h>
 #endif
 
+#include <cmath>
+#include <limits>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -54,6 +58,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
@@ -288,6 +293,123 @@ public:
   }
 };
 
+/**
+ * @brief The ExactDistanceMapImpl class performs one pass of a separable exact Euclidean distance transform
+ * (Felzenszwalb & Huttenlocher). Each line along the chosen axis is replaced by the lower envelope of the
+ * parabolas rooted at its cells, so after one pass per axis every cell holds the squared distance to, and the
+ * index of, its nearest source cell. Lines are independent, so the pass is parallel over lines.
+ */
+class ExactDistanceMapImpl
+{
+public:
+  ExactDistanceMapImpl(const int64_t dims[3], const FloatVec3Type& spacing, int32_t axis, double* squaredDistances, int64_t* nearest)
+  : m_Axis(axis)
+  , m_SquaredDistances(squaredDistances)
+  , m_Nearest(nearest)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+    m_Weight = static_cast<double>(spacing[axis]) * static_cast<double>(spacing[axis]);
+  }
+
+  /**
+   * @brief numLines Returns the number of lines running along the given axis
+   */
+  static int64_t numLines(const int64_t dims[3], int32_t axis)
+  {
+    return (dims[0] * dims[1] * dims[2]) / dims[axis];
+  }
+
+  void transformLines(int64_t start, int64_t end) const
+  {
+    const int64_t length = m_Dims[m_Axis];
+    const int64_t stride = (m_Axis == 0) ? 1 : ((m_Axis == 1) ? m_Dims[0] : m_Dims[0] * m_Dims[1]);
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    std::vector<double> f(length);
+    std::vector<int64_t> source(length);
+    std::vector<int64_t> v(length);
+    std::vector<double> z(length + 1);
+
+    for(int64_t line = start; line < end; line++)
+    {
+      int64_t offset = 0;
+      if(m_Axis == 0)
+      {
+        offset = line * m_Dims[0];
+      }
+      else if(m_Axis == 1)
+      {
+        offset = (line / m_Dims[0]) * m_Dims[0] * m_Dims[1] + (line % m_Dims[0]);
+      }
+      else
+      {
+        offset = line;
+      }
+
+      for(int64_t q = 0; q < length; q++)
+      {
+        f[q] = m_SquaredDistances[offset + q * stride];
+        source[q] = m_Nearest[offset + q * stride];
+      }
+
+      // Build the lower envelope of the parabolas w * (p - q)^2 + f[q], skipping cells that have no source yet
+      int64_t k = -1;
+      for(int64_t q = 0; q < length; q++)
+      {
+        if(f[q] == infinity)
+        {
+          continue;
+        }
+        double s = -infinity;
+        while(k >= 0)
+        {
+          const double vq = static_cast<double>(v[k]);
+          s = ((f[q] + m_Weight * q * q) - (f[v[k]] + m_Weight * vq * vq)) / (2.0 * m_Weight * (q - vq));
+          if(s > z[k])
+          {
+            break;
+          }
+          k--;
+        }
+        k++;
+        v[k] = q;
+        z[k] = (k == 0) ? -infinity : s;
+        z[k + 1] = infinity;
+      }
+      if(k < 0)
+      {
+        continue;
+      }
+
+      int64_t j = 0;
+      for(int64_t q = 0; q < length; q++)
+      {
+        while(z[j + 1] < static_cast<double>(q))
+        {
+          j++;
+        }
+        const double delta = static_cast<double>(q - v[j]);
+        m_SquaredDistances[offset + q * stride] = m_Weight * delta * delta + f[v[j]];
+        m_Nearest[offset + q * stride] = source[v[j]];
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    transformLines(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int32_t m_Axis = 0;
+  double m_Weight = 1.0;
+  double* m_SquaredDistances = nullptr;
+  int64_t* m_Nearest = nullptr;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -302,6 +424,7 @@ FindEuclideanDistMap::FindEuclideanDistMap()
 , m_DoQuadPoints(false)
 , m_SaveNearestNeighbors(false)
 , m_CalcManhattanDist(true)
+, m_CalcExactEuclideanDist(false)
 {
 }
 
@@ -317,6 +440,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance", CalcManhattanDist, FilterParameter::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Exact Euclidean Distance", CalcExactEuclideanDist, FilterParameter::Parameter, FindEuclideanDistMap));
   QStringList linkedProps("GBDistancesArrayName");
 
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Parameter, FindEuclideanDistMap, linkedProps));
@@ -362,6 +486,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcManhattanDist()));
+  setCalcExactEuclideanDist(reader->readValue("CalcExactEuclideanDist", getCalcExactEuclideanDist()));
   reader->closeFilterGroup();
 }
 
@@ -666,6 +791,23 @@ void FindEuclideanDistMap::findDistanceMap()
     }
   }
 
+  if(!m_CalcManhattanDist && m_CalcExactEuclideanDist)
+  {
+    if(m_DoBoundaries)
+    {
+      findExactDistanceMap(MapType::FeatureBoundary, m_GBEuclideanDistances);
+    }
+    if(m_DoTripleLines && !getCancel())
+    {
+      findExactDistanceMap(MapType::TripleJunction, m_TJEuclideanDistances);
+    }
+    if(m_DoQuadPoints && !getCancel())
+    {
+      findExactDistanceMap(MapType::QuadPoint, m_QPEuclideanDistances);
+    }
+    return;
+  }
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(true)
   {
@@ -741,6 +883,63 @@ void FindEuclideanDistMap::findDistanceMap()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::findExactDistanceMap(MapType mapType, float* distances)
+{
+  ImageGeom::Pointer imageGeom = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getGeometryAs<ImageGeom>();
+  SizeVec3Type udims = imageGeom->getDimensions();
+  FloatVec3Type spacing = imageGeom->getSpacing();
+
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
+  const size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  const uint32_t mapIndex = static_cast<uint32_t>(mapType);
+
+  // Only Cells inside a Feature can act as the source of a map, but the distance is measured in a
+  // straight line so the sources are not blocked by bad Cells
+  std::vector<double> squaredDistances(totalPoints, std::numeric_limits<double>::infinity());
+  std::vector<int64_t> nearest(totalPoints, -1);
+  for(size_t a = 0; a < totalPoints; a++)
+  {
+    if(m_FeatureIds[a] > 0 && m_NearestNeighbors[a * 3 + mapIndex] >= 0)
+    {
+      squaredDistances[a] = 0.0;
+      nearest[a] = static_cast<int64_t>(a);
+    }
+  }
+
+  for(int32_t axis = 0; axis < 3; axis++)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, ExactDistanceMapImpl::numLines(dims, axis));
+    dataAlg.execute(ExactDistanceMapImpl(dims, spacing, axis, squaredDistances.data(), nearest.data()));
+  }
+
+  for(size_t a = 0; a < totalPoints; a++)
+  {
+    if(m_FeatureIds[a] > 0)
+    {
+      distances[a] = (nearest[a] >= 0) ? static_cast<float>(std::sqrt(squaredDistances[a])) : -1.0f;
+      m_NearestNeighbors[a * 3 + mapIndex] = static_cast<int32_t>(nearest[a]);
+    }
+    else if(m_NearestNeighbors[a * 3 + mapIndex] >= 0)
+    {
+      // Matches the propagation based map, where Cells outside of every Feature are their own nearest Cell
+      distances[a] = 0.0f;
+      m_NearestNeighbors[a * 3 + mapIndex] = static_cast<int32_t>(a);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -983,3 +1182,15 @@ bool FindEuclideanDistMap::getCalcManhattanDist() const
 {
   return m_CalcManhattanDist;
 }
+
+// -----------------------------------------------------------------------------
+void FindEuclideanDistMap::setCalcExactEuclideanDist(bool value)
+{
+  m_CalcExactEuclideanDist = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindEuclideanDistMap::getCalcExactEuclideanDist() const
+{
+  return m_CalcExactEuclideanDist;
+}
@@ -65,6 +65,7 @@ class Statistics_EXPORT FindEuclideanDistMap : public AbstractFilter
   PYB11_PROPERTY(bool DoQuadPoints READ getDoQuadPoints WRITE setDoQuadPoints)
   PYB11_PROPERTY(bool SaveNearestNeighbors READ getSaveNearestNeighbors WRITE setSaveNearestNeighbors)
   PYB11_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
+  PYB11_PROPERTY(bool CalcExactEuclideanDist READ getCalcExactEuclideanDist WRITE setCalcExactEuclideanDist)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -217,6 +218,17 @@ public:
   bool getCalcManhattanDist() const;
   Q_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
 
+  /**
+   * @brief Setter property for CalcExactEuclideanDist
+   */
+  void setCalcExactEuclideanDist(bool value);
+  /**
+   * @brief Getter property for CalcExactEuclideanDist
+   * @return Value of CalcExactEuclideanDist
+   */
+  bool getCalcExactEuclideanDist() const;
+  Q_PROPERTY(bool CalcExactEuclideanDist READ getCalcExactEuclideanDist WRITE setCalcExactEuclideanDist)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -300,6 +312,14 @@ protected:
    */
   void findDistanceMap();
 
+  /**
+   * @brief findExactDistanceMap Computes the exact Euclidean distance (and nearest source Cell) from every
+   * Cell to the closest Cell of the given map type using a separable distance transform
+   * @param mapType The map to compute
+   * @param distances The output distances
+   */
+  void findExactDistanceMap(MapType mapType, float* distances);
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_FeatureIdsPtr;
   int32_t* m_FeatureIds = nullptr;
@@ -328,6 +348,7 @@ private:
   bool m_DoQuadPoints = {};
   bool m_SaveNearestNeighbors = {};
   bool m_CalcManhattanDist = {};
+  bool m_CalcExactEuclideanDist = {};
 
   // Full Euclidean Distance Arrays
 
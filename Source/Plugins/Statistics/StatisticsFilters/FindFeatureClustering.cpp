@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindFeatureClustering.h"
 
+#include <algorithm>
 #include <fstream>
+#include <thread>
 
 #include <QtCore/QTextStream>
 
@@ -42,6 +44,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -50,6 +53,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/RadialDistributionFunction.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
@@ -64,6 +68,204 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+namespace
+{
+/**
+ * @brief The FindClusteringDistancesImpl class gathers, for every Feature of a chunk, the centroid distances to the other
+ * Features of the phase. Candidates come from the 27 grid cells around the Feature, whose width is at least the search
+ * radius. Each list is ordered by the index of the other Feature, the order the serial all pairs loop produced.
+ */
+class FindClusteringDistancesImpl
+{
+public:
+  FindClusteringDistancesImpl(const std::vector<size_t>& phaseFeatures, const std::vector<size_t>& cellOffsets, const std::vector<size_t>& cellFeatures, const std::vector<size_t>& featureCells,
+                              const std::array<size_t, 3>& cellDims, const float* centroids, bool useMaximumRadius, float maximumRadius, size_t chunkSize,
+                              std::vector<std::vector<float>>& clusteringList, std::vector<size_t>& forwardStart, std::vector<float>& chunkMin, std::vector<float>& chunkMax)
+  : m_PhaseFeatures(phaseFeatures)
+  , m_CellOffsets(cellOffsets)
+  , m_CellFeatures(cellFeatures)
+  , m_FeatureCells(featureCells)
+  , m_CellDims(cellDims)
+  , m_Centroids(centroids)
+  , m_UseMaximumRadius(useMaximumRadius)
+  , m_MaximumRadius(maximumRadius)
+  , m_ChunkSize(chunkSize)
+  , m_ClusteringList(clusteringList)
+  , m_ForwardStart(forwardStart)
+  , m_ChunkMin(chunkMin)
+  , m_ChunkMax(chunkMax)
+  {
+  }
+
+  virtual ~FindClusteringDistancesImpl() = default;
+
+  void findDistances(size_t chunk) const
+  {
+    size_t start = chunk * m_ChunkSize;
+    size_t end = std::min(start + m_ChunkSize, m_PhaseFeatures.size());
+    float min = std::numeric_limits<float>::max();
+    float max = 0.0f;
+    std::vector<std::pair<size_t, float>> neighbors;
+
+    for(size_t p = start; p < end; p++)
+    {
+      size_t i = m_PhaseFeatures[p];
+      float x = m_Centroids[3 * i];
+      float y = m_Centroids[3 * i + 1];
+      float z = m_Centroids[3 * i + 2];
+
+      size_t cell = m_FeatureCells[p];
+      size_t cx = cell % m_CellDims[0];
+      size_t cy = (cell / m_CellDims[0]) % m_CellDims[1];
+      size_t cz = cell / (m_CellDims[0] * m_CellDims[1]);
+
+      neighbors.clear();
+      for(size_t k = (cz > 0 ? cz - 1 : 0); k <= std::min(cz + 1, m_CellDims[2] - 1); k++)
+      {
+        for(size_t j = (cy > 0 ? cy - 1 : 0); j <= std::min(cy + 1, m_CellDims[1] - 1); j++)
+        {
+          for(size_t h = (cx > 0 ? cx - 1 : 0); h <= std::min(cx + 1, m_CellDims[0] - 1); h++)
+          {
+            size_t neighborCell = (k * m_CellDims[1] + j) * m_CellDims[0] + h;
+            for(size_t n = m_CellOffsets[neighborCell]; n < m_CellOffsets[neighborCell + 1]; n++)
+            {
+              size_t other = m_CellFeatures[n];
+              if(other == i)
+              {
+                continue;
+              }
+              float xn = m_Centroids[3 * other];
+              float yn = m_Centroids[3 * other + 1];
+              float zn = m_Centroids[3 * other + 2];
+              float r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+              if(m_UseMaximumRadius && r > m_MaximumRadius)
+              {
+                continue;
+              }
+              neighbors.emplace_back(other, r);
+            }
+          }
+        }
+      }
+      std::sort(neighbors.begin(), neighbors.end());
+
+      std::vector<float>& distances = m_ClusteringList[i];
+      distances.resize(neighbors.size());
+      m_ForwardStart[i] = neighbors.size();
+      for(size_t n = 0; n < neighbors.size(); n++)
+      {
+        float r = neighbors[n].second;
+        distances[n] = r;
+        if(neighbors[n].first > i && m_ForwardStart[i] == neighbors.size())
+        {
+          m_ForwardStart[i] = n;
+        }
+        if(r > max)
+        {
+          max = r;
+        }
+        if(r < min)
+        {
+          min = r;
+        }
+      }
+    }
+    m_ChunkMin[chunk] = min;
+    m_ChunkMax[chunk] = max;
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      findDistances(chunk);
+    }
+  }
+
+private:
+  const std::vector<size_t>& m_PhaseFeatures;
+  const std::vector<size_t>& m_CellOffsets;
+  const std::vector<size_t>& m_CellFeatures;
+  const std::vector<size_t>& m_FeatureCells;
+  const std::array<size_t, 3>& m_CellDims;
+  const float* m_Centroids;
+  bool m_UseMaximumRadius;
+  float m_MaximumRadius;
+  size_t m_ChunkSize;
+  std::vector<std::vector<float>>& m_ClusteringList;
+  std::vector<size_t>& m_ForwardStart;
+  std::vector<float>& m_ChunkMin;
+  std::vector<float>& m_ChunkMax;
+};
+
+/**
+ * @brief The BinClusteringDistancesImpl class bins the distance lists of a chunk of Features into that chunk's own
+ * row of the histogram table, so chunks never write to the same counters.
+ */
+class BinClusteringDistancesImpl
+{
+public:
+  BinClusteringDistancesImpl(const std::vector<size_t>& phaseFeatures, const std::vector<std::vector<float>>& clusteringList, const bool* biasedFeatures, bool removeBiasedFeatures,
+                             float min, float stepsize, int32_t numberOfBins, size_t chunkSize, std::vector<uint64_t>& chunkHistograms)
+  : m_PhaseFeatures(phaseFeatures)
+  , m_ClusteringList(clusteringList)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_RemoveBiasedFeatures(removeBiasedFeatures)
+  , m_Min(min)
+  , m_Stepsize(stepsize)
+  , m_NumberOfBins(numberOfBins)
+  , m_ChunkSize(chunkSize)
+  , m_ChunkHistograms(chunkHistograms)
+  {
+  }
+
+  virtual ~BinClusteringDistancesImpl() = default;
+
+  void binDistances(size_t chunk) const
+  {
+    size_t start = chunk * m_ChunkSize;
+    size_t end = std::min(start + m_ChunkSize, m_PhaseFeatures.size());
+    uint64_t* histogram = m_ChunkHistograms.data() + chunk * m_NumberOfBins;
+    for(size_t p = start; p < end; p++)
+    {
+      size_t i = m_PhaseFeatures[p];
+      if(m_RemoveBiasedFeatures && m_BiasedFeatures[i])
+      {
+        continue;
+      }
+      for(const auto& distance : m_ClusteringList[i])
+      {
+        int32_t bin = (distance - m_Min) / m_Stepsize;
+        if(bin >= m_NumberOfBins)
+        {
+          bin = m_NumberOfBins - 1;
+        }
+        histogram[bin]++;
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      binDistances(chunk);
+    }
+  }
+
+private:
+  const std::vector<size_t>& m_PhaseFeatures;
+  const std::vector<std::vector<float>>& m_ClusteringList;
+  const bool* m_BiasedFeatures;
+  bool m_RemoveBiasedFeatures;
+  float m_Min;
+  float m_Stepsize;
+  int32_t m_NumberOfBins;
+  size_t m_ChunkSize;
+  std::vector<uint64_t>& m_ChunkHistograms;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -73,6 +275,8 @@ FindFeatureClustering::FindFeatureClustering()
 , m_PhaseNumber(1)
 , m_CellEnsembleAttributeMatrixName(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, "")
 , m_RemoveBiasedFeatures(false)
+, m_UseMaximumRadius(false)
+, m_MaximumRadius(1.0f)
 , m_EquivalentDiametersArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EquivalentDiameters)
 , m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases)
 , m_CentroidsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids)
@@ -97,6 +301,10 @@ void FindFeatureClustering::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Phase Index", PhaseNumber, FilterParameter::Parameter, FindFeatureClustering));
   QStringList linkedProps("BiasedFeaturesArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Remove Biased Features", RemoveBiasedFeatures, FilterParameter::Parameter, FindFeatureClustering, linkedProps));
+  linkedProps.clear();
+  linkedProps << "MaximumRadius";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Limit Search Radius", UseMaximumRadius, FilterParameter::Parameter, FindFeatureClustering, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Maximum Search Radius", MaximumRadius, FilterParameter::Parameter, FindFeatureClustering));
   parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req =
@@ -151,6 +359,8 @@ void FindFeatureClustering::readFilterParameters(AbstractFilterParametersReader*
   setPhaseNumber(reader->readValue("PhaseNumber", getPhaseNumber()));
   setBiasedFeaturesArrayPath(reader->readDataArrayPath("BiasedFeaturesArrayPath", getBiasedFeaturesArrayPath()));
   setRemoveBiasedFeatures(reader->readValue("RemoveBiasedFeatures", getRemoveBiasedFeatures()));
+  setUseMaximumRadius(reader->readValue("UseMaximumRadius", getUseMaximumRadius()));
+  setMaximumRadius(reader->readValue("MaximumRadius", getMaximumRadius()));
   reader->closeFilterGroup();
 }
 
@@ -195,6 +405,12 @@ void FindFeatureClustering::dataCheck()
     m_Centroids = m_CentroidsPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
+  if(m_UseMaximumRadius && m_MaximumRadius <= 0.0f)
+  {
+    QString ss = QObject::tr("The Maximum Search Radius must be greater than 0");
+    setErrorCondition(-11000, ss);
+  }
+
   if(m_RemoveBiasedFeatures)
   {
     cDims[0] = 1;
@@ -233,25 +449,17 @@ void FindFeatureClustering::dataCheck()
 // -----------------------------------------------------------------------------
 void FindFeatureClustering::find_clustering()
 {
-  bool writeErrorFile = true;
   std::ofstream outFile;
 
   if(!m_ErrorOutputFile.isEmpty())
   {
     outFile.open(m_ErrorOutputFile.toLatin1().data(), std::ios_base::binary);
-    writeErrorFile = true;
   }
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
-  int32_t bin = 0;
-  int32_t ensemble = 0;
+  int32_t ensemble = m_PhaseNumber;
   int32_t totalPPTfeatures = 0;
   float min = std::numeric_limits<float>::max();
   float max = 0.0f;
-  float value = 0.0f;
   float sizex = 0.0f, sizey = 0.0f, sizez = 0.0f, totalvol = 0.0f, totalpoints = 0.0f;
   float normFactor = 0.0f;
 
@@ -279,67 +487,118 @@ void FindFeatureClustering::find_clustering()
   FloatVec3Type vec3 = m->getGeometryAs<ImageGeom>()->getSpacing();
   std::array<float, 3> boxres = {vec3[0], vec3[1], vec3[2]};
 
+  std::vector<size_t> phaseFeatures;
+  std::array<float, 3> lower = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+  std::array<float, 3> upper = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
   for(size_t i = 1; i < totalFeatures; i++)
   {
     if(m_FeaturePhases[i] == m_PhaseNumber)
     {
-      totalPPTfeatures++;
+      phaseFeatures.push_back(i);
+      for(size_t d = 0; d < 3; d++)
+      {
+        lower[d] = std::min(lower[d], m_Centroids[3 * i + d]);
+        upper[d] = std::max(upper[d], m_Centroids[3 * i + d]);
+      }
     }
   }
-
-  clusteringlist.resize(totalFeatures);
-
-  for(size_t i = 1; i < totalFeatures; i++)
+  totalPPTfeatures = static_cast<int32_t>(phaseFeatures.size());
+
+  // Bin the centroids into a uniform grid whose cells are at least as wide as the search radius, so every Feature
+  // within the radius lies in one of the 27 cells around a Feature. Without a radius the grid is a single cell and
+  // every pair is visited. The grid is coarsened until it has no more cells than about twice the Feature count.
+  std::array<size_t, 3> cellDims = {1, 1, 1};
+  std::array<float, 3> cellWidth = {1.0f, 1.0f, 1.0f};
+  if(m_UseMaximumRadius && totalPPTfeatures > 0)
   {
-    if(m_FeaturePhases[i] == m_PhaseNumber)
+    float radius = m_MaximumRadius;
+    size_t maxCells = 2 * phaseFeatures.size() + 1;
+    while(true)
     {
-      if(i % 1000 == 0)
+      size_t cellCount = 1;
+      for(size_t d = 0; d < 3; d++)
+      {
+        float extent = upper[d] - lower[d];
+        cellDims[d] = std::max<size_t>(1, static_cast<size_t>(std::min(extent / radius, static_cast<float>(maxCells))));
+        cellCount *= cellDims[d];
+      }
+      if(cellCount <= maxCells)
       {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(ss);
+        break;
       }
+      radius *= 1.25f;
+    }
+  }
+  for(size_t d = 0; d < 3; d++)
+  {
+    float extent = upper[d] - lower[d];
+    cellWidth[d] = extent > 0.0f ? extent / cellDims[d] : 1.0f;
+  }
 
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
+  std::vector<size_t> featureCells(phaseFeatures.size());
+  std::vector<size_t> cellOffsets(cellDims[0] * cellDims[1] * cellDims[2] + 1, 0);
+  for(size_t p = 0; p < phaseFeatures.size(); p++)
+  {
+    size_t cellIndex[3] = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      float position = (m_Centroids[3 * phaseFeatures[p] + d] - lower[d]) / cellWidth[d];
+      cellIndex[d] = std::min(static_cast<size_t>(std::max(position, 0.0f)), cellDims[d] - 1);
+    }
+    featureCells[p] = (cellIndex[2] * cellDims[1] + cellIndex[1]) * cellDims[0] + cellIndex[0];
+    cellOffsets[featureCells[p] + 1]++;
+  }
+  for(size_t c = 1; c < cellOffsets.size(); c++)
+  {
+    cellOffsets[c] += cellOffsets[c - 1];
+  }
+  std::vector<size_t> cellFeatures(phaseFeatures.size());
+  {
+    std::vector<size_t> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+    for(size_t p = 0; p < phaseFeatures.size(); p++)
+    {
+      cellFeatures[cursor[featureCells[p]]++] = phaseFeatures[p];
+    }
+  }
 
-      for(size_t j = i + 1; j < totalFeatures; j++)
-      {
-        if(m_FeaturePhases[i] == m_FeaturePhases[j])
-        {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
+  // Each chunk of Features keeps its own min, max and histogram so the passes below need no locking
+  size_t chunkCount = std::max<size_t>(1, 16 * static_cast<size_t>(std::thread::hardware_concurrency()));
+  size_t chunkSize = std::max<size_t>(1, (phaseFeatures.size() + chunkCount - 1) / chunkCount);
+  chunkCount = (phaseFeatures.size() + chunkSize - 1) / chunkSize;
 
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+  clusteringlist.resize(totalFeatures);
+  std::vector<size_t> forwardStart(totalFeatures, 0);
+  std::vector<float> chunkMin(chunkCount, std::numeric_limits<float>::max());
+  std::vector<float> chunkMax(chunkCount, 0.0f);
 
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
+  notifyStatusMessage(QObject::tr("Finding the separation distances of %1 Features").arg(totalPPTfeatures));
+  if(chunkCount > 0)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, chunkCount);
+    dataAlg.setGrain(1);
+    dataAlg.execute(FindClusteringDistancesImpl(phaseFeatures, cellOffsets, cellFeatures, featureCells, cellDims, m_Centroids, m_UseMaximumRadius, m_MaximumRadius, chunkSize, clusteringlist,
+                                                forwardStart, chunkMin, chunkMax));
+  }
+  if(getCancel())
+  {
+    return;
+  }
 
-          if(writeErrorFile && m_FeaturePhases[j] == 2)
-          {
-            outFile << r << "\n" << r << "\n";
-          }
-        }
-      }
-    }
+  for(size_t chunk = 0; chunk < chunkCount; chunk++)
+  {
+    min = std::min(min, chunkMin[chunk]);
+    max = std::max(max, chunkMax[chunk]);
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  // Every pair is written twice, once from each Feature, as the all pairs loop did
+  if(outFile.is_open() && m_PhaseNumber == 2)
   {
-    for(size_t j = 0; j < clusteringlist[i].size(); j++)
+    for(const auto& i : phaseFeatures)
     {
-      if(m_FeaturePhases[i] == m_PhaseNumber)
+      for(size_t n = forwardStart[i]; n < clusteringlist[i].size(); n++)
       {
-        value = clusteringlist[i][j];
-        if(value > max)
-        {
-          max = value;
-        }
-        if(value < min)
-        {
-          min = value;
-        }
+        outFile << clusteringlist[i][n] << "\n" << clusteringlist[i][n] << "\n";
       }
     }
   }
@@ -349,23 +608,19 @@ void FindFeatureClustering::find_clustering()
   m_MaxMinArray[(m_PhaseNumber * 2)] = max;
   m_MaxMinArray[(m_PhaseNumber * 2) + 1] = min;
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  std::vector<uint64_t> chunkHistograms(chunkCount * m_NumberOfBins, 0);
+  if(chunkCount > 0)
+  {
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, chunkCount);
+    dataAlg.setGrain(1);
+    dataAlg.execute(BinClusteringDistancesImpl(phaseFeatures, clusteringlist, m_BiasedFeatures, m_RemoveBiasedFeatures, min, stepsize, m_NumberOfBins, chunkSize, chunkHistograms));
+  }
+  for(size_t chunk = 0; chunk < chunkCount; chunk++)
   {
-    for(size_t j = 0; j < clusteringlist[i].size(); j++)
+    for(int32_t bin = 0; bin < m_NumberOfBins; bin++)
     {
-      if(m_FeaturePhases[i] == m_PhaseNumber)
-      {
-        if(!m_RemoveBiasedFeatures || !m_BiasedFeatures[i])
-        {
-          ensemble = m_FeaturePhases[i];
-          bin = (clusteringlist[i][j] - min) / stepsize;
-          if(bin >= m_NumberOfBins)
-          {
-            bin = m_NumberOfBins - 1;
-          }
-          m_NewEnsembleArray[(m_NumberOfBins * ensemble) + bin]++;
-        }
-      }
+      m_NewEnsembleArray[(m_NumberOfBins * ensemble) + bin] += static_cast<float>(chunkHistograms[chunk * m_NumberOfBins + bin]);
     }
   }
 
@@ -418,7 +673,7 @@ void FindFeatureClustering::find_clustering()
   {
     // Set the vector for each list into the Clustering Object
     NeighborList<float>::SharedVectorType sharedClustLst(new std::vector<float>);
-    sharedClustLst->assign(clusteringlist[i].begin(), clusteringlist[i].end());
+    sharedClustLst->swap(clusteringlist[i]);
     m_ClusteringList.lock()->setList(static_cast<int>(i), sharedClustLst);
   }
 }
@@ -599,6 +854,30 @@ bool FindFeatureClustering::getRemoveBiasedFeatures() const
   return m_RemoveBiasedFeatures;
 }
 
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setUseMaximumRadius(bool value)
+{
+  m_UseMaximumRadius = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindFeatureClustering::getUseMaximumRadius() const
+{
+  return m_UseMaximumRadius;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setMaximumRadius(float value)
+{
+  m_MaximumRadius = value;
+}
+
+// -----------------------------------------------------------------------------
+float FindFeatureClustering::getMaximumRadius() const
+{
+  return m_MaximumRadius;
+}
+
 // -----------------------------------------------------------------------------
 void FindFeatureClustering::setBiasedFeaturesArrayPath(const DataArrayPath& value)
 {
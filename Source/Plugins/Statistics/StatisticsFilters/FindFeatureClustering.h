@@ -60,6 +60,8 @@ class Statistics_EXPORT FindFeatureClustering : public AbstractFilter
   PYB11_PROPERTY(int PhaseNumber READ getPhaseNumber WRITE setPhaseNumber)
   PYB11_PROPERTY(DataArrayPath CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
   PYB11_PROPERTY(bool RemoveBiasedFeatures READ getRemoveBiasedFeatures WRITE setRemoveBiasedFeatures)
+  PYB11_PROPERTY(bool UseMaximumRadius READ getUseMaximumRadius WRITE setUseMaximumRadius)
+  PYB11_PROPERTY(float MaximumRadius READ getMaximumRadius WRITE setMaximumRadius)
   PYB11_PROPERTY(DataArrayPath BiasedFeaturesArrayPath READ getBiasedFeaturesArrayPath WRITE setBiasedFeaturesArrayPath)
   PYB11_PROPERTY(DataArrayPath EquivalentDiametersArrayPath READ getEquivalentDiametersArrayPath WRITE setEquivalentDiametersArrayPath)
   PYB11_PROPERTY(DataArrayPath FeaturePhasesArrayPath READ getFeaturePhasesArrayPath WRITE setFeaturePhasesArrayPath)
@@ -154,6 +156,28 @@ public:
   bool getRemoveBiasedFeatures() const;
   Q_PROPERTY(bool RemoveBiasedFeatures READ getRemoveBiasedFeatures WRITE setRemoveBiasedFeatures)
 
+  /**
+   * @brief Setter property for UseMaximumRadius
+   */
+  void setUseMaximumRadius(bool value);
+  /**
+   * @brief Getter property for UseMaximumRadius
+   * @return Value of UseMaximumRadius
+   */
+  bool getUseMaximumRadius() const;
+  Q_PROPERTY(bool UseMaximumRadius READ getUseMaximumRadius WRITE setUseMaximumRadius)
+
+  /**
+   * @brief Setter property for MaximumRadius
+   */
+  void setMaximumRadius(float value);
+  /**
+   * @brief Getter property for MaximumRadius
+   * @return Value of MaximumRadius
+   */
+  float getMaximumRadius() const;
+  Q_PROPERTY(float MaximumRadius READ getMaximumRadius WRITE setMaximumRadius)
+
   /**
    * @brief Setter property for BiasedFeaturesArrayPath
    */
@@ -327,6 +351,8 @@ private:
   int m_PhaseNumber = {};
   DataArrayPath m_CellEnsembleAttributeMatrixName = {};
   bool m_RemoveBiasedFeatures = {};
+  bool m_UseMaximumRadius = {};
+  float m_MaximumRadius = {};
   DataArrayPath m_BiasedFeaturesArrayPath = {};
   DataArrayPath m_EquivalentDiametersArrayPath = {};
   DataArrayPath m_FeaturePhasesArrayPath = {};
@@ -46,6 +46,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/FeatureMoments.h"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -165,76 +167,38 @@ void FindLargestCrossSections::dataCheck()
 void FindLargestCrossSections::find_crosssections()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
   size_t numfeatures = m_LargestCrossSectionsPtr.lock()->getNumberOfTuples();
 
-  DoubleArrayType::Pointer m_FeatureCounts = DoubleArrayType::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  double* featurecounts = m_FeatureCounts->getPointer(0);
-
-  size_t outPlane = 0, inPlane1 = 0, inPlane2 = 0;
+  size_t outPlaneAxis = 2;
   float res_scalar = 0.0f, area = 0.0f;
-  size_t stride1 = 0, stride2 = 0, stride3 = 0;
-  size_t istride = 0, jstride = 0, kstride = 0;
-  size_t point = 0, gnum = 0;
 
-  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
+  FloatVec3Type spacing = imageGeom->getSpacing();
 
   if(m_Plane == 0)
   {
-    outPlane = m->getGeometryAs<ImageGeom>()->getZPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getYPoints();
-
+    outPlaneAxis = 2;
     res_scalar = spacing[0] * spacing[1];
-    stride1 = inPlane1 * inPlane2;
-    stride2 = 1;
-    stride3 = inPlane1;
   }
   if(m_Plane == 1)
   {
-    outPlane = m->getGeometryAs<ImageGeom>()->getYPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getZPoints();
+    outPlaneAxis = 1;
     res_scalar = spacing[0] * spacing[2];
-    stride1 = inPlane1;
-    stride2 = 1;
-    stride3 = inPlane1 * inPlane2;
   }
   if(m_Plane == 2)
   {
-    outPlane = m->getGeometryAs<ImageGeom>()->getXPoints();
-    inPlane1 = m->getGeometryAs<ImageGeom>()->getYPoints();
-    inPlane2 = m->getGeometryAs<ImageGeom>()->getZPoints();
+    outPlaneAxis = 0;
     res_scalar = spacing[1] * spacing[2];
-    stride1 = 1;
-    stride2 = inPlane1;
-    stride3 = inPlane1 * inPlane2;
   }
-  for(size_t i = 0; i < outPlane; i++)
+
+  std::vector<uint64_t> featurecounts = FeatureMoments::LargestSliceCounts(m_FeatureIds, imageGeom->getDimensions(), numfeatures, outPlaneAxis);
+  for(size_t g = 1; g < numfeatures; g++)
   {
-    for(size_t g = 0; g < numfeatures * 1; g++)
-    {
-      featurecounts[g] = 0.0f;
-    }
-    istride = i * stride1;
-    for(size_t j = 0; j < inPlane1; j++)
-    {
-      jstride = j * stride2;
-      for(size_t k = 0; k < inPlane2; k++)
-      {
-        kstride = k * stride3;
-        point = istride + jstride + kstride;
-        gnum = m_FeatureIds[point];
-        featurecounts[gnum]++;
-      }
-    }
-    for(size_t g = 1; g < numfeatures; g++)
+    area = static_cast<float>(static_cast<double>(featurecounts[g]) * res_scalar);
+    if(area > m_LargestCrossSections[g])
     {
-      area = featurecounts[g] * res_scalar;
-      if(area > m_LargestCrossSections[g])
-      {
-        m_LargestCrossSections[g] = area;
-      }
+      m_LargestCrossSections[g] = area;
     }
   }
 }
@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindNeighborhoods.h"
 
-#include <mutex>
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 #include <QtCore/QTextStream>
 
@@ -66,27 +68,29 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The FindNeighborhoodsImpl class finds the neighborhood of each Feature in a range. The Features are sorted by
+ * their bin, x fastest, so the Features of a row of bins are contiguous; only the rows of bins within the critical
+ * distance of a Feature are searched. Each Feature only writes its own list and count, so ranges are independent.
+ */
 class FindNeighborhoodsImpl
 {
 public:
-  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, float* centroids, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance)
+  FindNeighborhoodsImpl(FindNeighborhoods* filter, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance, const std::vector<uint64_t>& sortedKeys,
+                        const std::vector<int32_t>& sortedFeatures, const std::array<int64_t, 3>& binDims, std::vector<std::vector<int32_t>>& neighborhoodList, int32_t* neighborhoods)
   : m_Filter(filter)
-  , m_TotalFeatures(totalFeatures)
-  , m_Centroids(centroids)
   , m_Bins(bins)
   , m_CriticalDistance(criticalDistance)
+  , m_SortedKeys(sortedKeys)
+  , m_SortedFeatures(sortedFeatures)
+  , m_BinDims(binDims)
+  , m_NeighborhoodList(neighborhoodList)
+  , m_Neighborhoods(neighborhoods)
   {
   }
 
   void convert(size_t start, size_t end) const
   {
-    float x = 0.0f, y = 0.0f, z = 0.0f;
-    int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-    float dBinX = 0, dBinY = 0, dBinZ = 0;
-    float criticalDistance1 = 0, criticalDistance2 = 0;
-
-    size_t increment = (end - start) / 100;
-    size_t incCount = 0;
     // NEVER start at 0.
     if(start == 0)
     {
@@ -94,46 +98,47 @@ public:
     }
     for(size_t i = start; i < end; i++)
     {
-      incCount++;
-      if(incCount == increment || i == end - 1)
-      {
-        incCount = 0;
-        m_Filter->updateProgress(increment, m_TotalFeatures);
-      }
       if(m_Filter->getCancel())
       {
         break;
       }
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
-      bin1x = m_Bins[3 * i];
-      bin1y = m_Bins[3 * i + 1];
-      bin1z = m_Bins[3 * i + 2];
-      criticalDistance1 = m_CriticalDistance[i];
-
-      for(size_t j = i + 1; j < m_TotalFeatures; j++)
+
+      std::vector<int32_t>& neighbors = m_NeighborhoodList[i];
+      neighbors.clear();
+      // Another Feature is in the neighborhood if its bin is less than the critical distance away along every axis,
+      // so the search covers the bins up to the largest whole offset below the critical distance
+      float criticalDistance = m_CriticalDistance[i];
+      if(criticalDistance > 0.0f)
       {
-        bin2x = m_Bins[3 * j];
-        bin2y = m_Bins[3 * j + 1];
-        bin2z = m_Bins[3 * j + 2];
-        criticalDistance2 = m_CriticalDistance[j];
-        // Use the llabs version of the "C" abs function because we are using int64_t
-        // do NOT try to use the std::abs() function as this is C++11 ONLY
-        dBinX = llabs(bin2x - bin1x);
-        dBinY = llabs(bin2y - bin1y);
-        dBinZ = llabs(bin2z - bin1z);
-
-        if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
+        float maxReach = static_cast<float>(std::max(m_BinDims[0], std::max(m_BinDims[1], m_BinDims[2])));
+        int64_t reach = static_cast<int64_t>(std::ceil(std::min(criticalDistance, maxReach))) - 1;
+        int64_t lower[3] = {0, 0, 0};
+        int64_t upper[3] = {0, 0, 0};
+        for(size_t d = 0; d < 3; d++)
         {
-          m_Filter->updateNeighborHood(i, j);
+          lower[d] = std::max<int64_t>(m_Bins[3 * i + d] - reach, 0);
+          upper[d] = std::min<int64_t>(m_Bins[3 * i + d] + reach, m_BinDims[d] - 1);
         }
-
-        if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
+        for(int64_t zBin = lower[2]; zBin <= upper[2]; zBin++)
         {
-          m_Filter->updateNeighborHood(j, i);
+          for(int64_t yBin = lower[1]; yBin <= upper[1]; yBin++)
+          {
+            uint64_t rowKey = (static_cast<uint64_t>(zBin) * m_BinDims[1] + yBin) * m_BinDims[0];
+            uint64_t lastKey = rowKey + upper[0];
+            auto iter = std::lower_bound(m_SortedKeys.begin(), m_SortedKeys.end(), rowKey + lower[0]);
+            for(; iter != m_SortedKeys.end() && *iter <= lastKey; ++iter)
+            {
+              int32_t j = m_SortedFeatures[iter - m_SortedKeys.begin()];
+              if(static_cast<size_t>(j) != i)
+              {
+                neighbors.push_back(j);
+              }
+            }
+          }
         }
+        std::sort(neighbors.begin(), neighbors.end());
       }
+      m_Neighborhoods[i] = static_cast<int32_t>(neighbors.size());
     }
   }
 
@@ -146,10 +151,13 @@ public:
 
 private:
   FindNeighborhoods* m_Filter = nullptr;
-  size_t m_TotalFeatures = 0;
-  float* m_Centroids = nullptr;
   const std::vector<int64_t>& m_Bins;
   const std::vector<float>& m_CriticalDistance;
+  const std::vector<uint64_t>& m_SortedKeys;
+  const std::vector<int32_t>& m_SortedFeatures;
+  const std::array<int64_t, 3>& m_BinDims;
+  std::vector<std::vector<int32_t>>& m_NeighborhoodList;
+  int32_t* m_Neighborhoods = nullptr;
 };
 
 // -----------------------------------------------------------------------------
@@ -310,17 +318,13 @@ void FindNeighborhoods::execute()
   {
     return;
   }
-  m_IncCount = 0;
 
   float x = 0.0f, y = 0.0f, z = 0.0f;
-  m_NumCompleted = 0;
   std::vector<float> criticalDistance;
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_EquivalentDiametersArrayPath.getDataContainerName());
   size_t totalFeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
 
-  m_ProgIncrement = totalFeatures / 100;
-
   m_LocalNeighborhoodList.resize(totalFeatures);
   criticalDistance.resize(totalFeatures);
 
@@ -355,55 +359,78 @@ void FindNeighborhoods::execute()
     bins[3 * i + 2] = static_cast<int64_t>(zbin);
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
+  // Shift the bins so the lowest one is 0 and sort the Features by their linear bin key; the bins of a row of the
+  // grid are then contiguous and the Features of any bin range in a row are found with one binary search
+  std::array<int64_t, 3> minBin = {0, 0, 0};
+  std::array<int64_t, 3> binDims = {1, 1, 1};
+  if(totalFeatures > 1)
+  {
+    std::array<int64_t, 3> maxBin = {bins[3], bins[4], bins[5]};
+    minBin = maxBin;
+    for(size_t i = 2; i < totalFeatures; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        minBin[d] = std::min(minBin[d], bins[3 * i + d]);
+        maxBin[d] = std::max(maxBin[d], bins[3 * i + d]);
+      }
+    }
+    for(size_t d = 0; d < 3; d++)
+    {
+      binDims[d] = maxBin[d] - minBin[d] + 1;
+    }
+  }
+
+  std::vector<std::pair<uint64_t, int32_t>> keyedFeatures;
+  keyedFeatures.reserve(totalFeatures);
+  for(size_t i = 1; i < totalFeatures; i++)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance), tbb::auto_partitioner());
+    for(size_t d = 0; d < 3; d++)
+    {
+      bins[3 * i + d] -= minBin[d];
+    }
+    uint64_t key = (static_cast<uint64_t>(bins[3 * i + 2]) * binDims[1] + bins[3 * i + 1]) * binDims[0] + bins[3 * i];
+    keyedFeatures.emplace_back(key, static_cast<int32_t>(i));
   }
-  else
-#endif
+  std::sort(keyedFeatures.begin(), keyedFeatures.end());
+  std::vector<uint64_t> sortedKeys(keyedFeatures.size());
+  std::vector<int32_t> sortedFeatures(keyedFeatures.size());
+  for(size_t n = 0; n < keyedFeatures.size(); n++)
   {
-    FindNeighborhoodsImpl serial(this, totalFeatures, m_Centroids, bins, criticalDistance);
-    serial.convert(0, totalFeatures);
+    sortedKeys[n] = keyedFeatures[n].first;
+    sortedFeatures[n] = keyedFeatures[n].second;
+  }
+  keyedFeatures.clear();
+  keyedFeatures.shrink_to_fit();
+
+  // The Features are searched a block at a time so progress is reported and cancel is checked from this thread
+  FindNeighborhoodsImpl impl(this, bins, criticalDistance, sortedKeys, sortedFeatures, binDims, m_LocalNeighborhoodList, m_Neighborhoods);
+  size_t blockSize = std::max<size_t>(totalFeatures / 100, 1);
+  for(size_t blockStart = 0; blockStart < totalFeatures; blockStart += blockSize)
+  {
+    size_t blockEnd = std::min(blockStart + blockSize, totalFeatures);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(blockStart, blockEnd), impl, tbb::auto_partitioner());
+#else
+    impl.convert(blockStart, blockEnd);
+#endif
+    if(getCancel())
+    {
+      return;
+    }
+    QString ss = QObject::tr("Working on Feature %1 of %2").arg(blockEnd).arg(totalFeatures);
+    notifyStatusMessage(ss);
   }
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
     NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(m_LocalNeighborhoodList[i].begin(), m_LocalNeighborhoodList[i].end());
+    sharedNeiLst->swap(m_LocalNeighborhoodList[i]);
     m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateNeighborHood(size_t sourceIndex, size_t destIndex)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_Neighborhoods[sourceIndex]++;
-  m_LocalNeighborhoodList[sourceIndex].push_back(static_cast<int32_t>(destIndex));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateProgress(size_t numCompleted, size_t totalFeatures)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_IncCount += numCompleted;
-  m_NumCompleted = m_NumCompleted + numCompleted;
-  if(m_IncCount > m_ProgIncrement)
-  {
-    m_IncCount = 0;
-    QString ss = QObject::tr("Working on Feature %1 of %2").arg(m_NumCompleted).arg(totalFeatures);
-    notifyStatusMessage(ss);
-  }
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -161,9 +161,6 @@ public:
   QString getNeighborhoodsArrayName() const;
   Q_PROPERTY(QString NeighborhoodsArrayName READ getNeighborhoodsArrayName WRITE setNeighborhoodsArrayName)
 
-  void updateNeighborHood(size_t sourceIndex, size_t targetIndex);
-  void updateProgress(size_t numCompleted, size_t totalFeatures);
-
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -260,9 +257,6 @@ private:
 
   NeighborList<int32_t>::WeakPointer m_NeighborhoodList;
   std::vector<std::vector<int32_t>> m_LocalNeighborhoodList;
-  size_t m_NumCompleted = 0;
-  size_t m_ProgIncrement = 0;
-  size_t m_IncCount = 0;
 
 public:
   FindNeighborhoods(const FindNeighborhoods&) = delete;            // Copy Constructor Not Implemented
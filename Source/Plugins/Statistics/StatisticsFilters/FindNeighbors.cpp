@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindNeighbors.h"
 
-#include <QtCore/QDateTime>
+#include <algorithm>
+#include <thread>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -46,6 +48,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
@@ -60,6 +63,165 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+namespace
+{
+/**
+ * @brief The SharedFaces struct counts the voxel faces shared by one pair of features, split by the axis
+ * the faces are normal to so that each axis can be given its own face area.
+ */
+struct SharedFaces
+{
+  uint64_t pair = 0;             // (smaller feature id << 32) | larger feature id
+  uint32_t faces[3] = {0, 0, 0}; // Faces normal to X, Y and Z
+};
+
+/**
+ * @brief reduceSharedFaces Sorts the records by feature pair and sums the records of each pair into one
+ * @param sharedFaces
+ */
+void reduceSharedFaces(std::vector<SharedFaces>& sharedFaces)
+{
+  std::sort(sharedFaces.begin(), sharedFaces.end(), [](const SharedFaces& a, const SharedFaces& b) { return a.pair < b.pair; });
+  size_t count = 0;
+  for(size_t i = 0; i < sharedFaces.size(); i++)
+  {
+    if(count > 0 && sharedFaces[count - 1].pair == sharedFaces[i].pair)
+    {
+      for(size_t axis = 0; axis < 3; axis++)
+      {
+        sharedFaces[count - 1].faces[axis] += sharedFaces[i].faces[axis];
+      }
+    }
+    else
+    {
+      sharedFaces[count++] = sharedFaces[i];
+    }
+  }
+  sharedFaces.resize(count);
+}
+} // namespace
+
+/**
+ * @brief The FindNeighborsImpl class scans one block of X lines, recording every face shared by two different
+ * features exactly once (from the voxel on the lower side of the face) and filling in the boundary cell counts.
+ */
+class FindNeighborsImpl
+{
+public:
+  FindNeighborsImpl(const int64_t dims[3], int32_t* featureIds, int8_t* boundaryCells, bool storeSurfaceFeatures, const std::vector<int64_t>& blockLineStart,
+                    std::vector<std::vector<SharedFaces>>& blockFaces, std::vector<std::vector<int32_t>>& blockSurfaceFeatures)
+  : m_FeatureIds(featureIds)
+  , m_BoundaryCells(boundaryCells)
+  , m_StoreSurfaceFeatures(storeSurfaceFeatures)
+  , m_BlockLineStart(blockLineStart)
+  , m_BlockFaces(blockFaces)
+  , m_BlockSurfaceFeatures(blockSurfaceFeatures)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  void findNeighbors(int64_t block) const
+  {
+    const int64_t planeSize = m_Dims[0] * m_Dims[1];
+    const int64_t neighpoints[6] = {-planeSize, -m_Dims[0], -1, 1, m_Dims[0], planeSize};
+    std::vector<uint64_t> faces[3];
+    std::vector<int32_t>& surfaceFeatures = m_BlockSurfaceFeatures[block];
+
+    for(int64_t line = m_BlockLineStart[block]; line < m_BlockLineStart[block + 1]; line++)
+    {
+      const int64_t row = line % m_Dims[1];
+      const int64_t plane = line / m_Dims[1];
+      for(int64_t column = 0; column < m_Dims[0]; column++)
+      {
+        const int64_t index = line * m_Dims[0] + column;
+        const int32_t feature = m_FeatureIds[index];
+        if(feature <= 0)
+        {
+          if(nullptr != m_BoundaryCells)
+          {
+            m_BoundaryCells[index] = 0;
+          }
+          continue;
+        }
+
+        bool onBoundaryXY = (column == 0 || column == m_Dims[0] - 1 || row == 0 || row == m_Dims[1] - 1);
+        bool onBoundaryZ = (plane == 0 || plane == m_Dims[2] - 1);
+        if(m_StoreSurfaceFeatures && (onBoundaryXY || (onBoundaryZ && m_Dims[2] != 1)))
+        {
+          if(surfaceFeatures.empty() || surfaceFeatures.back() != feature)
+          {
+            surfaceFeatures.push_back(feature);
+          }
+        }
+
+        // Order matches neighpoints: -Z, -Y, -X, +X, +Y, +Z
+        const bool good[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+        const int32_t axis[6] = {2, 1, 0, 0, 1, 2};
+        int8_t onsurf = 0;
+        for(int32_t k = 0; k < 6; k++)
+        {
+          if(!good[k])
+          {
+            continue;
+          }
+          const int32_t neighFeature = m_FeatureIds[index + neighpoints[k]];
+          if(neighFeature != feature && neighFeature > 0)
+          {
+            onsurf++;
+            if(k >= 3)
+            {
+              const uint64_t low = static_cast<uint64_t>(std::min(feature, neighFeature));
+              const uint64_t high = static_cast<uint64_t>(std::max(feature, neighFeature));
+              faces[axis[k]].push_back((low << 32) | high);
+            }
+          }
+        }
+        if(nullptr != m_BoundaryCells)
+        {
+          m_BoundaryCells[index] = onsurf;
+        }
+      }
+    }
+
+    // Collapse the raw faces of this block so only one record per feature pair and axis is kept
+    std::vector<SharedFaces>& sharedFaces = m_BlockFaces[block];
+    for(size_t a = 0; a < 3; a++)
+    {
+      std::sort(faces[a].begin(), faces[a].end());
+      for(size_t i = 0; i < faces[a].size(); i++)
+      {
+        if(i == 0 || faces[a][i] != faces[a][i - 1])
+        {
+          sharedFaces.emplace_back();
+          sharedFaces.back().pair = faces[a][i];
+        }
+        sharedFaces.back().faces[a]++;
+      }
+      std::vector<uint64_t>().swap(faces[a]);
+    }
+    reduceSharedFaces(sharedFaces);
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      findNeighbors(static_cast<int64_t>(block));
+    }
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int32_t* m_FeatureIds = nullptr;
+  int8_t* m_BoundaryCells = nullptr;
+  bool m_StoreSurfaceFeatures = false;
+  const std::vector<int64_t>& m_BlockLineStart;
+  std::vector<std::vector<SharedFaces>>& m_BlockFaces;
+  std::vector<std::vector<int32_t>>& m_BlockSurfaceFeatures;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -225,7 +387,6 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -236,190 +397,97 @@ void FindNeighbors::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(m_StoreSurfaceFeatures)
     {
       m_SurfaceFeatures[i] = false;
     }
   }
 
-  for(size_t j = 0; j < totalPoints; j++)
+  // Split the volume into blocks of whole X lines; several per core keeps the load balanced
+  const int64_t numLines = dims[1] * dims[2];
+  int64_t numBlocks = std::min(static_cast<int64_t>(std::max(1u, std::thread::hardware_concurrency())) * 4, numLines);
+  std::vector<int64_t> blockLineStart(numBlocks + 1, 0);
+  for(int64_t b = 0; b <= numBlocks; b++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
+    blockLineStart[b] = b * numLines / numBlocks;
+  }
+  std::vector<std::vector<SharedFaces>> blockFaces(numBlocks);
+  std::vector<std::vector<int32_t>> blockSurfaceFeatures(numBlocks);
 
-    if(getCancel())
-    {
-      return;
-    }
+  notifyStatusMessage("Finding Neighbors || Determining Shared Faces");
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.setGrain(1);
+  dataAlg.execute(FindNeighborsImpl(dims, m_FeatureIds, m_StoreBoundaryCells ? m_BoundaryCells : nullptr, m_StoreSurfaceFeatures, blockLineStart, blockFaces, blockSurfaceFeatures));
 
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
+  if(getCancel())
+  {
+    return;
+  }
+
+  if(m_StoreSurfaceFeatures)
+  {
+    for(const auto& surfaceFeatures : blockSurfaceFeatures)
     {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures)
+      for(const auto& feature : surfaceFeatures)
       {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
+        m_SurfaceFeatures[feature] = true;
       }
-      for(int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
-        }
-      }
-    }
-    if(m_StoreBoundaryCells)
-    {
-      m_BoundaryCells[j] = onsurf;
     }
   }
 
-  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
-
-  // We do this to create new set of NeighborList objects
-  for(size_t i = 1; i < totalFeatures; i++)
+  notifyStatusMessage("Finding Neighbors || Reducing Shared Faces");
+  std::vector<SharedFaces> sharedFaces;
+  for(auto& faces : blockFaces)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
+    sharedFaces.insert(sharedFaces.end(), faces.begin(), faces.end());
+    std::vector<SharedFaces>().swap(faces);
+  }
+  reduceSharedFaces(sharedFaces);
 
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
+  // Each shared face record lists the pair for both features. The records are sorted by (smaller, larger)
+  // feature id, so filling in record order leaves every feature's neighbors in ascending order.
+  std::vector<size_t> offsets(totalFeatures + 1, 0);
+  for(const auto& shared : sharedFaces)
+  {
+    offsets[(shared.pair >> 32) + 1]++;
+    offsets[(shared.pair & 0xFFFFFFFF) + 1]++;
+  }
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    offsets[i + 1] += offsets[i];
+  }
 
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
+  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
+  const float faceArea[3] = {spacing[1] * spacing[2], spacing[0] * spacing[2], spacing[0] * spacing[1]};
 
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * spacing[0] * spacing[1];
+  std::vector<int32_t> neighbors(offsets[totalFeatures]);
+  std::vector<float> areas(offsets[totalFeatures]);
+  std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+  for(const auto& shared : sharedFaces)
+  {
+    const int32_t feature1 = static_cast<int32_t>(shared.pair >> 32);
+    const int32_t feature2 = static_cast<int32_t>(shared.pair & 0xFFFFFFFF);
+    const float area = shared.faces[0] * faceArea[0] + shared.faces[1] * faceArea[1] + shared.faces[2] * faceArea[2];
+    neighbors[cursor[feature1]] = feature2;
+    areas[cursor[feature1]++] = area;
+    neighbors[cursor[feature2]] = feature1;
+    areas[cursor[feature2]++] = area;
+  }
+  std::vector<SharedFaces>().swap(sharedFaces);
 
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+  // We do this to create new set of NeighborList objects
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    m_NumNeighbors[i] = static_cast<int32_t>(offsets[i + 1] - offsets[i]);
 
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]));
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(areas.begin() + offsets[i], areas.begin() + offsets[i + 1]));
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 }
@@ -35,6 +35,8 @@
 
 #include "FindShapes.h"
 
+#include <array>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -53,6 +55,8 @@
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 
+#include "DREAM3DCommon/Utilities/FeatureMoments.h"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -226,11 +230,7 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
   FloatVec3Type spacing = imageGeom->getSpacing();
   FloatVec3Type origin = imageGeom->getOrigin();
 
@@ -242,89 +242,32 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  for(size_t i = 0; i < numfeatures; i++)
-  {
-    m_FeatureMoments[6 * i + 0] = 0.0;
-    m_FeatureMoments[6 * i + 1] = 0.0;
-    m_FeatureMoments[6 * i + 2] = 0.0;
-    m_FeatureMoments[6 * i + 3] = 0.0;
-    m_FeatureMoments[6 * i + 4] = 0.0;
-    m_FeatureMoments[6 * i + 5] = 0.0;
-  }
+  FeatureMoments moments(m_FeatureIds, imageGeom->getDimensions(), numfeatures, FeatureMoments::Order::Second);
+  moments.compute();
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  // Each voxel is split into 8 subvoxels offset by a quarter voxel along every axis. The offsets cancel in the
+  // products of two different axes and add 8 * (res / 4)^2 per voxel to the squares.
+  std::array<double, 3> modRes = {{modXRes, modYRes, modZRes}};
+  std::array<double, 3> offset = {{0.0, 0.0, 0.0}};
+  std::array<double, 3> squares = {{0.0, 0.0, 0.0}};
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    double count = static_cast<double>(moments.getCount(i));
+    for(size_t d = 0; d < 3; d++)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-        y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-        z = float(i * modZRes) + (origin[2] * static_cast<float>(m_ScaleFactor));
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        m_FeatureMoments[gnum * 6 + 3] = m_FeatureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        m_FeatureMoments[gnum * 6 + 4] = m_FeatureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        m_FeatureMoments[gnum * 6 + 5] = m_FeatureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
+      offset[d] = static_cast<double>(origin[d] * static_cast<float>(m_ScaleFactor)) - static_cast<double>(m_Centroids[i * 3 + d] * static_cast<float>(m_ScaleFactor));
     }
+    for(size_t d = 0; d < 3; d++)
+    {
+      squares[d] = moments.getProductSum(i, d, modRes[d], offset[d], d, modRes[d], offset[d]) + count * (modRes[d] / 4.0) * (modRes[d] / 4.0);
+    }
+    m_FeatureMoments[i * 6 + 0] = 8.0 * (squares[1] + squares[2]);
+    m_FeatureMoments[i * 6 + 1] = 8.0 * (squares[0] + squares[2]);
+    m_FeatureMoments[i * 6 + 2] = 8.0 * (squares[0] + squares[1]);
+    m_FeatureMoments[i * 6 + 3] = 8.0 * moments.getProductSum(i, 0, modRes[0], offset[0], 1, modRes[1], offset[1]);
+    m_FeatureMoments[i * 6 + 4] = 8.0 * moments.getProductSum(i, 1, modRes[1], offset[1], 2, modRes[2], offset[2]);
+    m_FeatureMoments[i * 6 + 5] = 8.0 * moments.getProductSum(i, 0, modRes[0], offset[0], 2, modRes[2], offset[2]);
+    m_Volumes[i] = static_cast<float>(count);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
@@ -374,73 +317,45 @@ void FindShapes::find_moments2D()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  size_t xPoints = 0, yPoints = 0;
-  FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
-
-  if(imageGeom->getXPoints() == 1)
-  {
-    xPoints = imageGeom->getYPoints();
-    yPoints = imageGeom->getZPoints();
-    spacing = imageGeom->getSpacing();
-  }
+  // The two image axes spanning the plane, in the order their cells are stored
+  size_t xAxis = 1, yAxis = 2;
   if(imageGeom->getYPoints() == 1)
   {
-    xPoints = imageGeom->getXPoints();
-    yPoints = imageGeom->getZPoints();
-    spacing = imageGeom->getSpacing();
+    xAxis = 0;
+    yAxis = 2;
   }
   if(imageGeom->getZPoints() == 1)
   {
-    xPoints = imageGeom->getXPoints();
-    yPoints = imageGeom->getYPoints();
-    spacing = imageGeom->getSpacing();
+    xAxis = 0;
+    yAxis = 1;
   }
+  FloatVec3Type spacing = imageGeom->getSpacing();
 
   float modXRes = spacing[0] * m_ScaleFactor;
   float modYRes = spacing[1] * m_ScaleFactor;
 
   FloatVec3Type origin = imageGeom->getOrigin();
 
-  for(size_t i = 0; i < 6 * numfeatures; i++)
-  {
-    m_FeatureMoments[i] = 0.0;
-  }
+  FeatureMoments moments(m_FeatureIds, imageGeom->getDimensions(), numfeatures, FeatureMoments::Order::Second);
+  moments.compute();
 
-  float x = 0.0f, y = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f;
-  size_t yStride = 0;
-  for(size_t j = 0; j < yPoints; j++)
+  // Each pixel is split into 4 subpixels offset by a quarter pixel along both axes, see find_moments()
+  for(size_t i = 0; i < numfeatures; i++)
   {
-    yStride = j * xPoints;
-    for(size_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-      y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-      x1 = x + (modXRes / 4.0f);
-      x2 = x - (modXRes / 4.0f);
-      y1 = y + (modYRes / 4.0f);
-      y2 = y - (modYRes / 4.0f);
-      xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist2 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist3 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist3 = (y1 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xdist4 = (x2 - (m_Centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      m_FeatureMoments[gnum * 6 + 0] = m_FeatureMoments[gnum * 6 + 0] + xx;
-      m_FeatureMoments[gnum * 6 + 1] = m_FeatureMoments[gnum * 6 + 1] + yy;
-      m_FeatureMoments[gnum * 6 + 2] = m_FeatureMoments[gnum * 6 + 2] + xy;
-      m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-    }
+    double count = static_cast<double>(moments.getCount(i));
+    double xOffset = static_cast<double>(origin[0] * static_cast<float>(m_ScaleFactor)) - static_cast<double>(m_Centroids[i * 3 + 0] * static_cast<float>(m_ScaleFactor));
+    double yOffset = static_cast<double>(origin[1] * static_cast<float>(m_ScaleFactor)) - static_cast<double>(m_Centroids[i * 3 + 1] * static_cast<float>(m_ScaleFactor));
+    double xSquares = moments.getProductSum(i, xAxis, modXRes, xOffset, xAxis, modXRes, xOffset) + count * (modXRes / 4.0) * (modXRes / 4.0);
+    double ySquares = moments.getProductSum(i, yAxis, modYRes, yOffset, yAxis, modYRes, yOffset) + count * (modYRes / 4.0) * (modYRes / 4.0);
+    m_FeatureMoments[i * 6 + 0] = 4.0 * ySquares;
+    m_FeatureMoments[i * 6 + 1] = 4.0 * xSquares;
+    m_FeatureMoments[i * 6 + 2] = 4.0 * moments.getProductSum(i, xAxis, modXRes, xOffset, yAxis, modYRes, yOffset);
+    m_FeatureMoments[i * 6 + 3] = 0.0;
+    m_FeatureMoments[i * 6 + 4] = 0.0;
+    m_FeatureMoments[i * 6 + 5] = 0.0;
+    m_Volumes[i] = static_cast<float>(count);
   }
   double konst1 = static_cast<double>((modXRes / 2.0f) * (modYRes / 2.0f));
   double konst2 = static_cast<double>(spacing[0] * spacing[1]);
@@ -48,6 +48,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "DREAM3DCommon/Utilities/FeatureMoments.h"
+
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
@@ -193,23 +195,15 @@ void FindSizes::dataCheck()
 // -----------------------------------------------------------------------------
 void FindSizes::findSizesImage(ImageGeom::Pointer image)
 {
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<uint64_t>::Pointer m_FeatureCounts = DataArray<uint64_t>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  uint64_t* featurecounts = m_FeatureCounts->getPointer(0);
+  FeatureMoments moments(m_FeatureIds, image->getDimensions(), numfeatures, FeatureMoments::Order::Counts);
+  moments.compute();
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-
   FloatVec3Type spacing = image->getSpacing();
 
   if(image->getXPoints() == 1 || image->getYPoints() == 1 || image->getZPoints() == 1)
@@ -229,14 +223,15 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
 
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      if(featurecounts[i] > 9007199254740992ULL)
+      uint64_t featureCount = moments.getCount(i);
+      m_NumElements[i] = static_cast<int32_t>(featureCount);
+      if(featureCount > 9007199254740992ULL)
       {
-        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featurecounts[i]);
+        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featureCount);
         setErrorCondition(-78231, ss);
         return;
       }
-      m_Volumes[i] = (static_cast<double>(featurecounts[i]) * static_cast<double>(res_scalar));
+      m_Volumes[i] = (static_cast<double>(featureCount) * static_cast<double>(res_scalar));
 
       rad = m_Volumes[i] / SIMPLib::Constants::k_Pi;
       diameter = (2 * sqrtf(rad));
@@ -249,15 +244,16 @@ void FindSizes::findSizesImage(ImageGeom::Pointer image)
     float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
     for(size_t i = 1; i < numfeatures; i++)
     {
-      m_NumElements[i] = static_cast<int32_t>(featurecounts[i]);
-      if(featurecounts[i] > 9007199254740992ULL)
+      uint64_t featureCount = moments.getCount(i);
+      m_NumElements[i] = static_cast<int32_t>(featureCount);
+      if(featureCount > 9007199254740992ULL)
       {
-        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featurecounts[i]);
+        QString ss = QObject::tr("Number of voxels belonging to feature %1 (%2) is greater than 9007199254740992").arg(i).arg(featureCount);
         setErrorCondition(-78231, ss);
         return;
       }
 
-      m_Volumes[i] = (static_cast<double>(featurecounts[i]) * static_cast<double>(res_scalar));
+      m_Volumes[i] = (static_cast<double>(featureCount) * static_cast<double>(res_scalar));
 
       rad = m_Volumes[i] / vol_term;
       diameter = 2.0f * powf(rad, 0.3333333333f);
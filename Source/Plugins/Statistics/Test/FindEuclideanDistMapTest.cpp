@@ -231,6 +231,35 @@ public:
       DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
     }
 
+    // The exact distances reach the true closest boundary Cell, which the propagated nearest neighbor can miss
+    floatArray = am->getAttributeArrayAs<FloatArrayType>("GBExactDistance");
+    std::vector<float> GBExact = {2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                  2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0};
+
+    for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
+    {
+      float computedValue = floatArray->getValue(i);
+      float refValue = GBExact[i];
+      DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
+    }
+
+    floatArray = am->getAttributeArrayAs<FloatArrayType>("TJExactDistance");
+    for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
+    {
+      float computedValue = floatArray->getValue(i);
+      float refValue = TJEuclidean[i];
+      DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
+    }
+
+    floatArray = am->getAttributeArrayAs<FloatArrayType>("QPExactDistance");
+    for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
+    {
+      float computedValue = floatArray->getValue(i);
+      float refValue = QPEuclidean[i];
+      DREAM3D_COMPARE_FLOATS(&computedValue, &refValue, 1);
+    }
+
     return 0;
   }
 
@@ -311,6 +340,29 @@ public:
     filter->execute();
     DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
 
+    //-------------------------------------------
+    var.setValue(QString("GBExactDistance"));
+    err = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+    var.setValue(QString("TJExactDistance"));
+    err = filter->setProperty("TJDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+    var.setValue(QString("QPExactDistance"));
+    err = filter->setProperty("QPDistancesArrayName", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    calcManhattan = false;
+    var.setValue(calcManhattan);
+    err = filter->setProperty("CalcManhattanDist", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    var.setValue(true);
+    err = filter->setProperty("CalcExactEuclideanDist", var);
+    DREAM3D_REQUIRE(err >= 0);
+
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+
     DataContainerWriter::Pointer writer = DataContainerWriter::New();
     writer->setOutputFile(UnitTest::StatisticsTempDir + QDir::separator() + "FindEuclideanDistMap.dream3d");
     writer->setDataContainerArray(dca);
@@ -142,7 +142,7 @@ void CalculateTriangleGroupCurvatures::operator()() const
     err = nRingNeighborAlg->generate(m_TrianglesPtr, faceLabels);
     Q_ASSERT(err >= 0);
 
-    UniqueFaceIds_t triPatch = nRingNeighborAlg->getNRingTriangles();
+    const UniqueFaceIds_t& triPatch = nRingNeighborAlg->getNRingTriangles();
     Q_ASSERT(triPatch.size() > 1);
 
     DataArray<double>::Pointer patchCentroids = extractPatchData(triId, triPatch, m_SurfaceMeshTriangleCentroids->getPointer(0), QString("_INTERNAL_USE_ONLY_Patch_Centroids"));
@@ -281,7 +281,7 @@ void CalculateTriangleGroupCurvatures::operator()() const
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const
+DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(int64_t triId, const UniqueFaceIds_t& triPatch, double* data, const QString& name) const
 {
   std::vector<size_t> cDims(1, 3);
   DataArray<double>::Pointer extractedData = DataArray<double>::CreateArray(triPatch.size(), cDims, name, true);
@@ -292,17 +292,18 @@ DataArray<double>::Pointer CalculateTriangleGroupCurvatures::extractPatchData(in
   extractedData->setComponent(i, 1, data[triId * 3 + 1]);
   extractedData->setComponent(i, 2, data[triId * 3 + 2]);
   ++i;
-  triPatch.erase(triId);
 
-  for(UniqueFaceIds_t::iterator iter = triPatch.begin(); iter != triPatch.end(); ++iter)
+  for(const auto& t : triPatch)
   {
-    int64_t t = *iter;
+    if(t == triId)
+    {
+      continue;
+    }
     extractedData->setComponent(i, 0, data[t * 3]);
     extractedData->setComponent(i, 1, data[t * 3 + 1]);
     extractedData->setComponent(i, 2, data[t * 3 + 2]);
     ++i;
   }
-  triPatch.insert(triId);
 
   return extractedData;
 }
@@ -35,7 +35,7 @@
 
 #pragma once
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
@@ -61,7 +61,7 @@ public:
 
   void operator()() const;
 
-  typedef std::set<int64_t> UniqueFaceIds_t;
+  typedef std::vector<int64_t> UniqueFaceIds_t;
 
 protected:
   CalculateTriangleGroupCurvatures();
@@ -69,12 +69,12 @@ protected:
   /**
    * @brief extractPatchData Extracts out the needed data values from the global arrays
    * @param triId The seed triangle Id
-   * @param triPatch The group of triangles being used
+   * @param triPatch The sorted group of triangles being used
    * @param data The data to extract from
    * @param name The name of the data array being used
    * @return Shared pointer to the extracted data
    */
-  DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
+  DataArray<double>::Pointer extractPatchData(int64_t triId, const UniqueFaceIds_t& triPatch, double* data, const QString& name) const;
 
 private:
   int64_t m_NRing;
@@ -48,6 +48,8 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FaceLabelIndex.h"
+
 #include "CalculateTriangleGroupCurvatures.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -339,9 +341,6 @@ void FeatureFaceCurvatureFilter::execute()
     triangleGeom->findElementsContainingVert();
   }
 
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
-
   int32_t maxFaceId = 0;
   for(int64_t t = 0; t < numTriangles; ++t)
   {
@@ -350,28 +349,13 @@ void FeatureFaceCurvatureFilter::execute()
       maxFaceId = m_SurfaceMeshFeatureFaceIds[t];
     }
   }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
-
-  // Allocate all the vectors that we need
-  for(size_t iter = 0; iter < faceSizes.size(); ++iter)
-  {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
-  }
 
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
-  {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
-  }
+  // Group the Triangles by their Feature Face Id so each face's triangles are contiguous
+  std::vector<MeshIndexType> faceOffsets;
+  std::vector<MeshIndexType> faceTriangles;
+  FaceLabelIndex::GroupByKey(m_SurfaceMeshFeatureFaceIds, numTriangles, 1, maxFaceId + 1, faceOffsets, faceTriangles);
 
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
+  m_TotalFeatureFaces = maxFaceId + 1;
   m_CompletedFeatureFaces = 0;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -379,15 +363,12 @@ void FeatureFaceCurvatureFilter::execute()
 #else
 
 #endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
-
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
+  for(int32_t faceId = 0; faceId <= maxFaceId; ++faceId)
   {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
+    QString ss = QObject::tr("Working on Face Id %1/%2").arg(faceId).arg(maxFaceId);
     notifyStatusMessage(ss);
 
-    FaceIds_t& triangleIds = (*iter).second;
+    FaceIds_t triangleIds(faceTriangles.begin() + faceOffsets[faceId], faceTriangles.begin() + faceOffsets[faceId + 1]);
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     if(true)
     {
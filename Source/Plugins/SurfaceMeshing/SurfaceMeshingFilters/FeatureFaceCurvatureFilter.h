@@ -103,7 +103,6 @@ public:
   ~FeatureFaceCurvatureFilter() override;
 
   typedef std::vector<int64_t> FaceIds_t;
-  typedef std::map<int32_t, FaceIds_t> SharedFeatureFaces_t;
 
   /**
    * @brief Setter property for FaceAttributeMatrixPath
@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindNRingNeighbors.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <QtCore/QDebug>
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
@@ -110,18 +113,15 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
 #endif
 
   // Add our seed triangle
-  m_NRingTriangles.insert(m_TriangleId);
+  m_NRingTriangles.assign(1, m_TriangleId);
+  m_Frontier.assign(1, m_TriangleId);
 
-  for(int64_t ring = 0; ring < m_Ring; ++ring)
+  for(int64_t ring = 0; ring < m_Ring && !m_Frontier.empty(); ++ring)
   {
-    // Make a copy of the 1 Ring Triangles that we just found so that we can use those triangles as the
-    // seed triangles for the 2 Ring triangles
-    UniqueFaceIds_t lcvTriangles(m_NRingTriangles);
-
-    // Now that we have the 1 ring triangles, get the 2 Ring neighbors from that list
-    for(UniqueFaceIds_t::iterator triIter = lcvTriangles.begin(); triIter != lcvTriangles.end(); ++triIter)
+    // Only the triangles added by the previous ring can reach new triangles, so walk out from those
+    m_Candidates.clear();
+    for(const auto& triangleIdx : m_Frontier)
     {
-      int64_t triangleIdx = *triIter;
       // For each node, get the triangle ids that the node belongs to
       for(int32_t i = 0; i < 3; ++i)
       {
@@ -129,7 +129,6 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
         uint16_t tCount = node2TrianglePtr->getNumberOfElements(triangles[triangleIdx * 3 + i]);
         MeshIndexType* data = node2TrianglePtr->getElementListPointer(triangles[triangleIdx * 3 + i]);
 
-        // Copy all the triangles into our "2Ring" set which will be the unique set of triangle ids
         for(uint16_t t = 0; t < tCount; ++t)
         {
           int64_t tid = data[t];
@@ -137,11 +136,21 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
           check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
           if(check0 || check1)
           {
-            m_NRingTriangles.insert(tid);
+            m_Candidates.push_back(tid);
           }
         }
       }
     }
+    std::sort(m_Candidates.begin(), m_Candidates.end());
+    m_Candidates.erase(std::unique(m_Candidates.begin(), m_Candidates.end()), m_Candidates.end());
+
+    // The next frontier is every candidate that is not already in the patch
+    m_Frontier.clear();
+    std::set_difference(m_Candidates.begin(), m_Candidates.end(), m_NRingTriangles.begin(), m_NRingTriangles.end(), std::back_inserter(m_Frontier));
+
+    size_t middle = m_NRingTriangles.size();
+    m_NRingTriangles.insert(m_NRingTriangles.end(), m_Frontier.begin(), m_Frontier.end());
+    std::inplace_merge(m_NRingTriangles.begin(), m_NRingTriangles.begin() + middle, m_NRingTriangles.end());
   }
   return err;
 }
@@ -37,7 +37,7 @@
 
 #include <memory>
 
-#include <set>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
@@ -68,7 +68,7 @@ public:
 
   virtual ~FindNRingNeighbors();
 
-  using UniqueFaceIds_t = std::set<int64_t>;
+  using UniqueFaceIds_t = std::vector<int64_t>;
 
   /**
    * @brief Setter property for TriangleId
@@ -128,7 +128,7 @@ public:
 
   /**
    * @brief getNRingTriangles Returns the N ring set
-   * @return Set of N ring Ids
+   * @return Sorted, unique list of N ring Ids
    */
   UniqueFaceIds_t& getNRingTriangles();
 
@@ -172,6 +172,8 @@ private:
   bool m_WriteConformalMesh = {};
 
   UniqueFaceIds_t m_NRingTriangles;
+  UniqueFaceIds_t m_Frontier;
+  UniqueFaceIds_t m_Candidates;
 
 public:
   FindNRingNeighbors(const FindNRingNeighbors&) = delete;            // Copy Constructor Not Implemented
@@ -34,7 +34,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindTriangleGeomCentroids.h"
 
-#include <set>
+#include <algorithm>
 
 #include <QtCore/QTextStream>
 
@@ -46,10 +46,12 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FaceLabelIndex.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -59,6 +61,70 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+/**
+ * @brief The FindTriangleGeomCentroidsImpl class averages the unique vertices of the triangles bounding a range of
+ * features. The vertices of each feature are gathered from its triangle list, then sorted and made unique.
+ */
+class FindTriangleGeomCentroidsImpl
+{
+public:
+  FindTriangleGeomCentroidsImpl(const MeshIndexType* offsets, const MeshIndexType* featureTriangles, const MeshIndexType* tris, const float* vertices, float* centroids)
+  : m_Offsets(offsets)
+  , m_FeatureTriangles(featureTriangles)
+  , m_Tris(tris)
+  , m_Vertices(vertices)
+  , m_Centroids(centroids)
+  {
+  }
+
+  virtual ~FindTriangleGeomCentroidsImpl() = default;
+
+  void compute(size_t start, size_t end) const
+  {
+    std::vector<MeshIndexType> featureVertices;
+    for(size_t i = start; i < end; i++)
+    {
+      featureVertices.clear();
+      for(MeshIndexType t = m_Offsets[i]; t < m_Offsets[i + 1]; t++)
+      {
+        const MeshIndexType* tri = m_Tris + 3 * m_FeatureTriangles[t];
+        featureVertices.insert(featureVertices.end(), tri, tri + 3);
+      }
+      if(featureVertices.empty())
+      {
+        continue;
+      }
+      std::sort(featureVertices.begin(), featureVertices.end());
+      featureVertices.erase(std::unique(featureVertices.begin(), featureVertices.end()), featureVertices.end());
+
+      for(const auto& vert : featureVertices)
+      {
+        m_Centroids[3 * i + 0] += m_Vertices[3 * vert + 0];
+        m_Centroids[3 * i + 1] += m_Vertices[3 * vert + 1];
+        m_Centroids[3 * i + 2] += m_Vertices[3 * vert + 2];
+      }
+      m_Centroids[3 * i + 0] /= featureVertices.size();
+      m_Centroids[3 * i + 1] /= featureVertices.size();
+      m_Centroids[3 * i + 2] /= featureVertices.size();
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    compute(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Offsets;
+  const MeshIndexType* m_FeatureTriangles;
+  const MeshIndexType* m_Tris;
+  const float* m_Vertices;
+  float* m_Centroids;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -173,42 +239,19 @@ void FindTriangleGeomCentroids::execute()
   MeshIndexType* tris = triangles->getTriPointer(0);
 
   MeshIndexType numFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
-  std::vector<std::set<MeshIndexType>> vertexSets(numFeatures);
-
-  for(MeshIndexType i = 0; i < numTriangles; i++)
+  if(numFeatures < 2)
   {
-    if(m_FaceLabels[2 * i + 0] > 0)
-    {
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 0]);
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 1]);
-      vertexSets[m_FaceLabels[2 * i + 0]].insert(tris[3 * i + 2]);
-    }
-    if(m_FaceLabels[2 * i + 1] > 0)
-    {
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 0]);
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 1]);
-      vertexSets[m_FaceLabels[2 * i + 1]].insert(tris[3 * i + 2]);
-    }
+    return;
   }
 
-  std::set<MeshIndexType>::iterator it;
-  for(MeshIndexType i = 0; i < numFeatures; i++)
-  {
-    for(it = vertexSets[i].begin(); it != vertexSets[i].end(); ++it)
-    {
-      int32_t vert = *it;
-      m_Centroids[3 * i + 0] += vertPtr[3 * vert + 0];
-      m_Centroids[3 * i + 1] += vertPtr[3 * vert + 1];
-      m_Centroids[3 * i + 2] += vertPtr[3 * vert + 2];
-    }
-    if(!vertexSets[i].empty())
-    {
-      m_Centroids[3 * i + 0] /= vertexSets[i].size();
-      m_Centroids[3 * i + 1] /= vertexSets[i].size();
-      m_Centroids[3 * i + 2] /= vertexSets[i].size();
-    }
-    vertexSets[i].clear();
-  }
+  // List every triangle under both of its labels; feature 0 is skipped below
+  std::vector<MeshIndexType> offsets;
+  std::vector<MeshIndexType> featureTriangles;
+  FaceLabelIndex::GroupByKey(m_FaceLabels, numTriangles, 2, static_cast<int32_t>(numFeatures), offsets, featureTriangles);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, numFeatures);
+  dataAlg.execute(FindTriangleGeomCentroidsImpl(offsets.data(), featureTriangles.data(), tris, vertPtr, m_Centroids));
 }
 
 // -----------------------------------------------------------------------------
@@ -52,6 +52,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/VertexSmoothingEngine.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -283,104 +284,11 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   MeshIndexType* uedges = surfaceMesh->getEdgePointer(0);
   MeshIndexType nedges = surfaceMesh->getNumberOfEdges();
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, std::string("_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array"), true);
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
-
-  std::vector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array", true);
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
-
-  double dlta = 0.0;
-  for(int32_t q = 0; q < m_IterationSteps; q++)
+  // The connectivity never changes, so the vertex neighbors are gathered once for all iterations
+  VertexSmoothingEngine engine(nvert, uedges, nedges);
+  if(engine.execute(verts, lambda, m_IterationSteps, m_UseTaubinSmoothing, m_MuFactor, this) < 0)
   {
-    if(getCancel())
-    {
-      return -1;
-    }
-    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-    notifyStatusMessage(ss);
-    // Compute the Deltas for each point
-    for(MeshIndexType i = 0; i < nedges; i++)
-    {
-      MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-      MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-      for(MeshIndexType j = 0; j < 3; j++)
-      {
-        Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-        Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-        dlta = static_cast<double>(verts[3 * in2 + j] - verts[3 * in1 + j]);
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
-      }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
-    }
-
-    // Move each point
-    float ll = 0.0f;
-    for(MeshIndexType i = 0; i < nvert; i++)
-    {
-      for(MeshIndexType j = 0; j < 3; j++)
-      {
-        MeshIndexType in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
-
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
-      }
-      ncon[i] = 0; // reset for next iteration
-    }
-
-    // Now optionally apply a negative lambda based on the mu Factor value.
-    // This is from Taubin's paper on smoothing without shrinkage. This effectively
-    // runs a low pass filter on the data
-    if(m_UseTaubinSmoothing)
-    {
-
-      if(getCancel())
-      {
-        return -1;
-      }
-      QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
-      notifyStatusMessage(ss);
-      // Compute the Delta's
-      for(MeshIndexType i = 0; i < nedges; i++)
-      {
-        MeshIndexType in1 = uedges[2 * i];     // row of the first vertex
-        MeshIndexType in2 = uedges[2 * i + 1]; // row the second vertex
-
-        for(int32_t j = 0; j < 3; j++)
-        {
-          Q_ASSERT(static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3));
-          Q_ASSERT(static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3));
-          dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-          delta[3 * in1 + j] += dlta;
-          delta[3 * in2 + j] += -1.0 * dlta;
-        }
-        ncon[in1] += 1;
-        ncon[in2] += 1;
-      }
-
-      // MOve the points
-      float ll = 0.0f;
-      for(MeshIndexType i = 0; i < nvert; i++)
-      {
-        for(MeshIndexType j = 0; j < 3; j++)
-        {
-          MeshIndexType in0 = 3 * i + j;
-          dlta = delta[in0] / ncon[i];
-
-          ll = lambda[i] * m_MuFactor;
-          verts[3 * i + j] += ll * dlta;
-          delta[in0] = 0.0; // reset for next iteration
-        }
-        ncon[i] = 0; // reset for next iteration
-      }
-    }
+    return -1;
   }
 
   return err;
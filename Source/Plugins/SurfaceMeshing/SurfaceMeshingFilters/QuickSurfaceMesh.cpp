@@ -34,9 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "QuickSurfaceMesh.h"
 
+#include <algorithm>
 #include <array>
 #include <random>
 #include <set>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -57,6 +59,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -232,6 +235,374 @@ void copyCellArraysToFaceArrays(size_t faceIndex, size_t firstcIndex, size_t sec
   }
 }
 
+/**
+ * @brief The QuickSurfaceMeshNodeOwners struct records the distinct Feature Ids that share a mesh node. The node type
+ * saturates at 4 owners, so at most 4 Feature Ids are kept inline; the exterior of the volume (-1) is a flag.
+ */
+struct QuickSurfaceMeshNodeOwners
+{
+  std::array<int32_t, 4> featureIds = {{0, 0, 0, 0}};
+  int8_t count = 0;
+  bool boundary = false;
+
+  void insert(int32_t featureId)
+  {
+    if(featureId == -1)
+    {
+      boundary = true;
+      return;
+    }
+    for(int8_t i = 0; i < count; i++)
+    {
+      if(featureIds[i] == featureId)
+      {
+        return;
+      }
+    }
+    if(count < 4)
+    {
+      featureIds[count++] = featureId;
+    }
+  }
+
+  void merge(const QuickSurfaceMeshNodeOwners& other)
+  {
+    boundary = boundary || other.boundary;
+    for(int8_t i = 0; i < other.count; i++)
+    {
+      insert(other.featureIds[i]);
+    }
+  }
+
+  int8_t nodeType() const
+  {
+    int8_t type = static_cast<int8_t>(std::min(count + (boundary ? 1 : 0), 4));
+    if(boundary)
+    {
+      type += 10;
+    }
+    return type;
+  }
+};
+
+/**
+ * @brief The QuickSurfaceMeshSlab struct holds the bookkeeping for one z slab of the mesh. Nodes and triangles are
+ * counted per slab first and then written at the prefix-summed offsets. The nodes on the top plane of a slab are
+ * shared with the next slab, so their local ids and owners are kept for stitching.
+ */
+struct QuickSurfaceMeshSlab
+{
+  MeshIndexType zStart = 0;
+  MeshIndexType zEnd = 0;
+  MeshIndexType nodeCount = 0;
+  MeshIndexType triangleCount = 0;
+  MeshIndexType nodeOffset = 0;
+  MeshIndexType triangleOffset = 0;
+  std::vector<MeshIndexType> topPlaneNodes;
+  std::vector<QuickSurfaceMeshNodeOwners> topPlaneOwners;
+  std::vector<QuickSurfaceMeshNodeOwners> bottomPlaneOwners;
+};
+
+namespace
+{
+constexpr MeshIndexType k_UnassignedNode = std::numeric_limits<MeshIndexType>::max();
+
+// Lattice offsets of the 4 corner nodes of each voxel face, in the order the nodes are numbered
+using VoxelFace = std::array<std::array<MeshIndexType, 3>, 4>;
+const VoxelFace k_XMinFace = {{{{0, 0, 0}}, {{0, 1, 0}}, {{0, 0, 1}}, {{0, 1, 1}}}};
+const VoxelFace k_YMinFace = {{{{0, 0, 0}}, {{1, 0, 0}}, {{0, 0, 1}}, {{1, 0, 1}}}};
+const VoxelFace k_ZMinFace = {{{{0, 0, 0}}, {{1, 0, 0}}, {{0, 1, 0}}, {{1, 1, 0}}}};
+const VoxelFace k_XMaxFace = {{{{1, 0, 0}}, {{1, 1, 0}}, {{1, 0, 1}}, {{1, 1, 1}}}};
+const VoxelFace k_YMaxFace = {{{{1, 1, 0}}, {{0, 1, 0}}, {{1, 1, 1}}, {{0, 1, 1}}}};
+const VoxelFace k_ZMaxFace = {{{{1, 0, 1}}, {{0, 0, 1}}, {{1, 1, 1}}, {{0, 1, 1}}}};
+} // namespace
+
+/**
+ * @brief The QuickSurfaceMeshSlabImpl class meshes a range of z slabs. Only the two node planes touched by the current
+ * layer of voxels are held in memory. Without outputs it counts the nodes and triangles of each slab; with outputs it
+ * writes them at the slab offsets in exactly the order of a serial sweep through the volume.
+ */
+class QuickSurfaceMeshSlabImpl
+{
+public:
+  QuickSurfaceMeshSlabImpl(QuickSurfaceMesh* filter, const SizeVec3Type& dims, int32_t* featureIds, std::vector<QuickSurfaceMeshSlab>& slabs)
+  : m_Filter(filter)
+  , m_XPoints(dims[0])
+  , m_YPoints(dims[1])
+  , m_ZPoints(dims[2])
+  , m_FeatureIds(featureIds)
+  , m_Slabs(slabs)
+  {
+  }
+
+  virtual ~QuickSurfaceMeshSlabImpl() = default;
+
+  void setOutputs(const IGeometryGrid::Pointer& grid, float* vertex, MeshIndexType* triangle, int32_t* faceLabels, int8_t* nodeTypes, const std::vector<IDataArray::Pointer>& selectedArrays,
+                  const std::vector<IDataArray::Pointer>& createdArrays)
+  {
+    m_Emit = true;
+    m_Grid = grid;
+    m_Vertex = vertex;
+    m_Triangle = triangle;
+    m_FaceLabels = faceLabels;
+    m_NodeTypes = nodeTypes;
+    m_SelectedArrays = selectedArrays;
+    m_CreatedArrays = createdArrays;
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t s = range.min(); s < range.max(); s++)
+    {
+      meshSlab(s);
+    }
+  }
+
+private:
+  struct LayerState
+  {
+    std::vector<MeshIndexType> lowerNodes;
+    std::vector<MeshIndexType> upperNodes;
+    std::vector<QuickSurfaceMeshNodeOwners> lowerOwners;
+    std::vector<QuickSurfaceMeshNodeOwners> upperOwners;
+    MeshIndexType nextNode = 0;
+    MeshIndexType nextTriangle = 0;
+  };
+
+  QuickSurfaceMesh* m_Filter = nullptr;
+  MeshIndexType m_XPoints = 0;
+  MeshIndexType m_YPoints = 0;
+  MeshIndexType m_ZPoints = 0;
+  int32_t* m_FeatureIds = nullptr;
+  std::vector<QuickSurfaceMeshSlab>& m_Slabs;
+
+  bool m_Emit = false;
+  IGeometryGrid::Pointer m_Grid;
+  float* m_Vertex = nullptr;
+  MeshIndexType* m_Triangle = nullptr;
+  int32_t* m_FaceLabels = nullptr;
+  int8_t* m_NodeTypes = nullptr;
+  std::vector<IDataArray::Pointer> m_SelectedArrays;
+  std::vector<IDataArray::Pointer> m_CreatedArrays;
+
+  void meshSlab(size_t s) const
+  {
+    QuickSurfaceMeshSlab& slab = m_Slabs[s];
+    const size_t planeSize = (m_XPoints + 1) * (m_YPoints + 1);
+
+    LayerState state;
+    state.lowerNodes.assign(planeSize, k_UnassignedNode);
+    state.upperNodes.assign(planeSize, k_UnassignedNode);
+    if(m_Emit)
+    {
+      state.lowerOwners.resize(planeSize);
+      state.upperOwners.resize(planeSize);
+      state.nextNode = slab.nodeOffset;
+      state.nextTriangle = slab.triangleOffset;
+    }
+
+    // Nodes on the bottom plane that the layer below touches are numbered by the previous slab
+    if(slab.zStart > 0)
+    {
+      if(m_Emit)
+      {
+        const QuickSurfaceMeshSlab& previous = m_Slabs[s - 1];
+        for(size_t n = 0; n < planeSize; n++)
+        {
+          if(previous.topPlaneNodes[n] != k_UnassignedNode)
+          {
+            state.lowerNodes[n] = previous.nodeOffset + previous.topPlaneNodes[n];
+          }
+        }
+        slab.bottomPlaneOwners.resize(planeSize);
+      }
+      else
+      {
+        LayerState below;
+        below.lowerNodes.assign(planeSize, 0);
+        below.upperNodes.assign(planeSize, k_UnassignedNode);
+        meshLayer(slab.zStart - 1, below, false);
+        state.lowerNodes.swap(below.upperNodes);
+      }
+    }
+
+    for(MeshIndexType k = slab.zStart; k < slab.zEnd; k++)
+    {
+      meshLayer(k, state, m_Emit);
+
+      // Node plane k can not be touched again
+      if(m_Emit)
+      {
+        for(size_t n = 0; n < planeSize; n++)
+        {
+          if(state.lowerNodes[n] == k_UnassignedNode)
+          {
+            continue;
+          }
+          if(state.lowerNodes[n] < slab.nodeOffset)
+          {
+            slab.bottomPlaneOwners[n] = state.lowerOwners[n];
+          }
+          else
+          {
+            m_NodeTypes[state.lowerNodes[n]] = state.lowerOwners[n].nodeType();
+          }
+        }
+        std::fill(state.lowerOwners.begin(), state.lowerOwners.end(), QuickSurfaceMeshNodeOwners());
+        state.lowerOwners.swap(state.upperOwners);
+      }
+      std::fill(state.lowerNodes.begin(), state.lowerNodes.end(), k_UnassignedNode);
+      state.lowerNodes.swap(state.upperNodes);
+    }
+
+    // The top node plane is finished here only for the last slab
+    if(m_Emit)
+    {
+      if(slab.zEnd == m_ZPoints)
+      {
+        for(size_t n = 0; n < planeSize; n++)
+        {
+          if(state.lowerNodes[n] != k_UnassignedNode)
+          {
+            m_NodeTypes[state.lowerNodes[n]] = state.lowerOwners[n].nodeType();
+          }
+        }
+      }
+      else
+      {
+        slab.topPlaneOwners.swap(state.lowerOwners);
+      }
+    }
+    else
+    {
+      slab.nodeCount = state.nextNode;
+      slab.triangleCount = state.nextTriangle;
+      if(slab.zEnd < m_ZPoints)
+      {
+        slab.topPlaneNodes.swap(state.lowerNodes);
+      }
+    }
+  }
+
+  void meshLayer(MeshIndexType k, LayerState& state, bool emit) const
+  {
+    const MeshIndexType xP = m_XPoints;
+    const MeshIndexType yP = m_YPoints;
+    const MeshIndexType zP = m_ZPoints;
+    for(MeshIndexType j = 0; j < yP; j++)
+    {
+      for(MeshIndexType i = 0; i < xP; i++)
+      {
+        MeshIndexType point = (k * xP * yP) + (j * xP) + i;
+        int32_t featureId = m_FeatureIds[point];
+
+        if(i == 0)
+        {
+          meshFace(state, emit, k_XMinFace, i, j, k, true, -1, featureId, point, point, true);
+        }
+        if(j == 0)
+        {
+          meshFace(state, emit, k_YMinFace, i, j, k, false, -1, featureId, point, point, true);
+        }
+        if(k == 0)
+        {
+          meshFace(state, emit, k_ZMinFace, i, j, k, true, -1, featureId, point, point, true);
+        }
+        if(i == (xP - 1))
+        {
+          meshFace(state, emit, k_XMaxFace, i, j, k, false, -1, featureId, point, point, true);
+        }
+        else if(featureId != m_FeatureIds[point + 1])
+        {
+          meshInteriorFace(state, emit, k_XMaxFace, i, j, k, false, point, point + 1);
+        }
+        if(j == (yP - 1))
+        {
+          meshFace(state, emit, k_YMaxFace, i, j, k, false, -1, featureId, point, point, true);
+        }
+        else if(featureId != m_FeatureIds[point + xP])
+        {
+          meshInteriorFace(state, emit, k_YMaxFace, i, j, k, true, point, point + xP);
+        }
+        if(k == (zP - 1))
+        {
+          meshFace(state, emit, k_ZMaxFace, i, j, k, true, -1, featureId, point, point, true);
+        }
+        else if(featureId != m_FeatureIds[point + (xP * yP)])
+        {
+          meshInteriorFace(state, emit, k_ZMaxFace, i, j, k, false, point, point + (xP * yP));
+        }
+      }
+    }
+  }
+
+  void meshInteriorFace(LayerState& state, bool emit, const VoxelFace& face, MeshIndexType i, MeshIndexType j, MeshIndexType k, bool reversed, MeshIndexType point, MeshIndexType neighbor) const
+  {
+    // The face is labeled and wound from the side of the larger Feature Id
+    if(m_FeatureIds[point] < m_FeatureIds[neighbor])
+    {
+      meshFace(state, emit, face, i, j, k, !reversed, m_FeatureIds[point], m_FeatureIds[neighbor], neighbor, point, false);
+    }
+    else
+    {
+      meshFace(state, emit, face, i, j, k, reversed, m_FeatureIds[neighbor], m_FeatureIds[point], neighbor, point, false);
+    }
+  }
+
+  void meshFace(LayerState& state, bool emit, const VoxelFace& face, MeshIndexType i, MeshIndexType j, MeshIndexType k, bool reversed, int32_t label0, int32_t label1, MeshIndexType firstCell,
+                MeshIndexType secondCell, bool exterior) const
+  {
+    std::array<MeshIndexType, 4> nodes = {{0, 0, 0, 0}};
+    for(size_t c = 0; c < 4; c++)
+    {
+      const std::array<MeshIndexType, 3>& corner = face[c];
+      std::vector<MeshIndexType>& plane = corner[2] == 0 ? state.lowerNodes : state.upperNodes;
+      size_t index = (j + corner[1]) * (m_XPoints + 1) + (i + corner[0]);
+      if(plane[index] == k_UnassignedNode)
+      {
+        plane[index] = state.nextNode++;
+        if(emit)
+        {
+          float coords[3] = {0.0f, 0.0f, 0.0f};
+          m_Grid->getPlaneCoords(i + corner[0], j + corner[1], k + corner[2], coords);
+          float* vertex = m_Vertex + plane[index] * 3;
+          vertex[0] = coords[0];
+          vertex[1] = coords[1];
+          vertex[2] = coords[2];
+        }
+      }
+      nodes[c] = plane[index];
+      if(emit)
+      {
+        QuickSurfaceMeshNodeOwners& owners = corner[2] == 0 ? state.lowerOwners[index] : state.upperOwners[index];
+        owners.insert(label0);
+        owners.insert(label1);
+      }
+    }
+
+    if(emit)
+    {
+      MeshIndexType* triangle = m_Triangle + state.nextTriangle * 3;
+      triangle[0] = nodes[0];
+      triangle[1] = reversed ? nodes[2] : nodes[1];
+      triangle[2] = reversed ? nodes[1] : nodes[2];
+      triangle[3] = nodes[1];
+      triangle[4] = reversed ? nodes[2] : nodes[3];
+      triangle[5] = reversed ? nodes[3] : nodes[2];
+      for(MeshIndexType t = state.nextTriangle; t < state.nextTriangle + 2; t++)
+      {
+        m_FaceLabels[t * 2] = label0;
+        m_FaceLabels[t * 2 + 1] = label1;
+        for(size_t a = 0; a < m_SelectedArrays.size(); a++)
+        {
+          EXECUTE_FUNCTION_TEMPLATE(m_Filter, copyCellArraysToFaceArrays, m_SelectedArrays[a], t, firstCell, secondCell, m_SelectedArrays[a], m_CreatedArrays[a], exterior)
+        }
+      }
+    }
+    state.nextTriangle += 2;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -622,7 +993,7 @@ void QuickSurfaceMesh::correctProblemVoxels()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
+void QuickSurfaceMesh::determineActiveNodes(std::vector<QuickSurfaceMeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount)
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
@@ -630,299 +1001,42 @@ void QuickSurfaceMesh::determineActiveNodes(std::vector<MeshIndexType>& nodeIds,
 
   SizeVec3Type udims = grid->getDimensions();
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
   MeshIndexType zP = udims[2];
 
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
+  // Split the volume into z slabs of voxel layers. Each slab only keeps the two node planes of its current layer
+  MeshIndexType slabCount = std::max<MeshIndexType>(1, 2 * static_cast<MeshIndexType>(std::thread::hardware_concurrency()));
+  MeshIndexType slabThickness = std::max<MeshIndexType>(1, (zP + slabCount - 1) / slabCount);
+  slabCount = (zP + slabThickness - 1) / slabThickness;
+  slabs.resize(slabCount);
+  for(MeshIndexType s = 0; s < slabCount; s++)
+  {
+    slabs[s].zStart = s * slabThickness;
+    slabs[s].zEnd = std::min(slabs[s].zStart + slabThickness, zP);
+  }
 
   // first determining which nodes are actually boundary nodes and
   // count number of nodes and triangles that will be created
-  for(MeshIndexType k = 0; k < zP; k++)
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabCount);
+  dataAlg.setGrain(1);
+  dataAlg.execute(QuickSurfaceMeshSlabImpl(this, udims, m_FeatureIds, slabs));
+
+  // Node and triangle ids are numbered in sweep order, so each slab starts where the previous one ends
+  nodeCount = 0;
+  triangleCount = 0;
+  for(auto& slab : slabs)
   {
-    for(MeshIndexType j = 0; j < yP; j++)
-    {
-      for(MeshIndexType i = 0; i < xP; i++)
-      {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1;
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(i == (xP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(j == (yP - 1))
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        if(k == (zP - 1))
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-        else if(k < zP - 1 && m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId1] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId1] = nodeCount;
-            nodeCount++;
-          }
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          if(nodeIds[nodeId2] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId2] = nodeCount;
-            nodeCount++;
-          }
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          if(nodeIds[nodeId3] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId3] = nodeCount;
-            nodeCount++;
-          }
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          if(nodeIds[nodeId4] == std::numeric_limits<size_t>::max())
-          {
-            nodeIds[nodeId4] = nodeCount;
-            nodeCount++;
-          }
-          triangleCount++;
-          triangleCount++;
-        }
-      }
-    }
+    slab.nodeOffset = nodeCount;
+    slab.triangleOffset = triangleCount;
+    nodeCount += slab.nodeCount;
+    triangleCount += slab.triangleCount;
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount)
+void QuickSurfaceMesh::createNodesAndTriangles(std::vector<QuickSurfaceMeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount)
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
@@ -945,18 +1059,6 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
 
   SizeVec3Type udims = grid->getDimensions();
 
-  MeshIndexType xP = udims[0];
-  MeshIndexType yP = udims[1];
-  MeshIndexType zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  MeshIndexType point = 0, neigh1 = 0, neigh2 = 0, neigh3 = 0;
-
-  MeshIndexType nodeId1 = 0, nodeId2 = 0, nodeId3 = 0, nodeId4 = 0;
-
-  MeshIndexType cIndex1 = 0, cIndex2 = 0;
-
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
   float* vertex = triangleGeom->getVertexPointer(0);
@@ -970,562 +1072,36 @@ void QuickSurfaceMesh::createNodesAndTriangles(std::vector<MeshIndexType> m_Node
   updateVertexInstancePointers();
   updateFaceInstancePointers();
 
-  ownerLists.resize(nodeCount);
+  std::vector<IDataArray::Pointer> selectedArrays;
+  std::vector<IDataArray::Pointer> createdArrays;
+  for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
+  {
+    selectedArrays.push_back(m_SelectedWeakPtrVector[i].lock());
+    createdArrays.push_back(m_CreatedWeakPtrVector[i].lock());
+  }
 
   // Cycle through again assigning coordinates to each node and assigning node numbers and feature labels to each triangle
-  MeshIndexType triangleIndex = 0;
-  for(MeshIndexType k = 0; k < zP; k++)
+  QuickSurfaceMeshSlabImpl impl(this, udims, m_FeatureIds, slabs);
+  impl.setOutputs(grid, vertex, triangle, m_FaceLabels, m_NodeTypes, selectedArrays, createdArrays);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, slabs.size());
+  dataAlg.setGrain(1);
+  dataAlg.execute(impl);
+
+  // Stitch the node planes shared by neighboring slabs
+  for(size_t s = 1; s < slabs.size(); s++)
   {
-    for(MeshIndexType j = 0; j < yP; j++)
+    const QuickSurfaceMeshSlab& previous = slabs[s - 1];
+    for(size_t n = 0; n < previous.topPlaneNodes.size(); n++)
     {
-      for(MeshIndexType i = 0; i < xP; i++)
+      if(previous.topPlaneNodes[n] != k_UnassignedNode)
       {
-        point = (k * xP * yP) + (j * xP) + i;
-        neigh1 = point + 1; // <== What happens if we are at the end of a row?
-        neigh2 = point + xP;
-        neigh3 = point + (xP * yP);
-
-        if(i == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(j == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(k == 0)
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        if(i == (xP - 1)) // Takes care of the end of a Row...
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh1])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh1;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
-            cIndex1 = point;
-            cIndex2 = neigh1;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh1];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh1;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh1])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh1];
-            cIndex1 = point;
-            cIndex2 = neigh1;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh1, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh1]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh1]);
-        }
-        if(j == (yP - 1)) // Takes care of the end of a column
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh2])
-        {
-          nodeId1 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = (k * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh2;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
-            cIndex1 = point;
-            cIndex2 = neigh2;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh2];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh2;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh2])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh2];
-            cIndex1 = point;
-            cIndex2 = neigh2;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh2, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh2]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh2]);
-        }
-        if(k == (zP - 1)) // Takes care of the end of a Pillar
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-          m_FaceLabels[triangleIndex * 2] = -1;
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, point, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock(), true)
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(-1);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(-1);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(-1);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(-1);
-        }
-        else if(m_FeatureIds[point] != m_FeatureIds[neigh3])
-        {
-          nodeId1 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j, k + 1, vertex + (m_NodeIds[nodeId1] * 3));
-
-          nodeId2 = ((k + 1) * (xP + 1) * (yP + 1)) + (j * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j, k + 1, vertex + (m_NodeIds[nodeId2] * 3));
-
-          nodeId3 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + (i + 1);
-          getGridCoordinates(grid, i + 1, j + 1, k + 1, vertex + (m_NodeIds[nodeId3] * 3));
-
-          nodeId4 = ((k + 1) * (xP + 1) * (yP + 1)) + ((j + 1) * (xP + 1)) + i;
-          getGridCoordinates(grid, i, j + 1, k + 1, vertex + (m_NodeIds[nodeId4] * 3));
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId1];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh3;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId2];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
-            cIndex1 = point;
-            cIndex2 = neigh3;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          triangle[triangleIndex * 3 + 0] = m_NodeIds[nodeId2];
-          triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId4];
-          triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId3];
-          m_FaceLabels[triangleIndex * 2] = m_FeatureIds[neigh3];
-          m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[point];
-          cIndex1 = neigh3;
-          cIndex2 = point;
-          if(m_FeatureIds[point] < m_FeatureIds[neigh3])
-          {
-            triangle[triangleIndex * 3 + 1] = m_NodeIds[nodeId3];
-            triangle[triangleIndex * 3 + 2] = m_NodeIds[nodeId4];
-            m_FaceLabels[triangleIndex * 2] = m_FeatureIds[point];
-            m_FaceLabels[triangleIndex * 2 + 1] = m_FeatureIds[neigh3];
-            cIndex1 = point;
-            cIndex2 = neigh3;
-          }
-
-          for(size_t i = 0; i < m_SelectedWeakPtrVector.size(); i++)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(this, copyCellArraysToFaceArrays, m_SelectedWeakPtrVector[i].lock(), triangleIndex, neigh3, point, m_SelectedWeakPtrVector[i].lock(),
-                                      m_CreatedWeakPtrVector[i].lock())
-          }
-
-          triangleIndex++;
-
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId1]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId2]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId3]].insert(m_FeatureIds[neigh3]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[point]);
-          ownerLists[m_NodeIds[nodeId4]].insert(m_FeatureIds[neigh3]);
-        }
+        QuickSurfaceMeshNodeOwners owners = previous.topPlaneOwners[n];
+        owners.merge(slabs[s].bottomPlaneOwners[n]);
+        m_NodeTypes[previous.nodeOffset + previous.topPlaneNodes[n]] = owners.nodeType();
       }
     }
   }
-
-  for(size_t i = 0; i < nodeCount; i++)
-  {
-    m_NodeTypes[i] = static_cast<int8_t>(ownerLists[i].size());
-    if(m_NodeTypes[i] > 4)
-    {
-      m_NodeTypes[i] = 4;
-    }
-    if(ownerLists[i].find(-1) != ownerLists[i].end())
-    {
-      m_NodeTypes[i] += 10;
-    }
-  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1556,32 +1132,21 @@ void QuickSurfaceMesh::execute()
   {
     return;
   }
-  IGeometryGrid::Pointer grid = m->getGeometryAs<IGeometryGrid>();
-
-  SizeVec3Type udims = grid->getDimensions();
-
-  size_t xP = udims[0];
-  size_t yP = udims[1];
-  size_t zP = udims[2];
-
-  std::vector<std::set<int32_t>> ownerLists;
-
-  size_t possibleNumNodes = (xP + 1) * (yP + 1) * (zP + 1);
-  std::vector<size_t> m_NodeIds(possibleNumNodes, std::numeric_limits<size_t>::max());
+  std::vector<QuickSurfaceMeshSlab> slabs;
 
   size_t nodeCount = 0;
   size_t triangleCount = 0;
 
   correctProblemVoxels();
 
-  determineActiveNodes(m_NodeIds, nodeCount, triangleCount);
+  determineActiveNodes(slabs, nodeCount, triangleCount);
 
   // now create node and triangle arrays knowing the number that will be needed
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triangleCount);
   triangleGeom->resizeVertexList(nodeCount);
 
-  createNodesAndTriangles(m_NodeIds, nodeCount, triangleCount);
+  createNodesAndTriangles(slabs, nodeCount, triangleCount);
 
   MeshIndexType* triangle = triangleGeom->getTriPointer(0);
 
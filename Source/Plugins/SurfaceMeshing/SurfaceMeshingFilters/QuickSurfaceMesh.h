@@ -44,6 +44,8 @@
 
 #include "SurfaceMeshing/SurfaceMeshingDLLExport.h"
 
+struct QuickSurfaceMeshSlab;
+
 /**
  * @brief The QuickSurfaceMesh class. See [Filter documentation](@ref quicksurfacemesh) for details.
  */
@@ -329,9 +331,21 @@ private:
 
   void correctProblemVoxels();
 
-  void determineActiveNodes(std::vector<MeshIndexType>& m_NodeIds, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
+  /**
+   * @brief determineActiveNodes Splits the volume into z slabs and counts the nodes and triangles each slab creates
+   * @param slabs Slabs of the volume with their node and triangle offsets
+   * @param nodeCount Total number of nodes
+   * @param triangleCount Total number of triangles
+   */
+  void determineActiveNodes(std::vector<QuickSurfaceMeshSlab>& slabs, MeshIndexType& nodeCount, MeshIndexType& triangleCount);
 
-  void createNodesAndTriangles(std::vector<MeshIndexType> m_NodeIds, MeshIndexType nodeCount, MeshIndexType triangleCount);
+  /**
+   * @brief createNodesAndTriangles Writes the nodes, triangles and node types of each slab in parallel
+   * @param slabs Slabs computed by determineActiveNodes
+   * @param nodeCount Total number of nodes
+   * @param triangleCount Total number of triangles
+   */
+  void createNodesAndTriangles(std::vector<QuickSurfaceMeshSlab>& slabs, MeshIndexType nodeCount, MeshIndexType triangleCount);
 
   /**
    * @brief updateFaceInstancePointers Updates raw Face pointers
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SharedFeatureFaceFilter.h"
 
+#include <algorithm>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -46,6 +48,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FaceLabelIndex.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -191,52 +194,12 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct
-  {
-    int g;
-    int r;
-  } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-
-  std::vector<std::pair<int32_t, int32_t>> faceLabelMap;
-  faceLabelMap.push_back(std::pair<int32_t, int32_t>(0, 0));
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for(int64_t t = 0; t < totalPoints; ++t)
-  {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if(fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if(iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back(std::pair<int32_t, int32_t>(faceId.g, faceId.r));
-      ++index;
-    }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
-  }
+  // Number the unique (min, max) label pairs in the order they first appear and group the triangles of each one
+  FaceLabelIndex faceIndex;
+  faceIndex.build(m_SurfaceMeshFaceLabels, totalPoints);
+  int32_t index = faceIndex.getNumberOfFaceIds();
+  const std::vector<int32_t>& triangleFaceIds = faceIndex.getFaceIds();
+  std::copy(triangleFaceIds.begin(), triangleFaceIds.end(), m_SurfaceMeshFeatureFaceIds);
 
   // resize + update pointers
   std::vector<size_t> tDims(1, index);
@@ -247,13 +210,19 @@ void SharedFeatureFaceFilter::execute()
   for(int32_t i = 0; i < index; i++)
   {
     // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
+    const int32_t* labels = faceIndex.getFaceLabels(i);
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = labels[0];
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = labels[1];
 
     // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
+    m_SurfaceMeshFeatureFaceNumTriangles[i] = static_cast<int32_t>(faceIndex.getNumberOfTriangles(i));
+  }
+
+  // Face 0 reports the size of a real (0, 0) face if the mesh has one
+  int32_t zeroFaceId = faceIndex.findFaceId(0, 0);
+  if(zeroFaceId > 0)
+  {
+    m_SurfaceMeshFeatureFaceNumTriangles[0] = m_SurfaceMeshFeatureFaceNumTriangles[zeroFaceId];
   }
 }
 
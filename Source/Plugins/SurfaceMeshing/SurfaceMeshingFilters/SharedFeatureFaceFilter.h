@@ -93,9 +93,6 @@ public:
 
   ~SharedFeatureFaceFilter() override;
 
-  typedef QVector<int32_t> FaceIds_t;
-  typedef QMap<int32_t, FaceIds_t> SharedFeatureFaces_t;
-
   /**
    * @brief Setter property for FaceFeatureAttributeMatrixName
    */
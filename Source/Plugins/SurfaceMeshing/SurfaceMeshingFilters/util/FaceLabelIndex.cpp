@@ -0,0 +1,246 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FaceLabelIndex.h"
+
+#include <utility>
+
+namespace
+{
+/**
+ * @brief PackLabels Packs an unordered label pair into one 64 bit key, smallest label in the high word
+ */
+inline uint64_t PackLabels(int32_t label0, int32_t label1)
+{
+  if(label1 < label0)
+  {
+    std::swap(label0, label1);
+  }
+  return (static_cast<uint64_t>(static_cast<uint32_t>(label0)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(label1));
+}
+
+/**
+ * @brief HashKey Fibonacci hashing of a packed label pair
+ */
+inline size_t HashKey(uint64_t key)
+{
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 20);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FaceLabelIndex::FaceLabelIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FaceLabelIndex::~FaceLabelIndex() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FaceLabelIndex::findSlot(uint64_t key) const
+{
+  size_t slot = HashKey(key) & m_TableMask;
+  while(m_TableIds[slot] != 0 && m_TableKeys[slot] != key)
+  {
+    slot = (slot + 1) & m_TableMask;
+  }
+  return slot;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FaceLabelIndex::growTable()
+{
+  size_t capacity = (m_TableMask + 1) * 2;
+  m_TableKeys.assign(capacity, 0);
+  m_TableIds.assign(capacity, 0);
+  m_TableMask = capacity - 1;
+
+  int32_t numFaceIds = getNumberOfFaceIds();
+  for(int32_t faceId = 1; faceId < numFaceIds; faceId++)
+  {
+    uint64_t key = PackLabels(m_FaceLabels[2 * faceId], m_FaceLabels[2 * faceId + 1]);
+    size_t slot = findSlot(key);
+    m_TableKeys[slot] = key;
+    m_TableIds[slot] = faceId;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FaceLabelIndex::build(const int32_t* faceLabels, MeshIndexType numTriangles)
+{
+  // Start from roughly one face per 8 triangles and let the table grow past a load factor of 1/2
+  size_t capacity = 64;
+  while(capacity < numTriangles / 4)
+  {
+    capacity *= 2;
+  }
+  m_TableKeys.assign(capacity, 0);
+  m_TableIds.assign(capacity, 0);
+  m_TableMask = capacity - 1;
+
+  m_TriangleFaceIds.resize(numTriangles);
+  m_FaceLabels.assign(2, 0);
+  m_FaceLabels.reserve(capacity);
+
+  int32_t nextFaceId = 1;
+  for(MeshIndexType t = 0; t < numTriangles; t++)
+  {
+    uint64_t key = PackLabels(faceLabels[2 * t], faceLabels[2 * t + 1]);
+    size_t slot = findSlot(key);
+    if(m_TableIds[slot] == 0)
+    {
+      m_TableKeys[slot] = key;
+      m_TableIds[slot] = nextFaceId;
+      m_FaceLabels.push_back(static_cast<int32_t>(key >> 32));
+      m_FaceLabels.push_back(static_cast<int32_t>(key & 0xFFFFFFFFULL));
+      nextFaceId++;
+      if(static_cast<size_t>(nextFaceId) * 2 > m_TableMask + 1)
+      {
+        growTable();
+        slot = findSlot(key);
+      }
+    }
+    m_TriangleFaceIds[t] = m_TableIds[slot];
+  }
+
+  GroupByKey(m_TriangleFaceIds.data(), numTriangles, 1, nextFaceId, m_Offsets, m_Triangles);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FaceLabelIndex::GroupByKey(const int32_t* keys, MeshIndexType numItems, int32_t keysPerItem, int32_t numKeys, std::vector<MeshIndexType>& offsets, std::vector<MeshIndexType>& items)
+{
+  offsets.assign(static_cast<size_t>(numKeys) + 1, 0);
+  for(MeshIndexType i = 0; i < numItems; i++)
+  {
+    for(int32_t k = 0; k < keysPerItem; k++)
+    {
+      int32_t key = keys[i * keysPerItem + k];
+      // An item carrying the same key twice is only listed once
+      if(key >= 0 && key < numKeys && (k == 0 || key != keys[i * keysPerItem + k - 1]))
+      {
+        offsets[key + 1]++;
+      }
+    }
+  }
+  for(int32_t key = 0; key < numKeys; key++)
+  {
+    offsets[key + 1] += offsets[key];
+  }
+
+  items.resize(offsets[numKeys]);
+  std::vector<MeshIndexType> cursor(offsets.begin(), offsets.end() - 1);
+  for(MeshIndexType i = 0; i < numItems; i++)
+  {
+    for(int32_t k = 0; k < keysPerItem; k++)
+    {
+      int32_t key = keys[i * keysPerItem + k];
+      if(key >= 0 && key < numKeys && (k == 0 || key != keys[i * keysPerItem + k - 1]))
+      {
+        items[cursor[key]++] = i;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FaceLabelIndex::getNumberOfFaceIds() const
+{
+  return static_cast<int32_t>(m_FaceLabels.size() / 2);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FaceLabelIndex::getFaceId(MeshIndexType triangle) const
+{
+  return m_TriangleFaceIds[triangle];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int32_t>& FaceLabelIndex::getFaceIds() const
+{
+  return m_TriangleFaceIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FaceLabelIndex::findFaceId(int32_t label0, int32_t label1) const
+{
+  if(m_TableIds.empty())
+  {
+    return -1;
+  }
+  size_t slot = findSlot(PackLabels(label0, label1));
+  return m_TableIds[slot] == 0 ? -1 : m_TableIds[slot];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int32_t* FaceLabelIndex::getFaceLabels(int32_t faceId) const
+{
+  return m_FaceLabels.data() + 2 * faceId;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MeshIndexType FaceLabelIndex::getNumberOfTriangles(int32_t faceId) const
+{
+  return m_Offsets[faceId + 1] - m_Offsets[faceId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const MeshIndexType* FaceLabelIndex::getTriangles(int32_t faceId) const
+{
+  return m_Triangles.data() + m_Offsets[faceId];
+}
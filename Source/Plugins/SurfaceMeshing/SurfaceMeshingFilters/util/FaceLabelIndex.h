@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/IGeometry.h"
+
+/**
+ * @brief The FaceLabelIndex class groups the triangles of a surface mesh by their unordered pair of face labels.
+ * Each distinct pair gets a face id, numbered from 1 in the order the pairs first appear in the triangle list; id 0
+ * is reserved and holds the pair (0, 0) with no triangles. The pairs are found with a flat open addressing hash
+ * table and the triangles of each face are stored contiguously, in ascending order, in a CSR layout.
+ */
+class FaceLabelIndex
+{
+public:
+  FaceLabelIndex();
+
+  virtual ~FaceLabelIndex();
+
+  /**
+   * @brief build Assigns a face id to every triangle and groups the triangles by face id
+   * @param faceLabels Face labels, 2 per triangle
+   * @param numTriangles Number of triangles
+   */
+  void build(const int32_t* faceLabels, MeshIndexType numTriangles);
+
+  /**
+   * @brief getNumberOfFaceIds Returns the number of face ids, including the reserved id 0
+   * @return
+   */
+  int32_t getNumberOfFaceIds() const;
+
+  /**
+   * @brief getFaceId Returns the face id of a triangle
+   * @param triangle Triangle index
+   * @return
+   */
+  int32_t getFaceId(MeshIndexType triangle) const;
+
+  /**
+   * @brief getFaceIds Returns the face id of every triangle
+   * @return
+   */
+  const std::vector<int32_t>& getFaceIds() const;
+
+  /**
+   * @brief findFaceId Looks up the face id of a label pair, in either order
+   * @param label0 First label
+   * @param label1 Second label
+   * @return The face id, or -1 if no triangle carries the pair
+   */
+  int32_t findFaceId(int32_t label0, int32_t label1) const;
+
+  /**
+   * @brief getFaceLabels Returns the label pair of a face id, smallest label first
+   * @param faceId Face id
+   * @return Pointer to the 2 labels
+   */
+  const int32_t* getFaceLabels(int32_t faceId) const;
+
+  /**
+   * @brief getNumberOfTriangles Returns the number of triangles on a face
+   * @param faceId Face id
+   * @return
+   */
+  MeshIndexType getNumberOfTriangles(int32_t faceId) const;
+
+  /**
+   * @brief getTriangles Returns the triangles on a face; there are getNumberOfTriangles(faceId) of them
+   * @param faceId Face id
+   * @return
+   */
+  const MeshIndexType* getTriangles(int32_t faceId) const;
+
+  /**
+   * @brief GroupByKey Counting sort of items by integer keys into a CSR layout. Each item carries keysPerItem keys
+   * and is listed under each of them, once if the same key repeats back to back; keys outside [0, numKeys) are skipped. Items appear in ascending order
+   * within every key.
+   * @param keys Keys, keysPerItem per item
+   * @param numItems Number of items
+   * @param keysPerItem Number of keys carried by each item
+   * @param numKeys Number of keys
+   * @param offsets Output offsets; the items of key k are at [offsets[k], offsets[k + 1])
+   * @param items Output item list
+   */
+  static void GroupByKey(const int32_t* keys, MeshIndexType numItems, int32_t keysPerItem, int32_t numKeys, std::vector<MeshIndexType>& offsets, std::vector<MeshIndexType>& items);
+
+protected:
+  /**
+   * @brief findSlot Returns the hash table slot holding a key, or the empty slot where it belongs
+   * @param key Packed label pair
+   * @return
+   */
+  size_t findSlot(uint64_t key) const;
+
+  /**
+   * @brief growTable Doubles the hash table capacity and reinserts the face ids
+   */
+  void growTable();
+
+private:
+  std::vector<int32_t> m_TriangleFaceIds;
+  std::vector<int32_t> m_FaceLabels;
+  std::vector<MeshIndexType> m_Offsets;
+  std::vector<MeshIndexType> m_Triangles;
+  std::vector<uint64_t> m_TableKeys;
+  std::vector<int32_t> m_TableIds;
+  size_t m_TableMask = 0;
+
+public:
+  FaceLabelIndex(const FaceLabelIndex&) = delete;            // Copy Constructor Not Implemented
+  FaceLabelIndex(FaceLabelIndex&&) = delete;                 // Move Constructor Not Implemented
+  FaceLabelIndex& operator=(const FaceLabelIndex&) = delete; // Copy Assignment Not Implemented
+  FaceLabelIndex& operator=(FaceLabelIndex&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,191 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "VertexSmoothingEngine.h"
+
+#include <cstring>
+#include <utility>
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief The SmoothingPassImpl class moves a range of vertices towards the average of their neighbors. Every vertex
+ * only reads the source coordinates and writes its own destination coordinates, so ranges are independent.
+ */
+class SmoothingPassImpl
+{
+public:
+  SmoothingPassImpl(const MeshIndexType* offsets, const MeshIndexType* neighbors, const float* source, float* destination, const float* lambdas, float scale)
+  : m_Offsets(offsets)
+  , m_Neighbors(neighbors)
+  , m_Source(source)
+  , m_Destination(destination)
+  , m_Lambdas(lambdas)
+  , m_Scale(scale)
+  {
+  }
+
+  virtual ~SmoothingPassImpl() = default;
+
+  void smooth(size_t start, size_t end) const
+  {
+    for(size_t v = start; v < end; v++)
+    {
+      const float* position = m_Source + 3 * v;
+      float* target = m_Destination + 3 * v;
+      const MeshIndexType first = m_Offsets[v];
+      const MeshIndexType last = m_Offsets[v + 1];
+      float delta[3] = {0.0f, 0.0f, 0.0f};
+      for(MeshIndexType n = first; n < last; n++)
+      {
+        const float* neighbor = m_Source + 3 * m_Neighbors[n];
+        delta[0] += neighbor[0] - position[0];
+        delta[1] += neighbor[1] - position[1];
+        delta[2] += neighbor[2] - position[2];
+      }
+      // Vertices without neighbors stay where they are
+      const float factor = (last > first) ? m_Lambdas[v] * m_Scale / static_cast<float>(last - first) : 0.0f;
+      target[0] = position[0] + factor * delta[0];
+      target[1] = position[1] + factor * delta[1];
+      target[2] = position[2] + factor * delta[2];
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    smooth(range.min(), range.max());
+  }
+
+private:
+  const MeshIndexType* m_Offsets = nullptr;
+  const MeshIndexType* m_Neighbors = nullptr;
+  const float* m_Source = nullptr;
+  float* m_Destination = nullptr;
+  const float* m_Lambdas = nullptr;
+  float m_Scale = 1.0f;
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VertexSmoothingEngine::VertexSmoothingEngine(MeshIndexType numVertices, const MeshIndexType* edges, MeshIndexType numEdges)
+: m_NumVertices(numVertices)
+{
+  // Count the neighbors of every vertex, then fill the CSR lists in edge order
+  m_NeighborOffsets.assign(numVertices + 1, 0);
+  for(MeshIndexType e = 0; e < numEdges; e++)
+  {
+    m_NeighborOffsets[edges[2 * e] + 1]++;
+    m_NeighborOffsets[edges[2 * e + 1] + 1]++;
+  }
+  for(MeshIndexType v = 0; v < numVertices; v++)
+  {
+    m_NeighborOffsets[v + 1] += m_NeighborOffsets[v];
+  }
+  m_Neighbors.resize(m_NeighborOffsets[numVertices]);
+  std::vector<MeshIndexType> fill(m_NeighborOffsets.begin(), m_NeighborOffsets.end() - 1);
+  for(MeshIndexType e = 0; e < numEdges; e++)
+  {
+    MeshIndexType v0 = edges[2 * e];
+    MeshIndexType v1 = edges[2 * e + 1];
+    m_Neighbors[fill[v0]++] = v1;
+    m_Neighbors[fill[v1]++] = v0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VertexSmoothingEngine::~VertexSmoothingEngine() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VertexSmoothingEngine::smoothingPass(const float* source, float* destination, const float* lambdas, float scale) const
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, m_NumVertices);
+  dataAlg.execute(SmoothingPassImpl(m_NeighborOffsets.data(), m_Neighbors.data(), source, destination, lambdas, scale));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t VertexSmoothingEngine::execute(float* vertices, const float* lambdas, int32_t iterations, bool useTaubin, float muFactor, AbstractFilter* filter)
+{
+  // Passes alternate between the vertex array and the buffer
+  std::vector<float> buffer(3 * m_NumVertices);
+  float* current = vertices;
+  float* next = buffer.data();
+
+  int32_t err = 0;
+  for(int32_t q = 0; q < iterations; q++)
+  {
+    if(nullptr != filter)
+    {
+      if(filter->getCancel())
+      {
+        err = -1;
+        break;
+      }
+      QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(iterations);
+      filter->notifyStatusMessage(ss);
+    }
+    smoothingPass(current, next, lambdas, 1.0f);
+    std::swap(current, next);
+
+    // Now optionally apply a negative lambda based on the mu Factor value.
+    // This is from Taubin's paper on smoothing without shrinkage. This effectively
+    // runs a low pass filter on the data
+    if(useTaubin)
+    {
+      smoothingPass(current, next, lambdas, muFactor);
+      std::swap(current, next);
+    }
+  }
+
+  if(current != vertices)
+  {
+    ::memcpy(vertices, current, sizeof(float) * 3 * m_NumVertices);
+  }
+  return err;
+}
@@ -0,0 +1,98 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/IGeometry.h"
+
+#include "SurfaceMeshing/SurfaceMeshingDLLExport.h"
+
+class AbstractFilter;
+
+/**
+ * @brief The VertexSmoothingEngine class runs Laplacian and Taubin smoothing on the vertices of a mesh. The vertex
+ * neighbors are gathered into a CSR adjacency once, from the unique edge list. Each smoothing pass then updates
+ * all vertices in parallel from the coordinates of the previous pass, using a second coordinate buffer.
+ */
+class SurfaceMeshing_EXPORT VertexSmoothingEngine
+{
+public:
+  /**
+   * @brief VertexSmoothingEngine Builds the vertex adjacency
+   * @param numVertices Number of vertices in the mesh
+   * @param edges Unique edge list, 2 vertex ids per edge
+   * @param numEdges Number of edges
+   */
+  VertexSmoothingEngine(MeshIndexType numVertices, const MeshIndexType* edges, MeshIndexType numEdges);
+
+  virtual ~VertexSmoothingEngine();
+
+  /**
+   * @brief execute Smooths the vertices in place. Each iteration moves every vertex by its lambda times the average
+   * offset to its neighbors; Taubin smoothing follows with a second pass scaled by the mu factor.
+   * @param vertices Vertex coordinates, 3 per vertex
+   * @param lambdas Per vertex smoothing factor
+   * @param iterations Number of iterations
+   * @param useTaubin Whether to run the Taubin mu pass after each Laplacian pass
+   * @param muFactor Factor applied to the lambdas for the mu pass
+   * @param filter Filter used for progress messages and cancel requests; may be nullptr
+   * @return 0 on success, -1 if the filter was canceled
+   */
+  int32_t execute(float* vertices, const float* lambdas, int32_t iterations, bool useTaubin, float muFactor, AbstractFilter* filter);
+
+protected:
+  /**
+   * @brief smoothingPass Computes one Jacobi update of all vertices from source into destination
+   * @param source Coordinates read by the pass
+   * @param destination Coordinates written by the pass
+   * @param lambdas Per vertex smoothing factor
+   * @param scale Factor applied to every lambda
+   */
+  void smoothingPass(const float* source, float* destination, const float* lambdas, float scale) const;
+
+private:
+  MeshIndexType m_NumVertices = 0;
+  std::vector<MeshIndexType> m_NeighborOffsets;
+  std::vector<MeshIndexType> m_Neighbors;
+
+public:
+  VertexSmoothingEngine(const VertexSmoothingEngine&) = delete;            // Copy Constructor Not Implemented
+  VertexSmoothingEngine(VertexSmoothingEngine&&) = delete;                 // Move Constructor Not Implemented
+  VertexSmoothingEngine& operator=(const VertexSmoothingEngine&) = delete; // Copy Assignment Not Implemented
+  VertexSmoothingEngine& operator=(VertexSmoothingEngine&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/VertexSmoothingEngine.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class VertexSmoothingEngineTest
+{
+
+public:
+  VertexSmoothingEngineTest() = default;
+  virtual ~VertexSmoothingEngineTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // A jittered grid of triangles with the unique edges of every cell, followed by one vertex that is on no edge
+  // -----------------------------------------------------------------------------
+  void CreateMesh(std::vector<float>& vertices, std::vector<MeshIndexType>& edges, std::vector<float>& lambdas)
+  {
+    const MeshIndexType xPoints = 12;
+    const MeshIndexType yPoints = 10;
+    std::mt19937_64 generator(5489);
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+
+    vertices.clear();
+    for(MeshIndexType y = 0; y < yPoints; y++)
+    {
+      for(MeshIndexType x = 0; x < xPoints; x++)
+      {
+        vertices.push_back(static_cast<float>(x + 0.3 * (distribution(generator) - 0.5)));
+        vertices.push_back(static_cast<float>(y + 0.3 * (distribution(generator) - 0.5)));
+        vertices.push_back(static_cast<float>(2.0 * (distribution(generator) - 0.5)));
+      }
+    }
+    vertices.push_back(50.0f);
+    vertices.push_back(50.0f);
+    vertices.push_back(50.0f);
+
+    edges.clear();
+    for(MeshIndexType y = 0; y < yPoints; y++)
+    {
+      for(MeshIndexType x = 0; x < xPoints; x++)
+      {
+        MeshIndexType v = y * xPoints + x;
+        if(x + 1 < xPoints)
+        {
+          edges.push_back(v);
+          edges.push_back(v + 1);
+        }
+        if(y + 1 < yPoints)
+        {
+          edges.push_back(v);
+          edges.push_back(v + xPoints);
+        }
+        if(x + 1 < xPoints && y + 1 < yPoints)
+        {
+          edges.push_back(v);
+          edges.push_back(v + xPoints + 1);
+        }
+      }
+    }
+
+    MeshIndexType numVertices = vertices.size() / 3;
+    lambdas.resize(numVertices);
+    for(float& lambda : lambdas)
+    {
+      lambda = static_cast<float>(0.1 + 0.2 * distribution(generator));
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The edge by edge scatter LaplacianSmoothing used before the smoothing engine. Vertices on no edge are skipped
+  // here since the scatter divided them by zero.
+  // -----------------------------------------------------------------------------
+  void ScatterSmoothingPass(std::vector<float>& vertices, const std::vector<MeshIndexType>& edges, const std::vector<float>& lambdas, float scale)
+  {
+    MeshIndexType numVertices = vertices.size() / 3;
+    MeshIndexType numEdges = edges.size() / 2;
+    std::vector<double> delta(3 * numVertices, 0.0);
+    std::vector<int32_t> ncon(numVertices, 0);
+    for(MeshIndexType i = 0; i < numEdges; i++)
+    {
+      MeshIndexType in1 = edges[2 * i];
+      MeshIndexType in2 = edges[2 * i + 1];
+      for(MeshIndexType j = 0; j < 3; j++)
+      {
+        double dlta = static_cast<double>(vertices[3 * in2 + j] - vertices[3 * in1 + j]);
+        delta[3 * in1 + j] += dlta;
+        delta[3 * in2 + j] += -1.0 * dlta;
+      }
+      ncon[in1] += 1;
+      ncon[in2] += 1;
+    }
+    for(MeshIndexType i = 0; i < numVertices; i++)
+    {
+      if(ncon[i] == 0)
+      {
+        continue;
+      }
+      for(MeshIndexType j = 0; j < 3; j++)
+      {
+        double dlta = delta[3 * i + j] / ncon[i];
+        vertices[3 * i + j] += lambdas[i] * scale * dlta;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunAndCompare(int32_t iterations, bool useTaubin, float muFactor)
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> edges;
+    std::vector<float> lambdas;
+    CreateMesh(vertices, edges, lambdas);
+    std::vector<float> expected = vertices;
+    std::vector<float> initial = vertices;
+
+    for(int32_t q = 0; q < iterations; q++)
+    {
+      ScatterSmoothingPass(expected, edges, lambdas, 1.0f);
+      if(useTaubin)
+      {
+        ScatterSmoothingPass(expected, edges, lambdas, muFactor);
+      }
+    }
+
+    VertexSmoothingEngine engine(vertices.size() / 3, edges.data(), edges.size() / 2);
+    int32_t err = engine.execute(vertices.data(), lambdas.data(), iterations, useTaubin, muFactor, nullptr);
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+
+    bool moved = false;
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRED(std::fabs(vertices[i] - expected[i]), <=, 1.0E-4f)
+      moved = moved || vertices[i] != initial[i];
+    }
+    DREAM3D_REQUIRE(moved)
+
+    // The vertex on no edge stays where it is
+    size_t last = vertices.size() - 3;
+    DREAM3D_REQUIRE_EQUAL(vertices[last], 50.0f)
+    DREAM3D_REQUIRE_EQUAL(vertices[last + 1], 50.0f)
+    DREAM3D_REQUIRE_EQUAL(vertices[last + 2], 50.0f)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestLaplacianMatchesScatter()
+  {
+    RunAndCompare(1, false, 0.0f);
+    RunAndCompare(8, false, 0.0f);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestTaubinMatchesScatter()
+  {
+    RunAndCompare(1, true, -1.03f);
+    RunAndCompare(7, true, -1.03f);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestCancel()
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> edges;
+    std::vector<float> lambdas;
+    CreateMesh(vertices, edges, lambdas);
+    std::vector<float> initial = vertices;
+
+    AbstractFilter::Pointer filter = AbstractFilter::New();
+    filter->setCancel(true);
+    VertexSmoothingEngine engine(vertices.size() / 3, edges.data(), edges.size() / 2);
+    int32_t err = engine.execute(vertices.data(), lambdas.data(), 5, true, -1.03f, filter.get());
+    DREAM3D_REQUIRE_EQUAL(err, -1)
+    for(size_t i = 0; i < initial.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(vertices[i], initial[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestLaplacianMatchesScatter())
+    DREAM3D_REGISTER_TEST(TestTaubinMatchesScatter())
+    DREAM3D_REGISTER_TEST(TestCancel())
+  }
+
+private:
+  VertexSmoothingEngineTest(const VertexSmoothingEngineTest&); // Copy Constructor Not Implemented
+  void operator=(const VertexSmoothingEngineTest&);            // Move assignment Not Implemented
+};
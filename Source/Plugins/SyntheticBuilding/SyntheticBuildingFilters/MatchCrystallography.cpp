@@ -35,7 +35,9 @@
 
 #include "MatchCrystallography.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <QtCore/QTextStream>
 
@@ -50,6 +52,7 @@
 #include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
@@ -64,6 +67,7 @@
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 #include "SyntheticBuilding/SyntheticBuildingVersion.h"
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/MatchCrystallographyChain.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
@@ -92,12 +96,12 @@ MatchCrystallography::MatchCrystallography()
 , m_FeatureEulerAnglesArrayName(SIMPL::FeatureData::EulerAngles)
 , m_AvgQuatsArrayName(SIMPL::FeatureData::AvgQuats)
 , m_MaxIterations(1)
+, m_NumberOfChains(1)
 {
   m_NeighborList = NeighborList<int32_t>::NullPointer();
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
 
   m_ActualOdf = FloatArrayType::NullPointer();
   m_SimOdf = FloatArrayType::NullPointer();
@@ -117,6 +121,7 @@ void MatchCrystallography::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Number of Iterations (Swaps)", MaxIterations, FilterParameter::Parameter, MatchCrystallography));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number of Monte Carlo Chains", NumberOfChains, FilterParameter::Parameter, MatchCrystallography));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -194,6 +199,7 @@ void MatchCrystallography::readFilterParameters(AbstractFilterParametersReader*
 {
   reader->openFilterGroup(this, index);
   setMaxIterations(reader->readValue("MaxIterations", getMaxIterations()));
+  setNumberOfChains(reader->readValue("NumberOfChains", getNumberOfChains()));
   setInputStatsArrayPath(reader->readDataArrayPath("InputStatsArrayPath", getInputStatsArrayPath()));
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setPhaseTypesArrayPath(reader->readDataArrayPath("PhaseTypesArrayPath", getPhaseTypesArrayPath()));
@@ -219,7 +225,6 @@ void MatchCrystallography::initialize()
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  m_MdfChange = m_OdfChange = 0.0f;
   m_UnbiasedVolume.clear();
   m_TotalSurfaceArea.clear();
 
@@ -240,6 +245,12 @@ void MatchCrystallography::dataCheck()
   initialize();
   DataArrayPath tempPath;
 
+  if(getNumberOfChains() < 1)
+  {
+    QString ss = QObject::tr("The number of Monte Carlo chains must be at least 1");
+    setErrorCondition(-11000, ss);
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getFeatureIdsArrayPath().getDataContainerName());
 
   std::vector<size_t> cDims(1, 1);
@@ -633,458 +644,98 @@ int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
+void MatchCrystallography::matchCrystallography(size_t ensem)
 {
-  double curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+  std::vector<LaueOps::Pointer> laueOps = LaueOps::GetAllOrientationOps();
+  uint32_t laueIndex = m_CrystalStructures[ensem];
 
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0);
-  double mag = std::sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0)
-  {
-    rod[3] = std::numeric_limits<double>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
+  MatchCrystallographyInputs inputs;
+  inputs.filter = this;
+  inputs.neighborList = m_NeighborList.lock().get();
+  inputs.sharedSurfaceAreaList = m_SharedSurfaceAreaList.lock().get();
+  inputs.volumes = m_Volumes;
+  inputs.surfaceFeatures = m_SurfaceFeatures;
+  inputs.featurePhases = m_FeaturePhases;
+  inputs.totalFeatures = totalFeatures;
+  inputs.ensem = ensem;
+  inputs.numFeatures = m_NumFeatures[ensem];
+  inputs.unbiasedVolume = m_UnbiasedVolume[ensem];
+  inputs.totalSurfaceArea = m_TotalSurfaceArea[ensem];
+  inputs.actualOdf = m_ActualOdf->getPointer(0);
+  inputs.numOdfBins = laueOps[laueIndex]->getODFSize();
+  inputs.actualMdf = m_ActualMdf->getPointer(0);
+  inputs.numMdfBins = static_cast<int32_t>(m_ActualMdf->getSize());
+  inputs.crystalStructure = laueIndex;
+  inputs.maxIterations = m_MaxIterations;
 
-  curmisobin = ops->getMisoBin(rod);
-  QuatD qq1(q1[0], q1[1], q1[2], q1[3]);
-  QuatD qq2(q2[0], q2[1], q2[2], q2[3]);
-  OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = ops->getMisoBin(rod);
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin)) * (m_ActualMdf->getValue(curmisobin) - m_SimMdf->getValue(curmisobin))) -
-                               ((m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(curmisobin) - (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  m_MdfChange = m_MdfChange + (((m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin)) * (m_ActualMdf->getValue(newmisobin) - m_SimMdf->getValue(newmisobin))) -
-                               ((m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem]))) *
-                                (m_ActualMdf->getValue(newmisobin) - (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-}
+  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, QuatF& q1, QuatF& q2, LaueOps* ops)
-{
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
+  // The first chain works directly on the filter's arrays; every additional chain starts from its own copy of the
+  // same initial state and is seeded differently, so the chains explore independent swap/switch sequences
+  size_t numChains = static_cast<size_t>(m_NumberOfChains);
+  std::vector<MatchCrystallographyChainState> chainStates(numChains - 1);
+  std::vector<MatchCrystallographyChain> chains;
+  chains.reserve(numChains);
+  // Only a chain that runs on the filter's own thread may report its progress
+  chains.emplace_back(inputs, m_FeatureEulerAngles, m_AvgQuats, m_SimOdf->getPointer(0), m_SimMdf->getPointer(0), m_MisorientationLists, seed, numChains == 1);
+  for(size_t k = 1; k < numChains; k++)
+  {
+    MatchCrystallographyChainState& state = chainStates[k - 1];
+    state.featureEulerAngles.assign(m_FeatureEulerAngles, m_FeatureEulerAngles + totalFeatures * 3);
+    state.avgQuats.assign(m_AvgQuats, m_AvgQuats + totalFeatures * 4);
+    state.simOdf.assign(m_SimOdf->getPointer(0), m_SimOdf->getPointer(0) + m_SimOdf->getSize());
+    state.simMdf.assign(m_SimMdf->getPointer(0), m_SimMdf->getPointer(0) + m_SimMdf->getSize());
+    state.misorientationLists = m_MisorientationLists;
+    chains.emplace_back(inputs, state.featureEulerAngles.data(), state.avgQuats.data(), state.simOdf.data(), state.simMdf.data(), state.misorientationLists, seed + k, false);
+  }
 
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+  // Every chain starts from the same state, so the errors of the first one are the common reference. A distribution
+  // that already matches exactly is left unweighted so the comparison of the chains does not divide by zero.
+  double initialOdfError = chains[0].getOdfError() > 0.0 ? chains[0].getOdfError() : 1.0;
+  double initialMdfError = chains[0].getMdfError() > 0.0 ? chains[0].getMdfError() : 1.0;
 
-  OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
+  if(numChains == 1)
   {
-    rod[3] = std::numeric_limits<float>::infinity();
+    chains[0].run();
   }
   else
   {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
+    notifyStatusMessage(QObject::tr("Running %1 Monte Carlo Chains of %2 Iterations").arg(numChains).arg(m_MaxIterations));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numChains);
+    dataAlg.setGrain(1);
+    dataAlg.execute(MatchCrystallographyChainsImpl(chains));
   }
 
-  curmisobin = ops->getMisoBin(rod);
-  OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
-
-  rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
-  newmisobin = ops->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  m_SimMdf->setValue(curmisobin, (m_SimMdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  m_SimMdf->setValue(newmisobin, (m_SimMdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::matchCrystallography(size_t ensem)
-{
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
-
-  std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-  std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
-  std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-  generator.seed(seed);
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-  std::array<double, 3> randx3;
-
-  int32_t numbins = 0;
-  int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
-  size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
-  //  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
-  int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
-
-  std::vector<LaueOps::Pointer> laueOps = LaueOps::GetAllOrientationOps();
-  uint32_t laueIndex = m_CrystalStructures[ensem];
-  LaueOps::Pointer laueOp = laueOps[laueIndex];
-  numbins = laueOp->getODFSize();
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
-  while(badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
+  if(getCancel())
   {
-    uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Swapping/Switching Orientations Iteration %1/%2").arg(iterations).arg(m_MaxIterations);
-      float timeDiff = ((float)iterations / (float)(currentMillis - startMillis));
-      float estimatedTime = (float)(m_MaxIterations - iterations) / timeDiff;
-
-      ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
-      notifyStatusMessage(ss);
-
-      millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
-    }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = m_ActualOdf->getPointer(0);
-    float* simOdfPtr = m_SimOdf->getPointer(0);
-    float delta = 0.0f;
-    for(int32_t i = 0; i < numbins; i++)
-    {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
-    }
-    for(int32_t i = 0; i < (numbins); i++)
-    {
-      currentmdferror = currentmdferror + ((m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)) * (m_ActualMdf->getValue(i) - m_SimMdf->getValue(i)));
-    }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>(distribution(generator));
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    if(random < 0.5) // SwapOutOrientation
-    {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      if(counter == totalFeatures)
-      {
-        badtrycount = 10 * m_NumFeatures[ensem];
-      }
-      else
-      {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        OrientationD rod(4, 0.0);
-
-        OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-        rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-        g1odfbin = laueOp->getOdfBin(rod);
-        random = static_cast<float>(distribution(generator));
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        randx3[0] = distribution(generator);
-        randx3[1] = distribution(generator);
-        randx3[2] = distribution(generator);
-        OrientationD g1ea = laueOp->determineEulerAngles(randx3.data(), choose);
-        g1ea = laueOp->randomizeEulerAngles(g1ea);
-
-        q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(g1ea);
-
-        m_OdfChange = ((m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose)) * (m_ActualOdf->getValue(choose) - m_SimOdf->getValue(choose))) -
-                      ((m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                       (m_ActualOdf->getValue(choose) - (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))));
-        m_OdfChange = m_OdfChange + (((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-                                     ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                                      (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-        m_MdfChange = 0;
-        size_t size = 0;
-        if(!neighborlist[selectedfeature1].empty())
-        {
-          size = neighborlist[selectedfeature1].size();
-        }
-        for(size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-          q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-        }
-
-        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-        if(deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-          m_SimOdf->setValue(choose, (m_SimOdf->getValue(choose) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-          size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-          }
-        }
-      }
-      if(getCancel())
-      {
-        return;
-      }
-    }
-    else // SwitchOrientation
-    {
-      counter = 0;
-      selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      while((m_SurfaceFeatures[selectedfeature1] || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
-      {
-        if(selectedfeature1 >= totalFeatures)
-        {
-          selectedfeature1 = selectedfeature1 - totalFeatures;
-        }
-        selectedfeature1++;
-        counter++;
-      }
-      if(selectedfeature1 >= totalFeatures)
-      {
-        selectedfeature1 = selectedfeature1 - totalFeatures;
-      }
-      if(counter == totalFeatures)
-      {
-        badtrycount = 10 * m_NumFeatures[ensem];
-      }
-      else
-      {
-        counter = 0;
-        selectedfeature2 = static_cast<int32_t>(distribution(generator) * totalFeatures);
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        while((m_SurfaceFeatures[selectedfeature2] || m_FeaturePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) && counter < totalFeatures)
-        {
-          if(selectedfeature2 >= totalFeatures)
-          {
-            selectedfeature2 = selectedfeature2 - totalFeatures;
-          }
-          selectedfeature2++;
-          counter++;
-        }
-        if(selectedfeature2 >= totalFeatures)
-        {
-          selectedfeature2 = selectedfeature2 - totalFeatures;
-        }
-        if(counter == totalFeatures)
-        {
-          badtrycount = 10 * m_NumFeatures[ensem];
-        }
-        else
-        {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-          OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
-          OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-
-          g1odfbin = laueOp->getOdfBin(rod);
-          q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
-
-          eu = OrientationD(m_FeatureEulerAngles[3 * selectedfeature2], m_FeatureEulerAngles[3 * selectedfeature2 + 1], m_FeatureEulerAngles[3 * selectedfeature2 + 2]);
-          rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
-          g2odfbin = laueOp->getOdfBin(rod);
-
-          m_OdfChange =
-              ((m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin)) * (m_ActualOdf->getValue(g1odfbin) - m_SimOdf->getValue(g1odfbin))) -
-              ((m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))) *
-               (m_ActualOdf->getValue(g1odfbin) - (m_SimOdf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]))));
-          m_OdfChange =
-              m_OdfChange +
-              (((m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin)) * (m_ActualOdf->getValue(g2odfbin) - m_SimOdf->getValue(g2odfbin))) -
-               ((m_ActualOdf->getValue(g2odfbin) - (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]))) *
-                (m_ActualOdf->getValue(g2odfbin) -
-                 (m_SimOdf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])))));
-
-          m_MdfChange = 0;
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g2ea1, g2ea2, g2ea3));
-
-          size_t size = 0;
-          if(!neighborlist[selectedfeature1].empty())
-          {
-            size = neighborlist[selectedfeature1].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2))
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-            }
-          }
-
-          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-          size = 0;
-          if(!neighborlist[selectedfeature2].empty())
-          {
-            size = neighborlist[selectedfeature2].size();
-          }
-          for(size_t j = 0; j < size; j++)
-          {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
-            QuatF q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if(neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-            }
-          }
-
-          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
-          if(deltaerror > 0)
-          {
+    return;
+  }
 
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            m_SimOdf->setValue(g1odfbin, (m_SimOdf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem])));
-            m_SimOdf->setValue(g2odfbin, (m_SimOdf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / m_UnbiasedVolume[ensem]) - (m_Volumes[selectedfeature2] / m_UnbiasedVolume[ensem])));
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
-            size = 0;
-            if(!neighborlist[selectedfeature1].empty())
-            {
-              size = neighborlist[selectedfeature1].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if(neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-              }
-            }
-
-            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
-            q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
-            size = 0;
-            if(!neighborlist[selectedfeature2].empty())
-            {
-              size = neighborlist[selectedfeature2].size();
-            }
-            for(size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if(neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, q1, q2, laueOp.get());
-              }
-            }
-          }
-        }
-      }
-    }
-    if(getCancel())
+  // Keep the chain with the lowest combined error, weighting the ODF and MDF relative to their starting errors
+  // the same way a single move is accepted
+  size_t bestChain = 0;
+  double bestError = std::numeric_limits<double>::max();
+  for(size_t k = 0; k < numChains; k++)
+  {
+    double error = chains[k].getOdfError() / initialOdfError + chains[k].getMdfError() / initialMdfError;
+    if(error < bestError)
     {
-      return;
+      bestError = error;
+      bestChain = k;
     }
   }
-
-  if(getCancel())
+  if(bestChain > 0)
   {
-    return;
+    MatchCrystallographyChainState& state = chainStates[bestChain - 1];
+    std::copy(state.featureEulerAngles.begin(), state.featureEulerAngles.end(), m_FeatureEulerAngles);
+    std::copy(state.avgQuats.begin(), state.avgQuats.end(), m_AvgQuats);
+    std::copy(state.simOdf.begin(), state.simOdf.end(), m_SimOdf->getPointer(0));
+    std::copy(state.simMdf.begin(), state.simMdf.end(), m_SimMdf->getPointer(0));
+    m_MisorientationLists.swap(state.misorientationLists);
   }
 
   for(size_t i = 0; i < totalPoints; i++)
@@ -1434,3 +1085,15 @@ int MatchCrystallography::getMaxIterations() const
 {
   return m_MaxIterations;
 }
+
+// -----------------------------------------------------------------------------
+void MatchCrystallography::setNumberOfChains(int value)
+{
+  m_NumberOfChains = value;
+}
+
+// -----------------------------------------------------------------------------
+int MatchCrystallography::getNumberOfChains() const
+{
+  return m_NumberOfChains;
+}
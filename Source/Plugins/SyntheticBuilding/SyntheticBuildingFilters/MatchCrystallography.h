@@ -77,6 +77,7 @@ class SyntheticBuilding_EXPORT MatchCrystallography : public AbstractFilter
   PYB11_PROPERTY(QString FeatureEulerAnglesArrayName READ getFeatureEulerAnglesArrayName WRITE setFeatureEulerAnglesArrayName)
   PYB11_PROPERTY(QString AvgQuatsArrayName READ getAvgQuatsArrayName WRITE setAvgQuatsArrayName)
   PYB11_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
+  PYB11_PROPERTY(int NumberOfChains READ getNumberOfChains WRITE setNumberOfChains)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -267,6 +268,17 @@ public:
   int getMaxIterations() const;
   Q_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
 
+  /**
+   * @brief Setter property for NumberOfChains
+   */
+  void setNumberOfChains(int value);
+  /**
+   * @brief Getter property for NumberOfChains
+   * @return Value of NumberOfChains
+   */
+  int getNumberOfChains() const;
+  Q_PROPERTY(int NumberOfChains READ getNumberOfChains WRITE setNumberOfChains)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -371,30 +383,6 @@ protected:
    */
   int32_t pick_euler(float random, int32_t numbins);
 
-  /**
-   * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-   * @param feature Feature Id of Feature that has been swapped
-   * @param ensem Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaterions for the Feature
-   * @param q2 Quaterions for the Feature neighbor
-   */
-  void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops);
-
-  /**
-   * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-   * @param feature Feature Id of the Feature that has been swapped
-   * @param phase Ensemble index of the current phase
-   * @param j Neighbor index for the Feature
-   * @param neighsurfarea Surface area for the Feature neighbor
-   * @param sym Crystal structure index
-   * @param q1 Quaternions for the Feature
-   * @param q2 Quaternions for the Feature neighbor
-   */
-  void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, QuatF& q1, QuatF& q2, LaueOps* ops);
-
   /**
    * @brief matchCrystallography Swaps orientations for Features unitl convergence to
    * the input statistics
@@ -446,6 +434,7 @@ private:
   QString m_FeatureEulerAnglesArrayName = {};
   QString m_AvgQuatsArrayName = {};
   int m_MaxIterations = {};
+  int m_NumberOfChains = {};
 
   // Cell Data
 
@@ -459,9 +448,6 @@ private:
   StatsDataArray::WeakPointer m_StatsDataArray;
 
   // All other private instance variables
-  float m_MdfChange;
-  float m_OdfChange;
-
   std::vector<float> m_UnbiasedVolume;
   std::vector<float> m_TotalSurfaceArea;
 
@@ -35,6 +35,7 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include <QtCore/QDir>
@@ -325,14 +326,23 @@ void PackPrimaryPhases::initialize()
   m_SuperEllipsoidOps = ShapeOps::NullPointer();
   ::m_OrthoOps = OrthoRhombicOps::New();
 
-  m_ColumnList.clear();
-  m_RowList.clear();
-  m_PlaneList.clear();
+  m_ColumnOffsets.clear();
+  m_RowOffsets.clear();
+  m_PlaneOffsets.clear();
   m_EllipFuncList.clear();
 
+  m_WrappedColumns.clear();
+  m_WrappedRows.clear();
+  m_WrappedPlanes.clear();
+
+  m_CentroidBins.clear();
+  m_FeatureCentroidBins.clear();
+  m_CentroidBinDims[0] = m_CentroidBinDims[1] = m_CentroidBinDims[2] = 1;
+  m_OneOverCentroidBinSize[0] = m_OneOverCentroidBinSize[1] = m_OneOverCentroidBinSize[2] = 1.0f;
+
   m_PointsToAdd.clear();
   m_PointsToRemove.clear();
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = m_UseSeed ? m_SeedValue : QDateTime::currentMSecsSinceEpoch();
   m_FirstPrimaryFeature = 1;
   m_SizeX = m_SizeY = m_SizeZ = m_TotalVol = 0.0f;
   m_TotalVol = 1.0f;
@@ -1097,7 +1107,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     writeErrorFile = outFile.is_open();
   }
 
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  m_Seed = m_UseSeed ? m_SeedValue : QDateTime::currentMSecsSinceEpoch();
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
@@ -1185,8 +1195,8 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   exclusionOwnersPtr->initializeWithValue(0);
 
   // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  std::vector<int64_t> availablePoints;
+  std::vector<int64_t> availablePointSlots;
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1194,16 +1204,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   int64_t featureOwnersIdx = 0;
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
-  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
-  {
-    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
-    {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
-    }
-  }
+  initializeAvailablePoints(exclusionOwners, availablePoints, availablePointSlots);
   // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
@@ -1415,10 +1416,11 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
     return;
   }
 
-  m_ColumnList.resize(totalFeatures);
-  m_RowList.resize(totalFeatures);
-  m_PlaneList.resize(totalFeatures);
+  m_ColumnOffsets.resize(totalFeatures);
+  m_RowOffsets.resize(totalFeatures);
+  m_PlaneOffsets.resize(totalFeatures);
   m_EllipFuncList.resize(totalFeatures);
+  initializeWrappedIndices();
   m_PackQualities.resize(totalFeatures);
   m_FillingError = 1.0f;
 
@@ -1494,6 +1496,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   float timeDiff = 0.0f;
 
   // determine neighborhoods and initial neighbor distribution errors
+  initializeCentroidBins(totalFeatures);
   for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
   {
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
@@ -1515,16 +1518,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
   int32_t totalAdjustments = static_cast<int32_t>(100 * (totalFeatures - 1));
 
   // determine initial set of available points
-  m_AvailablePointsCount = 0;
-  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
-  {
-    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
-    {
-      availablePoints[i] = m_AvailablePointsCount;
-      availablePointsInv[m_AvailablePointsCount] = i;
-      m_AvailablePointsCount++;
-    }
-  }
+  initializeAvailablePoints(exclusionOwners, availablePoints, availablePointSlots);
 
   // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
   m_PointsToRemove.clear();
@@ -1598,7 +1592,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       if(!availablePoints.empty())
       {
         key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
+        featureOwnersIdx = availablePoints[key];
       }
       else
       {
@@ -1623,7 +1617,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       if(m_FillingError <= m_OldFillingError)
       {
         m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
+        updateAvailablePoints(exclusionOwners, availablePoints, availablePointSlots);
         acceptedmoves++;
       }
       else if(m_FillingError > m_OldFillingError)
@@ -1706,7 +1700,7 @@ void PackPrimaryPhases::placeFeatures(Int32ArrayType::Pointer featureOwnersPtr)
       if(m_FillingError <= m_OldFillingError)
       {
         m_OldNeighborhoodError = m_CurrentNeighborhoodError;
-        updateAvailablePoints(availablePoints, availablePointsInv);
+        updateAvailablePoints(exclusionOwners, availablePoints, availablePointSlots);
         acceptedmoves++;
       }
       //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
@@ -1917,34 +1911,27 @@ void PackPrimaryPhases::transferAttributes(int32_t gnum, Feature_t* feature)
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::moveFeature(size_t gnum, float xc, float yc, float zc)
 {
-  int64_t occolumn = 0, ocrow = 0, ocplane = 0;
-  int64_t nccolumn = 0, ncrow = 0, ncplane = 0;
-  int64_t shiftcolumn = 0, shiftrow = 0, shiftplane = 0;
-  float oxc = m_Centroids[3 * gnum];
-  float oyc = m_Centroids[3 * gnum + 1];
-  float ozc = m_Centroids[3 * gnum + 2];
-  occolumn = static_cast<int64_t>((oxc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-  ocrow = static_cast<int64_t>((oyc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-  ocplane = static_cast<int64_t>((ozc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-  nccolumn = static_cast<int64_t>((xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
-  ncrow = static_cast<int64_t>((yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
-  ncplane = static_cast<int64_t>((zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
-  shiftcolumn = nccolumn - occolumn;
-  shiftrow = ncrow - ocrow;
-  shiftplane = ncplane - ocplane;
+  // The voxels of the Feature are stored relative to its center packing point, so only the centroid has to move
   m_Centroids[3 * gnum] = xc;
   m_Centroids[3 * gnum + 1] = yc;
   m_Centroids[3 * gnum + 2] = zc;
-  size_t size = m_ColumnList[gnum].size();
 
-  for(size_t i = 0; i < size; i++)
+  if(m_FeatureCentroidBins.empty())
+  {
+    return;
+  }
+  int64_t bin[3] = {0, 0, 0};
+  findCentroidBin(xc, yc, zc, bin);
+  int64_t newBin = (m_CentroidBinDims[0] * m_CentroidBinDims[1] * bin[2]) + (m_CentroidBinDims[0] * bin[1]) + bin[0];
+  int64_t oldBin = m_FeatureCentroidBins[gnum];
+  if(newBin != oldBin)
   {
-    int64_t& cl = m_ColumnList[gnum][i];
-    cl += shiftcolumn;
-    int64_t& rl = m_RowList[gnum][i];
-    rl += shiftrow;
-    int64_t& pl = m_PlaneList[gnum][i];
-    pl += shiftplane;
+    std::vector<int32_t>& oldFeatures = m_CentroidBins[oldBin];
+    auto iter = std::find(oldFeatures.begin(), oldFeatures.end(), static_cast<int32_t>(gnum));
+    *iter = oldFeatures.back();
+    oldFeatures.pop_back();
+    m_CentroidBins[newBin].push_back(static_cast<int32_t>(gnum));
+    m_FeatureCentroidBins[gnum] = newBin;
   }
 }
 
@@ -1953,8 +1940,6 @@ void PackPrimaryPhases::moveFeature(size_t gnum, float xc, float yc, float zc)
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-
   float x = 0.0f, y = 0.0f, z = 0.0f;
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float dia = 0.0f, dia2 = 0.0f;
@@ -1963,7 +1948,6 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
   dia = m_EquivalentDiameters[gnum];
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumberOfTuples();
   int32_t increment = 0;
   if(add)
   {
@@ -1973,24 +1957,103 @@ void PackPrimaryPhases::determineNeighbors(size_t gnum, bool add)
   {
     increment = -1;
   }
-  for(size_t n = m_FirstPrimaryFeature; n < totalFeatures; n++)
+
+  // The bins are at least as wide as the largest diameter, so every Feature close enough to count sits in an adjacent bin
+  int64_t bin[3] = {0, 0, 0};
+  findCentroidBin(x, y, z, bin);
+  int64_t zStart = std::max<int64_t>(bin[2] - 1, 0);
+  int64_t zEnd = std::min<int64_t>(bin[2] + 1, m_CentroidBinDims[2] - 1);
+  int64_t yStart = std::max<int64_t>(bin[1] - 1, 0);
+  int64_t yEnd = std::min<int64_t>(bin[1] + 1, m_CentroidBinDims[1] - 1);
+  int64_t xStart = std::max<int64_t>(bin[0] - 1, 0);
+  int64_t xEnd = std::min<int64_t>(bin[0] + 1, m_CentroidBinDims[0] - 1);
+  for(int64_t binZ = zStart; binZ <= zEnd; binZ++)
   {
-    xn = m_Centroids[3 * n];
-    yn = m_Centroids[3 * n + 1];
-    zn = m_Centroids[3 * n + 2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
-    if(dx < dia && dy < dia && dz < dia)
+    for(int64_t binY = yStart; binY <= yEnd; binY++)
     {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+      for(int64_t binX = xStart; binX <= xEnd; binX++)
+      {
+        const std::vector<int32_t>& binFeatures = m_CentroidBins[(m_CentroidBinDims[0] * m_CentroidBinDims[1] * binZ) + (m_CentroidBinDims[0] * binY) + binX];
+        for(int32_t n : binFeatures)
+        {
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          dia2 = m_EquivalentDiameters[n];
+          dx = fabs(x - xn);
+          dy = fabs(y - yn);
+          dz = fabs(z - zn);
+          if(dx < dia && dy < dia && dz < dia)
+          {
+            m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+          }
+          if(dx < dia2 && dy < dia2 && dz < dia2)
+          {
+            m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+          }
+        }
+      }
     }
-    if(dx < dia2 && dy < dia2 && dz < dia2)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initializeCentroidBins(size_t totalFeatures)
+{
+  float maxDiameter = 0.0f;
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    maxDiameter = std::max(maxDiameter, m_EquivalentDiameters[i]);
+  }
+
+  // A small margin keeps the bins strictly wider than any diameter despite float rounding
+  float minBinSize = maxDiameter * 1.001f;
+  float sizes[3] = {m_SizeX, m_SizeY, m_SizeZ};
+  for(size_t d = 0; d < 3; d++)
+  {
+    m_CentroidBinDims[d] = 1;
+    if(minBinSize > 0.0f && sizes[d] > minBinSize)
     {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      m_CentroidBinDims[d] = static_cast<int64_t>(sizes[d] / minBinSize);
     }
   }
+  // Coarsen the grid until there are not many more bins than Features
+  int64_t maxBins = std::max<int64_t>(static_cast<int64_t>(totalFeatures), 1);
+  while(m_CentroidBinDims[0] * m_CentroidBinDims[1] * m_CentroidBinDims[2] > maxBins)
+  {
+    int64_t* largest = std::max_element(m_CentroidBinDims, m_CentroidBinDims + 3);
+    *largest = (*largest + 1) / 2;
+  }
+  for(size_t d = 0; d < 3; d++)
+  {
+    m_OneOverCentroidBinSize[d] = (sizes[d] > 0.0f) ? static_cast<float>(m_CentroidBinDims[d]) / sizes[d] : 0.0f;
+  }
+
+  m_CentroidBins.assign(m_CentroidBinDims[0] * m_CentroidBinDims[1] * m_CentroidBinDims[2], std::vector<int32_t>());
+  m_FeatureCentroidBins.assign(totalFeatures, 0);
+  int64_t bin[3] = {0, 0, 0};
+  for(size_t i = m_FirstPrimaryFeature; i < totalFeatures; i++)
+  {
+    findCentroidBin(m_Centroids[3 * i], m_Centroids[3 * i + 1], m_Centroids[3 * i + 2], bin);
+    int64_t binIdx = (m_CentroidBinDims[0] * m_CentroidBinDims[1] * bin[2]) + (m_CentroidBinDims[0] * bin[1]) + bin[0];
+    m_CentroidBins[binIdx].push_back(static_cast<int32_t>(i));
+    m_FeatureCentroidBins[i] = binIdx;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::findCentroidBin(float xc, float yc, float zc, int64_t bin[3]) const
+{
+  float coords[3] = {xc, yc, zc};
+  for(size_t d = 0; d < 3; d++)
+  {
+    int64_t b = static_cast<int64_t>(coords[d] * m_OneOverCentroidBinSize[d]);
+    bin[d] = std::min(std::max<int64_t>(b, 0), m_CentroidBinDims[d] - 1);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -2295,94 +2358,50 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
   int32_t* exclusionOwners = exclusionOwnersPtr->getPointer(0);
 
+  // Index the wrap tables by the unwrapped column, row and plane; see initializeWrappedIndices()
+  const int64_t* wrappedColumns = m_WrappedColumns.data() + 3 * m_PackingPoints[0];
+  const int64_t* wrappedRows = m_WrappedRows.data() + 3 * m_PackingPoints[1];
+  const int64_t* wrappedPlanes = m_WrappedPlanes.data() + 3 * m_PackingPoints[2];
+
   m_FillingError = m_FillingError * float(m_TotalPackingPoints);
-  int64_t col = 0, row = 0, plane = 0;
   int32_t k1 = 0, k2 = 0, k3 = 0;
   if(gadd > 0)
   {
     k1 = 2;
     k2 = -1;
     k3 = 1;
-    size_t numVoxelsForCurrentGrain = m_ColumnList[gadd].size();
-    std::vector<int64_t>& cl = m_ColumnList[gadd];
-    std::vector<int64_t>& rl = m_RowList[gadd];
-    std::vector<int64_t>& pl = m_PlaneList[gadd];
-    std::vector<float>& efl = m_EllipFuncList[gadd];
+    size_t numVoxelsForCurrentGrain = m_ColumnOffsets[gadd].size();
+    const std::vector<int32_t>& cl = m_ColumnOffsets[gadd];
+    const std::vector<int32_t>& rl = m_RowOffsets[gadd];
+    const std::vector<int32_t>& pl = m_PlaneOffsets[gadd];
+    const std::vector<float>& efl = m_EllipFuncList[gadd];
+    int64_t centerColumn = static_cast<int64_t>((m_Centroids[3 * gadd] - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+    int64_t centerRow = static_cast<int64_t>((m_Centroids[3 * gadd + 1] - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+    int64_t centerPlane = static_cast<int64_t>((m_Centroids[3 * gadd + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
     float packquality = 0;
     for(size_t i = 0; i < numVoxelsForCurrentGrain; i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
+      int64_t col = wrappedColumns[centerColumn + cl[i]];
+      int64_t row = wrappedRows[centerRow + rl[i]];
+      int64_t plane = wrappedPlanes[centerPlane + pl[i]];
+      // Without periodic boundaries the voxels outside of the packing grid are skipped
+      if(col < 0 || row < 0 || plane < 0)
       {
-        // Perform mod arithmetic to ensure we are within the packing points range
-        col = col % m_PackingPoints[0];
-        row = row % m_PackingPoints[1];
-        plane = plane % m_PackingPoints[2];
-
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
-        {
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToRemove.push_back(featureOwnersIdx);
-          }
-          exclusionOwners[featureOwnersIdx]++;
-        }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-        packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
+        continue;
       }
-      else
+      featureOwnersIdx = plane + row + col;
+      int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+      if(efl[i] > 0.1f)
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(exclusionOwners[featureOwnersIdx] > 0)
-          {
-          }
-          if(efl[i] > 0.1f)
-          {
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToRemove.push_back(featureOwnersIdx);
-            }
-            exclusionOwners[featureOwnersIdx]++;
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
-          packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
+          m_PointsToRemove.push_back(featureOwnersIdx);
         }
+        exclusionOwners[featureOwnersIdx]++;
       }
+      m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+      featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+      packquality = static_cast<float>(packquality + ((currentFeatureOwner) * (currentFeatureOwner)));
     }
     m_PackQualities[gadd] = static_cast<int64_t>(packquality / float(numVoxelsForCurrentGrain));
   }
@@ -2391,80 +2410,35 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
     k1 = -2;
     k2 = 3;
     k3 = -1;
-    size_t size = m_ColumnList[gremove].size();
-    std::vector<int64_t>& cl = m_ColumnList[gremove];
-    std::vector<int64_t>& rl = m_RowList[gremove];
-    std::vector<int64_t>& pl = m_PlaneList[gremove];
-    std::vector<float>& efl = m_EllipFuncList[gremove];
+    size_t size = m_ColumnOffsets[gremove].size();
+    const std::vector<int32_t>& cl = m_ColumnOffsets[gremove];
+    const std::vector<int32_t>& rl = m_RowOffsets[gremove];
+    const std::vector<int32_t>& pl = m_PlaneOffsets[gremove];
+    const std::vector<float>& efl = m_EllipFuncList[gremove];
+    int64_t centerColumn = static_cast<int64_t>((m_Centroids[3 * gremove] - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0]);
+    int64_t centerRow = static_cast<int64_t>((m_Centroids[3 * gremove + 1] - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1]);
+    int64_t centerPlane = static_cast<int64_t>((m_Centroids[3 * gremove + 2] - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2]);
     for(size_t i = 0; i < size; i++)
     {
-      col = cl[i];
-      row = rl[i];
-      plane = pl[i];
-      if(m_PeriodicBoundaries)
+      int64_t col = wrappedColumns[centerColumn + cl[i]];
+      int64_t row = wrappedRows[centerRow + rl[i]];
+      int64_t plane = wrappedPlanes[centerPlane + pl[i]];
+      if(col < 0 || row < 0 || plane < 0)
       {
-        // Perform mod arithmetic to ensure we are within the packing points range
-        col = col % m_PackingPoints[0];
-        row = row % m_PackingPoints[1];
-        plane = plane % m_PackingPoints[2];
-
-        if(col < 0)
-        {
-          col = col + m_PackingPoints[0];
-        }
-        if(col > m_PackingPoints[0] - 1)
-        {
-          col = col - m_PackingPoints[0];
-        }
-        if(row < 0)
-        {
-          row = row + m_PackingPoints[1];
-        }
-        if(row > m_PackingPoints[1] - 1)
-        {
-          row = row - m_PackingPoints[1];
-        }
-        if(plane < 0)
-        {
-          plane = plane + m_PackingPoints[2];
-        }
-        if(plane > m_PackingPoints[2] - 1)
-        {
-          plane = plane - m_PackingPoints[2];
-        }
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-        int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-        if(efl[i] > 0.1f)
-        {
-          exclusionOwners[featureOwnersIdx]--;
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToAdd.push_back(featureOwnersIdx);
-          }
-        }
-        m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-        //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-        featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+        continue;
       }
-      else
+      featureOwnersIdx = plane + row + col;
+      int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
+      if(efl[i] > 0.1f)
       {
-        if(col >= 0 && col < m_PackingPoints[0] && row >= 0 && row < m_PackingPoints[1] && plane >= 0 && plane < m_PackingPoints[2])
+        exclusionOwners[featureOwnersIdx]--;
+        if(exclusionOwners[featureOwnersIdx] == 0)
         {
-          featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col;
-          int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
-          if(efl[i] > 0.1f)
-          {
-            exclusionOwners[featureOwnersIdx]--;
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToAdd.push_back(featureOwnersIdx);
-            }
-          }
-          m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
-          //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
-          featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
+          m_PointsToAdd.push_back(featureOwnersIdx);
         }
       }
+      m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
+      featureOwners[featureOwnersIdx] = currentFeatureOwner + k3;
     }
   }
   m_FillingError = m_FillingError / float(m_TotalPackingPoints);
@@ -2474,33 +2448,80 @@ float PackPrimaryPhases::checkFillingError(int32_t gadd, int32_t gremove, Int32A
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void PackPrimaryPhases::initializeWrappedIndices()
 {
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
-  for(size_t i = 0; i < removeSize; i++)
+  // The voxels of a Feature are at most 2 packing grids away from the grid in any direction
+  // (see insertFeature), so the tables cover the unwrapped range [-3 * points, 4 * points)
+  int64_t strides[3] = {1, m_PackingPoints[0], m_PackingPoints[0] * m_PackingPoints[1]};
+  std::vector<int64_t>* tables[3] = {&m_WrappedColumns, &m_WrappedRows, &m_WrappedPlanes};
+  for(size_t d = 0; d < 3; d++)
+  {
+    int64_t points = m_PackingPoints[d];
+    std::vector<int64_t>& table = *(tables[d]);
+    table.resize(7 * points);
+    for(int64_t i = 0; i < 7 * points; i++)
+    {
+      int64_t unwrapped = i - 3 * points;
+      if(m_PeriodicBoundaries)
+      {
+        table[i] = (((unwrapped % points) + points) % points) * strides[d];
+      }
+      else
+      {
+        table[i] = (unwrapped >= 0 && unwrapped < points) ? unwrapped * strides[d] : -1;
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::initializeAvailablePoints(const int32_t* exclusionOwners, std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointSlots)
+{
+  availablePoints.clear();
+  availablePointSlots.assign(m_TotalPackingPoints, -1);
+  for(int64_t i = 0; i < m_TotalPackingPoints; i++)
+  {
+    if((exclusionOwners[i] == 0 && !m_UseMask) || (exclusionOwners[i] == 0 && m_UseMask && m_Mask[i]))
+    {
+      availablePointSlots[i] = static_cast<int64_t>(availablePoints.size());
+      availablePoints.push_back(i);
+    }
+  }
+  m_AvailablePointsCount = availablePoints.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::updateAvailablePoints(const int32_t* exclusionOwners, std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointSlots)
+{
+  // A point can be freed by the old position of a Feature and covered again by its new one (or the other way around),
+  // so the final exclusion state decides whether the point is available
+  for(size_t featureOwnersIdx : m_PointsToRemove)
   {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
+    int64_t slot = availablePointSlots[featureOwnersIdx];
+    if(slot < 0 || exclusionOwners[featureOwnersIdx] == 0)
     {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
+      continue;
     }
-    m_AvailablePointsCount--;
+    int64_t last = availablePoints.back();
+    availablePoints[slot] = last;
+    availablePointSlots[last] = slot;
+    availablePoints.pop_back();
+    availablePointSlots[featureOwnersIdx] = -1;
   }
-  for(size_t i = 0; i < addSize; i++)
+  for(size_t featureOwnersIdx : m_PointsToAdd)
   {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
+    if(availablePointSlots[featureOwnersIdx] >= 0 || exclusionOwners[featureOwnersIdx] != 0 || (m_UseMask && !m_Mask[featureOwnersIdx]))
+    {
+      continue;
+    }
+    availablePointSlots[featureOwnersIdx] = static_cast<int64_t>(availablePoints.size());
+    availablePoints.push_back(static_cast<int64_t>(featureOwnersIdx));
   }
+  m_AvailablePointsCount = availablePoints.size();
   m_PointsToRemove.clear();
   m_PointsToAdd.clear();
 }
@@ -2619,9 +2640,9 @@ void PackPrimaryPhases::insertFeature(size_t gnum)
         inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
         if(inside >= 0)
         {
-          m_ColumnList[gnum].push_back(column);
-          m_RowList[gnum].push_back(row);
-          m_PlaneList[gnum].push_back(plane);
+          m_ColumnOffsets[gnum].push_back(static_cast<int32_t>(column - centercolumn));
+          m_RowOffsets[gnum].push_back(static_cast<int32_t>(row - centerrow));
+          m_PlaneOffsets[gnum].push_back(static_cast<int32_t>(plane - centerplane));
           m_EllipFuncList[gnum].push_back(inside);
         }
       }
@@ -3848,6 +3869,30 @@ bool PackPrimaryPhases::getWriteGoalAttributes() const
   return m_WriteGoalAttributes;
 }
 
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::setSeedValue(uint64_t value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+uint64_t PackPrimaryPhases::getSeedValue() const
+{
+  return m_SeedValue;
+}
+
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::setSaveGeometricDescriptions(int value)
 {
@@ -333,6 +333,29 @@ public:
   bool getWriteGoalAttributes() const;
   Q_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
 
+  /**
+   * @brief Setter property for UseSeed. When set, the packing is seeded with SeedValue instead of the current time
+   * so that a run can be reproduced. This property is not exposed as a filter parameter.
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(uint64_t value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  uint64_t getSeedValue() const;
+  Q_PROPERTY(uint64_t SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief Setter property for SaveGeometricDescriptions
    */
@@ -535,17 +558,48 @@ protected:
    * @param gadd Value that determines whether to add point Ids to be filled
    * @param gremove Value that determines whether to add point Ids to be removed
    * @param featureOwnersPtr Array of Feature Ids for each packing point
-   * @param exclusionOwnersPtr Array of exlusion Ids for each packing point
+   * @param exclusionOwnersPtr Array of exclusion Ids for each packing point
    * @return Float percentage value for the ratio of unassinged/"garbage" packing points
    */
   float checkFillingError(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
   /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
+   * @brief initializeAvailablePoints Collects every packing point that is not in an exclusion zone (and not masked out)
+   * @param exclusionOwners Array of exclusion Ids for each packing point
+   * @param availablePoints Dense list of the available packing points
+   * @param availablePointSlots Position of each packing point in availablePoints, or -1 if it is not available
    */
-  void updateAvailablePoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+  void initializeAvailablePoints(const int32_t* exclusionOwners, std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointSlots);
+
+  /**
+   * @brief updateAvailablePoints Applies the points that left or entered an exclusion zone during the last accepted move
+   * @param exclusionOwners Array of exclusion Ids for each packing point
+   * @param availablePoints Dense list of the available packing points
+   * @param availablePointSlots Position of each packing point in availablePoints, or -1 if it is not available
+   */
+  void updateAvailablePoints(const int32_t* exclusionOwners, std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointSlots);
+
+  /**
+   * @brief initializeWrappedIndices Builds the lookup tables that turn an unwrapped packing column, row or plane
+   * into its contribution to the packing point index
+   */
+  void initializeWrappedIndices();
+
+  /**
+   * @brief initializeCentroidBins Sorts the Feature centroids into a grid of bins at least as wide as the
+   * largest equivalent diameter, so that determineNeighbors only has to visit the adjacent bins
+   * @param totalFeatures Number of Features
+   */
+  void initializeCentroidBins(size_t totalFeatures);
+
+  /**
+   * @brief findCentroidBin Returns the bin coordinates of a centroid
+   * @param xc x centroid coordinate
+   * @param yc y centroid coordinate
+   * @param zc z centroid coordinate
+   * @param bin Output bin coordinates
+   */
+  void findCentroidBin(float xc, float yc, float zc, int64_t bin[3]) const;
 
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -588,7 +642,7 @@ protected:
   /**
    * @brief writeVtkFile Outputs a debug VTK file for visualization
    * @param featureOwners Array of Feature Ids for each packing point
-   * @param exclusionZonesPtr Array of exlusion Ids for each packing point
+   * @param exclusionZonesPtr Array of exclusion Ids for each packing point
    * @return Integer error code
    */
   int32_t writeVtkFile(int32_t* featureOwners, int32_t* exclusionZonesPtr);
@@ -659,6 +713,8 @@ private:
   QString m_CsvOutputFile = {};
   bool m_PeriodicBoundaries = {};
   bool m_WriteGoalAttributes = {};
+  bool m_UseSeed = {};
+  uint64_t m_SeedValue = {};
   int m_SaveGeometricDescriptions = {};
   DataArrayPath m_NewAttributeMatrixPath = {};
   DataArrayPath m_SelectedAttributeMatrixPath = {};
@@ -688,11 +744,20 @@ private:
   ShapeOps::Pointer m_EllipsoidOps;
   ShapeOps::Pointer m_SuperEllipsoidOps;
 
-  std::vector<std::vector<int64_t>> m_ColumnList;
-  std::vector<std::vector<int64_t>> m_RowList;
-  std::vector<std::vector<int64_t>> m_PlaneList;
+  std::vector<std::vector<int32_t>> m_ColumnOffsets;
+  std::vector<std::vector<int32_t>> m_RowOffsets;
+  std::vector<std::vector<int32_t>> m_PlaneOffsets;
   std::vector<std::vector<float>> m_EllipFuncList;
 
+  std::vector<int64_t> m_WrappedColumns;
+  std::vector<int64_t> m_WrappedRows;
+  std::vector<int64_t> m_WrappedPlanes;
+
+  std::vector<std::vector<int32_t>> m_CentroidBins;
+  std::vector<int64_t> m_FeatureCentroidBins;
+  int64_t m_CentroidBinDims[3];
+  FloatVec3Type m_OneOverCentroidBinSize;
+
   std::vector<size_t> m_PointsToAdd;
   std::vector<size_t> m_PointsToRemove;
 
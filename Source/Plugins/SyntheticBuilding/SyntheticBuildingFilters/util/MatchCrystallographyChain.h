@@ -0,0 +1,616 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QObject>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Utilities/TimeUtilities.h"
+
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The MatchCrystallographyInputs struct holds the read-only data every Monte Carlo chain of one phase shares
+ */
+struct MatchCrystallographyInputs
+{
+  AbstractFilter* filter = nullptr;
+  NeighborList<int32_t>* neighborList = nullptr;
+  NeighborList<float>* sharedSurfaceAreaList = nullptr;
+  const float* volumes = nullptr;
+  const bool* surfaceFeatures = nullptr;
+  const int32_t* featurePhases = nullptr;
+  size_t totalFeatures = 0;
+  size_t ensem = 0;
+  int32_t numFeatures = 0;
+  float unbiasedVolume = 0.0f;
+  float totalSurfaceArea = 0.0f;
+  const float* actualOdf = nullptr;
+  int32_t numOdfBins = 0;
+  const float* actualMdf = nullptr;
+  int32_t numMdfBins = 0;
+  uint32_t crystalStructure = 0;
+  int32_t maxIterations = 0;
+};
+
+/**
+ * @brief The MatchCrystallographyChainState struct owns a copy of the orientations and distributions
+ * that one additional Monte Carlo chain modifies
+ */
+struct MatchCrystallographyChainState
+{
+  std::vector<float> featureEulerAngles;
+  std::vector<float> avgQuats;
+  std::vector<float> simOdf;
+  std::vector<float> simMdf;
+  std::vector<std::vector<float>> misorientationLists;
+};
+
+/**
+ * @brief The MatchCrystallographyChain class runs one Monte Carlo chain of orientation swaps and switches. The
+ * squared ODF and MDF errors are kept as running sums that are only corrected for the bins an accepted move changes.
+ */
+class MatchCrystallographyChain
+{
+public:
+  MatchCrystallographyChain(const MatchCrystallographyInputs& inputs, float* featureEulerAngles, float* avgQuats, float* simOdf, float* simMdf,
+                            std::vector<std::vector<float>>& misorientationLists, uint64_t seed, bool reportProgress)
+  : m_Inputs(inputs)
+  , m_FeatureEulerAngles(featureEulerAngles)
+  , m_AvgQuats(avgQuats)
+  , m_SimOdf(simOdf)
+  , m_SimMdf(simMdf)
+  , m_MisorientationLists(misorientationLists)
+  , m_Seed(seed)
+  , m_ReportProgress(reportProgress)
+  {
+    // The full error is only summed once; accepted moves then adjust it for the bins they touch
+    for(int32_t i = 0; i < m_Inputs.numOdfBins; i++)
+    {
+      double delta = m_Inputs.actualOdf[i] - m_SimOdf[i];
+      m_OdfError += delta * delta;
+    }
+    for(int32_t i = 0; i < m_Inputs.numMdfBins; i++)
+    {
+      double delta = m_Inputs.actualMdf[i] - m_SimMdf[i];
+      m_MdfError += delta * delta;
+    }
+  }
+
+  double getOdfError() const
+  {
+    return m_OdfError;
+  }
+
+  double getMdfError() const
+  {
+    return m_MdfError;
+  }
+
+  void run()
+  {
+    NeighborList<int32_t>& neighborlist = *(m_Inputs.neighborList);
+    NeighborList<float>& neighborsurfacearealist = *(m_Inputs.sharedSurfaceAreaList);
+    const float* actualOdf = m_Inputs.actualOdf;
+    const float* volumes = m_Inputs.volumes;
+    const float unbiasedVolume = m_Inputs.unbiasedVolume;
+    const size_t totalFeatures = m_Inputs.totalFeatures;
+    const size_t ensem = m_Inputs.ensem;
+    const int32_t maxIterations = m_Inputs.maxIterations;
+
+    std::mt19937_64 generator(m_Seed);
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    std::array<double, 3> randx3;
+
+    int32_t iterations = 0, badtrycount = 0;
+    float random = 0.0f;
+    size_t counter = 0;
+
+    QuatF q1;
+    QuatF q2;
+
+    float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
+    float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
+    int32_t g1odfbin = 0, g2odfbin = 0;
+    float deltaerror = 0.0f;
+    float currentodferror = 0.0f, currentmdferror = 0.0f;
+    int32_t selectedfeature1 = 0, selectedfeature2 = 0;
+
+    // Each chain gets its own operator instance so the chains do not share any mutable state
+    LaueOps::Pointer laueOp = LaueOps::GetAllOrientationOps()[m_Inputs.crystalStructure];
+    LaueOps* ops = laueOp.get();
+
+    uint64_t millis = QDateTime::currentMSecsSinceEpoch();
+    uint64_t startMillis = millis;
+    while(badtrycount < (maxIterations / 10) && iterations < maxIterations)
+    {
+      if(m_ReportProgress)
+      {
+        uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
+        if(currentMillis - millis > 1000)
+        {
+          QString ss = QObject::tr("Swapping/Switching Orientations Iteration %1/%2").arg(iterations).arg(maxIterations);
+          float timeDiff = ((float)iterations / (float)(currentMillis - startMillis));
+          float estimatedTime = (float)(maxIterations - iterations) / timeDiff;
+
+          ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
+          m_Inputs.filter->notifyStatusMessage(ss);
+
+          millis = QDateTime::currentMSecsSinceEpoch();
+        }
+      }
+      currentodferror = static_cast<float>(m_OdfError);
+      currentmdferror = static_cast<float>(m_MdfError);
+      iterations++;
+      badtrycount++;
+      random = static_cast<float>(distribution(generator));
+
+      if(m_Inputs.filter->getCancel())
+      {
+        return;
+      }
+
+      if(random < 0.5) // SwapOutOrientation
+      {
+        counter = 0;
+        selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        while((m_Inputs.surfaceFeatures[selectedfeature1] || m_Inputs.featurePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+        {
+          if(selectedfeature1 >= totalFeatures)
+          {
+            selectedfeature1 = selectedfeature1 - totalFeatures;
+          }
+          selectedfeature1++;
+          counter++;
+        }
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        if(counter == totalFeatures)
+        {
+          badtrycount = 10 * m_Inputs.numFeatures;
+        }
+        else
+        {
+          ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
+          ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
+          ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
+          OrientationD rod(4, 0.0);
+
+          OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
+          rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+
+          g1odfbin = ops->getOdfBin(rod);
+          random = static_cast<float>(distribution(generator));
+          int32_t choose = pickEuler(random);
+
+          randx3[0] = distribution(generator);
+          randx3[1] = distribution(generator);
+          randx3[2] = distribution(generator);
+          OrientationD g1ea = ops->determineEulerAngles(randx3.data(), choose);
+          g1ea = ops->randomizeEulerAngles(g1ea);
+
+          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(g1ea);
+
+          float volumeFraction = volumes[selectedfeature1] / unbiasedVolume;
+          m_OdfChange = ((actualOdf[choose] - m_SimOdf[choose]) * (actualOdf[choose] - m_SimOdf[choose])) -
+                        ((actualOdf[choose] - (m_SimOdf[choose] + volumeFraction)) * (actualOdf[choose] - (m_SimOdf[choose] + volumeFraction)));
+          m_OdfChange = m_OdfChange + (((actualOdf[g1odfbin] - m_SimOdf[g1odfbin]) * (actualOdf[g1odfbin] - m_SimOdf[g1odfbin])) -
+                                       ((actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction)) * (actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction))));
+
+          m_MdfChange = 0;
+          size_t size = 0;
+          if(!neighborlist[selectedfeature1].empty())
+          {
+            size = neighborlist[selectedfeature1].size();
+          }
+          for(size_t j = 0; j < size; j++)
+          {
+            int32_t neighbor = neighborlist[selectedfeature1][j];
+            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+
+            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
+            measureMdfChange(selectedfeature1, j, neighsurfarea, q1, q2, ops);
+          }
+
+          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
+          if(deltaerror > 0)
+          {
+            badtrycount = 0;
+            m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
+            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
+            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
+            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+            setOdfValue(choose, m_SimOdf[choose] + volumeFraction);
+            setOdfValue(g1odfbin, m_SimOdf[g1odfbin] - volumeFraction);
+            for(size_t j = 0; j < size; j++)
+            {
+              int neighbor = neighborlist[selectedfeature1][j];
+              eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+
+              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
+              applyMdfChange(selectedfeature1, j, neighsurfarea, q1, q2, ops);
+            }
+          }
+        }
+        if(m_Inputs.filter->getCancel())
+        {
+          return;
+        }
+      }
+      else // SwitchOrientation
+      {
+        counter = 0;
+        selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        while((m_Inputs.surfaceFeatures[selectedfeature1] || m_Inputs.featurePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+        {
+          if(selectedfeature1 >= totalFeatures)
+          {
+            selectedfeature1 = selectedfeature1 - totalFeatures;
+          }
+          selectedfeature1++;
+          counter++;
+        }
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        if(counter == totalFeatures)
+        {
+          badtrycount = 10 * m_Inputs.numFeatures;
+        }
+        else
+        {
+          counter = 0;
+          selectedfeature2 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+          if(selectedfeature2 >= totalFeatures)
+          {
+            selectedfeature2 = selectedfeature2 - totalFeatures;
+          }
+          while((m_Inputs.surfaceFeatures[selectedfeature2] || m_Inputs.featurePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) &&
+                counter < totalFeatures)
+          {
+            if(selectedfeature2 >= totalFeatures)
+            {
+              selectedfeature2 = selectedfeature2 - totalFeatures;
+            }
+            selectedfeature2++;
+            counter++;
+          }
+          if(selectedfeature2 >= totalFeatures)
+          {
+            selectedfeature2 = selectedfeature2 - totalFeatures;
+          }
+          if(counter == totalFeatures)
+          {
+            badtrycount = 10 * m_Inputs.numFeatures;
+          }
+          else
+          {
+            g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
+            g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
+            g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
+            g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
+            g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
+            g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
+            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+            OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
+            OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+
+            g1odfbin = ops->getOdfBin(rod);
+            q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
+
+            eu = OrientationD(m_FeatureEulerAngles[3 * selectedfeature2], m_FeatureEulerAngles[3 * selectedfeature2 + 1], m_FeatureEulerAngles[3 * selectedfeature2 + 2]);
+            rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+            g2odfbin = ops->getOdfBin(rod);
+
+            float volumeFraction1 = volumes[selectedfeature1] / unbiasedVolume;
+            float volumeFraction2 = volumes[selectedfeature2] / unbiasedVolume;
+            m_OdfChange = ((actualOdf[g1odfbin] - m_SimOdf[g1odfbin]) * (actualOdf[g1odfbin] - m_SimOdf[g1odfbin])) -
+                          ((actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction1 + volumeFraction2)) * (actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction1 + volumeFraction2)));
+            m_OdfChange =
+                m_OdfChange + (((actualOdf[g2odfbin] - m_SimOdf[g2odfbin]) * (actualOdf[g2odfbin] - m_SimOdf[g2odfbin])) -
+                               ((actualOdf[g2odfbin] - (m_SimOdf[g2odfbin] - volumeFraction2 + volumeFraction1)) * (actualOdf[g2odfbin] - (m_SimOdf[g2odfbin] - volumeFraction2 + volumeFraction1))));
+
+            m_MdfChange = 0;
+
+            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g2ea1, g2ea2, g2ea3));
+
+            size_t size = 0;
+            if(!neighborlist[selectedfeature1].empty())
+            {
+              size = neighborlist[selectedfeature1].size();
+            }
+            for(size_t j = 0; j < size; j++)
+            {
+              int32_t neighbor = neighborlist[selectedfeature1][j];
+              if(neighbor != selectedfeature2)
+              {
+                eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+                q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+                float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
+                measureMdfChange(selectedfeature1, j, neighsurfarea, q1, q2, ops);
+              }
+            }
+
+            q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
+            size = 0;
+            if(!neighborlist[selectedfeature2].empty())
+            {
+              size = neighborlist[selectedfeature2].size();
+            }
+            for(size_t j = 0; j < size; j++)
+            {
+              int32_t neighbor = neighborlist[selectedfeature2][j];
+              if(neighbor != selectedfeature1)
+              {
+                eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+                q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+                float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
+                measureMdfChange(selectedfeature2, j, neighsurfarea, q1, q2, ops);
+              }
+            }
+
+            deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
+            if(deltaerror > 0)
+            {
+              badtrycount = 0;
+              m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
+              m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
+              m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
+              m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
+              m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
+              m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
+              setOdfValue(g1odfbin, m_SimOdf[g1odfbin] + volumeFraction2 - volumeFraction1);
+              setOdfValue(g2odfbin, m_SimOdf[g2odfbin] + volumeFraction1 - volumeFraction2);
+
+              q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
+              q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+              size = 0;
+              if(!neighborlist[selectedfeature1].empty())
+              {
+                size = neighborlist[selectedfeature1].size();
+              }
+              for(size_t j = 0; j < size; j++)
+              {
+                int32_t neighbor = neighborlist[selectedfeature1][j];
+                if(neighbor != selectedfeature2)
+                {
+                  ea1 = m_FeatureEulerAngles[3 * neighbor];
+                  ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
+                  ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
+                  q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
+                  float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
+                  applyMdfChange(selectedfeature1, j, neighsurfarea, q1, q2, ops);
+                }
+              }
+
+              q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
+              size = 0;
+              if(!neighborlist[selectedfeature2].empty())
+              {
+                size = neighborlist[selectedfeature2].size();
+              }
+              for(size_t j = 0; j < size; j++)
+              {
+                int32_t neighbor = neighborlist[selectedfeature2][j];
+                if(neighbor != selectedfeature1)
+                {
+                  ea1 = m_FeatureEulerAngles[3 * neighbor];
+                  ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
+                  ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
+                  q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
+                  float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
+                  applyMdfChange(selectedfeature2, j, neighsurfarea, q1, q2, ops);
+                }
+              }
+            }
+          }
+        }
+      }
+      if(m_Inputs.filter->getCancel())
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  const MatchCrystallographyInputs& m_Inputs;
+  float* m_FeatureEulerAngles = nullptr;
+  float* m_AvgQuats = nullptr;
+  float* m_SimOdf = nullptr;
+  float* m_SimMdf = nullptr;
+  std::vector<std::vector<float>>& m_MisorientationLists;
+  uint64_t m_Seed = 0;
+  bool m_ReportProgress = false;
+
+  double m_OdfError = 0.0;
+  double m_MdfError = 0.0;
+  float m_OdfChange = 0.0f;
+  float m_MdfChange = 0.0f;
+
+  /**
+   * @brief setOdfValue Stores a new simulated ODF value and corrects the running ODF error for that bin only
+   */
+  void setOdfValue(int32_t bin, float value)
+  {
+    double oldDelta = m_Inputs.actualOdf[bin] - m_SimOdf[bin];
+    double newDelta = m_Inputs.actualOdf[bin] - value;
+    m_OdfError += newDelta * newDelta - oldDelta * oldDelta;
+    m_SimOdf[bin] = value;
+  }
+
+  /**
+   * @brief setMdfValue Stores a new simulated MDF value and corrects the running MDF error for that bin only
+   */
+  void setMdfValue(size_t bin, float value)
+  {
+    double oldDelta = m_Inputs.actualMdf[bin] - m_SimMdf[bin];
+    double newDelta = m_Inputs.actualMdf[bin] - value;
+    m_MdfError += newDelta * newDelta - oldDelta * oldDelta;
+    m_SimMdf[bin] = value;
+  }
+
+  /**
+   * @brief pickEuler Picks a random bin from the incoming orientation statistics
+   */
+  int32_t pickEuler(float random) const
+  {
+    int32_t choose = 0;
+    float totaldensity = 0.0f;
+
+    for(int32_t j = 0; j < m_Inputs.numOdfBins; j++)
+    {
+      float density = m_Inputs.actualOdf[j];
+      float td1 = totaldensity;
+      totaldensity = totaldensity + density;
+      if(random < totaldensity && random >= td1)
+      {
+        choose = j;
+        break;
+      }
+    }
+    return choose;
+  }
+
+  /**
+   * @brief misorientationBin Returns the MDF bin of the stored misorientation between a feature and its j'th neighbor. The
+   * magnitude is taken in the precision T, matching the double (measure) and float (apply) paths of the original loop bodies
+   */
+  template <typename T>
+  size_t misorientationBin(int32_t feature, size_t j, LaueOps* ops) const
+  {
+    T curmiso1 = m_MisorientationLists[feature][3 * j];
+    T curmiso2 = m_MisorientationLists[feature][3 * j + 1];
+    T curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+
+    OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0);
+    T mag = std::sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
+    if(mag == 0.0)
+    {
+      rod[3] = std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+      rod[3] = mag;
+      rod[0] = rod[0] / rod[3];
+      rod[1] = rod[1] / rod[3];
+      rod[2] = rod[2] / rod[3];
+    }
+    return ops->getMisoBin(rod);
+  }
+
+  /**
+   * @brief measureMdfChange Accumulates the MDF error change of moving one boundary to the misorientation between q1 and q2
+   */
+  void measureMdfChange(int32_t feature, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
+  {
+    const float* actualMdf = m_Inputs.actualMdf;
+    size_t curmisobin = misorientationBin<double>(feature, j, ops);
+    OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+    size_t newmisobin = ops->getMisoBin(rod);
+
+    float areaFraction = neighsurfarea / m_Inputs.totalSurfaceArea;
+    m_MdfChange = m_MdfChange + (((actualMdf[curmisobin] - m_SimMdf[curmisobin]) * (actualMdf[curmisobin] - m_SimMdf[curmisobin])) -
+                                 ((actualMdf[curmisobin] - (m_SimMdf[curmisobin] - areaFraction)) * (actualMdf[curmisobin] - (m_SimMdf[curmisobin] - areaFraction))));
+    m_MdfChange = m_MdfChange + (((actualMdf[newmisobin] - m_SimMdf[newmisobin]) * (actualMdf[newmisobin] - m_SimMdf[newmisobin])) -
+                                 ((actualMdf[newmisobin] - (m_SimMdf[newmisobin] + areaFraction)) * (actualMdf[newmisobin] - (m_SimMdf[newmisobin] + areaFraction))));
+  }
+
+  /**
+   * @brief applyMdfChange Moves one boundary of an accepted swap or switch to its new misorientation bin
+   */
+  void applyMdfChange(int32_t feature, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
+  {
+    size_t curmisobin = misorientationBin<float>(feature, j, ops);
+    OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+    size_t newmisobin = ops->getMisoBin(rod);
+    m_MisorientationLists[feature][3 * j] = 0.0f;
+    m_MisorientationLists[feature][3 * j + 1] = 0.0f;
+    m_MisorientationLists[feature][3 * j + 2] = 0.0f;
+    float areaFraction = neighsurfarea / m_Inputs.totalSurfaceArea;
+    setMdfValue(curmisobin, m_SimMdf[curmisobin] - areaFraction);
+    setMdfValue(newmisobin, m_SimMdf[newmisobin] + areaFraction);
+  }
+};
+
+/**
+ * @brief The MatchCrystallographyChainsImpl class runs a range of independent Monte Carlo chains
+ */
+class MatchCrystallographyChainsImpl
+{
+public:
+  MatchCrystallographyChainsImpl(std::vector<MatchCrystallographyChain>& chains)
+  : m_Chains(chains)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t k = range.min(); k < range.max(); k++)
+    {
+      m_Chains[k].run();
+    }
+  }
+
+private:
+  std::vector<MatchCrystallographyChain>& m_Chains;
+};
@@ -0,0 +1,671 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuilding/SyntheticBuildingFilters/util/MatchCrystallographyChain.h"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+/**
+ * @brief The MatchCrystallographyFixture struct holds a small synthetic phase of features with assigned orientations,
+ * built the same way MatchCrystallography prepares a phase before it runs its Monte Carlo chains.
+ */
+struct MatchCrystallographyFixture
+{
+  AbstractFilter::Pointer filter;
+  NeighborList<int32_t>::Pointer neighborList;
+  NeighborList<float>::Pointer sharedSurfaceAreaList;
+  std::vector<float> volumes;
+  std::vector<bool> surfaceFeaturesVector;
+  std::unique_ptr<bool[]> surfaceFeatures;
+  std::vector<int32_t> featurePhases;
+  std::vector<float> actualOdf;
+  std::vector<float> actualMdf;
+  std::vector<float> featureEulerAngles;
+  std::vector<float> avgQuats;
+  std::vector<float> simOdf;
+  std::vector<float> simMdf;
+  std::vector<std::vector<float>> misorientationLists;
+  MatchCrystallographyInputs inputs;
+};
+
+/**
+ * @brief The BaselineChain class is the swap/switch loop of MatchCrystallography as it was before the chains kept
+ * running errors: the ODF and MDF errors are summed over every bin on every iteration. The sums are taken in double
+ * like the chain's running errors, and the MDF sum is limited to the MDF bins since the original loop read past the end
+ * of the MDF, so only the error bookkeeping differs between the two.
+ */
+class BaselineChain
+{
+public:
+  BaselineChain(const MatchCrystallographyInputs& inputs, float* featureEulerAngles, float* avgQuats, float* simOdf, float* simMdf, std::vector<std::vector<float>>& misorientationLists,
+                uint64_t seed)
+  : m_Inputs(inputs)
+  , m_FeatureEulerAngles(featureEulerAngles)
+  , m_AvgQuats(avgQuats)
+  , m_SimOdf(simOdf)
+  , m_SimMdf(simMdf)
+  , m_MisorientationLists(misorientationLists)
+  , m_Seed(seed)
+  {
+  }
+
+  void run()
+  {
+    NeighborList<int32_t>& neighborlist = *(m_Inputs.neighborList);
+    NeighborList<float>& neighborsurfacearealist = *(m_Inputs.sharedSurfaceAreaList);
+    const float* actualOdf = m_Inputs.actualOdf;
+    const float* volumes = m_Inputs.volumes;
+    const float unbiasedVolume = m_Inputs.unbiasedVolume;
+    const size_t totalFeatures = m_Inputs.totalFeatures;
+    const size_t ensem = m_Inputs.ensem;
+    const int32_t maxIterations = m_Inputs.maxIterations;
+
+    std::mt19937_64 generator(m_Seed);
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    std::array<double, 3> randx3;
+
+    int32_t iterations = 0, badtrycount = 0;
+    float random = 0.0f;
+    size_t counter = 0;
+
+    QuatF q1;
+    QuatF q2;
+
+    float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
+    float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
+    int32_t g1odfbin = 0, g2odfbin = 0;
+    float deltaerror = 0.0f;
+    float currentodferror = 0.0f, currentmdferror = 0.0f;
+    int32_t selectedfeature1 = 0, selectedfeature2 = 0;
+
+    LaueOps::Pointer laueOp = LaueOps::GetAllOrientationOps()[m_Inputs.crystalStructure];
+    LaueOps* ops = laueOp.get();
+
+    while(badtrycount < (maxIterations / 10) && iterations < maxIterations)
+    {
+      double odfError = 0.0;
+      for(int32_t i = 0; i < m_Inputs.numOdfBins; i++)
+      {
+        double delta = actualOdf[i] - m_SimOdf[i];
+        odfError += delta * delta;
+      }
+      double mdfError = 0.0;
+      for(int32_t i = 0; i < m_Inputs.numMdfBins; i++)
+      {
+        double delta = m_Inputs.actualMdf[i] - m_SimMdf[i];
+        mdfError += delta * delta;
+      }
+      currentodferror = static_cast<float>(odfError);
+      currentmdferror = static_cast<float>(mdfError);
+      iterations++;
+      badtrycount++;
+      random = static_cast<float>(distribution(generator));
+
+      if(random < 0.5) // SwapOutOrientation
+      {
+        counter = 0;
+        selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        while((m_Inputs.surfaceFeatures[selectedfeature1] || m_Inputs.featurePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+        {
+          if(selectedfeature1 >= totalFeatures)
+          {
+            selectedfeature1 = selectedfeature1 - totalFeatures;
+          }
+          selectedfeature1++;
+          counter++;
+        }
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        if(counter == totalFeatures)
+        {
+          badtrycount = 10 * m_Inputs.numFeatures;
+        }
+        else
+        {
+          ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
+          ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
+          ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
+          OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
+          OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+
+          g1odfbin = ops->getOdfBin(rod);
+          random = static_cast<float>(distribution(generator));
+          int32_t choose = pickEuler(random);
+
+          randx3[0] = distribution(generator);
+          randx3[1] = distribution(generator);
+          randx3[2] = distribution(generator);
+          OrientationD g1ea = ops->determineEulerAngles(randx3.data(), choose);
+          g1ea = ops->randomizeEulerAngles(g1ea);
+
+          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(g1ea);
+
+          float volumeFraction = volumes[selectedfeature1] / unbiasedVolume;
+          m_OdfChange = ((actualOdf[choose] - m_SimOdf[choose]) * (actualOdf[choose] - m_SimOdf[choose])) -
+                        ((actualOdf[choose] - (m_SimOdf[choose] + volumeFraction)) * (actualOdf[choose] - (m_SimOdf[choose] + volumeFraction)));
+          m_OdfChange = m_OdfChange + (((actualOdf[g1odfbin] - m_SimOdf[g1odfbin]) * (actualOdf[g1odfbin] - m_SimOdf[g1odfbin])) -
+                                       ((actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction)) * (actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction))));
+
+          m_MdfChange = 0;
+          size_t size = neighborlist[selectedfeature1].size();
+          for(size_t j = 0; j < size; j++)
+          {
+            int32_t neighbor = neighborlist[selectedfeature1][j];
+            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+            measureMdfChange(selectedfeature1, j, neighborsurfacearealist[selectedfeature1][j], q1, q2, ops);
+          }
+
+          deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
+          if(deltaerror > 0)
+          {
+            badtrycount = 0;
+            m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
+            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
+            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
+            q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+            m_SimOdf[choose] = m_SimOdf[choose] + volumeFraction;
+            m_SimOdf[g1odfbin] = m_SimOdf[g1odfbin] - volumeFraction;
+            for(size_t j = 0; j < size; j++)
+            {
+              int32_t neighbor = neighborlist[selectedfeature1][j];
+              eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+              applyMdfChange(selectedfeature1, j, neighborsurfacearealist[selectedfeature1][j], q1, q2, ops);
+            }
+          }
+        }
+      }
+      else // SwitchOrientation
+      {
+        counter = 0;
+        selectedfeature1 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        while((m_Inputs.surfaceFeatures[selectedfeature1] || m_Inputs.featurePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+        {
+          if(selectedfeature1 >= totalFeatures)
+          {
+            selectedfeature1 = selectedfeature1 - totalFeatures;
+          }
+          selectedfeature1++;
+          counter++;
+        }
+        if(selectedfeature1 >= totalFeatures)
+        {
+          selectedfeature1 = selectedfeature1 - totalFeatures;
+        }
+        if(counter == totalFeatures)
+        {
+          badtrycount = 10 * m_Inputs.numFeatures;
+          continue;
+        }
+        counter = 0;
+        selectedfeature2 = static_cast<int32_t>(distribution(generator) * totalFeatures);
+        if(selectedfeature2 >= totalFeatures)
+        {
+          selectedfeature2 = selectedfeature2 - totalFeatures;
+        }
+        while((m_Inputs.surfaceFeatures[selectedfeature2] || m_Inputs.featurePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) &&
+              counter < totalFeatures)
+        {
+          if(selectedfeature2 >= totalFeatures)
+          {
+            selectedfeature2 = selectedfeature2 - totalFeatures;
+          }
+          selectedfeature2++;
+          counter++;
+        }
+        if(selectedfeature2 >= totalFeatures)
+        {
+          selectedfeature2 = selectedfeature2 - totalFeatures;
+        }
+        if(counter == totalFeatures)
+        {
+          badtrycount = 10 * m_Inputs.numFeatures;
+          continue;
+        }
+
+        g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
+        g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
+        g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
+        g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
+        g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
+        g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
+        q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+        OrientationD eu(m_FeatureEulerAngles[3 * selectedfeature1], m_FeatureEulerAngles[3 * selectedfeature1 + 1], m_FeatureEulerAngles[3 * selectedfeature1 + 2]);
+        OrientationD rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+        g1odfbin = ops->getOdfBin(rod);
+        q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
+
+        eu = OrientationD(m_FeatureEulerAngles[3 * selectedfeature2], m_FeatureEulerAngles[3 * selectedfeature2 + 1], m_FeatureEulerAngles[3 * selectedfeature2 + 2]);
+        rod = OrientationTransformation::eu2ro<OrientationD, OrientationD>(eu);
+        g2odfbin = ops->getOdfBin(rod);
+
+        float volumeFraction1 = volumes[selectedfeature1] / unbiasedVolume;
+        float volumeFraction2 = volumes[selectedfeature2] / unbiasedVolume;
+        m_OdfChange = ((actualOdf[g1odfbin] - m_SimOdf[g1odfbin]) * (actualOdf[g1odfbin] - m_SimOdf[g1odfbin])) -
+                      ((actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction1 + volumeFraction2)) * (actualOdf[g1odfbin] - (m_SimOdf[g1odfbin] - volumeFraction1 + volumeFraction2)));
+        m_OdfChange = m_OdfChange + (((actualOdf[g2odfbin] - m_SimOdf[g2odfbin]) * (actualOdf[g2odfbin] - m_SimOdf[g2odfbin])) -
+                                     ((actualOdf[g2odfbin] - (m_SimOdf[g2odfbin] - volumeFraction2 + volumeFraction1)) * (actualOdf[g2odfbin] - (m_SimOdf[g2odfbin] - volumeFraction2 + volumeFraction1))));
+
+        m_MdfChange = 0;
+
+        q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g2ea1, g2ea2, g2ea3));
+        size_t size = neighborlist[selectedfeature1].size();
+        for(size_t j = 0; j < size; j++)
+        {
+          int32_t neighbor = neighborlist[selectedfeature1][j];
+          if(neighbor != selectedfeature2)
+          {
+            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+            measureMdfChange(selectedfeature1, j, neighborsurfacearealist[selectedfeature1][j], q1, q2, ops);
+          }
+        }
+
+        q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
+        size = neighborlist[selectedfeature2].size();
+        for(size_t j = 0; j < size; j++)
+        {
+          int32_t neighbor = neighborlist[selectedfeature2][j];
+          if(neighbor != selectedfeature1)
+          {
+            eu = OrientationD(m_FeatureEulerAngles[3 * neighbor], m_FeatureEulerAngles[3 * neighbor + 1], m_FeatureEulerAngles[3 * neighbor + 2]);
+            q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(eu);
+            measureMdfChange(selectedfeature2, j, neighborsurfacearealist[selectedfeature2][j], q1, q2, ops);
+          }
+        }
+
+        deltaerror = (m_OdfChange / currentodferror) + (m_MdfChange / currentmdferror);
+        if(deltaerror > 0)
+        {
+          badtrycount = 0;
+          m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
+          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
+          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
+          m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
+          m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
+          m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
+          m_SimOdf[g1odfbin] = m_SimOdf[g1odfbin] + volumeFraction2 - volumeFraction1;
+          m_SimOdf[g2odfbin] = m_SimOdf[g2odfbin] + volumeFraction1 - volumeFraction2;
+
+          q1 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(g1ea1, g1ea2, g1ea3));
+          q1.copyInto(m_AvgQuats + selectedfeature1 * 4, Quaternion<float>::Order::VectorScalar);
+          size = neighborlist[selectedfeature1].size();
+          for(size_t j = 0; j < size; j++)
+          {
+            int32_t neighbor = neighborlist[selectedfeature1][j];
+            if(neighbor != selectedfeature2)
+            {
+              ea1 = m_FeatureEulerAngles[3 * neighbor];
+              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
+              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
+              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
+              applyMdfChange(selectedfeature1, j, neighborsurfacearealist[selectedfeature1][j], q1, q2, ops);
+            }
+          }
+
+          q1.copyInto(m_AvgQuats + selectedfeature2 * 4, Quaternion<float>::Order::VectorScalar);
+          size = neighborlist[selectedfeature2].size();
+          for(size_t j = 0; j < size; j++)
+          {
+            int32_t neighbor = neighborlist[selectedfeature2][j];
+            if(neighbor != selectedfeature1)
+            {
+              ea1 = m_FeatureEulerAngles[3 * neighbor];
+              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
+              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
+              q2 = OrientationTransformation::eu2qu<OrientationD, QuatF>(OrientationD(ea1, ea2, ea3));
+              applyMdfChange(selectedfeature2, j, neighborsurfacearealist[selectedfeature2][j], q1, q2, ops);
+            }
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const MatchCrystallographyInputs& m_Inputs;
+  float* m_FeatureEulerAngles = nullptr;
+  float* m_AvgQuats = nullptr;
+  float* m_SimOdf = nullptr;
+  float* m_SimMdf = nullptr;
+  std::vector<std::vector<float>>& m_MisorientationLists;
+  uint64_t m_Seed = 0;
+  float m_OdfChange = 0.0f;
+  float m_MdfChange = 0.0f;
+
+  int32_t pickEuler(float random) const
+  {
+    float totaldensity = 0.0f;
+    for(int32_t j = 0; j < m_Inputs.numOdfBins; j++)
+    {
+      float td1 = totaldensity;
+      totaldensity = totaldensity + m_Inputs.actualOdf[j];
+      if(random < totaldensity && random >= td1)
+      {
+        return j;
+      }
+    }
+    return 0;
+  }
+
+  template <typename T>
+  size_t misorientationBin(int32_t feature, size_t j, LaueOps* ops) const
+  {
+    T curmiso1 = m_MisorientationLists[feature][3 * j];
+    T curmiso2 = m_MisorientationLists[feature][3 * j + 1];
+    T curmiso3 = m_MisorientationLists[feature][3 * j + 2];
+
+    OrientationD rod(curmiso1, curmiso2, curmiso3, 0.0);
+    T mag = std::sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
+    if(mag == 0.0)
+    {
+      rod[3] = std::numeric_limits<double>::infinity();
+    }
+    else
+    {
+      rod[3] = mag;
+      rod[0] = rod[0] / rod[3];
+      rod[1] = rod[1] / rod[3];
+      rod[2] = rod[2] / rod[3];
+    }
+    return ops->getMisoBin(rod);
+  }
+
+  void measureMdfChange(int32_t feature, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
+  {
+    const float* actualMdf = m_Inputs.actualMdf;
+    size_t curmisobin = misorientationBin<double>(feature, j, ops);
+    OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+    size_t newmisobin = ops->getMisoBin(rod);
+
+    float areaFraction = neighsurfarea / m_Inputs.totalSurfaceArea;
+    m_MdfChange = m_MdfChange + (((actualMdf[curmisobin] - m_SimMdf[curmisobin]) * (actualMdf[curmisobin] - m_SimMdf[curmisobin])) -
+                                 ((actualMdf[curmisobin] - (m_SimMdf[curmisobin] - areaFraction)) * (actualMdf[curmisobin] - (m_SimMdf[curmisobin] - areaFraction))));
+    m_MdfChange = m_MdfChange + (((actualMdf[newmisobin] - m_SimMdf[newmisobin]) * (actualMdf[newmisobin] - m_SimMdf[newmisobin])) -
+                                 ((actualMdf[newmisobin] - (m_SimMdf[newmisobin] + areaFraction)) * (actualMdf[newmisobin] - (m_SimMdf[newmisobin] + areaFraction))));
+  }
+
+  void applyMdfChange(int32_t feature, size_t j, float neighsurfarea, const QuatF& q1, const QuatF& q2, LaueOps* ops)
+  {
+    size_t curmisobin = misorientationBin<float>(feature, j, ops);
+    OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+    OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+    size_t newmisobin = ops->getMisoBin(rod);
+    m_MisorientationLists[feature][3 * j] = 0.0f;
+    m_MisorientationLists[feature][3 * j + 1] = 0.0f;
+    m_MisorientationLists[feature][3 * j + 2] = 0.0f;
+    float areaFraction = neighsurfarea / m_Inputs.totalSurfaceArea;
+    m_SimMdf[curmisobin] = m_SimMdf[curmisobin] - areaFraction;
+    m_SimMdf[newmisobin] = m_SimMdf[newmisobin] + areaFraction;
+  }
+};
+
+class MatchCrystallographyChainTest
+{
+
+public:
+  MatchCrystallographyChainTest() = default;
+  virtual ~MatchCrystallographyChainTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // Every feature touches the next ones along a ring and one across it, and every ninth feature touches the surface
+  // -----------------------------------------------------------------------------
+  void BuildFixture(MatchCrystallographyFixture& fixture, size_t numFeatures, int32_t maxIterations)
+  {
+    const size_t ensem = 1;
+    const uint32_t crystalStructure = EbsdLib::CrystalStructure::Cubic_High;
+    const size_t totalFeatures = numFeatures + 1;
+    LaueOps::Pointer ops = LaueOps::GetAllOrientationOps()[crystalStructure];
+
+    std::mt19937_64 generator(1234567);
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+
+    fixture.filter = AbstractFilter::New();
+    fixture.featurePhases.assign(totalFeatures, static_cast<int32_t>(ensem));
+    fixture.featurePhases[0] = 0;
+    fixture.surfaceFeatures.reset(new bool[totalFeatures]);
+    fixture.volumes.assign(totalFeatures, 0.0f);
+    float unbiasedVolume = 0.0f;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      fixture.surfaceFeatures[i] = (i % 9 == 0);
+      fixture.volumes[i] = 1.0f + static_cast<float>(std::floor(distribution(generator) * 20.0));
+      if(!fixture.surfaceFeatures[i])
+      {
+        unbiasedVolume += fixture.volumes[i];
+      }
+    }
+    fixture.surfaceFeatures[0] = false;
+
+    std::vector<std::vector<int32_t>> neighbors(totalFeatures);
+    std::vector<std::vector<float>> areas(totalFeatures);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(size_t step : {size_t(1), size_t(2), numFeatures / 2})
+      {
+        size_t n = (i - 1 + step) % numFeatures + 1;
+        float area = 1.0f + static_cast<float>(std::floor(distribution(generator) * 8.0));
+        neighbors[i].push_back(static_cast<int32_t>(n));
+        areas[i].push_back(area);
+        neighbors[n].push_back(static_cast<int32_t>(i));
+        areas[n].push_back(area);
+      }
+    }
+    fixture.neighborList = NeighborList<int32_t>::CreateArray(totalFeatures, SIMPL::FeatureData::NeighborList, true);
+    fixture.sharedSurfaceAreaList = NeighborList<float>::CreateArray(totalFeatures, SIMPL::FeatureData::SharedSurfaceAreaList, true);
+    float totalSurfaceArea = 0.0f;
+    for(size_t i = 0; i < totalFeatures; i++)
+    {
+      fixture.neighborList->setList(static_cast<int32_t>(i), NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>(neighbors[i])));
+      fixture.sharedSurfaceAreaList->setList(static_cast<int32_t>(i), NeighborList<float>::SharedVectorType(new std::vector<float>(areas[i])));
+      for(float area : areas[i])
+      {
+        totalSurfaceArea += area;
+      }
+    }
+
+    // A textured ODF and a smooth MDF, both normalized
+    int32_t numOdfBins = ops->getODFSize();
+    int32_t numMdfBins = ops->getMDFSize();
+    fixture.actualOdf.resize(numOdfBins);
+    float odfSum = 0.0f;
+    for(int32_t i = 0; i < numOdfBins; i++)
+    {
+      fixture.actualOdf[i] = static_cast<float>(distribution(generator)) + ((i % 97) == 0 ? 200.0f : 0.0f);
+      odfSum += fixture.actualOdf[i];
+    }
+    for(float& value : fixture.actualOdf)
+    {
+      value /= odfSum;
+    }
+    fixture.actualMdf.resize(numMdfBins);
+    float mdfSum = 0.0f;
+    for(int32_t i = 0; i < numMdfBins; i++)
+    {
+      fixture.actualMdf[i] = 1.0f + static_cast<float>(i % 13);
+      mdfSum += fixture.actualMdf[i];
+    }
+    for(float& value : fixture.actualMdf)
+    {
+      value /= mdfSum;
+    }
+
+    // Random orientations, the simulated ODF they give and the misorientations across every boundary, the same way
+    // assign_eulers() and measure_misorientations() set them up
+    fixture.featureEulerAngles.assign(totalFeatures * 3, 0.0f);
+    fixture.avgQuats.assign(totalFeatures * 4, 0.0f);
+    fixture.simOdf.assign(numOdfBins, 0.0f);
+    fixture.simMdf.assign(numMdfBins, 0.0f);
+    std::array<double, 3> randx3;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      int32_t choose = static_cast<int32_t>(distribution(generator) * numOdfBins) % numOdfBins;
+      randx3[0] = distribution(generator);
+      randx3[1] = distribution(generator);
+      randx3[2] = distribution(generator);
+      OrientationD eulers = ops->determineEulerAngles(randx3.data(), choose);
+      eulers = ops->randomizeEulerAngles(eulers);
+      fixture.featureEulerAngles[3 * i] = static_cast<float>(eulers[0]);
+      fixture.featureEulerAngles[3 * i + 1] = static_cast<float>(eulers[1]);
+      fixture.featureEulerAngles[3 * i + 2] = static_cast<float>(eulers[2]);
+      QuatF q = OrientationTransformation::eu2qu<OrientationD, QuatF>(eulers);
+      q.copyInto(fixture.avgQuats.data() + i * 4, Quaternion<float>::Order::VectorScalar);
+      if(!fixture.surfaceFeatures[i])
+      {
+        fixture.simOdf[choose] += fixture.volumes[i] / unbiasedVolume;
+      }
+    }
+    fixture.misorientationLists.resize(totalFeatures);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      fixture.misorientationLists[i].assign(neighbors[i].size() * 3, 0.0f);
+      QuatF q1(fixture.avgQuats.data() + i * 4);
+      for(size_t j = 0; j < neighbors[i].size(); j++)
+      {
+        int32_t nname = neighbors[i][j];
+        QuatF q2(fixture.avgQuats.data() + nname * 4);
+        OrientationD axisAngle = ops->calculateMisorientation(q1, q2);
+        OrientationD rod = OrientationTransformation::ax2ro<OrientationD, OrientationD>(axisAngle);
+        fixture.misorientationLists[i][3 * j] = static_cast<float>(rod[0]);
+        fixture.misorientationLists[i][3 * j + 1] = static_cast<float>(rod[1]);
+        fixture.misorientationLists[i][3 * j + 2] = static_cast<float>(rod[2]);
+        if(!fixture.surfaceFeatures[i] && (nname > static_cast<int32_t>(i) || fixture.surfaceFeatures[nname]))
+        {
+          fixture.simMdf[ops->getMisoBin(rod)] += areas[i][j] / totalSurfaceArea;
+        }
+      }
+    }
+
+    MatchCrystallographyInputs& inputs = fixture.inputs;
+    inputs.filter = fixture.filter.get();
+    inputs.neighborList = fixture.neighborList.get();
+    inputs.sharedSurfaceAreaList = fixture.sharedSurfaceAreaList.get();
+    inputs.volumes = fixture.volumes.data();
+    inputs.surfaceFeatures = fixture.surfaceFeatures.get();
+    inputs.featurePhases = fixture.featurePhases.data();
+    inputs.totalFeatures = totalFeatures;
+    inputs.ensem = ensem;
+    inputs.numFeatures = static_cast<int32_t>(numFeatures);
+    inputs.unbiasedVolume = unbiasedVolume;
+    inputs.totalSurfaceArea = totalSurfaceArea;
+    inputs.actualOdf = fixture.actualOdf.data();
+    inputs.numOdfBins = numOdfBins;
+    inputs.actualMdf = fixture.actualMdf.data();
+    inputs.numMdfBins = numMdfBins;
+    inputs.crystalStructure = crystalStructure;
+    inputs.maxIterations = maxIterations;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RequireEqual(const std::vector<float>& actual, const std::vector<float>& expected)
+  {
+    DREAM3D_REQUIRE_EQUAL(actual.size(), expected.size())
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(actual[i], expected[i])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // A single chain, which is what the filter runs in place when NumberOfChains is 1, makes exactly the moves of the
+  // baseline loop for the same seed, and its running errors match the errors summed over every bin
+  // -----------------------------------------------------------------------------
+  int TestSingleChainMatchesBaseline()
+  {
+    const size_t numFeatures = 120;
+    const int32_t maxIterations = 20000;
+    for(uint64_t seed : {uint64_t(5489), uint64_t(987654321)})
+    {
+      MatchCrystallographyFixture expected;
+      BuildFixture(expected, numFeatures, maxIterations);
+      BaselineChain baseline(expected.inputs, expected.featureEulerAngles.data(), expected.avgQuats.data(), expected.simOdf.data(), expected.simMdf.data(), expected.misorientationLists, seed);
+      baseline.run();
+
+      MatchCrystallographyFixture actual;
+      BuildFixture(actual, numFeatures, maxIterations);
+      std::vector<float> initialEulers = actual.featureEulerAngles;
+      MatchCrystallographyChain chain(actual.inputs, actual.featureEulerAngles.data(), actual.avgQuats.data(), actual.simOdf.data(), actual.simMdf.data(), actual.misorientationLists, seed, false);
+      chain.run();
+
+      // Make sure the chain actually accepted some moves
+      bool moved = false;
+      for(size_t i = 0; i < initialEulers.size(); i++)
+      {
+        moved = moved || (initialEulers[i] != actual.featureEulerAngles[i]);
+      }
+      DREAM3D_REQUIRE(moved)
+
+      RequireEqual(actual.featureEulerAngles, expected.featureEulerAngles);
+      RequireEqual(actual.avgQuats, expected.avgQuats);
+      RequireEqual(actual.simOdf, expected.simOdf);
+      RequireEqual(actual.simMdf, expected.simMdf);
+      DREAM3D_REQUIRE_EQUAL(actual.misorientationLists.size(), expected.misorientationLists.size())
+      for(size_t i = 0; i < expected.misorientationLists.size(); i++)
+      {
+        RequireEqual(actual.misorientationLists[i], expected.misorientationLists[i]);
+      }
+
+      double odfError = 0.0;
+      for(size_t i = 0; i < actual.simOdf.size(); i++)
+      {
+        double delta = actual.actualOdf[i] - actual.simOdf[i];
+        odfError += delta * delta;
+      }
+      double mdfError = 0.0;
+      for(size_t i = 0; i < actual.simMdf.size(); i++)
+      {
+        double delta = actual.actualMdf[i] - actual.simMdf[i];
+        mdfError += delta * delta;
+      }
+      DREAM3D_REQUIRED(std::fabs(chain.getOdfError() - odfError), <=, 1.0E-9 * odfError)
+      DREAM3D_REQUIRED(std::fabs(chain.getMdfError() - mdfError), <=, 1.0E-9 * mdfError)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSingleChainMatchesBaseline())
+  }
+
+private:
+  MatchCrystallographyChainTest(const MatchCrystallographyChainTest&); // Copy Constructor Not Implemented
+  void operator=(const MatchCrystallographyChainTest&);                // Move assignment Not Implemented
+};
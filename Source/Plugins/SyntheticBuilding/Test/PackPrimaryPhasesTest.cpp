@@ -0,0 +1,190 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/Common/ShapeType.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "UnitTestSupport.hpp"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+class PackPrimaryPhasesTest
+{
+
+public:
+  PackPrimaryPhasesTest() = default;
+  virtual ~PackPrimaryPhasesTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames = {"GeneratePrimaryStatsData", "InitializeSyntheticVolume", "PackPrimaryPhases"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The PackPrimaryPhasesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE_VALID_POINTER(filterFactory.get())
+    AbstractFilter::Pointer filter = filterFactory->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void ExecuteFilter(const AbstractFilter::Pointer& filter, const DataContainerArray::Pointer& dca)
+  {
+    filter->setDataContainerArray(dca);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Packs a small equiaxed single phase volume and returns its Feature Ids along with the number of Features
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer PackVolume(uint64_t seed, size_t& numFeatures)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    QVariant var;
+    bool propWasSet = false;
+
+    AbstractFilter::Pointer statsFilter = CreateFilter("GeneratePrimaryStatsData");
+    var.setValue(2.0);
+    propWasSet = statsFilter->setProperty("Mu", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(0.1);
+    propWasSet = statsFilter->setProperty("Sigma", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(1.0);
+    propWasSet = statsFilter->setProperty("BinStepSize", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    ExecuteFilter(statsFilter, dca);
+
+    // Every primary phase is packed with ellipsoids
+    AttributeMatrix::Pointer ensembleAttrMat = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::StatsGenerator, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(ensembleAttrMat.get())
+    UInt32ArrayType::Pointer shapeTypes = UInt32ArrayType::CreateArray(ensembleAttrMat->getTupleDimensions(), std::vector<size_t>(1, 1), SIMPL::EnsembleData::ShapeTypes, true);
+    shapeTypes->initializeWithValue(static_cast<ShapeType::EnumType>(ShapeType::Type::Ellipsoid));
+    shapeTypes->setValue(0, static_cast<ShapeType::EnumType>(ShapeType::Type::Unknown));
+    ensembleAttrMat->insertOrAssign(shapeTypes);
+
+    AbstractFilter::Pointer volumeFilter = CreateFilter("InitializeSyntheticVolume");
+    IntVec3Type dims(40, 40, 40);
+    var.setValue(dims);
+    propWasSet = volumeFilter->setProperty("Dimensions", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    FloatVec3Type spacing(1.0f, 1.0f, 1.0f);
+    var.setValue(spacing);
+    propWasSet = volumeFilter->setProperty("Spacing", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    ExecuteFilter(volumeFilter, dca);
+
+    AbstractFilter::Pointer packFilter = CreateFilter("PackPrimaryPhases");
+    var.setValue(true);
+    propWasSet = packFilter->setProperty("UseSeed", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(seed);
+    propWasSet = packFilter->setProperty("SeedValue", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    ExecuteFilter(packFilter, dca);
+
+    AttributeMatrix::Pointer featureAttrMat =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::SyntheticVolumeDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(featureAttrMat.get())
+    numFeatures = featureAttrMat->getNumberOfTuples();
+
+    Int32ArrayType::Pointer featureIds =
+        dca->getPrereqArrayFromPath<Int32ArrayType>(nullptr, DataArrayPath(SIMPL::Defaults::SyntheticVolumeDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds), {1});
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+    DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), static_cast<size_t>(dims[0] * dims[1] * dims[2]))
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two packs with the same seed must give the same volume, every voxel must end up in a Feature, and a different
+  // seed must give a different volume
+  // -----------------------------------------------------------------------------
+  int TestFixedSeedPacking()
+  {
+    size_t numFeatures = 0;
+    Int32ArrayType::Pointer featureIds = PackVolume(5489, numFeatures);
+    DREAM3D_REQUIRED(numFeatures, >, 2)
+
+    std::vector<size_t> featureCounts(numFeatures, 0);
+    size_t numCells = featureIds->getNumberOfTuples();
+    for(size_t i = 0; i < numCells; i++)
+    {
+      int32_t featureId = featureIds->getValue(i);
+      DREAM3D_REQUIRED(featureId, >, 0)
+      DREAM3D_REQUIRED(static_cast<size_t>(featureId), <, numFeatures)
+      featureCounts[featureId]++;
+    }
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      DREAM3D_REQUIRED(featureCounts[i], >, 0)
+    }
+
+    size_t repeatNumFeatures = 0;
+    Int32ArrayType::Pointer repeatFeatureIds = PackVolume(5489, repeatNumFeatures);
+    DREAM3D_REQUIRE_EQUAL(repeatNumFeatures, numFeatures)
+    for(size_t i = 0; i < numCells; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(repeatFeatureIds->getValue(i), featureIds->getValue(i))
+    }
+
+    size_t otherNumFeatures = 0;
+    Int32ArrayType::Pointer otherFeatureIds = PackVolume(987654321, otherNumFeatures);
+    bool differs = (otherNumFeatures != numFeatures);
+    for(size_t i = 0; i < numCells && !differs; i++)
+    {
+      differs = (otherFeatureIds->getValue(i) != featureIds->getValue(i));
+    }
+    DREAM3D_REQUIRE(differs)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFixedSeedPacking())
+  }
+
+private:
+  PackPrimaryPhasesTest(const PackPrimaryPhasesTest&); // Copy Constructor Not Implemented
+  void operator=(const PackPrimaryPhasesTest&);        // Move assignment Not Implemented
+};